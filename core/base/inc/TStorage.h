@@ -80,6 +80,10 @@ public:
    static void SetReAllocHooks(ReAllocFun_t func1, ReAllocCFun_t func2);
    static void SetCustomNewDelete();
    static void EnableStatistics(int size= -1, int ix= -1);
+   static void EnableObjectPool(Bool_t enable = kTRUE);
+   static Bool_t IsObjectPoolEnabled();
+   static void GetObjectPoolStatistics(ULong64_t &nAllocated, ULong64_t &nFreed, ULong64_t &nBytesReserved);
+   static void PrintObjectPoolStatistics();
 
    static Bool_t HasCustomNewDelete();
 
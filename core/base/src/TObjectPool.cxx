@@ -0,0 +1,325 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TObjectPool.h"
+#include "TString.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+
+using ROOT::Internal::TObjectPool;
+
+namespace {
+
+constexpr size_t kGranularity = 16;
+constexpr UInt_t kNClasses = TObjectPool::kMaxSize / kGranularity;
+constexpr size_t kSpanSize = size_t(1) << TObjectPool::kSpanShift;
+constexpr UInt_t kSpansPerChunk = 16;
+
+constexpr UInt_t ClassOf(size_t size)
+{
+   return size ? (size - 1) / kGranularity : 0;
+}
+
+constexpr size_t SizeOf(UInt_t c)
+{
+   return (c + 1) * kGranularity;
+}
+
+/// Number of blocks exchanged at once between a thread cache and the free list of the class, about 8 KiB.
+constexpr UInt_t BatchOf(UInt_t c)
+{
+   return 8192 / SizeOf(c) < 8 ? 8 : (8192 / SizeOf(c) > 128 ? 128 : UInt_t(8192 / SizeOf(c)));
+}
+
+struct TFreeBlock {
+   TFreeBlock *fNext;
+};
+
+struct TClassList {
+   std::mutex fMutex;
+   TFreeBlock *fHead = nullptr;
+   char *fBump = nullptr;    ///< Next block never used of the last span of the class
+   char *fBumpEnd = nullptr; ///< End of the last span of the class
+   std::atomic<ULong64_t> fNAllocated{0};
+   std::atomic<ULong64_t> fNFreed{0};
+};
+
+struct TCentral {
+   TClassList fLists[kNClasses];
+   std::mutex fSpanMutex;
+   char *fChunk = nullptr; ///< Spans not yet given to a class
+   UInt_t fChunkSpansLeft = 0;
+   std::atomic<ULong64_t> fNSpans{0};
+};
+
+// Never deleted: the objects can be freed until the very end of the process.
+TCentral &GetCentral()
+{
+   static TCentral *central = new TCentral;
+   return *central;
+}
+
+struct TThreadCache {
+   TFreeBlock *fHead[kNClasses];
+   UInt_t fCount[kNClasses];
+   ULong64_t fNAllocated[kNClasses];
+   ULong64_t fNFreed[kNClasses];
+};
+
+// Trivially destructible, so that they can still be used by the destructors of thread_local and static objects
+// that run after the cache of the thread was released.
+thread_local TThreadCache *tCache = nullptr;
+thread_local bool tCacheReleased = false;
+
+void FlushCounters(TThreadCache &cache, UInt_t c, TClassList &list)
+{
+   list.fNAllocated.fetch_add(cache.fNAllocated[c], std::memory_order_relaxed);
+   list.fNFreed.fetch_add(cache.fNFreed[c], std::memory_order_relaxed);
+   cache.fNAllocated[c] = 0;
+   cache.fNFreed[c] = 0;
+}
+
+/// Give a new span to the class c, the lock of its list being held. Return false if out of memory.
+bool NewSpan(UInt_t c, TClassList &list)
+{
+   auto &central = GetCentral();
+   std::lock_guard<std::mutex> lock(central.fSpanMutex);
+   if (!central.fChunkSpansLeft) {
+      auto raw = static_cast<char *>(malloc(kSpansPerChunk * kSpanSize + kSpanSize));
+      if (!raw)
+         return false;
+      const auto misalignment = reinterpret_cast<std::uintptr_t>(raw) & (kSpanSize - 1);
+      central.fChunk = misalignment ? raw + kSpanSize - misalignment : raw;
+      central.fChunkSpansLeft = kSpansPerChunk;
+   }
+   char *span = central.fChunk;
+
+   const ULong64_t addr = reinterpret_cast<std::uintptr_t>(span);
+   if (addr >> 48)
+      return false;
+   auto &leafRef = TObjectPool::GetSpanMapLeaf(addr >> 32);
+   auto leaf = leafRef.load(std::memory_order_acquire);
+   if (!leaf) {
+      leaf = static_cast<UChar_t *>(calloc(1 << 16, 1));
+      if (!leaf)
+         return false;
+      leafRef.store(leaf, std::memory_order_release);
+   }
+   leaf[(addr >> TObjectPool::kSpanShift) & 0xFFFF] = UChar_t(c + 1);
+
+   central.fChunk += kSpanSize;
+   --central.fChunkSpansLeft;
+   central.fNSpans.fetch_add(1, std::memory_order_relaxed);
+   list.fBump = span;
+   list.fBumpEnd = span + kSpanSize / SizeOf(c) * SizeOf(c);
+   return true;
+}
+
+/// Take a block of the class c from its list, the lock of the list being held.
+TFreeBlock *TakeBlock(UInt_t c, TClassList &list)
+{
+   if (auto block = list.fHead) {
+      list.fHead = block->fNext;
+      return block;
+   }
+   if (list.fBump == list.fBumpEnd && !NewSpan(c, list))
+      return nullptr;
+   auto block = reinterpret_cast<TFreeBlock *>(list.fBump);
+   list.fBump += SizeOf(c);
+   return block;
+}
+
+/// Move a batch of blocks of the class c from its list to the cache of the thread.
+void Refill(TThreadCache &cache, UInt_t c)
+{
+   auto &list = GetCentral().fLists[c];
+   std::lock_guard<std::mutex> lock(list.fMutex);
+   FlushCounters(cache, c, list);
+   for (UInt_t i = BatchOf(c); i; --i) {
+      auto block = TakeBlock(c, list);
+      if (!block)
+         break;
+      block->fNext = cache.fHead[c];
+      cache.fHead[c] = block;
+      ++cache.fCount[c];
+   }
+}
+
+/// Move n blocks of the class c from the cache of the thread to its list.
+void Drain(TThreadCache &cache, UInt_t c, UInt_t n)
+{
+   if (!n)
+      return;
+   auto first = cache.fHead[c];
+   auto last = first;
+   for (UInt_t i = 1; i < n; ++i)
+      last = last->fNext;
+   cache.fHead[c] = last->fNext;
+   cache.fCount[c] -= n;
+
+   auto &list = GetCentral().fLists[c];
+   std::lock_guard<std::mutex> lock(list.fMutex);
+   FlushCounters(cache, c, list);
+   last->fNext = list.fHead;
+   list.fHead = first;
+}
+
+struct TThreadCacheGuard {
+   ~TThreadCacheGuard()
+   {
+      auto cache = tCache;
+      tCache = nullptr;
+      tCacheReleased = true;
+      for (UInt_t c = 0; c < kNClasses; ++c) {
+         Drain(*cache, c, cache->fCount[c]);
+         auto &list = GetCentral().fLists[c];
+         std::lock_guard<std::mutex> lock(list.fMutex);
+         FlushCounters(*cache, c, list);
+      }
+      free(cache);
+   }
+};
+
+/// Return the cache of the thread, or nullptr if it was already released because the thread is ending.
+TThreadCache *GetThreadCache()
+{
+   if (tCache)
+      return tCache;
+   if (tCacheReleased)
+      return nullptr;
+   tCache = static_cast<TThreadCache *>(calloc(1, sizeof(TThreadCache)));
+   if (tCache) {
+      static thread_local TThreadCacheGuard guard;
+      (void)guard;
+   }
+   return tCache;
+}
+
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+
+std::atomic<UChar_t *> TObjectPool::fgSpanMap[1 << 16];
+constexpr size_t TObjectPool::kMaxSize;
+constexpr UInt_t TObjectPool::kSpanShift;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the entry of the span map for the given 4 GiB of address space.
+
+std::atomic<UChar_t *> &TObjectPool::GetSpanMapLeaf(ULong64_t index)
+{
+   return fgSpanMap[index];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Allocate a block of at least size bytes, at most kMaxSize. Return nullptr if out of memory.
+
+void *TObjectPool::Alloc(size_t size)
+{
+   const auto c = ClassOf(size);
+   auto cache = GetThreadCache();
+   if (!cache) {
+      auto &list = GetCentral().fLists[c];
+      std::lock_guard<std::mutex> lock(list.fMutex);
+      auto block = TakeBlock(c, list);
+      if (block)
+         list.fNAllocated.fetch_add(1, std::memory_order_relaxed);
+      return block;
+   }
+
+   if (!cache->fHead[c]) {
+      Refill(*cache, c);
+      if (!cache->fHead[c])
+         return nullptr;
+   }
+   auto block = cache->fHead[c];
+   cache->fHead[c] = block->fNext;
+   --cache->fCount[c];
+   ++cache->fNAllocated[c];
+   return block;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Free a block allocated by the pool, from any thread.
+
+void TObjectPool::Free(void *p)
+{
+   const ULong64_t addr = reinterpret_cast<std::uintptr_t>(p);
+   const UInt_t c = fgSpanMap[addr >> 32].load(std::memory_order_acquire)[(addr >> kSpanShift) & 0xFFFF] - 1;
+   auto block = static_cast<TFreeBlock *>(p);
+   auto cache = GetThreadCache();
+   if (!cache) {
+      auto &list = GetCentral().fLists[c];
+      std::lock_guard<std::mutex> lock(list.fMutex);
+      block->fNext = list.fHead;
+      list.fHead = block;
+      list.fNFreed.fetch_add(1, std::memory_order_relaxed);
+      return;
+   }
+
+   block->fNext = cache->fHead[c];
+   cache->fHead[c] = block;
+   ++cache->fNFreed[c];
+   // keep up to two batches, so that alternating allocations and frees do not move blocks back and forth
+   if (++cache->fCount[c] > 2 * BatchOf(c))
+      Drain(*cache, c, BatchOf(c));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of blocks allocated and freed so far, and the memory reserved by the pool.
+/// The operations of the other threads still running are counted by batches only.
+
+void TObjectPool::GetStatistics(ULong64_t &nAllocated, ULong64_t &nFreed, ULong64_t &nBytesReserved)
+{
+   auto &central = GetCentral();
+   auto cache = tCache;
+   nAllocated = nFreed = 0;
+   for (UInt_t c = 0; c < kNClasses; ++c) {
+      auto &list = central.fLists[c];
+      if (cache) {
+         std::lock_guard<std::mutex> lock(list.fMutex);
+         FlushCounters(*cache, c, list);
+      }
+      nAllocated += list.fNAllocated.load(std::memory_order_relaxed);
+      nFreed += list.fNFreed.load(std::memory_order_relaxed);
+   }
+   nBytesReserved = central.fNSpans.load(std::memory_order_relaxed) * kSpanSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the number of blocks allocated, freed and in use for each size class.
+
+void TObjectPool::PrintStatistics()
+{
+   ULong64_t nAllocated, nFreed, nBytesReserved;
+   GetStatistics(nAllocated, nFreed, nBytesReserved);
+
+   auto &central = GetCentral();
+   Printf("Object pool statistics");
+   Printf("%12s%16s%16s%16s", "size", "alloc", "free", "in use");
+   Printf("============================================================");
+   for (UInt_t c = 0; c < kNClasses; ++c) {
+      const auto &list = central.fLists[c];
+      const ULong64_t nAlloc = list.fNAllocated.load(std::memory_order_relaxed);
+      const ULong64_t nFree = list.fNFreed.load(std::memory_order_relaxed);
+      if (nAlloc)
+         Printf("%12lu%16llu%16llu%16lld", (unsigned long)SizeOf(c), nAlloc, nFree, (Long64_t)(nAlloc - nFree));
+   }
+   Printf("------------------------------------------------------------");
+   Printf("%12s%16llu%16llu%16lld", "Total:", nAllocated, nFreed, (Long64_t)(nAllocated - nFreed));
+   Printf("Memory reserved: %llu kB", nBytesReserved / 1024);
+   Printf("============================================================");
+}
+
+} // namespace Internal
+} // namespace ROOT
@@ -0,0 +1,62 @@
+// @(#)root/base:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TObjectPool
+#define ROOT_TObjectPool
+
+#include "RtypesCore.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace ROOT {
+namespace Internal {
+
+/**
+\class ROOT::Internal::TObjectPool
+\brief Allocator of the small objects created with TStorage::ObjectAlloc, with a cache of free blocks per thread.
+
+The blocks are grouped in size classes of 16 bytes, up to kMaxSize bytes. Each class carves its blocks out of spans
+of 64 KiB, which are never returned to the system. A thread allocates and frees the blocks of its own cache without
+any synchronization; the caches exchange batches of blocks with a free list per class, protected by a mutex.
+
+The size class of the span of every address is recorded in a two-level map, so that a block is recognized as coming
+from the pool whatever the thread that frees it, and even after the pool is disabled.
+*/
+class TObjectPool {
+private:
+   static std::atomic<UChar_t *> fgSpanMap[1 << 16]; ///< Size class plus one of each span, per 4 GiB of address space
+
+public:
+   static constexpr size_t kMaxSize = 1024; ///< Largest block allocated by the pool
+   static constexpr UInt_t kSpanShift = 16; ///< Log2 of the size of the spans
+
+   static std::atomic<UChar_t *> &GetSpanMapLeaf(ULong64_t index);
+   static void *Alloc(size_t size);
+   static void Free(void *p);
+   static void GetStatistics(ULong64_t &nAllocated, ULong64_t &nFreed, ULong64_t &nBytesReserved);
+   static void PrintStatistics();
+
+   /// Return true if p was allocated by the pool.
+   static Bool_t Owns(const void *p)
+   {
+      const ULong64_t addr = reinterpret_cast<std::uintptr_t>(p);
+      if (addr >> 48)
+         return kFALSE;
+      const auto leaf = fgSpanMap[addr >> 32].load(std::memory_order_acquire);
+      return leaf && leaf[(addr >> kSpanShift) & 0xFFFF];
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -2003,6 +2003,9 @@ void TROOT::InitSystem()
       if (msize != -1 || mcnt != -1)
          TStorage::EnableStatistics(msize, mcnt);
 
+      if (gEnv->GetValue("Root.ObjectPool", 0))
+         TStorage::EnableObjectPool();
+
       fgMemCheck = gEnv->GetValue("Root.MemCheck", 0);
 
 #if defined(R__HAS_COCOA)
@@ -28,9 +28,17 @@ occur.
 
 Set the compile option R__NOSTATS to de-activate all memory checking
 and statistics gathering in the system.
+
+The objects allocated with ObjectAlloc(), i.e. by TObject::operator new,
+can be taken from a pool of blocks of a few size classes, with a cache of
+free blocks per thread, instead of the global allocator. This speeds up the
+creation and deletion of many small objects, especially from several threads.
+The pool is enabled with EnableObjectPool() or the resource Root.ObjectPool;
+its statistics are printed by PrintObjectPoolStatistics().
 */
 
 #include <stdlib.h>
+#include <atomic>
 
 #include "TROOT.h"
 #include "TObjectTable.h"
@@ -38,6 +46,7 @@ and statistics gathering in the system.
 #include "TString.h"
 #include "TVirtualMutex.h"
 #include "TInterpreter.h"
+#include "TObjectPool.h"
 
 #if !defined(R__NOSTATS)
 #   define MEM_DEBUG
@@ -83,6 +92,7 @@ static Int_t    gAllocatedTotal, gFreedTotal;
 static void   **gTraceArray = 0;
 static Int_t    gTraceCapacity = 10, gTraceIndex = 0,
                 gMemSize = -1, gMemIndex = -1;
+static std::atomic<bool> gUseObjectPool(false);
 
 // Used in NewDelete.cxx; set by TMapFile.
 ROOT::Internal::FreeIfTMapFile_t *ROOT::Internal::gFreeIfTMapFile = nullptr;
@@ -327,7 +337,11 @@ Int_t *TStorage::ReAllocInt(Int_t *ovp, size_t size, size_t oldsize)
 
 void *TStorage::ObjectAlloc(size_t sz)
 {
-   void* space =  ::operator new(sz);
+   void *space = nullptr;
+   if (sz <= ROOT::Internal::TObjectPool::kMaxSize && gUseObjectPool.load(std::memory_order_relaxed))
+      space = ROOT::Internal::TObjectPool::Alloc(sz);
+   if (!space)
+      space = ::operator new(sz);
    memset(space, kObjectAllocMemValue, sz);
    return space;
 }
@@ -339,7 +353,11 @@ void *TStorage::ObjectAlloc(size_t sz)
 
 void *TStorage::ObjectAllocArray(size_t sz)
 {
-   void* space =  ::operator new(sz);
+   void *space = nullptr;
+   if (sz <= ROOT::Internal::TObjectPool::kMaxSize && gUseObjectPool.load(std::memory_order_relaxed))
+      space = ROOT::Internal::TObjectPool::Alloc(sz);
+   if (!space)
+      space = ::operator new(sz);
    return space;
 }
 
@@ -358,8 +376,11 @@ void *TStorage::ObjectAlloc(size_t , void *vp)
 
 void TStorage::ObjectDealloc(void *vp)
 {
-
-   ::operator delete(vp);
+   // the pool may have been disabled since the object was allocated
+   if (ROOT::Internal::TObjectPool::Owns(vp))
+      ROOT::Internal::TObjectPool::Free(vp);
+   else
+      ::operator delete(vp);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -377,7 +398,10 @@ void TStorage::ObjectDealloc(void *vp, void *ptr)
 
 void TStorage::ObjectDealloc(void *vp, size_t size)
 {
-   ::operator delete(vp, size);
+   if (ROOT::Internal::TObjectPool::Owns(vp))
+      ROOT::Internal::TObjectPool::Free(vp);
+   else
+      ::operator delete(vp, size);
 }
 #endif
 
@@ -458,6 +482,43 @@ void TStorage::EnableStatistics(int size, int ix)
 #endif
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable the allocation of the objects from the object pool.
+/// The objects allocated from the pool can be deleted at any time, even
+/// after the pool is disabled. The memory of the pool is never returned
+/// to the system.
+
+void TStorage::EnableObjectPool(Bool_t enable)
+{
+   gUseObjectPool = enable;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the objects are allocated from the object pool.
+
+Bool_t TStorage::IsObjectPoolEnabled()
+{
+   return gUseObjectPool;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of objects allocated from and returned to the object
+/// pool so far, and the memory reserved by the pool. The allocations of the
+/// other threads still running are only accounted for by batches.
+
+void TStorage::GetObjectPoolStatistics(ULong64_t &nAllocated, ULong64_t &nFreed, ULong64_t &nBytesReserved)
+{
+   ROOT::Internal::TObjectPool::GetStatistics(nAllocated, nFreed, nBytesReserved);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the object pool usage statistics, per size class.
+
+void TStorage::PrintObjectPoolStatistics()
+{
+   ROOT::Internal::TObjectPool::PrintStatistics();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 ULong_t TStorage::GetHeapBegin()
@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+
+#include "TClonesArray.h"
+#include "TNamed.h"
+#include "TObjString.h"
+#include "TStorage.h"
+
+#include <thread>
+#include <vector>
+
+TEST(TStorage, ObjectPool)
+{
+   TStorage::EnableObjectPool();
+   ULong64_t nAllocated0, nFreed0, nBytes;
+   TStorage::GetObjectPoolStatistics(nAllocated0, nFreed0, nBytes);
+
+   std::vector<TObject *> objects;
+   for (int i = 0; i < 1000; ++i) {
+      objects.emplace_back(new TObjString("a string"));
+      objects.emplace_back(new TNamed("name", "title"));
+   }
+   for (auto obj : objects)
+      EXPECT_TRUE(obj->IsOnHeap());
+
+   ULong64_t nAllocated, nFreed;
+   TStorage::GetObjectPoolStatistics(nAllocated, nFreed, nBytes);
+   EXPECT_EQ(nAllocated - nAllocated0, 2000u);
+   EXPECT_GT(nBytes, 0u);
+
+   // the objects of the pool can be deleted after it is disabled
+   TStorage::EnableObjectPool(kFALSE);
+   EXPECT_FALSE(TStorage::IsObjectPoolEnabled());
+   auto notPooled = new TNamed("name", "title");
+   for (auto obj : objects)
+      delete obj;
+   delete notPooled;
+
+   TStorage::GetObjectPoolStatistics(nAllocated, nFreed, nBytes);
+   EXPECT_EQ(nAllocated - nAllocated0, 2000u);
+   EXPECT_EQ(nFreed - nFreed0, 2000u);
+}
+
+TEST(TStorage, ObjectPoolThreads)
+{
+   TStorage::EnableObjectPool();
+   ULong64_t nAllocated0, nFreed0, nBytes;
+   TStorage::GetObjectPoolStatistics(nAllocated0, nFreed0, nBytes);
+
+   // each thread deletes the objects created by the previous one
+   const int nThreads = 4;
+   const int nObjects = 10000;
+   std::vector<std::vector<TObjString *>> objects(nThreads + 1);
+   for (int i = 0; i < nObjects; ++i)
+      objects[0].emplace_back(new TObjString("a string"));
+   for (int t = 0; t < nThreads; ++t) {
+      std::thread thread([&objects, t]() {
+         for (int i = 0; i < nObjects; ++i)
+            objects[t + 1].emplace_back(new TObjString(objects[t][i]->GetName()));
+         for (auto obj : objects[t])
+            delete obj;
+      });
+      thread.join();
+   }
+   for (auto obj : objects[nThreads]) {
+      EXPECT_STREQ(obj->GetName(), "a string");
+      delete obj;
+   }
+   TStorage::EnableObjectPool(kFALSE);
+
+   ULong64_t nAllocated, nFreed;
+   TStorage::GetObjectPoolStatistics(nAllocated, nFreed, nBytes);
+   EXPECT_EQ(nAllocated - nAllocated0, ULong64_t((nThreads + 1) * nObjects));
+   EXPECT_EQ(nFreed - nFreed0, ULong64_t((nThreads + 1) * nObjects));
+}
+
+TEST(TStorage, ObjectPoolClonesArray)
+{
+   // load the dictionaries before counting
+   TClonesArray("TNamed").ConstructedAt(0);
+   TStorage::EnableObjectPool();
+   ULong64_t nAllocated0, nFreed0, nBytes;
+   TStorage::GetObjectPoolStatistics(nAllocated0, nFreed0, nBytes);
+
+   const int nObjects = 1000;
+   {
+      // the slots of the array are allocated by TStorage::ObjectAlloc
+      TClonesArray arr("TNamed", 10);
+      for (int i = 0; i < nObjects; ++i)
+         new (arr[i]) TNamed("name", "title");
+      // destructed objects, whose memory is released by ExpandCreate and by the destructor of the array
+      arr.Delete();
+      arr.ExpandCreate(nObjects / 2);
+      EXPECT_EQ(arr.GetEntriesFast(), nObjects / 2);
+      arr.Clear("C");
+   }
+   TStorage::EnableObjectPool(kFALSE);
+
+   ULong64_t nAllocated, nFreed;
+   TStorage::GetObjectPoolStatistics(nAllocated, nFreed, nBytes);
+   EXPECT_GE(nAllocated - nAllocated0, ULong64_t(nObjects));
+   EXPECT_EQ(nAllocated - nAllocated0, nFreed - nFreed0);
+}
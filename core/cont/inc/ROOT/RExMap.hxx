@@ -0,0 +1,198 @@
+// @(#)root/cont:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RExMap
+#define ROOT_RExMap
+
+#include "RtypesCore.h"
+
+#include <memory>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define R__EXMAP_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace ROOT {
+namespace Internal {
+
+/**
+\class ROOT::Internal::RExMap
+\brief Transient map of (key,value) pairs of Long64_t, with the interface of TExMap.
+
+The map is used by the I/O buffers to map the objects to their offsets when writing, and the offsets to the
+objects when reading. It is an open addressing hash table whose capacity is a power of two: the slots are in groups
+of 16, with one control byte per slot holding 7 bits of the hash of its key. A lookup compares the control bytes of
+a whole group at once, with SSE2 instructions when available, and the keys of the matching slots only.
+
+Unlike TExMap, the keys are hashed by the map itself and the hash given to the methods is ignored; the map is not
+persistent and cannot be iterated.
+*/
+class RExMap {
+public:
+   static constexpr UInt_t kGroupSize = 16;
+
+private:
+   enum : UChar_t { kEmpty = 0x80, kDeleted = 0xFE }; // the control byte of a used slot has its high bit unset
+
+   struct RSlot {
+      Long64_t fKey;
+      Long64_t fValue;
+   };
+
+   std::unique_ptr<UChar_t[]> fCtrl; ///< Control byte of each slot
+   std::unique_ptr<RSlot[]> fSlots;  ///< Key and value of each slot
+   UInt_t fCapacity = 0;             ///< Number of slots, a power of two multiple of kGroupSize
+   UInt_t fSize = 0;                 ///< Number of slots in use
+   UInt_t fGrowthLeft = 0;           ///< Number of empty slots that can be used before rehashing
+
+   static ULong64_t Hash(Long64_t key)
+   {
+      // finalizer of MurmurHash3, which spreads the few varying bits of pointers and offsets
+      ULong64_t h = key;
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      h *= 0xc4ceb9fe1a85ec53ULL;
+      h ^= h >> 33;
+      return h;
+   }
+
+   static UInt_t CountTrailingZeros(UInt_t mask)
+   {
+#ifdef _MSC_VER
+      unsigned long index;
+      _BitScanForward(&index, mask);
+      return index;
+#else
+      return __builtin_ctz(mask);
+#endif
+   }
+
+   /// Bit i of the result is set if the control byte i of the group at g is equal to b.
+   static UInt_t Match(const UChar_t *g, UChar_t b)
+   {
+#ifdef R__EXMAP_SSE2
+      const auto ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(g));
+      return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(b), ctrl));
+#else
+      UInt_t mask = 0;
+      for (UInt_t i = 0; i < kGroupSize; ++i)
+         mask |= UInt_t(g[i] == b) << i;
+      return mask;
+#endif
+   }
+
+   /// Bit i of the result is set if the slot i of the group at g is empty or deleted.
+   static UInt_t MatchFree(const UChar_t *g)
+   {
+#ifdef R__EXMAP_SSE2
+      return _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(g)));
+#else
+      UInt_t mask = 0;
+      for (UInt_t i = 0; i < kGroupSize; ++i)
+         mask |= UInt_t(g[i] >> 7) << i;
+      return mask;
+#endif
+   }
+
+   /// Return the slot of key, or fCapacity if it is not in the map. In freeSlot, return the first empty or deleted
+   /// slot of the probe sequence of the key, where it would be added.
+   template <bool FindFreeSlot>
+   UInt_t Find(Long64_t key, UInt_t &freeSlot) const
+   {
+      const auto h = Hash(key);
+      const auto h2 = UChar_t(h & 0x7F);
+      const UInt_t groupMask = fCapacity / kGroupSize - 1;
+      UInt_t group = UInt_t(h >> 7) & groupMask;
+      freeSlot = fCapacity;
+      // triangular probing visits all the groups, their number is a power of two
+      for (UInt_t step = 1; step <= groupMask + 1; ++step) {
+         const auto first = group * kGroupSize;
+         const auto ctrl = fCtrl.get() + first;
+         for (auto m = Match(ctrl, h2); m; m &= m - 1) {
+            const auto slot = first + CountTrailingZeros(m);
+            if (fSlots[slot].fKey == key)
+               return slot;
+         }
+         const auto free = MatchFree(ctrl);
+         if (FindFreeSlot && freeSlot == fCapacity && free)
+            freeSlot = first + CountTrailingZeros(free);
+         if (Match(ctrl, kEmpty))
+            return fCapacity;
+         group = (group + step) & groupMask;
+      }
+      return fCapacity;
+   }
+
+   void Insert(UInt_t slot, Long64_t key, Long64_t value)
+   {
+      if (fCtrl[slot] == kEmpty)
+         --fGrowthLeft;
+      fCtrl[slot] = UChar_t(Hash(key) & 0x7F);
+      fSlots[slot].fKey = key;
+      fSlots[slot].fValue = value;
+      ++fSize;
+      if (fGrowthLeft == 0)
+         Rehash();
+   }
+
+   void Allocate(UInt_t capacity);
+   void Rehash();
+
+public:
+   RExMap(Int_t mapSize = 100);
+   RExMap(const RExMap &) = delete;
+   RExMap &operator=(const RExMap &) = delete;
+   ~RExMap();
+
+   void Add(ULong64_t hash, Long64_t key, Long64_t value);
+   void Add(Long64_t key, Long64_t value) { Add(0, key, value); }
+   void AddAt(UInt_t slot, ULong64_t hash, Long64_t key, Long64_t value);
+   void AddAt(UInt_t slot, Long64_t key, Long64_t value) { AddAt(slot, 0, key, value); }
+   void Delete();
+   Int_t Capacity() const { return fCapacity; }
+   Int_t GetSize() const { return fSize; }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Return the value belonging to the specified key. If the key is not found, return 0.
+   Long64_t GetValue(ULong64_t /*hash*/, Long64_t key) const
+   {
+      UInt_t freeSlot;
+      const auto slot = Find<false>(key, freeSlot);
+      return slot < fCapacity ? fSlots[slot].fValue : 0;
+   }
+   Long64_t GetValue(Long64_t key) const { return GetValue(0, key); }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Return the value belonging to the specified key. If the key is not found, return 0 and in 'slot' the slot
+   /// where it can be added with AddAt, as long as the capacity of the map does not change.
+   Long64_t GetValue(ULong64_t /*hash*/, Long64_t key, UInt_t &slot) const
+   {
+      const auto found = Find<true>(key, slot);
+      return found < fCapacity ? fSlots[found].fValue : 0;
+   }
+   Long64_t GetValue(Long64_t key, UInt_t &slot) const { return GetValue(0, key, slot); }
+
+   void Remove(ULong64_t hash, Long64_t key);
+   void Remove(Long64_t key) { Remove(0, key); }
+
+   Long64_t &operator()(ULong64_t hash, Long64_t key);
+   Long64_t &operator()(Long64_t key) { return operator()(0, key); }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -0,0 +1,163 @@
+// @(#)root/cont:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RExMap.hxx"
+#include "TError.h"
+
+#include <cstring>
+
+namespace {
+
+/// The smallest capacity, a power of two multiple of the group size, holding n entries below the maximum load of 7/8.
+UInt_t CapacityFor(ULong64_t n)
+{
+   ULong64_t capacity = ROOT::Internal::RExMap::kGroupSize;
+   while (capacity * 7 / 8 < n)
+      capacity *= 2;
+   return capacity;
+}
+
+} // anonymous namespace
+
+namespace ROOT {
+namespace Internal {
+
+constexpr UInt_t RExMap::kGroupSize;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a map able to hold mapSize entries before growing.
+
+RExMap::RExMap(Int_t mapSize)
+{
+   Allocate(CapacityFor(mapSize > 0 ? mapSize : 1));
+}
+
+RExMap::~RExMap() = default;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Allocate an empty table of the given capacity.
+
+void RExMap::Allocate(UInt_t capacity)
+{
+   fCtrl.reset(new UChar_t[capacity]);
+   fSlots.reset(new RSlot[capacity]);
+   fCapacity = capacity;
+   Delete();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Move the entries to a new table with twice as many free slots as entries, and no deleted slots. The capacity
+/// always changes, so that the slots returned by GetValue before are not used by AddAt.
+
+void RExMap::Rehash()
+{
+   auto newCapacity = CapacityFor(2ULL * fSize);
+   if (newCapacity == fCapacity)
+      newCapacity *= 2;
+
+   auto oldCtrl = std::move(fCtrl);
+   auto oldSlots = std::move(fSlots);
+   const auto oldCapacity = fCapacity;
+   const auto size = fSize;
+   Allocate(newCapacity);
+
+   UInt_t freeSlot;
+   for (UInt_t i = 0; i < oldCapacity; ++i) {
+      if (oldCtrl[i] & 0x80)
+         continue;
+      Find<true>(oldSlots[i].fKey, freeSlot);
+      fCtrl[freeSlot] = oldCtrl[i];
+      fSlots[freeSlot] = oldSlots[i];
+   }
+   fSize = size;
+   fGrowthLeft -= size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add a (key,value) pair to the map. The key should be unique.
+
+void RExMap::Add(ULong64_t, Long64_t key, Long64_t value)
+{
+   UInt_t freeSlot;
+   if (Find<true>(key, freeSlot) < fCapacity) {
+      ::Error("RExMap::Add", "key %lld is not unique", key);
+      return;
+   }
+   Insert(freeSlot, key, value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add a (key,value) pair to the map. The key should be unique.
+/// If the 'slot' is free, use it to store the value, otherwise revert to Add(hash,key,value).
+/// This is usually used in conjunction with GetValue with 3 parameters:
+/// ~~~ {.cpp}
+/// if ((idx = (ULong64_t)fMap->GetValue(hash, key, slot)) != 0) {
+///    ...
+/// } else {
+///    fMap->AddAt(slot,hash,key,value);
+/// }
+/// ~~~
+
+void RExMap::AddAt(UInt_t slot, ULong64_t hash, Long64_t key, Long64_t value)
+{
+   if (slot < fCapacity && (fCtrl[slot] & 0x80))
+      Insert(slot, key, value);
+   else
+      Add(hash, key, value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Delete all entries stored in the map. The capacity is kept.
+
+void RExMap::Delete()
+{
+   memset(fCtrl.get(), kEmpty, fCapacity);
+   fSize = 0;
+   fGrowthLeft = fCapacity * 7 / 8;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the entry with the specified key from the map.
+
+void RExMap::Remove(ULong64_t, Long64_t key)
+{
+   UInt_t freeSlot;
+   const auto slot = Find<false>(key, freeSlot);
+   if (slot == fCapacity) {
+      ::Error("RExMap::Remove", "key %lld not found", key);
+      return;
+   }
+   // The lookups stop at the groups with an empty slot: the slot can be emptied if its group has one already.
+   if (Match(fCtrl.get() + slot / kGroupSize * kGroupSize, kEmpty)) {
+      fCtrl[slot] = kEmpty;
+      ++fGrowthLeft;
+   } else {
+      fCtrl[slot] = kDeleted;
+   }
+   --fSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a reference to the value belonging to the specified key, adding it with value 0 if not found.
+
+Long64_t &RExMap::operator()(ULong64_t, Long64_t key)
+{
+   UInt_t freeSlot;
+   auto slot = Find<true>(key, freeSlot);
+   if (slot == fCapacity) {
+      const auto capacity = fCapacity;
+      Insert(freeSlot, key, 0);
+      slot = capacity == fCapacity ? freeSlot : Find<false>(key, freeSlot);
+   }
+   return fSlots[slot].fValue;
+}
+
+} // namespace Internal
+} // namespace ROOT
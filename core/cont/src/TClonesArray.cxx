@@ -164,7 +164,8 @@ static inline void R__ReleaseMemory(TClass *cl, TObject *obj)
       if (TObject::GetObjectStat() && gObjectTable) {
          gObjectTable->RemoveQuietly(obj);
       }
-      ::operator delete(obj);
+      // allocated by TStorage::ObjectAlloc, possibly from the object pool
+      TStorage::ObjectDealloc(obj);
    }
 }
 
@@ -0,0 +1,96 @@
+#include "gtest/gtest.h"
+#include "ROOT/RExMap.hxx"
+
+#include <map>
+#include <random>
+#include <vector>
+
+using ROOT::Internal::RExMap;
+
+TEST(RExMap, AddGetValue)
+{
+   RExMap m(4);
+   EXPECT_EQ(m.GetSize(), 0);
+   EXPECT_EQ(m.GetValue(42), 0);
+
+   m.Add(0, 0);
+   m.Add(42, 7);
+   m.Add(-3, 8);
+   EXPECT_EQ(m.GetSize(), 3);
+   EXPECT_EQ(m.GetValue(0), 0);
+   EXPECT_EQ(m.GetValue(42), 7);
+   EXPECT_EQ(m.GetValue(-3), 8);
+   EXPECT_EQ(m.GetValue(43), 0);
+
+   // the hash given by the caller does not matter
+   EXPECT_EQ(m.GetValue(12345, 42), 7);
+
+   m(42) = 9;
+   EXPECT_EQ(m.GetValue(42), 9);
+   m(44) += 2;
+   EXPECT_EQ(m.GetValue(44), 2);
+   EXPECT_EQ(m.GetSize(), 4);
+
+   m.Delete();
+   EXPECT_EQ(m.GetSize(), 0);
+   EXPECT_EQ(m.GetValue(42), 0);
+}
+
+TEST(RExMap, GrowWithPointers)
+{
+   // keys with the distribution of heap addresses
+   std::vector<double> objects(100000);
+   RExMap m;
+   Long64_t offset = 1;
+   for (auto &o : objects)
+      m.Add(reinterpret_cast<Long64_t>(&o), offset++);
+   EXPECT_EQ(m.GetSize(), Int_t(objects.size()));
+   EXPECT_GE(m.Capacity(), Int_t(objects.size()));
+
+   offset = 1;
+   for (auto &o : objects)
+      EXPECT_EQ(m.GetValue(reinterpret_cast<Long64_t>(&o)), offset++);
+   EXPECT_EQ(m.GetValue(reinterpret_cast<Long64_t>(objects.data() + objects.size())), 0);
+}
+
+TEST(RExMap, AddAtSlot)
+{
+   RExMap m(16);
+   for (Long64_t key = 1; key < 1000; ++key) {
+      UInt_t slot;
+      ASSERT_EQ(m.GetValue(key, slot), 0);
+      const auto capacity = m.Capacity();
+      m.AddAt(slot, key, key * 10);
+      // as in TBufferFile::WriteObjectClass: the slot is still valid if the capacity did not change
+      if (capacity == m.Capacity())
+         EXPECT_EQ(m.GetValue(key, slot), key * 10);
+   }
+   for (Long64_t key = 1; key < 1000; ++key)
+      EXPECT_EQ(m.GetValue(key), key * 10);
+}
+
+TEST(RExMap, RemoveAndReAdd)
+{
+   // compare with std::map, removing and adding keys many times to create and reuse deleted slots
+   std::mt19937_64 gen(1);
+   std::uniform_int_distribution<Long64_t> keys(0, 5000);
+   std::map<Long64_t, Long64_t> ref;
+   RExMap m(8);
+   for (int i = 0; i < 200000; ++i) {
+      const auto key = keys(gen);
+      if (ref.count(key)) {
+         m.Remove(key);
+         ref.erase(key);
+      } else {
+         m.Add(key, i + 1);
+         ref[key] = i + 1;
+      }
+   }
+   EXPECT_EQ(m.GetSize(), Int_t(ref.size()));
+   // the deleted slots do not make the map grow without bounds
+   EXPECT_LE(m.Capacity(), 4 * 8192);
+   for (Long64_t key = 0; key <= 5000; ++key) {
+      auto it = ref.find(key);
+      EXPECT_EQ(m.GetValue(key), it == ref.end() ? 0 : it->second);
+   }
+}
@@ -268,6 +268,8 @@ private:
 
    static TClass     *LoadClassDefault(const char *requestedname, Bool_t silent);
    static TClass     *LoadClassCustom(const char *requestedname, Bool_t silent);
+   static TClass     *GetClassUncached(const char *name, Bool_t load, Bool_t silent);
+   static TClass     *GetClassUncached(const std::type_info &typeinfo, Bool_t load, Bool_t silent);
 
    void               SetClassVersion(Version_t version);
    void               SetClassSize(Int_t sizof) { fSizeof = sizof; }
@@ -66,6 +66,7 @@ In order to access the name of a class within the ROOT type system, the method T
 #include "TROOT.h"
 #include "TRealData.h"
 #include "TCheckHashRecursiveRemoveConsistency.h" // Private header
+#include "TClassLookupCache.h" // Private header
 #include "TStreamer.h"
 #include "TStreamerElement.h"
 #include "TVirtualStreamerInfo.h"
@@ -433,6 +434,32 @@ IdMap_t *TClass::GetIdMap() {
 #endif
 }
 
+namespace {
+   using ClassNameCache_t = ROOT::Internal::TClassLookupCache<std::string>;
+   using ClassTypeInfoCache_t = ROOT::Internal::TClassLookupCache<const std::type_info *>;
+
+   // Caches of the lookups of TClass::GetClass by name and by type_info.
+   ClassNameCache_t &GetClassNameCache() {
+#ifdef R__COMPLETE_MEM_TERMINATION
+      static ClassNameCache_t gClassNameCacheObject;
+      return gClassNameCacheObject;
+#else
+      static ClassNameCache_t *gClassNameCache = new ClassNameCache_t;
+      return *gClassNameCache;
+#endif
+   }
+
+   ClassTypeInfoCache_t &GetClassTypeInfoCache() {
+#ifdef R__COMPLETE_MEM_TERMINATION
+      static ClassTypeInfoCache_t gClassTypeInfoCacheObject;
+      return gClassTypeInfoCacheObject;
+#else
+      static ClassTypeInfoCache_t *gClassTypeInfoCache = new ClassTypeInfoCache_t;
+      return *gClassTypeInfoCache;
+#endif
+   }
+}
+
 DeclIdMap_t *TClass::GetDeclIdMap() {
 
 #ifdef R__COMPLETE_MEM_TERMINATION
@@ -482,6 +509,8 @@ void TClass::RemoveClass(TClass *oldcl)
    if (oldcl->GetTypeInfo()) {
       GetIdMap()->Remove(oldcl->GetTypeInfo()->name());
    }
+   GetClassNameCache().Remove(oldcl);
+   GetClassTypeInfoCache().Remove(oldcl);
    if (oldcl->fClassInfo) {
       //GetDeclIdMap()->Remove((void*)(oldcl->fClassInfo));
    }
@@ -2887,11 +2916,32 @@ TVirtualIsAProxy* TClass::GetIsAProxy() const
 /// If silent is 'true', do not warn about missing dictionary for the class.
 /// (typically used for class that are used only for transient members)
 /// Returns 0 in case class is not found.
+///
+/// The classes already found and loaded are returned from a cache, without
+/// taking any lock nor normalizing the name.
 
 TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
 {
    if (!name || !name[0]) return 0;
 
+   auto &cache = GetClassNameCache();
+   const auto hash = cache.Hash(name);
+   TClass *cl = cache.Find(hash, name);
+   if (cl && cl->IsLoaded()) return cl;
+
+   const auto generation = cache.GetGeneration();
+   cl = GetClassUncached(name, load, silent);
+   if (cl && cl->IsLoaded())
+      cache.Add(hash, name, cl, generation);
+   return cl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Look up the TClass of the specified class name without using the cache of
+/// GetClass, see GetClass.
+
+TClass *TClass::GetClassUncached(const char *name, Bool_t load, Bool_t silent)
+{
    if (strstr(name, "(anonymous)")) return 0;
    if (strncmp(name,"class ",6)==0) name += 6;
    if (strncmp(name,"struct ",7)==0) name += 7;
@@ -3106,8 +3156,29 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Return pointer to class with name.
+///
+/// The classes already found and loaded are returned from a cache, without
+/// taking any lock.
+
+TClass *TClass::GetClass(const std::type_info& typeinfo, Bool_t load, Bool_t silent)
+{
+   auto &cache = GetClassTypeInfoCache();
+   const auto hash = cache.Hash(&typeinfo);
+   TClass *cl = cache.Find(hash, &typeinfo);
+   if (cl && cl->IsLoaded()) return cl;
+
+   const auto generation = cache.GetGeneration();
+   cl = GetClassUncached(typeinfo, load, silent);
+   if (cl && cl->IsLoaded())
+      cache.Add(hash, &typeinfo, cl, generation);
+   return cl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Look up the TClass of the specified type without using the cache of
+/// GetClass, see GetClass.
 
-TClass *TClass::GetClass(const std::type_info& typeinfo, Bool_t load, Bool_t /* silent */)
+TClass *TClass::GetClassUncached(const std::type_info& typeinfo, Bool_t load, Bool_t /* silent */)
 {
    if (!gROOT->GetListOfClasses())
       return 0;
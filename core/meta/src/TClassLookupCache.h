@@ -0,0 +1,159 @@
+// @(#)root/meta:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TClassLookupCache
+#define ROOT_TClassLookupCache
+
+#include "RtypesCore.h"
+#include "TString.h"
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+class TClass;
+
+namespace ROOT {
+namespace Internal {
+
+/**
+\class ROOT::Internal::TClassLookupCache
+\brief Cache of the successful TClass::GetClass lookups, readable without taking any lock.
+
+The cache maps the names, as requested, or the addresses of the type_info to the loaded TClass they resolved to. It
+is an open addressing hash table of pointers to entries, which are only ever added: a reader loads the current table
+and probes it with atomic loads only. The writers are serialized by a mutex. When the table grows, the entries are
+copied to a new table, which is then published; the old tables are kept, as readers may still be probing them.
+
+The entries of a TClass that is removed from the list of classes are reset, and the lookups that started before the
+removal do not add entries. The number of entries is bounded by the number of distinct names or types requested.
+*/
+template <typename Key_t>
+class TClassLookupCache {
+   struct TEntry {
+      std::size_t fHash;
+      Key_t fKey;
+      std::atomic<TClass *> fClass;
+      TEntry(std::size_t hash, const Key_t &key, TClass *cl) : fHash(hash), fKey(key), fClass(cl) {}
+   };
+
+   struct TTable {
+      std::size_t fMask;
+      std::unique_ptr<std::atomic<TEntry *>[]> fSlots;
+      TTable(std::size_t capacity) : fMask(capacity - 1), fSlots(new std::atomic<TEntry *>[capacity])
+      {
+         for (std::size_t i = 0; i < capacity; ++i)
+            fSlots[i].store(nullptr, std::memory_order_relaxed);
+      }
+   };
+
+   std::atomic<TTable *> fTable{nullptr};
+   std::atomic<ULong64_t> fGeneration{0}; ///< Number of removals of classes so far
+   std::mutex fMutex;                     ///< Serializes the writers
+   std::vector<std::unique_ptr<TTable>> fTables;
+   std::vector<std::unique_ptr<TEntry>> fEntries;
+   std::unordered_map<const TClass *, std::vector<TEntry *>> fEntriesOfClass;
+
+   static bool IsEqual(const std::string &key, const char *name) { return key == name; }
+   static bool IsEqual(const std::type_info *key, const std::type_info *typeinfo) { return key == typeinfo; }
+
+   template <typename Arg_t>
+   TEntry *FindEntry(const TTable *table, std::size_t hash, const Arg_t &key) const
+   {
+      // the tables are never more than half full: the probing stops at an empty slot
+      for (auto i = hash & table->fMask;; i = (i + 1) & table->fMask) {
+         auto entry = table->fSlots[i].load(std::memory_order_acquire);
+         if (!entry || (entry->fHash == hash && IsEqual(entry->fKey, key)))
+            return entry;
+      }
+   }
+
+   void Insert(TTable *table, TEntry *entry)
+   {
+      auto i = entry->fHash & table->fMask;
+      while (table->fSlots[i].load(std::memory_order_relaxed))
+         i = (i + 1) & table->fMask;
+      table->fSlots[i].store(entry, std::memory_order_release);
+   }
+
+public:
+   static std::size_t Hash(const char *name) { return TString::Hash(name, strlen(name)); }
+   static std::size_t Hash(const std::type_info *typeinfo) { return TString::Hash(&typeinfo, sizeof(typeinfo)); }
+
+   /// Return the cached TClass of the key, or nullptr.
+   template <typename Arg_t>
+   TClass *Find(std::size_t hash, const Arg_t &key) const
+   {
+      const auto table = fTable.load(std::memory_order_acquire);
+      if (!table)
+         return nullptr;
+      const auto entry = FindEntry(table, hash, key);
+      return entry ? entry->fClass.load(std::memory_order_acquire) : nullptr;
+   }
+
+   /// The generation to pass to Add, to be taken before starting a lookup.
+   ULong64_t GetGeneration() const { return fGeneration.load(std::memory_order_acquire); }
+
+   /// Cache the result of a lookup, unless a class was removed since it started.
+   template <typename Arg_t>
+   void Add(std::size_t hash, const Arg_t &key, TClass *cl, ULong64_t generation)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      if (generation != fGeneration.load(std::memory_order_relaxed))
+         return;
+
+      auto table = fTable.load(std::memory_order_relaxed);
+      TEntry *entry = table ? FindEntry(table, hash, key) : nullptr;
+      if (entry) {
+         if (entry->fClass.load(std::memory_order_relaxed) == cl)
+            return;
+         entry->fClass.store(cl, std::memory_order_release);
+      } else {
+         if (!table || 2 * (fEntries.size() + 1) > table->fMask + 1) {
+            std::unique_ptr<TTable> newTable(new TTable(table ? 2 * (table->fMask + 1) : 256));
+            for (auto &e : fEntries)
+               Insert(newTable.get(), e.get());
+            table = newTable.get();
+            fTables.emplace_back(std::move(newTable));
+            fTable.store(table, std::memory_order_release);
+         }
+         fEntries.emplace_back(new TEntry(hash, Key_t(key), cl));
+         entry = fEntries.back().get();
+         Insert(table, entry);
+      }
+      fEntriesOfClass[cl].emplace_back(entry);
+   }
+
+   /// Reset the entries of a class that is removed, and prevent the lookups in progress from being cached.
+   void Remove(const TClass *cl)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fGeneration.fetch_add(1, std::memory_order_acq_rel);
+      auto it = fEntriesOfClass.find(cl);
+      if (it == fEntriesOfClass.end())
+         return;
+      for (auto entry : it->second) {
+         // the entry may have been pointed to another class since
+         TClass *expected = const_cast<TClass *>(cl);
+         entry->fClass.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+      }
+      fEntriesOfClass.erase(it);
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
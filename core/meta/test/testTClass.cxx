@@ -1,9 +1,15 @@
 #include "TClass.h"
 #include "THashTable.h"
 #include "TInterpreter.h"
+#include "TNamed.h"
+#include "TROOT.h"
 
 #include "gtest/gtest.h"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 TEST(TClass, DictCheck)
 {
    gInterpreter->ProcessLine(".L stlDictCheck.h+");
@@ -22,3 +28,29 @@ TEST(TClass, DictCheck)
 
    EXPECT_STREQ(errMsg.c_str(), "Missing dictionary for C, ") << errMsg;
 }
+
+TEST(TClass, GetClassConcurrent)
+{
+   ROOT::EnableThreadSafety();
+
+   const auto namedCl = TClass::GetClass("TNamed");
+   const auto vecCl = TClass::GetClass("vector<int>");
+   ASSERT_NE(namedCl, nullptr);
+   ASSERT_NE(vecCl, nullptr);
+
+   std::atomic<int> nErrors(0);
+   std::vector<std::thread> threads;
+   for (int t = 0; t < 8; ++t) {
+      threads.emplace_back([&]() {
+         for (int i = 0; i < 10000; ++i) {
+            if (TClass::GetClass("TNamed") != namedCl || TClass::GetClass(typeid(TNamed)) != namedCl ||
+                TClass::GetClass("vector<int>") != vecCl || TClass::GetClass("std::vector<int>") != vecCl ||
+                TClass::GetClass(typeid(std::vector<int>)) != vecCl || TClass::GetClass("NotAClass") != nullptr)
+               ++nErrors;
+         }
+      });
+   }
+   for (auto &t : threads)
+      t.join();
+   EXPECT_EQ(nErrors, 0);
+}
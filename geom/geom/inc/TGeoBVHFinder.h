@@ -0,0 +1,69 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2000, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TGeoBVHFinder
+#define ROOT_TGeoBVHFinder
+
+#include "TGeoVoxelFinder.h"
+
+class TGeoBVHFinder : public TGeoVoxelFinder
+{
+public:
+   enum {
+      kBVHWidth     = 4,   // number of children per node
+      kBVHMaxLeaf   = 4,   // maximum number of daughters per leaf
+      kBVHMaxDepth  = 48,  // depth after which splits are forced to the median
+      kBVHStackSize = 256  // traversal stack size
+   };
+
+protected:
+   Int_t             fNnodes;         // number of BVH nodes
+   Int_t             fNchildren;      // length of children arrays (kBVHWidth*fNnodes)
+   Int_t             fNnodeBoxes;     // length of node boxes array (6*kBVHWidth*fNnodes)
+   Int_t             fNitems;         // number of daughter references stored in leaves
+   Int_t             fNleaves;        // number of leaves
+   Int_t             fDepth;          // depth of the tree
+   Double_t         *fNodeBoxes;      //[fNnodeBoxes] child boxes of each node, [xmin|xmax|ymin|ymax|zmin|zmax] x kBVHWidth
+   Int_t            *fChildren;       //[fNchildren] child node index, or -1-offset of the first daughter for leaves
+   Int_t            *fNchildItems;    //[fNchildren] number of daughters in leaf children (0 for nodes)
+   Int_t            *fItems;          //[fNitems] daughter indices grouped by leaf
+
+   static Int_t      fgAdaptiveThreshold; // minimum number of daughters for adaptive selection of the BVH
+
+   TGeoBVHFinder(const TGeoBVHFinder&); // Not implemented
+   TGeoBVHFinder& operator=(const TGeoBVHFinder&); // Not implemented
+
+   void                BuildBVH();
+   void                ClearBVH();
+
+public :
+   TGeoBVHFinder();
+   TGeoBVHFinder(TGeoVolume *vol);
+   virtual ~TGeoBVHFinder();
+
+   virtual Double_t    Efficiency();
+   virtual Int_t      *GetCheckList(const Double_t *point, Int_t &nelem, TGeoStateInfo &td);
+   virtual Int_t      *GetNextCandidates(const Double_t *point, Int_t &ncheck, TGeoStateInfo &td);
+   virtual void        FindOverlaps(Int_t inode) const;
+   Int_t               GetDepth() const {return fDepth;}
+   Int_t               GetNleaves() const {return fNleaves;}
+   Int_t               GetNnodes() const {return fNnodes;}
+   virtual Int_t      *GetNextVoxel(const Double_t *point, const Double_t *dir, Int_t &ncheck, TGeoStateInfo &td);
+   virtual void        Print(Option_t *option="") const;
+   virtual void        SortCrossedVoxels(const Double_t *point, const Double_t *dir, TGeoStateInfo &td);
+   virtual void        Voxelize(Option_t *option="");
+
+   static Int_t        GetAdaptiveThreshold();
+   static void         SetAdaptiveThreshold(Int_t ndaughters);
+
+   ClassDef(TGeoBVHFinder, 1)                // bounding volume hierarchy finder class
+};
+
+#endif
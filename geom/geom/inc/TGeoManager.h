@@ -459,6 +459,7 @@ public:
    Int_t                  GetRTmode() const {return fRaytraceMode;}
    void                   SetRTmode(Int_t mode); // *MENU*
    Bool_t                 IsMultiThread() const {return fMultiThread;}
+   void                   SetMultiThread(Bool_t flag=kTRUE) {fMultiThread = flag;}
    static void            SetNavigatorsLock(Bool_t flag);
    static Int_t           ThreadId();
    static Int_t           GetNumThreads();
@@ -65,6 +65,7 @@ protected :
    Int_t              fNumber;         //  volume serial number in the list of volumes
    Int_t              fNtotal;         // total number of physical nodes
    Int_t              fRefCount;       // reference counter
+   Int_t              fVoxelsType;     // type of finder used for bounding boxes (EGeoVoxelsType)
    TGeoExtension     *fUserExtension;  //! Transient user-defined extension to volumes
    TGeoExtension     *fFWExtension;    //! Transient framework-defined extension to volumes
 
@@ -89,6 +90,11 @@ public:
       kVolumeAdded   =     BIT(23),
       kVolumeOC      =     BIT(21)  // overlapping candidates
    };
+   enum EGeoVoxelsType {
+      kVoxelsSlices   = 0, // slices on each axis (TGeoVoxelFinder)
+      kVoxelsBVH      = 1, // bounding volume hierarchy (TGeoBVHFinder)
+      kVoxelsAdaptive = 2  // hierarchy only for large numbers of daughters
+   };
    // constructors
    TGeoVolume();
    TGeoVolume(const char *name, const TGeoShape *shape, const TGeoMedium *med=0);
@@ -177,6 +183,8 @@ public:
    TObject        *GetField() const                  {return fField;}
    TGeoPatternFinder *GetFinder() const              {return fFinder;}
    TGeoVoxelFinder   *GetVoxels() const;
+   Int_t           GetVoxelsType() const {return fVoxelsType;}
+   TGeoVoxelFinder   *MakeVoxelFinder();
    const char     *GetIconName() const               {return fShape->GetName();}
    Int_t           GetIndex(const TGeoNode *node) const;
    TGeoNode       *GetNode(const char *name) const;
@@ -231,6 +239,7 @@ public:
    void            SetInvisible() {SetVisibility(kFALSE);}
    virtual void    SetMedium(TGeoMedium *medium) {fMedium = medium;}
    void            SetVoxelFinder(TGeoVoxelFinder *finder) {fVoxels = finder;}
+   void            SetVoxelsType(Int_t type);
    void            SetFinder(TGeoPatternFinder *finder) {fFinder = finder;}
    void            SetNumber(Int_t number) {fNumber = number;}
    void            SetNtotal(Int_t ntotal) {fNtotal = ntotal;}
@@ -243,7 +252,7 @@ public:
    Double_t        Weight(Double_t precision=0.01, Option_t *option="va"); // *MENU*
    Double_t        WeightA() const;
 
-   ClassDef(TGeoVolume, 6)              // geometry volume descriptor
+   ClassDef(TGeoVolume, 7)              // geometry volume descriptor
 };
 
 ////////////////////////////////////////////////////////////////////////////
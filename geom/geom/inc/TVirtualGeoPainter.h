@@ -66,6 +66,7 @@ public:
    virtual void       CheckGeometryFull(Bool_t checkoverlaps=kTRUE, Bool_t checkcrossings=kTRUE, Int_t nrays=10000, const Double_t *vertex=NULL) = 0;
    virtual void       CheckGeometry(Int_t nrays, Double_t startx, Double_t starty, Double_t startz) const = 0;
    virtual void       CheckOverlaps(const TGeoVolume *vol, Double_t ovlp=0.1, Option_t *option="") const = 0;
+   virtual void       CheckOverlapsMT(const TObjArray *volumes, Double_t ovlp=0.1, Option_t *option="", TStopwatch *timer=0) = 0;
    virtual Int_t      CountVisibleNodes() = 0;
    virtual void       DefaultAngles() = 0;
    virtual void       DefaultColors() = 0;
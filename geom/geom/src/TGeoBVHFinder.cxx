@@ -0,0 +1,681 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2000, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TGeoBVHFinder
+\ingroup Geometry_classes
+
+Bounding volume hierarchy used as spatial index for the daughters of
+a volume, as alternative to the slice voxelization of TGeoVoxelFinder.
+
+  The slice structure needs a sort and a bit pattern per slice on each
+axis, so both its build time and memory grow faster than linearly with
+the number of daughters, while the number of candidates per slice
+degrades when daughters are not aligned with the axes. The BVH is built
+in O(N log N) with a binned surface area heuristic and then collapsed
+into a 4-wide tree. The bounding boxes of the children of each node
+are stored as structure of arrays, so that a node is tested against a
+point or a ray in a single loop over the 4 children that the compiler
+can vectorize.
+
+  The finder is selected per volume with TGeoVolume::SetVoxelsType().
+With TGeoVolume::kVoxelsAdaptive the BVH is used only for volumes
+having at least GetAdaptiveThreshold() daughters.
+
+  Since the hierarchy does not partition the space in slices, a ray
+query returns all the daughters having the bounding box crossed by the
+ray in a single batch, sorted front to back by the order of traversal.
+*/
+
+#include "TGeoBVHFinder.h"
+
+#include "TBuffer.h"
+#include "TMath.h"
+#include "TString.h"
+#include "TGeoBBox.h"
+#include "TGeoNode.h"
+#include "TGeoManager.h"
+#include "TGeoStateInfo.h"
+
+#include <algorithm>
+#include <vector>
+
+ClassImp(TGeoBVHFinder);
+
+Int_t TGeoBVHFinder::fgAdaptiveThreshold = 1000;
+
+namespace {
+
+struct BVHBuildNode_t {
+   Double_t fBox[6];  // xmin, xmax, ymin, ymax, zmin, zmax
+   Int_t    fLeft;    // index of first child, -1 for leaves
+   Int_t    fRight;   // index of second child
+   Int_t    fFirst;   // first item for leaves
+   Int_t    fCount;   // number of items for leaves
+};
+
+struct BVHBuilder_t {
+   enum { kNbins = 16 };
+   const Double_t               *fBoxes;   // daughter boxes (dx,dy,dz,ox,oy,oz)
+   std::vector<Int_t>            fItems;   // daughter indices
+   std::vector<BVHBuildNode_t>   fNodes;   // binary tree
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Expand box with the bounding box of daughter id.
+
+   void Expand(Double_t *box, Int_t id) const
+   {
+      const Double_t *b = &fBoxes[6*id];
+      const Double_t tol = TGeoShape::Tolerance();
+      for (Int_t j=0; j<3; j++) {
+         box[2*j]   = TMath::Min(box[2*j],   b[j+3]-b[j]-tol);
+         box[2*j+1] = TMath::Max(box[2*j+1], b[j+3]+b[j]+tol);
+      }
+   }
+
+   static void Reset(Double_t *box)
+   {
+      for (Int_t j=0; j<3; j++) {
+         box[2*j]   = TGeoShape::Big();
+         box[2*j+1] = -TGeoShape::Big();
+      }
+   }
+
+   static Double_t HalfArea(const Double_t *box)
+   {
+      Double_t dx = box[1]-box[0];
+      Double_t dy = box[3]-box[2];
+      Double_t dz = box[5]-box[4];
+      if (dx<0 || dy<0 || dz<0) return 0;
+      return dx*dy + dy*dz + dz*dx;
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Build recursively the binary node for items [first, first+count).
+   /// Returns the node index.
+
+   Int_t Build(Int_t first, Int_t count, Int_t depth)
+   {
+      Int_t inode = fNodes.size();
+      fNodes.push_back(BVHBuildNode_t());
+      BVHBuildNode_t node;
+      Reset(node.fBox);
+      Double_t cmin[3], cmax[3];
+      for (Int_t j=0; j<3; j++) {
+         cmin[j] = TGeoShape::Big();
+         cmax[j] = -TGeoShape::Big();
+      }
+      for (Int_t i=first; i<first+count; i++) {
+         Int_t id = fItems[i];
+         Expand(node.fBox, id);
+         for (Int_t j=0; j<3; j++) {
+            cmin[j] = TMath::Min(cmin[j], fBoxes[6*id+3+j]);
+            cmax[j] = TMath::Max(cmax[j], fBoxes[6*id+3+j]);
+         }
+      }
+      node.fLeft = node.fRight = -1;
+      node.fFirst = first;
+      node.fCount = count;
+      if (count <= TGeoBVHFinder::kBVHMaxLeaf) {
+         fNodes[inode] = node;
+         return inode;
+      }
+      // Split along the axis of largest extent of the centroids
+      Int_t axis = 0;
+      for (Int_t j=1; j<3; j++) if (cmax[j]-cmin[j] > cmax[axis]-cmin[axis]) axis = j;
+      Double_t extent = cmax[axis]-cmin[axis];
+      Int_t *items = &fItems[first];
+      Int_t nleft = 0;
+      if (extent > 0 && depth < TGeoBVHFinder::kBVHMaxDepth) {
+         // Binned surface area heuristic
+         Int_t binCount[kNbins] = {0};
+         Double_t binBox[kNbins][6];
+         for (Int_t ib=0; ib<kNbins; ib++) Reset(binBox[ib]);
+         const Double_t scale = kNbins/extent;
+         for (Int_t i=0; i<count; i++) {
+            Int_t ib = TMath::Min(Int_t(kNbins-1), Int_t((fBoxes[6*items[i]+3+axis]-cmin[axis])*scale));
+            binCount[ib]++;
+            Expand(binBox[ib], items[i]);
+         }
+         Double_t rightArea[kNbins];
+         Int_t rightCount[kNbins];
+         Double_t acc[6];
+         Reset(acc);
+         Int_t nacc = 0;
+         for (Int_t ib=kNbins-1; ib>0; ib--) {
+            for (Int_t j=0; j<3; j++) {
+               acc[2*j] = TMath::Min(acc[2*j], binBox[ib][2*j]);
+               acc[2*j+1] = TMath::Max(acc[2*j+1], binBox[ib][2*j+1]);
+            }
+            nacc += binCount[ib];
+            rightArea[ib] = HalfArea(acc);
+            rightCount[ib] = nacc;
+         }
+         Reset(acc);
+         nacc = 0;
+         Double_t bestCost = TGeoShape::Big();
+         Int_t bestBin = -1;
+         for (Int_t ib=0; ib<kNbins-1; ib++) {
+            for (Int_t j=0; j<3; j++) {
+               acc[2*j] = TMath::Min(acc[2*j], binBox[ib][2*j]);
+               acc[2*j+1] = TMath::Max(acc[2*j+1], binBox[ib][2*j+1]);
+            }
+            nacc += binCount[ib];
+            if (!nacc || !rightCount[ib+1]) continue;
+            Double_t cost = nacc*HalfArea(acc) + rightCount[ib+1]*rightArea[ib+1];
+            if (cost < bestCost) {
+               bestCost = cost;
+               bestBin = ib;
+            }
+         }
+         if (bestBin >= 0) {
+            const Double_t *boxes = fBoxes;
+            const Double_t origin = cmin[axis];
+            Int_t *mid = std::partition(items, items+count, [&](Int_t id) {
+               return TMath::Min(Int_t(kNbins-1), Int_t((boxes[6*id+3+axis]-origin)*scale)) <= bestBin;
+            });
+            nleft = mid-items;
+         }
+      }
+      if (nleft <= 0 || nleft >= count) {
+         // Median split, always balanced
+         nleft = count/2;
+         const Double_t *boxes = fBoxes;
+         std::nth_element(items, items+nleft, items+count, [&](Int_t a, Int_t b) {
+            return boxes[6*a+3+axis] < boxes[6*b+3+axis];
+         });
+      }
+      node.fLeft = Build(first, nleft, depth+1);
+      node.fRight = Build(first+nleft, count-nleft, depth+1);
+      node.fCount = 0;
+      fNodes[inode] = node;
+      return inode;
+   }
+};
+
+struct BVHWideTree_t {
+   std::vector<Double_t> fBoxes;
+   std::vector<Int_t>    fChildren;
+   std::vector<Int_t>    fNitems;
+   Int_t                 fNleaves;
+   Int_t                 fDepth;
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Collapse the binary node ibin and its descendants into a node having up to
+   /// kBVHWidth children. Returns the index of the new node.
+
+   Int_t Collapse(const std::vector<BVHBuildNode_t> &bin, Int_t ibin, Int_t depth)
+   {
+      const Int_t width = TGeoBVHFinder::kBVHWidth;
+      if (depth > fDepth) fDepth = depth;
+      Int_t inode = fChildren.size()/width;
+      fBoxes.resize(6*width*(inode+1));
+      fChildren.resize(width*(inode+1), 0);
+      fNitems.resize(width*(inode+1), 0);
+      Double_t *box = &fBoxes[6*width*inode];
+      for (Int_t j=0; j<3; j++) {
+         for (Int_t k=0; k<width; k++) {
+            box[2*j*width+k] = TGeoShape::Big();
+            box[(2*j+1)*width+k] = -TGeoShape::Big();
+         }
+      }
+      Int_t kids[width];
+      Int_t nkids = 0;
+      if (bin[ibin].fLeft < 0) {
+         kids[nkids++] = ibin;
+      } else {
+         kids[nkids++] = bin[ibin].fLeft;
+         kids[nkids++] = bin[ibin].fRight;
+      }
+      // Open the largest internal children until the node is full
+      while (nkids < width) {
+         Int_t iopen = -1;
+         Double_t amax = -1;
+         for (Int_t k=0; k<nkids; k++) {
+            if (bin[kids[k]].fLeft < 0) continue;
+            Double_t area = BVHBuilder_t::HalfArea(bin[kids[k]].fBox);
+            if (area > amax) {
+               amax = area;
+               iopen = k;
+            }
+         }
+         if (iopen < 0) break;
+         Int_t iold = kids[iopen];
+         kids[iopen] = bin[iold].fLeft;
+         kids[nkids++] = bin[iold].fRight;
+      }
+      for (Int_t k=0; k<nkids; k++) {
+         const BVHBuildNode_t &kid = bin[kids[k]];
+         for (Int_t j=0; j<6; j++) fBoxes[6*width*inode + j*width + k] = kid.fBox[j];
+         if (kid.fLeft < 0) {
+            fChildren[width*inode+k] = -1-kid.fFirst;
+            fNitems[width*inode+k] = kid.fCount;
+            fNleaves++;
+         } else {
+            Int_t ichild = Collapse(bin, kids[k], depth+1);
+            fChildren[width*inode+k] = ichild;
+         }
+      }
+      return inode;
+   }
+};
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Default constructor
+
+TGeoBVHFinder::TGeoBVHFinder()
+{
+   fNnodes      = 0;
+   fNchildren   = 0;
+   fNnodeBoxes  = 0;
+   fNitems      = 0;
+   fNleaves     = 0;
+   fDepth       = 0;
+   fNodeBoxes   = 0;
+   fChildren    = 0;
+   fNchildItems = 0;
+   fItems       = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor for the volume vol.
+
+TGeoBVHFinder::TGeoBVHFinder(TGeoVolume *vol)
+              :TGeoVoxelFinder(vol)
+{
+   fNnodes      = 0;
+   fNchildren   = 0;
+   fNnodeBoxes  = 0;
+   fNitems      = 0;
+   fNleaves     = 0;
+   fDepth       = 0;
+   fNodeBoxes   = 0;
+   fChildren    = 0;
+   fNchildItems = 0;
+   fItems       = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor
+
+TGeoBVHFinder::~TGeoBVHFinder()
+{
+   ClearBVH();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Minimum number of daughters for which TGeoVolume::kVoxelsAdaptive selects
+/// the BVH instead of the slices.
+
+Int_t TGeoBVHFinder::GetAdaptiveThreshold()
+{
+   return fgAdaptiveThreshold;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the minimum number of daughters for which TGeoVolume::kVoxelsAdaptive
+/// selects the BVH instead of the slices.
+
+void TGeoBVHFinder::SetAdaptiveThreshold(Int_t ndaughters)
+{
+   fgAdaptiveThreshold = ndaughters;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release the arrays of the hierarchy.
+
+void TGeoBVHFinder::ClearBVH()
+{
+   if (fNodeBoxes) delete [] fNodeBoxes;
+   if (fChildren) delete [] fChildren;
+   if (fNchildItems) delete [] fNchildItems;
+   if (fItems) delete [] fItems;
+   fNodeBoxes   = 0;
+   fChildren    = 0;
+   fNchildItems = 0;
+   fItems       = 0;
+   fNnodes      = 0;
+   fNchildren   = 0;
+   fNnodeBoxes  = 0;
+   fNitems      = 0;
+   fNleaves     = 0;
+   fDepth       = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the hierarchy from the daughter bounding boxes.
+
+void TGeoBVHFinder::BuildBVH()
+{
+   ClearBVH();
+   Int_t nd = fVolume->GetNdaughters();
+   if (!nd || !fBoxes) return;
+   BVHBuilder_t builder;
+   builder.fBoxes = fBoxes;
+   builder.fItems.resize(nd);
+   for (Int_t id=0; id<nd; id++) builder.fItems[id] = id;
+   builder.fNodes.reserve(2*nd);
+   builder.Build(0, nd, 0);
+
+   BVHWideTree_t tree;
+   tree.fNleaves = 0;
+   tree.fDepth = 0;
+   tree.Collapse(builder.fNodes, 0, 1);
+
+   fNnodes      = tree.fChildren.size()/kBVHWidth;
+   fNchildren   = tree.fChildren.size();
+   fNnodeBoxes  = tree.fBoxes.size();
+   fNitems      = nd;
+   fNleaves     = tree.fNleaves;
+   fDepth       = tree.fDepth;
+   fNodeBoxes   = new Double_t[fNnodeBoxes];
+   fChildren    = new Int_t[fNchildren];
+   fNchildItems = new Int_t[fNchildren];
+   fItems       = new Int_t[fNitems];
+   std::copy(tree.fBoxes.begin(), tree.fBoxes.end(), fNodeBoxes);
+   std::copy(tree.fChildren.begin(), tree.fChildren.end(), fChildren);
+   std::copy(tree.fNitems.begin(), tree.fNitems.end(), fNchildItems);
+   std::copy(builder.fItems.begin(), builder.fItems.end(), fItems);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Average filling of the leaves.
+
+Double_t TGeoBVHFinder::Efficiency()
+{
+   printf("BVH efficiency for %s\n", fVolume->GetName());
+   if (NeedRebuild()) {
+      Voxelize();
+      fVolume->FindOverlaps();
+   }
+   if (!fNleaves) return 0;
+   Double_t eff = Double_t(fNitems)/(fNleaves*kBVHMaxLeaf);
+   printf("nodes=%i leaves=%i depth=%i leaf filling : %g\n", fNnodes, fNleaves, fDepth, eff);
+   return eff;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Get the list of daughters having the bounding box containing the local
+/// point.
+
+Int_t *TGeoBVHFinder::GetCheckList(const Double_t *point, Int_t &nelem, TGeoStateInfo &td)
+{
+   if (NeedRebuild()) {
+      Voxelize();
+      fVolume->FindOverlaps();
+   }
+   nelem = 0;
+   if (!fNnodes) return 0;
+   const Double_t tol = TGeoShape::Tolerance();
+   const Double_t px = point[0];
+   const Double_t py = point[1];
+   const Double_t pz = point[2];
+   Int_t stack[kBVHStackSize];
+   Int_t nstack = 0;
+   stack[nstack++] = 0;
+   while (nstack) {
+      Int_t inode = stack[--nstack];
+      const Double_t *box = &fNodeBoxes[6*kBVHWidth*inode];
+      Int_t inside[kBVHWidth];
+      for (Int_t k=0; k<kBVHWidth; k++) {
+         inside[k] = (px >= box[k])            & (px <= box[kBVHWidth+k]) &
+                     (py >= box[2*kBVHWidth+k]) & (py <= box[3*kBVHWidth+k]) &
+                     (pz >= box[4*kBVHWidth+k]) & (pz <= box[5*kBVHWidth+k]);
+      }
+      for (Int_t k=0; k<kBVHWidth; k++) {
+         if (!inside[k]) continue;
+         Int_t ichild = fChildren[kBVHWidth*inode+k];
+         if (ichild > 0) {
+            stack[nstack++] = ichild;
+            continue;
+         }
+         Int_t first = -1-ichild;
+         Int_t last = first + fNchildItems[kBVHWidth*inode+k];
+         for (Int_t i=first; i<last; i++) {
+            Int_t id = fItems[i];
+            const Double_t *b = &fBoxes[6*id];
+            if (TMath::Abs(px-b[3]) > b[0]+tol) continue;
+            if (TMath::Abs(py-b[4]) > b[1]+tol) continue;
+            if (TMath::Abs(pz-b[5]) > b[2]+tol) continue;
+            td.fVoxCheckList[nelem++] = id;
+         }
+      }
+   }
+   td.fVoxNcandidates = nelem;
+   if (!nelem) return 0;
+   return td.fVoxCheckList;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The BVH provides all candidates crossed by a ray in a single batch, see
+/// GetNextVoxel.
+
+Int_t *TGeoBVHFinder::GetNextCandidates(const Double_t * /*point*/, Int_t &ncheck, TGeoStateInfo & /*td*/)
+{
+   ncheck = 0;
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the list of overlapping daughters for the node inode, querying
+/// the hierarchy with its bounding box.
+
+void TGeoBVHFinder::FindOverlaps(Int_t inode) const
+{
+   if (!fBoxes) return;
+   TGeoNode *node = fVolume->GetNode(inode);
+   if (!fNnodes) {
+      node->SetOverlaps(0, 0);
+      return;
+   }
+   Double_t xmin = fBoxes[6*inode+3] - fBoxes[6*inode];
+   Double_t xmax = fBoxes[6*inode+3] + fBoxes[6*inode];
+   Double_t ymin = fBoxes[6*inode+4] - fBoxes[6*inode+1];
+   Double_t ymax = fBoxes[6*inode+4] + fBoxes[6*inode+1];
+   Double_t zmin = fBoxes[6*inode+5] - fBoxes[6*inode+2];
+   Double_t zmax = fBoxes[6*inode+5] + fBoxes[6*inode+2];
+   std::vector<Int_t> found;
+   Int_t stack[kBVHStackSize];
+   Int_t nstack = 0;
+   stack[nstack++] = 0;
+   while (nstack) {
+      Int_t icurrent = stack[--nstack];
+      const Double_t *box = &fNodeBoxes[6*kBVHWidth*icurrent];
+      Int_t touch[kBVHWidth];
+      for (Int_t k=0; k<kBVHWidth; k++) {
+         touch[k] = (box[k] < xmax)            & (box[kBVHWidth+k] > xmin) &
+                    (box[2*kBVHWidth+k] < ymax) & (box[3*kBVHWidth+k] > ymin) &
+                    (box[4*kBVHWidth+k] < zmax) & (box[5*kBVHWidth+k] > zmin);
+      }
+      for (Int_t k=0; k<kBVHWidth; k++) {
+         if (!touch[k]) continue;
+         Int_t ichild = fChildren[kBVHWidth*icurrent+k];
+         if (ichild > 0) {
+            stack[nstack++] = ichild;
+            continue;
+         }
+         Int_t first = -1-ichild;
+         Int_t last = first + fNchildItems[kBVHWidth*icurrent+k];
+         for (Int_t i=first; i<last; i++) {
+            Int_t ib = fItems[i];
+            if (ib == inode) continue; // everyone overlaps with itself
+            const Double_t *b = &fBoxes[6*ib];
+            if ((xmax-b[3]+b[0])*(b[3]+b[0]-xmin) <= 0.) continue;
+            if ((ymax-b[4]+b[1])*(b[4]+b[1]-ymin) <= 0.) continue;
+            if ((zmax-b[5]+b[2])*(b[5]+b[2]-zmin) <= 0.) continue;
+            found.push_back(ib);
+         }
+      }
+   }
+   if (found.empty()) {
+      node->SetOverlaps(0, 0);
+      return;
+   }
+   std::sort(found.begin(), found.end());
+   Int_t novlp = found.size();
+   Int_t *ovlps = new Int_t[novlp];
+   std::copy(found.begin(), found.end(), ovlps);
+   node->SetOverlaps(ovlps, novlp);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the list of daughters crossed by the ray prepared by
+/// SortCrossedVoxels. The whole list is returned at the first call, then 0.
+
+Int_t *TGeoBVHFinder::GetNextVoxel(const Double_t * /*point*/, const Double_t * /*dir*/, Int_t &ncheck, TGeoStateInfo &td)
+{
+   ncheck = 0;
+   if (td.fVoxCurrent) return 0;
+   td.fVoxCurrent = 1;
+   if (!td.fVoxNcandidates) return 0;
+   ncheck = td.fVoxNcandidates;
+   return td.fVoxCheckList;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Collect in the state the daughters having the bounding box crossed by the
+/// ray (point, dir), in front to back order of the traversed nodes. The boxes
+/// are not pruned with a step limit: the callers (navigator, parallel world,
+/// assemblies) have their own limits, which are not known here.
+
+void TGeoBVHFinder::SortCrossedVoxels(const Double_t *point, const Double_t *dir, TGeoStateInfo &td)
+{
+   if (NeedRebuild()) {
+      Voxelize();
+      fVolume->FindOverlaps();
+   }
+   td.fVoxCurrent = 0;
+   td.fVoxNcandidates = 0;
+   if (!fNnodes) return;
+   Double_t invdir[3];
+   for (Int_t i=0; i<3; i++) {
+      invdir[i] = TGeoShape::Big();
+      if (TMath::Abs(dir[i])<1E-10) continue;
+      invdir[i] = 1./dir[i];
+   }
+   const Double_t tol = TGeoShape::Tolerance();
+   Int_t stack[kBVHStackSize];
+   Int_t nstack = 0;
+   stack[nstack++] = 0;
+   while (nstack) {
+      Int_t inode = stack[--nstack];
+      const Double_t *box = &fNodeBoxes[6*kBVHWidth*inode];
+      Double_t tnear[kBVHWidth];
+      Int_t hit[kBVHWidth];
+      for (Int_t k=0; k<kBVHWidth; k++) {
+         Double_t t1 = (box[k]-point[0])*invdir[0];
+         Double_t t2 = (box[kBVHWidth+k]-point[0])*invdir[0];
+         Double_t tmin = TMath::Min(t1,t2);
+         Double_t tmax = TMath::Max(t1,t2);
+         t1 = (box[2*kBVHWidth+k]-point[1])*invdir[1];
+         t2 = (box[3*kBVHWidth+k]-point[1])*invdir[1];
+         tmin = TMath::Max(tmin, TMath::Min(t1,t2));
+         tmax = TMath::Min(tmax, TMath::Max(t1,t2));
+         t1 = (box[4*kBVHWidth+k]-point[2])*invdir[2];
+         t2 = (box[5*kBVHWidth+k]-point[2])*invdir[2];
+         tmin = TMath::Max(tmin, TMath::Min(t1,t2));
+         tmax = TMath::Min(tmax, TMath::Max(t1,t2));
+         tnear[k] = tmin;
+         hit[k] = (tmin <= tmax) & (tmax >= 0);
+      }
+      // Order crossed children by distance
+      Int_t order[kBVHWidth];
+      Int_t nhit = 0;
+      for (Int_t k=0; k<kBVHWidth; k++) {
+         if (!hit[k] || !fChildren[kBVHWidth*inode+k]) continue;
+         Int_t j = nhit++;
+         while (j>0 && tnear[order[j-1]] > tnear[k]) {
+            order[j] = order[j-1];
+            j--;
+         }
+         order[j] = k;
+      }
+      // Push nodes farthest first, so that the nearest is processed next. Leaves
+      // are kept for after the nodes were pushed, also in increasing distance.
+      for (Int_t j=nhit-1; j>=0; j--) {
+         Int_t ichild = fChildren[kBVHWidth*inode+order[j]];
+         if (ichild > 0) stack[nstack++] = ichild;
+      }
+      for (Int_t j=0; j<nhit; j++) {
+         Int_t ichild = fChildren[kBVHWidth*inode+order[j]];
+         if (ichild > 0) continue;
+         Int_t first = -1-ichild;
+         Int_t last = first + fNchildItems[kBVHWidth*inode+order[j]];
+         for (Int_t i=first; i<last; i++) {
+            Int_t id = fItems[i];
+            const Double_t *b = &fBoxes[6*id];
+            Double_t tmin = -TGeoShape::Big();
+            Double_t tmax = TGeoShape::Big();
+            for (Int_t iaxis=0; iaxis<3; iaxis++) {
+               Double_t t1 = (b[iaxis+3]-b[iaxis]-tol-point[iaxis])*invdir[iaxis];
+               Double_t t2 = (b[iaxis+3]+b[iaxis]+tol-point[iaxis])*invdir[iaxis];
+               tmin = TMath::Max(tmin, TMath::Min(t1,t2));
+               tmax = TMath::Min(tmax, TMath::Max(t1,t2));
+            }
+            if (tmin > tmax || tmax < 0) continue;
+            td.fVoxCheckList[td.fVoxNcandidates++] = id;
+         }
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the hierarchy.
+
+void TGeoBVHFinder::Print(Option_t *option) const
+{
+   if (NeedRebuild()) {
+      TGeoBVHFinder *vox = (TGeoBVHFinder*)this;
+      vox->Voxelize();
+      fVolume->FindOverlaps();
+   }
+   printf("BVH for volume %s (nd=%i)\n", fVolume->GetName(), fVolume->GetNdaughters());
+   printf("nodes=%i leaves=%i depth=%i memory=%i bytes\n", fNnodes, fNleaves, fDepth,
+          Int_t(fNnodeBoxes*sizeof(Double_t) + (2*fNchildren+fNitems)*sizeof(Int_t)));
+   TString opt(option);
+   opt.ToLower();
+   if (!opt.Contains("all")) return;
+   for (Int_t inode=0; inode<fNnodes; inode++) {
+      printf("node %i:\n", inode);
+      const Double_t *box = &fNodeBoxes[6*kBVHWidth*inode];
+      for (Int_t k=0; k<kBVHWidth; k++) {
+         Int_t ichild = fChildren[kBVHWidth*inode+k];
+         if (!ichild) continue;
+         printf("   [%g, %g] x [%g, %g] x [%g, %g] ", box[k], box[kBVHWidth+k],
+                box[2*kBVHWidth+k], box[3*kBVHWidth+k], box[4*kBVHWidth+k], box[5*kBVHWidth+k]);
+         if (ichild > 0) {
+            printf("-> node %i\n", ichild);
+            continue;
+         }
+         Int_t first = -1-ichild;
+         printf("-> leaf :");
+         for (Int_t i=first; i<first+fNchildItems[kBVHWidth*inode+k]; i++) printf(" %i", fItems[i]);
+         printf("\n");
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the bounding boxes of the daughters and the hierarchy on top.
+
+void TGeoBVHFinder::Voxelize(Option_t * /*option*/)
+{
+   if (fVolume->IsAssembly()) fVolume->GetShape()->ComputeBBox();
+   Int_t nd = fVolume->GetNdaughters();
+   TGeoVolume *vd;
+   for (Int_t i=0; i<nd; i++) {
+      vd = fVolume->GetNode(i)->GetVolume();
+      if (vd->IsAssembly()) vd->GetShape()->ComputeBBox();
+   }
+   BuildVoxelLimits();
+   BuildBVH();
+   SetNeedRebuild(kFALSE);
+}
@@ -747,9 +747,10 @@ Int_t TGeoUnion::GetNpoints()
       fLeftMat->MasterToLocal(&points[3*itot], point);
       if (!fLeft->Contains(point)) itot++;
    }
+   // The number of points is set last, since it tells that the points are cached
+   fPoints = new Double_t[3*itot];
+   memcpy(fPoints, points, 3*itot*sizeof(Double_t));
    fNpoints = itot;
-   fPoints = new Double_t[3*fNpoints];
-   memcpy(fPoints, points, 3*fNpoints*sizeof(Double_t));
    delete [] points1;
    delete [] points2;
    delete [] points;
@@ -1080,9 +1081,10 @@ Int_t TGeoSubtraction::GetNpoints()
       fLeftMat->MasterToLocal(&points[3*itot], point);
       if (fLeft->Contains(point)) itot++;
    }
+   // The number of points is set last, since it tells that the points are cached
+   fPoints = new Double_t[3*itot];
+   memcpy(fPoints, points, 3*itot*sizeof(Double_t));
    fNpoints = itot;
-   fPoints = new Double_t[3*fNpoints];
-   memcpy(fPoints, points, 3*fNpoints*sizeof(Double_t));
    delete [] points1;
    delete [] points2;
    delete [] points;
@@ -1506,9 +1508,10 @@ Int_t TGeoIntersection::GetNpoints()
       fLeftMat->MasterToLocal(&points[3*itot], point);
       if (fLeft->Contains(point)) itot++;
    }
+   // The number of points is set last, since it tells that the points are cached
+   fPoints = new Double_t[3*itot];
+   memcpy(fPoints, points, 3*itot*sizeof(Double_t));
    fNpoints = itot;
-   fPoints = new Double_t[3*fNpoints];
-   memcpy(fPoints, points, 3*fNpoints*sizeof(Double_t));
    delete [] points1;
    delete [] points2;
    delete [] points;
@@ -235,6 +235,7 @@ in order to enhance rays.
 */
 
 #include <stdlib.h>
+#include <atomic>
 
 #include "Riostream.h"
 
@@ -304,6 +305,11 @@ UInt_t TGeoManager::fgExportPrecision = 17;
 TGeoManager::EDefaultUnits TGeoManager::fgDefaultUnits = TGeoManager::kG4Units;
 TGeoManager::ThreadsMap_t *TGeoManager::fgThreadId = 0;
 
+namespace {
+// Incremented when navigators are deleted, so that the navigators cached by the threads are looked up again
+std::atomic<Int_t> gNavigatorsGeneration(0);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor.
 
@@ -913,15 +919,18 @@ TGeoNavigator *TGeoManager::AddNavigator()
 TGeoNavigator *TGeoManager::GetCurrentNavigator() const
 {
    TTHREAD_TLS(TGeoNavigator*) tnav = 0;
+   TTHREAD_TLS(Int_t) tgeneration = -1;
    if (!fMultiThread) return fCurrentNavigator;
    TGeoNavigator *nav = tnav; // TTHREAD_TLS_GET(TGeoNavigator*,tnav);
-   if (nav) return nav;
+   const Int_t generation = gNavigatorsGeneration.load();
+   if (nav && tgeneration == generation) return nav;
    std::thread::id threadId = std::this_thread::get_id();
    NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
    if (it == fNavigators.end()) return 0;
    TGeoNavigatorArray *array = it->second;
    nav = array->GetCurrentNavigator();
    tnav = nav; // TTHREAD_TLS_SET(TGeoNavigator*,tnav,nav);
+   tgeneration = generation;
    return nav;
 }
 
@@ -981,6 +990,7 @@ void TGeoManager::ClearNavigators()
       if (arr) delete arr;
    }
    fNavigators.clear();
+   gNavigatorsGeneration++;
    if (fMultiThread) fgMutex.unlock();
 }
 
@@ -996,6 +1006,7 @@ void TGeoManager::RemoveNavigator(const TGeoNavigator *nav)
          if ((TGeoNavigator*)arr->Remove((TObject*)nav)) {
             delete nav;
             if (!arr->GetEntries()) fNavigators.erase(it);
+            gNavigatorsGeneration++;
             if (fMultiThread) fgMutex.unlock();
             return;
          }
@@ -73,6 +73,7 @@ painting a node on a pad will take the corresponding volume attributes.
 #include "TBrowser.h"
 #include "TObjArray.h"
 #include "TStyle.h"
+#include "TROOT.h"
 
 #include "TGeoManager.h"
 #include "TGeoMatrix.h"
@@ -210,6 +211,8 @@ Int_t TGeoNode::CountDaughters(Bool_t unique_volumes)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Check overlaps bigger than OVLP hierarchically, starting with this node.
+/// If implicit multi-threading is enabled (ROOT::EnableImplicitMT()), the
+/// unique volumes of the branch are checked in parallel on the IMT pool.
 
 void TGeoNode::CheckOverlaps(Double_t ovlp, Option_t *option)
 {
@@ -233,26 +236,43 @@ void TGeoNode::CheckOverlaps(Double_t ovlp, Option_t *option)
       Info("CheckOverlaps", "=== NOTE: Extrusions NOT checked with sampling option ! ===");
    }
    timer->Start();
-   geom->GetGeomPainter()->OpProgress(fVolume->GetName(),icheck,ncheck,timer,kFALSE);
-   fVolume->CheckOverlaps(ovlp,option);
-   icheck++;
    TGeoIterator next(fVolume);
    TGeoNode *node;
    TString path;
    TObjArray *overlaps = geom->GetListOfOverlaps();
    Int_t novlps;
    TString msg;
-   while ((node=next())) {
-      next.GetPath(path);
+   if (ROOT::IsImplicitMTEnabled()) {
+      // Collect the unique volumes in traversal order and check them in parallel
+      TObjArray volumes;
+      volumes.Add(fVolume);
+      fVolume->SelectVolume(kFALSE);
+      while ((node=next())) {
+         icheck++;
+         if (!node->GetVolume()->IsSelected()) {
+            node->GetVolume()->SelectVolume(kFALSE);
+            volumes.Add(node->GetVolume());
+         }
+      }
+      fVolume->SelectVolume(kTRUE);
       icheck++;
-      if (!node->GetVolume()->IsSelected()) {
-         msg = TString::Format("found %d overlaps", overlaps->GetEntriesFast());
-         geom->GetGeomPainter()->OpProgress(node->GetVolume()->GetName(),icheck,ncheck,timer,kFALSE, msg);
-         node->GetVolume()->SelectVolume(kFALSE);
-         node->GetVolume()->CheckOverlaps(ovlp,option);
+      geom->GetGeomPainter()->CheckOverlapsMT(&volumes, ovlp, option, timer);
+   } else {
+      geom->GetGeomPainter()->OpProgress(fVolume->GetName(),icheck,ncheck,timer,kFALSE);
+      fVolume->CheckOverlaps(ovlp,option);
+      icheck++;
+      while ((node=next())) {
+         next.GetPath(path);
+         icheck++;
+         if (!node->GetVolume()->IsSelected()) {
+            msg = TString::Format("found %d overlaps", overlaps->GetEntriesFast());
+            geom->GetGeomPainter()->OpProgress(node->GetVolume()->GetName(),icheck,ncheck,timer,kFALSE, msg);
+            node->GetVolume()->SelectVolume(kFALSE);
+            node->GetVolume()->CheckOverlaps(ovlp,option);
+         }
       }
+      fVolume->SelectVolume(kTRUE);
    }
-   fVolume->SelectVolume(kTRUE);
    geom->SetCheckingOverlaps(kFALSE);
    geom->SortOverlaps();
    novlps = overlaps->GetEntriesFast();
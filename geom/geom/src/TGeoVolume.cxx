@@ -399,6 +399,7 @@ volumes (or volume assemblies) as content.
 #include "TGeoScaledShape.h"
 #include "TGeoCompositeShape.h"
 #include "TGeoVoxelFinder.h"
+#include "TGeoBVHFinder.h"
 #include "TGeoExtension.h"
 
 ClassImp(TGeoVolume);
@@ -457,6 +458,7 @@ TGeoVolume::TGeoVolume()
    fNumber   = 0;
    fNtotal   = 0;
    fRefCount = 0;
+   fVoxelsType = kVoxelsSlices;
    fUserExtension = 0;
    fFWExtension = 0;
    TObject::ResetBit(kVolumeImportNodes);
@@ -489,6 +491,7 @@ TGeoVolume::TGeoVolume(const char *name, const TGeoShape *shape, const TGeoMediu
    fNumber   = 0;
    fNtotal   = 0;
    fRefCount = 0;
+   fVoxelsType = kVoxelsSlices;
    fUserExtension = 0;
    fFWExtension = 0;
    if (fGeoManager) fNumber = fGeoManager->AddVolume(this);
@@ -515,6 +518,7 @@ TGeoVolume::TGeoVolume(const TGeoVolume& gv) :
   fNumber(gv.fNumber),
   fNtotal(gv.fNtotal),
   fRefCount(0),
+  fVoxelsType(gv.fVoxelsType),
   fUserExtension(gv.fUserExtension->Grab()),
   fFWExtension(gv.fFWExtension->Grab())
 {
@@ -542,6 +546,7 @@ TGeoVolume& TGeoVolume::operator=(const TGeoVolume& gv)
       fNumber=gv.fNumber;
       fRefCount = 0;
       fNtotal=gv.fNtotal;
+      fVoxelsType=gv.fVoxelsType;
       fUserExtension=gv.fUserExtension->Grab();
       fFWExtension=gv.fFWExtension->Grab();
    }
@@ -1793,8 +1798,9 @@ TGeoVolume *TGeoVolume::CloneVolume() const
    vol->SetFinder(fFinder);
    // copy voxels
    TGeoVoxelFinder *voxels = 0;
+   vol->SetVoxelsType(fVoxelsType);
    if (fVoxels) {
-      voxels = new TGeoVoxelFinder(vol);
+      voxels = vol->MakeVoxelFinder();
       vol->SetVoxelFinder(voxels);
    }
    // copy option, uid
@@ -2369,7 +2375,7 @@ void TGeoVolume::Voxelize(Option_t *option)
       fVoxels = 0;
    }
    // Create the voxels structure
-   fVoxels = new TGeoVoxelFinder(this);
+   fVoxels = MakeVoxelFinder();
    fVoxels->Voxelize(option);
    if (fVoxels) {
       if (fVoxels->IsInvalid()) {
@@ -2379,6 +2385,43 @@ void TGeoVolume::Voxelize(Option_t *option)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Create a finder for the bounding boxes of the daughters, of the type
+/// selected by SetVoxelsType. The finder is not voxelized.
+
+TGeoVoxelFinder *TGeoVolume::MakeVoxelFinder()
+{
+   Bool_t bvh = (fVoxelsType == kVoxelsBVH);
+   if (fVoxelsType == kVoxelsAdaptive)
+      bvh = (GetNdaughters() >= TGeoBVHFinder::GetAdaptiveThreshold());
+   if (bvh) return new TGeoBVHFinder(this);
+   return new TGeoVoxelFinder(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Select the finder used for the bounding boxes of the daughters:
+///  - kVoxelsSlices : slices on each axis (default)
+///  - kVoxelsBVH : bounding volume hierarchy, faster to build and to query
+///    for volumes with many daughters
+///  - kVoxelsAdaptive : hierarchy for volumes having at least
+///    TGeoBVHFinder::GetAdaptiveThreshold() daughters, slices otherwise
+/// Existing voxels are rebuilt at the next navigation query.
+
+void TGeoVolume::SetVoxelsType(Int_t type)
+{
+   if (type < kVoxelsSlices || type > kVoxelsAdaptive) {
+      Error("SetVoxelsType", "Invalid voxels type %d for volume %s", type, GetName());
+      return;
+   }
+   if (type == fVoxelsType) return;
+   fVoxelsType = type;
+   if (fVoxels && !TObject::TestBit(kVolumeClone)) {
+      delete fVoxels;
+      fVoxels = MakeVoxelFinder();
+      fVoxels->SetNeedRebuild();
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Estimate the weight of a volume (in kg) with SIGMA(M)/M better than PRECISION.
 /// Option can contain : v - verbose, a - analytical  (default)
@@ -2931,8 +2974,9 @@ TGeoVolume *TGeoVolumeAssembly::CloneVolume() const
    ((TGeoShapeAssembly*)vol->GetShape())->NeedsBBoxRecompute();
    // copy voxels
    TGeoVoxelFinder *voxels = 0;
+   vol->SetVoxelsType(fVoxelsType);
    if (fVoxels) {
-      voxels = new TGeoVoxelFinder(vol);
+      voxels = vol->MakeVoxelFinder();
       vol->SetVoxelFinder(voxels);
    }
    // copy option, uid
@@ -3015,8 +3059,9 @@ TGeoVolumeAssembly *TGeoVolumeAssembly::MakeAssemblyFromVolume(TGeoVolume *volor
    vol->GetShape()->ComputeBBox();
    // copy voxels
    TGeoVoxelFinder *voxels = 0;
+   vol->SetVoxelsType(volorig->GetVoxelsType());
    if (volorig->GetVoxels()) {
-      voxels = new TGeoVoxelFinder(vol);
+      voxels = vol->MakeVoxelFinder();
       vol->SetVoxelFinder(voxels);
    }
    // copy option, uid
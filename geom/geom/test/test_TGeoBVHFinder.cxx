@@ -0,0 +1,89 @@
+// test the navigation with the bounding volume hierarchy against the slices
+
+#include "gtest/gtest.h"
+
+#include "TGeoManager.h"
+#include "TGeoMaterial.h"
+#include "TGeoMatrix.h"
+#include "TGeoMedium.h"
+#include "TGeoNavigator.h"
+#include "TGeoShape.h"
+#include "TGeoVolume.h"
+#include "TMath.h"
+#include "TRandom3.h"
+
+#include <vector>
+
+// Distances from points around an assembly of rotated cubes and tracked lengths of
+// rays crossing it, each query following a short step of the navigator
+void NavigateAssembly(TGeoVolume *assembly, Int_t type, std::vector<Double_t> &dist, std::vector<Double_t> &length)
+{
+   assembly->SetVoxelsType(type);
+   assembly->Voxelize("");
+   assembly->FindOverlaps();
+   TGeoNavigator *nav = gGeoManager->GetCurrentNavigator();
+   TRandom3 rndm(5678);
+   Double_t point[3], dir[3];
+   for (Int_t i = 0; i < 2000; i++) {
+      Double_t phi = 2. * TMath::Pi() * rndm.Rndm();
+      Double_t cost = 1. - 2. * rndm.Rndm();
+      Double_t sint = TMath::Sqrt((1. + cost) * (1. - cost));
+      point[0] = 15. * sint * TMath::Cos(phi);
+      point[1] = 15. * sint * TMath::Sin(phi);
+      point[2] = 15. * cost;
+      // towards a random point of the assembly
+      Double_t norm = 0;
+      for (Int_t j = 0; j < 3; j++) {
+         dir[j] = rndm.Uniform(-4., 4.) - point[j];
+         norm += dir[j] * dir[j];
+      }
+      for (Int_t j = 0; j < 3; j++) dir[j] /= TMath::Sqrt(norm);
+
+      nav->InitTrack(point, dir);
+      nav->FindNextBoundaryAndStep(1.E-3);
+      dist.push_back(assembly->GetShape()->DistFromOutside(point, dir, 3));
+
+      Double_t len = 0;
+      while (!nav->IsOutside()) {
+         TGeoNode *current = nav->GetCurrentNode();
+         nav->FindNextBoundaryAndStep();
+         if (current != gGeoManager->GetTopNode()) len += nav->GetStep();
+      }
+      length.push_back(len);
+   }
+}
+
+TEST(TGeoBVHFinder, SameNavigationAsSlicesAfterShortStep)
+{
+   TGeoManager *geom = new TGeoManager("bvh", "slices versus bounding volume hierarchy");
+   TGeoMedium *med = new TGeoMedium("Vacuum", 1, new TGeoMaterial("Vacuum", 0, 0, 0));
+   TGeoVolume *top = geom->MakeBox("TOP", med, 20, 20, 20);
+   geom->SetTopVolume(top);
+   TGeoVolume *assembly = geom->MakeVolumeAssembly("ASM");
+   TGeoVolume *cube = geom->MakeBox("CUBE", med, 0.5, 0.5, 0.5);
+   TRandom3 rndm(4321);
+   Int_t copy = 0;
+   for (Int_t i = 0; i < 5; i++) {
+      for (Int_t j = 0; j < 5; j++) {
+         for (Int_t k = 0; k < 5; k++) {
+            TGeoRotation *rot = new TGeoRotation("", 360. * rndm.Rndm(), 180. * rndm.Rndm(), 360. * rndm.Rndm());
+            assembly->AddNode(cube, copy++, new TGeoCombiTrans(-4. + 2. * i, -4. + 2. * j, -4. + 2. * k, rot));
+         }
+      }
+   }
+   top->AddNode(assembly, 1);
+   geom->CloseGeometry();
+
+   std::vector<Double_t> dist1, length1, dist2, length2;
+   NavigateAssembly(assembly, TGeoVolume::kVoxelsSlices, dist1, length1);
+   NavigateAssembly(assembly, TGeoVolume::kVoxelsBVH, dist2, length2);
+
+   Int_t nhits = 0;
+   for (UInt_t i = 0; i < dist1.size(); i++) {
+      if (dist1[i] < TGeoShape::Big()) nhits++;
+      EXPECT_NEAR(dist1[i], dist2[i], 1.E-9 * TMath::Max(1., dist1[i]));
+      EXPECT_NEAR(length1[i], length2[i], 1.E-9 * TMath::Max(1., length1[i]));
+   }
+   EXPECT_GT(nhits, 100);
+   delete geom;
+}
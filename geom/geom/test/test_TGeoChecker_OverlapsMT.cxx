@@ -0,0 +1,59 @@
+// test the overlap checks on the implicit MT pool
+
+#include "gtest/gtest.h"
+
+#include "TGeoBBox.h"
+#include "TGeoCompositeShape.h"
+#include "TGeoManager.h"
+#include "TGeoMaterial.h"
+#include "TGeoMatrix.h"
+#include "TGeoMedium.h"
+#include "TGeoTube.h"
+#include "TGeoVolume.h"
+#include "TROOT.h"
+
+// Containers checked in parallel, each holding volumes of the same composite shape,
+// with two overlapping copies in half of them
+TGeoManager *CreateSharedCompositeGeometry()
+{
+   TGeoManager *geom = new TGeoManager("shared", "volumes sharing a composite shape");
+   TGeoMedium *med = new TGeoMedium("Vacuum", 1, new TGeoMaterial("Vacuum", 0, 0, 0));
+   TGeoVolume *top = geom->MakeBox("TOP", med, 100, 100, 100);
+   geom->SetTopVolume(top);
+
+   new TGeoBBox("B", 2, 2, 2);
+   new TGeoTube("T", 0, 1, 3);
+   TGeoTranslation *tr = new TGeoTranslation("tr", 1, 0, 0);
+   tr->RegisterYourself();
+   TGeoCompositeShape *shape = new TGeoCompositeShape("C", "B+T:tr");
+
+   for (Int_t i = 0; i < 16; i++) {
+      TGeoVolume *container = geom->MakeBox(Form("CONT%d", i), med, 5, 5, 5);
+      TGeoVolume *vol = new TGeoVolume(Form("VC%d", i), shape, med);
+      container->AddNode(vol, 1);
+      if (i % 2) container->AddNode(vol, 2, new TGeoTranslation(0.5, 0, 0));
+      top->AddNode(container, 1, new TGeoTranslation(-80 + 10 * i, 0, 0));
+   }
+   geom->CloseGeometry();
+   return geom;
+}
+
+TEST(TGeoChecker, OverlapsSharedComposite)
+{
+   // The mesh of the composite shape is not computed before the parallel check
+   ROOT::EnableImplicitMT(4);
+   TGeoManager *geom = CreateSharedCompositeGeometry();
+   geom->CheckOverlaps(0.01);
+   const Int_t nparallel = geom->GetListOfOverlaps()->GetEntries();
+   const Int_t nvertices = geom->GetVolume("VC0")->GetShape()->GetNmeshVertices();
+   EXPECT_FALSE(geom->IsMultiThread());
+   delete geom;
+   ROOT::DisableImplicitMT();
+
+   geom = CreateSharedCompositeGeometry();
+   geom->CheckOverlaps(0.01);
+   EXPECT_GT(geom->GetListOfOverlaps()->GetEntries(), 0);
+   EXPECT_EQ(geom->GetListOfOverlaps()->GetEntries(), nparallel);
+   EXPECT_EQ(geom->GetVolume("VC0")->GetShape()->GetNmeshVertices(), nvertices);
+   delete geom;
+}
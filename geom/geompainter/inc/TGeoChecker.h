@@ -14,6 +14,9 @@
 
 #include "TObject.h"
 
+#include <vector>
+#include <functional>
+
 // forward declarations
 class TTree;
 class TGeoShape;
@@ -26,6 +29,8 @@ class TGeoOverlap;
 class TBuffer3D;
 class TH2F;
 class TStopwatch;
+class TRandom;
+class TObjArray;
 
 ///////////////////////////////////////////////////////////////////////////
 // TGeoChecker - A simple checker generating random points inside a      //
@@ -50,7 +55,10 @@ private :
    TGeoNode        *fSelectedNode;    //! Selected node for overlap checking
    Int_t            fNchecks;         //! Number of checks for current volume
    Int_t            fNmeshPoints;     //! Number of points on mesh to be checked
+   std::vector<TGeoOverlap*> *fThreadOverlaps; //! Overlaps found by a worker checker, merged by the caller
+   TRandom         *fRandom;          //! Random generator used by a worker checker (gRandom if null)
 // methods
+   void             AddOverlap(TGeoOverlap *ovlp) const;
    void             CleanPoints(Double_t *points, Int_t &numPoints) const;
    Int_t            NChecksPerVolume(TGeoVolume *vol);
    Int_t            PropagateInGeom(Double_t *, Double_t *);
@@ -69,9 +77,11 @@ public:
    void             CheckGeometry(Int_t nrays, Double_t startx, Double_t starty, Double_t startz) const;
    void             CheckOverlaps(const TGeoVolume *vol, Double_t ovlp=0.1, Option_t *option="");
    void             CheckOverlapsBySampling(TGeoVolume *vol, Double_t ovlp=0.1, Int_t npoints=1000000) const;
+   void             CheckOverlapsMT(const TObjArray *volumes, Double_t ovlp=0.1, Option_t *option="", TStopwatch *timer=0);
    void             CheckPoint(Double_t x=0, Double_t y=0, Double_t z=0, Option_t *option="");
    void             CheckShape(TGeoShape *shape, Int_t testNo, Int_t nsamples, Option_t *option);
    Double_t         CheckVoxels(TGeoVolume *vol, TGeoVoxelFinder *voxels, Double_t *xyz, Int_t npoints);
+   Int_t            ExecuteTasks(UInt_t ntasks, const std::function<void(UInt_t)> &task);
    TH2F            *LegoPlot(Int_t ntheta=60, Double_t themin=0., Double_t themax=180.,
                             Int_t nphi=90, Double_t phimin=0., Double_t phimax=360.,
                             Double_t rmin=0., Double_t rmax=9999999, Option_t *option="");
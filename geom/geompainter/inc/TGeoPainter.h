@@ -92,6 +92,7 @@ public:
    virtual void       CheckPoint(Double_t x=0, Double_t y=0, Double_t z=0, Option_t *option="");
    virtual void       CheckShape(TGeoShape *shape, Int_t testNo, Int_t nsamples, Option_t *option);
    virtual void       CheckOverlaps(const TGeoVolume *vol, Double_t ovlp=0.1, Option_t *option="") const;
+   virtual void       CheckOverlapsMT(const TObjArray *volumes, Double_t ovlp=0.1, Option_t *option="", TStopwatch *timer=0);
    Int_t              CountNodes(TGeoVolume *vol, Int_t level) const;
    virtual Int_t      CountVisibleNodes();
    virtual void       DefaultAngles();
@@ -23,6 +23,15 @@ definition in terms of overlapping/extruding objects. Both types of checks
 can be done for a given branch (starting with a given volume) as well as for
 the geometry as a whole.
 
+#### TGeoChecker::CheckOverlapsMT(const TObjArray *volumes, Double_t ovlp)
+
+Called by TGeoManager::CheckOverlaps() when implicit multi-threading is
+enabled. The unique volumes of the checked branch are distributed on the IMT
+pool; each task uses a private checker (own mesh buffers and random generator)
+and the navigator of its thread. The overlaps found per volume are merged in
+the order of the serial traversal, so the result does not depend on the
+number of threads.
+
 #### TGeoChecker::CheckPoint(Double_t x, Double_t y, Double_t z)
 
 This method can be called directly from the TGeoManager class and print a
@@ -70,6 +79,7 @@ volume by material sampling. Accepts as input the desired precision.
 #include "TPolyMarker3D.h"
 #include "TPolyLine3D.h"
 #include "TStopwatch.h"
+#include "TROOT.h"
 
 #include "TGeoVoxelFinder.h"
 #include "TGeoBBox.h"
@@ -84,6 +94,13 @@ volume by material sampling. Accepts as input the desired precision.
 #include "TMath.h"
 
 #include <stdlib.h>
+#include <atomic>
+#include <mutex>
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
 
 // statics and globals
 
@@ -105,7 +122,9 @@ TGeoChecker::TGeoChecker()
              fTimer(NULL),
              fSelectedNode(NULL),
              fNchecks(0),
-             fNmeshPoints(1000)
+             fNmeshPoints(1000),
+             fThreadOverlaps(NULL),
+             fRandom(NULL)
 {
 }
 
@@ -125,7 +144,9 @@ TGeoChecker::TGeoChecker(TGeoManager *geom)
              fTimer(NULL),
              fSelectedNode(NULL),
              fNchecks(0),
-             fNmeshPoints(1000)
+             fNmeshPoints(1000),
+             fThreadOverlaps(NULL),
+             fRandom(NULL)
 {
    fBuff1 = new TBuffer3D(TBuffer3DTypes::kGeneric,500,3*500,0,0,0,0);
    fBuff2 = new TBuffer3D(TBuffer3DTypes::kGeneric,500,3*500,0,0,0,0);
@@ -987,7 +1008,7 @@ TGeoOverlap *TGeoChecker::MakeCheckOverlap(const char *name, TGeoVolume *vol1, T
    if (vol1->IsAssembly() || vol2->IsAssembly()) return nodeovlp;
    TGeoShape *shape1 = vol1->GetShape();
    TGeoShape *shape2 = vol2->GetShape();
-   OpProgress("refresh", 0,0,NULL,kFALSE,kTRUE);
+   if (!fThreadOverlaps) OpProgress("refresh", 0,0,NULL,kFALSE,kTRUE);
    shape1->GetMeshNumbers(numPoints1, numSegs1, numPols1);
    if (fBuff1->fID != (TObject*)shape1) {
       // Fill first buffer.
@@ -1040,7 +1061,7 @@ TGeoOverlap *TGeoChecker::MakeCheckOverlap(const char *name, TGeoVolume *vol1, T
                isextrusion = kTRUE;
                nodeovlp = new TGeoOverlap(name, vol1, vol2, mat1,mat2,kFALSE,safety);
                nodeovlp->SetNextPoint(point[0],point[1],point[2]);
-               fGeoManager->AddOverlap(nodeovlp);
+               AddOverlap(nodeovlp);
             } else {
                if (safety>nodeovlp->GetOverlap()) nodeovlp->SetOverlap(safety);
                nodeovlp->SetNextPoint(point[0],point[1],point[2]);
@@ -1069,7 +1090,7 @@ TGeoOverlap *TGeoChecker::MakeCheckOverlap(const char *name, TGeoVolume *vol1, T
                isextrusion = kTRUE;
                nodeovlp = new TGeoOverlap(name, vol1,vol2,mat1,mat2,kFALSE,safety);
                nodeovlp->SetNextPoint(point[0],point[1],point[2]);
-               fGeoManager->AddOverlap(nodeovlp);
+               AddOverlap(nodeovlp);
             } else {
                if (safety>nodeovlp->GetOverlap()) nodeovlp->SetOverlap(safety);
                nodeovlp->SetNextPoint(point[0],point[1],point[2]);
@@ -1098,7 +1119,7 @@ TGeoOverlap *TGeoChecker::MakeCheckOverlap(const char *name, TGeoVolume *vol1, T
             isoverlapping = kTRUE;
             nodeovlp = new TGeoOverlap(name,vol1,vol2,mat1,mat2,kTRUE,safety);
             nodeovlp->SetNextPoint(point[0],point[1],point[2]);
-            fGeoManager->AddOverlap(nodeovlp);
+            AddOverlap(nodeovlp);
          } else {
             if (safety>nodeovlp->GetOverlap()) nodeovlp->SetOverlap(safety);
             nodeovlp->SetNextPoint(point[0],point[1],point[2]);
@@ -1121,7 +1142,7 @@ TGeoOverlap *TGeoChecker::MakeCheckOverlap(const char *name, TGeoVolume *vol1, T
             isoverlapping = kTRUE;
             nodeovlp = new TGeoOverlap(name,vol1,vol2,mat1,mat2,kTRUE,safety);
             nodeovlp->SetNextPoint(point[0],point[1],point[2]);
-            fGeoManager->AddOverlap(nodeovlp);
+            AddOverlap(nodeovlp);
          } else {
             if (safety>nodeovlp->GetOverlap()) nodeovlp->SetOverlap(safety);
             nodeovlp->SetNextPoint(point[0],point[1],point[2]);
@@ -1170,12 +1191,13 @@ void TGeoChecker::CheckOverlapsBySampling(TGeoVolume *vol, Double_t /* ovlp */,
    TGeoHMatrix mat1, mat2;
 //   Int_t tid = TGeoManager::ThreadId();
    TGeoNavigator *nav = fGeoManager->GetCurrentNavigator();
+   TRandom *rndm = fRandom ? fRandom : gRandom;
    TGeoStateInfo &td = *nav->GetCache()->GetInfo();
    while (ipoint < npoints) {
    // Shoot randomly in the bounding box.
-      pt[0] = orig[0] - dx + 2.*dx*gRandom->Rndm();
-      pt[1] = orig[1] - dy + 2.*dy*gRandom->Rndm();
-      pt[2] = orig[2] - dz + 2.*dz*gRandom->Rndm();
+      pt[0] = orig[0] - dx + 2.*dx*rndm->Rndm();
+      pt[1] = orig[1] - dy + 2.*dy*rndm->Rndm();
+      pt[2] = orig[2] - dz + 2.*dz*rndm->Rndm();
       if (!vol->Contains(pt)) {
          itry++;
          if (itry>10000 && !ipoint) {
@@ -1239,7 +1261,7 @@ void TGeoChecker::CheckOverlapsBySampling(TGeoVolume *vol, Double_t /* ovlp */,
                vol->GetName(), name1.Data(), name2.Data()), node1->GetVolume(),node2->GetVolume(),
                &mat1,&mat2, kTRUE, safe);
             flags[nd*id1+id0] = nodeovlp;
-            fGeoManager->AddOverlap(nodeovlp);
+            AddOverlap(nodeovlp);
          }
          // Max 100 points per marker
          if (nodeovlp->GetPolyMarker()->GetN()<100) nodeovlp->SetNextPoint(pt[0],pt[1],pt[2]);
@@ -1353,8 +1375,11 @@ void TGeoChecker::CheckOverlaps(const TGeoVolume *vol, Double_t ovlp, Option_t *
    if (vol->GetFinder()) return;
    UInt_t nd = vol->GetNdaughters();
    if (!nd) return;
-   TGeoShape::SetTransform(gGeoIdentity);
-   fNchecks = NChecksPerVolume((TGeoVolume*)vol);
+   if (!fThreadOverlaps) {
+      // Worker checkers get the transform and progress set up by CheckOverlapsMT
+      TGeoShape::SetTransform(gGeoIdentity);
+      fNchecks = NChecksPerVolume((TGeoVolume*)vol);
+   }
    Bool_t sampling = kFALSE;
    TString opt(option);
    opt.ToLower();
@@ -1563,6 +1588,144 @@ void TGeoChecker::CheckOverlaps(const TGeoVolume *vol, Double_t ovlp, Option_t *
    }
 }
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the mesh of the shape of VOL and of the shapes of its daughters,
+/// going through assemblies. Composite shapes cache their mesh vertices on
+/// the first request without any lock, and several volumes can share them, so
+/// the caches must be filled before the volumes are checked in parallel.
+
+void FillMeshCaches(TGeoVolume *vol)
+{
+   Int_t nvert, nsegs, npols;
+   vol->GetShape()->GetMeshNumbers(nvert, nsegs, npols);
+   Int_t nd = vol->GetNdaughters();
+   for (Int_t id=0; id<nd; id++) {
+      TGeoVolume *dvol = vol->GetNode(id)->GetVolume();
+      if (dvol->IsAssembly()) FillMeshCaches(dvol);
+      else                    dvol->GetShape()->GetMeshNumbers(nvert, nsegs, npols);
+   }
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Check illegal overlaps for a list of unique volumes within a limit OVLP,
+/// distributing the volumes on the implicit MT pool. Each task uses a private
+/// checker (own mesh buffers, random generator seeded by the volume index) and
+/// a navigator owned by its thread. The overlaps found are kept per volume and
+/// added to the manager at the end, in the order of the input list. Progress is
+/// reported using the optional TIMER, followed by a timing summary.
+
+void TGeoChecker::CheckOverlapsMT(const TObjArray *volumes, Double_t ovlp, Option_t *option, TStopwatch *timer)
+{
+   Int_t nvolumes = volumes->GetEntriesFast();
+   if (!nvolumes) return;
+   TString opt(option);
+   opt.ToLower();
+   Bool_t sampling = opt.Contains("s");
+   // Everything modifying shared geometry state is done upfront, on this thread
+   if (!sampling) fGeoManager->SetNsegments(80);
+   TGeoShape::SetTransform(gGeoIdentity);
+   Int_t ivol;
+   TGeoVolume *vol;
+   for (ivol=0; ivol<nvolumes; ivol++) {
+      vol = (TGeoVolume*)volumes->At(ivol);
+      TGeoVoxelFinder *vox = vol->GetVoxels();
+      if (vox && vox->NeedRebuild()) {
+         vox->Voxelize();
+         vol->FindOverlaps();
+      }
+      FillMeshCaches(vol);
+   }
+   std::vector<std::vector<TGeoOverlap*>> found(nvolumes);
+   std::mutex progressMutex;
+   std::atomic<Int_t> ndone(0);
+   TStopwatch timing;
+   timing.Start();
+
+   auto checkVolume = [&](UInt_t i) {
+      TGeoVolume *volume = (TGeoVolume*)volumes->At(i);
+      TGeoChecker checker(fGeoManager);
+      TRandom3 rndm(i+1);
+      checker.fThreadOverlaps = &found[i];
+      checker.fRandom = &rndm;
+      checker.fSelectedNode = fSelectedNode;
+      checker.fNmeshPoints = fNmeshPoints;
+      checker.CheckOverlaps(volume, ovlp, option);
+      Int_t icheck = ++ndone;
+      if (timer) {
+         std::lock_guard<std::mutex> lock(progressMutex);
+         OpProgress(volume->GetName(), icheck, nvolumes, timer, kFALSE, kFALSE,
+                    TString::Format("found %d overlaps", (Int_t)found[i].size()));
+      }
+   };
+
+   Int_t nthreads = ExecuteTasks(nvolumes, checkVolume);
+   timing.Stop();
+
+   Int_t nfound = 0;
+   for (auto &list : found) {
+      for (auto ovlap : list) fGeoManager->AddOverlap(ovlap);
+      nfound += list.size();
+   }
+   Info("CheckOverlapsMT", "Checked %d volumes on %d threads in %g s (cpu %g s), found %d overlaps",
+        nvolumes, nthreads, timing.RealTime(), timing.CpuTime(), nfound);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Execute TASK for all indices in [0, NTASKS). If implicit multi-threading is
+/// enabled the tasks are distributed on the IMT pool, otherwise they run
+/// serially on the calling thread. The geometry is switched to multi-threaded
+/// mode if needed and every pool thread without a navigator gets its own, so
+/// tasks can navigate using fGeoManager->GetCurrentNavigator(). Tasks must not
+/// modify other shared state. Once the tasks are done, the navigators added
+/// for the pool threads are deleted and the previous thread mode is restored.
+/// The thread data of the shapes is kept for the larger number of threads,
+/// since the pool threads keep their thread ids. Returns the number of threads
+/// used.
+
+Int_t TGeoChecker::ExecuteTasks(UInt_t ntasks, const std::function<void(UInt_t)> &task)
+{
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && ntasks > 1) {
+      Int_t nthreads = ROOT::GetImplicitMTPoolSize();
+      // Thread-private data of shapes and volumes must exist for all pool threads
+      const Bool_t wasMultiThread = fGeoManager->IsMultiThread();
+      if (!wasMultiThread || fGeoManager->GetMaxThreads() < nthreads)
+         fGeoManager->SetMaxThreads(nthreads);
+      std::vector<TGeoNavigator *> navigators;
+      std::mutex navigatorsMutex;
+      auto navtask = [&](UInt_t i) {
+         if (!fGeoManager->GetCurrentNavigator()) {
+            TGeoNavigator *nav = fGeoManager->AddNavigator();
+            std::lock_guard<std::mutex> lock(navigatorsMutex);
+            navigators.push_back(nav);
+         }
+         task(i);
+      };
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(navtask, ROOT::TSeq<UInt_t>(ntasks));
+      for (auto nav : navigators) fGeoManager->RemoveNavigator(nav);
+      fGeoManager->SetMultiThread(wasMultiThread);
+      return nthreads;
+   }
+#endif
+   for (UInt_t i=0; i<ntasks; i++) task(i);
+   return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Register an overlap found during checking. Worker checkers collect overlaps
+/// in their own container, otherwise they are added to the manager directly.
+
+void TGeoChecker::AddOverlap(TGeoOverlap *ovlp) const
+{
+   if (fThreadOverlaps) fThreadOverlaps->push_back(ovlp);
+   else                 fGeoManager->AddOverlap(ovlp);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Print the current list of overlaps held by the manager class.
 
@@ -2038,6 +2201,8 @@ void TGeoChecker::ShapeNormal(TGeoShape *shape, Int_t nsamples, Option_t *)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Generate a lego plot fot the top volume, according to option.
+/// The rays are traced in parallel per phi bin when implicit multi-threading
+/// is enabled; the histogram is filled afterwards in bin order.
 
 TH2F *TGeoChecker::LegoPlot(Int_t ntheta, Double_t themin, Double_t themax,
                             Int_t nphi,   Double_t phimin, Double_t phimax,
@@ -2046,21 +2211,30 @@ TH2F *TGeoChecker::LegoPlot(Int_t ntheta, Double_t themin, Double_t themax,
    TH2F *hist = new TH2F("lego", option, nphi, phimin, phimax, ntheta, themin, themax);
 
    Double_t degrad = TMath::Pi()/180.;
-   Double_t theta, phi, step, matprop, x;
-   Double_t start[3];
-   Double_t dir[3];
-   TGeoNode *startnode, *endnode;
-   Int_t i;  // loop index for phi
-   Int_t j;  // loop index for theta
    Int_t ntot = ntheta * nphi;
    Int_t n10 = ntot/10;
-   Int_t igen = 0, iloop=0;
+   std::atomic<Int_t> igen(0);
+   std::mutex progressMutex;
+   // Radiation lengths per (phi, theta) bin, filled in bin order at the end
+   std::vector<Double_t> values(ntot);
    printf("=== Lego plot sph. => nrays=%i\n", ntot);
-   for (i=1; i<=nphi; i++) {
-      for (j=1; j<=ntheta; j++) {
-         igen++;
+
+   // One task per phi bin, each tracing all theta bins with its thread navigator
+   auto tracePhiBin = [&](UInt_t iphi) {
+      TGeoNavigator *nav = fGeoManager->GetCurrentNavigator();
+      Double_t theta, phi, step, matprop, x;
+      Double_t start[3];
+      Double_t dir[3];
+      TGeoNode *startnode, *endnode;
+      Int_t iloop = 0;
+      Int_t i = iphi+1;  // phi bin
+      for (Int_t j=1; j<=ntheta; j++) {
+         Int_t icount = ++igen;
          if (n10) {
-            if ((igen%n10) == 0) printf("%i percent\n", Int_t(100*igen/ntot));
+            if ((icount%n10) == 0) {
+               std::lock_guard<std::mutex> lock(progressMutex);
+               printf("%i percent\n", Int_t(100*icount/ntot));
+            }
          }
          x = 0;
          theta = hist->GetYaxis()->GetBinCenter(j);
@@ -2069,27 +2243,26 @@ TH2F *TGeoChecker::LegoPlot(Int_t ntheta, Double_t themin, Double_t themax,
          dir[0]=TMath::Sin(theta*degrad)*TMath::Cos(phi*degrad);
          dir[1]=TMath::Sin(theta*degrad)*TMath::Sin(phi*degrad);
          dir[2]=TMath::Cos(theta*degrad);
-         fGeoManager->InitTrack(&start[0], &dir[0]);
-         startnode = fGeoManager->GetCurrentNode();
-         if (fGeoManager->IsOutside()) startnode=0;
+         nav->InitTrack(&start[0], &dir[0]);
+         startnode = nav->GetCurrentNode();
+         if (nav->IsOutside()) startnode=0;
          if (startnode) {
             matprop = startnode->GetVolume()->GetMaterial()->GetRadLen();
          } else {
             matprop = 0.;
          }
-         fGeoManager->FindNextBoundary();
-//         fGeoManager->IsStepEntering();
+         nav->FindNextBoundary();
          // find where we end-up
-         endnode = fGeoManager->Step();
-         step = fGeoManager->GetStep();
+         endnode = nav->Step();
+         step = nav->GetStep();
          while (step<1E10) {
             // now see if we can make an other step
             iloop=0;
-            while (!fGeoManager->IsEntering()) {
+            while (!nav->IsEntering()) {
                iloop++;
-               fGeoManager->SetStep(1E-3);
+               nav->SetStep(1E-3);
                step += 1E-3;
-               endnode = fGeoManager->Step();
+               endnode = nav->Step();
             }
             if (iloop>1000) printf("%i steps\n", iloop);
             if (matprop>0) {
@@ -2104,12 +2277,19 @@ TH2F *TGeoChecker::LegoPlot(Int_t ntheta, Double_t themin, Double_t themax,
                matprop = 0.;
             }
 
-            fGeoManager->FindNextBoundary();
-            endnode = fGeoManager->Step();
-            step = fGeoManager->GetStep();
+            nav->FindNextBoundary();
+            endnode = nav->Step();
+            step = nav->GetStep();
          }
-         hist->Fill(phi, theta, x);
+         values[iphi*ntheta+j-1] = x;
       }
+   };
+   ExecuteTasks(nphi, tracePhiBin);
+
+   for (Int_t i=1; i<=nphi; i++) {
+      Double_t phi = hist->GetXaxis()->GetBinCenter(i)+1E-3;
+      for (Int_t j=1; j<=ntheta; j++)
+         hist->Fill(phi, hist->GetYaxis()->GetBinCenter(j), values[(i-1)*ntheta+j-1]);
    }
    return hist;
 }
@@ -2187,14 +2367,14 @@ void TGeoChecker::RandomPoints(TGeoVolume *vol, Int_t npoints, Option_t *option)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Randomly shoot nrays from point (startx,starty,startz) and plot intersections
-/// with surfaces for current top node.
+/// with surfaces for current top node. Rays are generated upfront and tracked
+/// in parallel chunks when implicit multi-threading is enabled.
 
 void TGeoChecker::RandomRays(Int_t nrays, Double_t startx, Double_t starty, Double_t startz, const char *target_vol, Bool_t check_norm)
 {
    TObjArray *pm = new TObjArray(128);
    TString starget = target_vol;
    TPolyLine3D *line = 0;
-   TPolyLine3D *normline = 0;
    TGeoVolume *vol=fGeoManager->GetTopVolume();
 //   vol->VisibleDaughters(kTRUE);
 
@@ -2203,18 +2383,12 @@ void TGeoChecker::RandomRays(Int_t nrays, Double_t startx, Double_t starty, Doub
       nrays = 100000;
       random = kTRUE;
    }
-   Double_t start[3];
-   Double_t dir[3];
-   const Double_t *point = fGeoManager->GetCurrentPoint();
    vol->Draw();
    printf("Start... %i rays\n", nrays);
-   TGeoNode *startnode, *endnode;
-   Bool_t vis1,vis2;
    Int_t i=0;
-   Int_t ipoint, inull;
-   Int_t itot=0;
+   Int_t itot;
    Int_t n10=nrays/10;
-   Double_t theta,phi, step, normlen;
+   Double_t theta,phi, normlen;
    Double_t ox = ((TGeoBBox*)vol->GetShape())->GetOrigin()[0];
    Double_t oy = ((TGeoBBox*)vol->GetShape())->GetOrigin()[1];
    Double_t oz = ((TGeoBBox*)vol->GetShape())->GetOrigin()[2];
@@ -2224,13 +2398,12 @@ void TGeoChecker::RandomRays(Int_t nrays, Double_t startx, Double_t starty, Doub
    normlen = TMath::Max(dx,dy);
    normlen = TMath::Max(normlen,dz);
    normlen *= 0.05;
-   while (itot<nrays) {
-      itot++;
-      inull = 0;
-      ipoint = 0;
-      if (n10) {
-         if ((itot%n10) == 0) printf("%i percent\n", Int_t(100*itot/nrays));
-      }
+   // Generate all rays upfront, so that the sequence of random numbers does
+   // not depend on how tracking is distributed among threads
+   std::vector<Double_t> rays(6*nrays);
+   for (itot=0; itot<nrays; itot++) {
+      Double_t *start = &rays[6*itot];
+      Double_t *dir = start+3;
       if (random) {
          start[0] = ox-dx+2*dx*gRandom->Rndm();
          start[1] = oy-dy+2*dy*gRandom->Rndm();
@@ -2245,71 +2418,108 @@ void TGeoChecker::RandomRays(Int_t nrays, Double_t startx, Double_t starty, Doub
       dir[0]=TMath::Sin(theta)*TMath::Cos(phi);
       dir[1]=TMath::Sin(theta)*TMath::Sin(phi);
       dir[2]=TMath::Cos(theta);
-      startnode = fGeoManager->InitTrack(start[0],start[1],start[2], dir[0],dir[1],dir[2]);
-      line = 0;
-      if (fGeoManager->IsOutside()) startnode=0;
-      vis1 = kFALSE;
-      if (target_vol) {
-         if (startnode && starget==startnode->GetVolume()->GetName()) vis1 = kTRUE;
-      } else {
-         if (startnode && startnode->IsOnScreen()) vis1 = kTRUE;
-      }
-      if (vis1) {
-         line = new TPolyLine3D(2);
-         line->SetLineColor(startnode->GetVolume()->GetLineColor());
-         line->SetPoint(ipoint++, start[0], start[1], start[2]);
-         i++;
-         pm->Add(line);
-      }
-      while ((endnode=fGeoManager->FindNextBoundaryAndStep())) {
-         step = fGeoManager->GetStep();
-         if (step<TGeoShape::Tolerance()) inull++;
-         else inull = 0;
-         if (inull>5) break;
-         const Double_t *normal = 0;
-         if (check_norm) {
-            normal = fGeoManager->FindNormalFast();
-            if (!normal) break;
+   }
+
+   // Segments found along each ray, converted to polylines in ray order
+   struct RaySegment_t {
+      Int_t    fColor;       // line color
+      Int_t    fWidth;       // line width, 0 for track segments
+      Double_t fPoints[6];   // first and second point
+   };
+   const Int_t nchunks = TMath::Min(nrays, 1000);
+   std::vector<std::vector<RaySegment_t>> segments(nchunks);
+   std::atomic<Int_t> ndone(0);
+   std::mutex progressMutex;
+
+   auto traceRays = [&](UInt_t ichunk) {
+      TGeoNavigator *nav = fGeoManager->GetCurrentNavigator();
+      const Double_t *point = nav->GetCurrentPoint();
+      std::vector<RaySegment_t> &chunk = segments[ichunk];
+      TGeoNode *startnode, *endnode;
+      Bool_t vis1, vis2;
+      Int_t ipoint, inull, iseg;
+      Double_t step;
+      Int_t first = ichunk*nrays/nchunks;
+      Int_t last = (ichunk+1)*nrays/nchunks;
+      for (Int_t iray=first; iray<last; iray++) {
+         Int_t icount = ++ndone;
+         if (n10) {
+            if ((icount%n10) == 0) {
+               std::lock_guard<std::mutex> lock(progressMutex);
+               printf("%i percent\n", Int_t(100*icount/nrays));
+            }
          }
-         vis2 = kFALSE;
+         const Double_t *start = &rays[6*iray];
+         const Double_t *dir = start+3;
+         inull = 0;
+         ipoint = 0;
+         iseg = -1;
+         startnode = nav->InitTrack(start, dir);
+         if (nav->IsOutside()) startnode=0;
+         vis1 = kFALSE;
          if (target_vol) {
-            if (starget==endnode->GetVolume()->GetName()) vis2 = kTRUE;
-         } else if (endnode->IsOnScreen()) vis2 = kTRUE;
-         if (ipoint>0) {
-         // old visible node had an entry point -> finish segment
-            line->SetPoint(ipoint, point[0], point[1], point[2]);
-            if (!vis2 && check_norm) {
-               normline = new TPolyLine3D(2);
-               normline->SetLineColor(kBlue);
-               normline->SetLineWidth(1);
-               normline->SetPoint(0, point[0], point[1], point[2]);
-               normline->SetPoint(1, point[0]+normal[0]*normlen,
-                                     point[1]+normal[1]*normlen,
-                                     point[2]+normal[2]*normlen);
-               pm->Add(normline);
-            }
-            ipoint = 0;
-            line   = 0;
+            if (startnode && starget==startnode->GetVolume()->GetName()) vis1 = kTRUE;
+         } else {
+            if (startnode && startnode->IsOnScreen()) vis1 = kTRUE;
+         }
+         if (vis1) {
+            iseg = chunk.size();
+            chunk.push_back({startnode->GetVolume()->GetLineColor(), 0, {start[0], start[1], start[2], 0, 0, 0}});
+            ipoint++;
          }
-         if (vis2) {
-            // create new segment
-            line = new TPolyLine3D(2);
-            line->SetLineColor(endnode->GetVolume()->GetLineColor());
-            line->SetPoint(ipoint++, point[0], point[1], point[2]);
-            i++;
+         while ((endnode=nav->FindNextBoundaryAndStep())) {
+            step = nav->GetStep();
+            if (step<TGeoShape::Tolerance()) inull++;
+            else inull = 0;
+            if (inull>5) break;
+            const Double_t *normal = 0;
             if (check_norm) {
-               normline = new TPolyLine3D(2);
-               normline->SetLineColor(kBlue);
-               normline->SetLineWidth(2);
-               normline->SetPoint(0, point[0], point[1], point[2]);
-               normline->SetPoint(1, point[0]+normal[0]*normlen,
-                                     point[1]+normal[1]*normlen,
-                                     point[2]+normal[2]*normlen);
+               normal = nav->FindNormalFast();
+               if (!normal) break;
+            }
+            vis2 = kFALSE;
+            if (target_vol) {
+               if (starget==endnode->GetVolume()->GetName()) vis2 = kTRUE;
+            } else if (endnode->IsOnScreen()) vis2 = kTRUE;
+            if (ipoint>0) {
+            // old visible node had an entry point -> finish segment
+               memcpy(&chunk[iseg].fPoints[3], point, 3*sizeof(Double_t));
+               if (!vis2 && check_norm) {
+                  chunk.push_back({kBlue, 1, {point[0], point[1], point[2],
+                                              point[0]+normal[0]*normlen,
+                                              point[1]+normal[1]*normlen,
+                                              point[2]+normal[2]*normlen}});
+               }
+               ipoint = 0;
+               iseg = -1;
+            }
+            if (vis2) {
+               // create new segment
+               iseg = chunk.size();
+               chunk.push_back({endnode->GetVolume()->GetLineColor(), 0, {point[0], point[1], point[2], 0, 0, 0}});
+               ipoint++;
+               if (check_norm && !random) {
+                  chunk.push_back({kBlue, 2, {point[0], point[1], point[2],
+                                              point[0]+normal[0]*normlen,
+                                              point[1]+normal[1]*normlen,
+                                              point[2]+normal[2]*normlen}});
+               }
             }
-            pm->Add(line);
-            if (!random) pm->Add(normline);
          }
       }
+   };
+   ExecuteTasks(nchunks, traceRays);
+
+   for (auto &chunk : segments) {
+      for (auto &seg : chunk) {
+         line = new TPolyLine3D(2);
+         line->SetLineColor(seg.fColor);
+         if (seg.fWidth) line->SetLineWidth(seg.fWidth);
+         else i++;
+         line->SetPoint(0, seg.fPoints[0], seg.fPoints[1], seg.fPoints[2]);
+         line->SetPoint(1, seg.fPoints[3], seg.fPoints[4], seg.fPoints[5]);
+         pm->Add(line);
+      }
    }
    // draw all segments
    for (Int_t m=0; m<pm->GetEntriesFast(); m++) {
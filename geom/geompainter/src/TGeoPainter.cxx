@@ -16,6 +16,9 @@ using TBuffer3D mechanism.
 */
 
 #include <map>
+#include <atomic>
+#include <mutex>
+#include <vector>
 #include "TROOT.h"
 #include "TClass.h"
 #include "TColor.h"
@@ -230,6 +233,15 @@ void TGeoPainter::CheckOverlaps(const TGeoVolume *vol, Double_t ovlp, Option_t *
    fChecker->CheckOverlaps(vol, ovlp, option);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Check overlaps for a list of volumes, distributing them on the implicit MT
+/// pool (see TGeoChecker::CheckOverlapsMT).
+
+void TGeoPainter::CheckOverlapsMT(const TObjArray *volumes, Double_t ovlp, Option_t *option, TStopwatch *timer)
+{
+   fChecker->CheckOverlapsMT(volumes, ovlp, option, timer);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Check current point in the geometry.
 
@@ -1601,7 +1613,9 @@ void TGeoPainter::RandomRays(Int_t nrays, Double_t startx, Double_t starty, Doub
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Raytrace current drawn geometry
+/// Raytrace current drawn geometry. The pixels are traced in tiles of columns,
+/// in parallel on the implicit MT pool if enabled, each tile using the navigator
+/// of its thread; the image is drawn afterwards from the computed colors.
 
 void TGeoPainter::Raytrace(Option_t *)
 {
@@ -1614,7 +1628,7 @@ void TGeoPainter::Raytrace(Option_t *)
    if (!view->IsPerspective()) view->SetPerspective();
    gVirtualX->SetMarkerSize(1);
    gVirtualX->SetMarkerStyle(1);
-   Bool_t inclipst=kFALSE, inclip=kFALSE;
+   Bool_t inclipst=kFALSE;
    Double_t krad = TMath::DegToRad();
    Double_t lat = view->GetLatitude();
    Double_t longit = view->GetLongitude();
@@ -1641,7 +1655,7 @@ void TGeoPainter::Raytrace(Option_t *)
    Double_t dview = view->GetDview();
    Double_t dproj = view->GetDproj();
    Double_t local[3] = {0,0,1};
-   Double_t dir[3], normal[3];
+   Double_t dir[3];
    LocalToMasterVect(local,dir);
    Double_t min[3], max[3];
    view->GetRange(min, max);
@@ -1649,158 +1663,185 @@ void TGeoPainter::Raytrace(Option_t *)
    for (Int_t i=0; i<3; i++) cov[i] = 0.5*(min[i]+max[i]);
    Double_t cop[3];
    for (Int_t i=0; i<3; i++) cop[i] = cov[i] - dir[i]*dview;
-   fGeoManager->InitTrack(cop, dir);
-   Bool_t outside = fGeoManager->IsOutside();
-   fGeoManager->DoBackupState();
-   if (fClippingShape) inclipst = inclip = fClippingShape->Contains(cop);
-   Int_t px, py;
-   Double_t xloc, yloc, modloc;
    Int_t pxmin,pxmax, pymin,pymax;
    pxmin = gPad->UtoAbsPixel(0);
    pxmax = gPad->UtoAbsPixel(1);
    pymin = gPad->VtoAbsPixel(1);
    pymax = gPad->VtoAbsPixel(0);
-   TGeoNode *next = nullptr;
-   TGeoNode *nextnode = nullptr;
-   Double_t step,steptot;
-   Double_t *norm;
-   const Double_t *point = fGeoManager->GetCurrentPoint();
-   Double_t *ppoint = (Double_t*)point;
+   Int_t npx = TMath::Max(pxmax-pxmin, 0);
+   Int_t npy = TMath::Max(pymax-pymin, 0);
+   // Pad coordinates are computed upfront, tracking tasks do not touch the pad
+   std::vector<Double_t> xlocs(npx), ylocs(npy);
+   Int_t px, py;
+   for (px=pxmin; px<pxmax; px++) xlocs[px-pxmin] = gPad->AbsPixeltoX(pxmin+pxmax-px)*du-u0;
+   for (py=pymin; py<pymax; py++) ylocs[py-pymin] = gPad->AbsPixeltoY(pymin+pymax-py)*dv-v0;
    Double_t tosource[3];
-   Double_t calf;
    Double_t phi = 45.*krad;
    tosource[0] = -dir[0]*TMath::Cos(phi)+dir[1]*TMath::Sin(phi);
    tosource[1] = -dir[0]*TMath::Sin(phi)-dir[1]*TMath::Cos(phi);
    tosource[2] = -dir[2];
-
-   Bool_t done;
-//   Int_t istep;
-   Int_t base_color, color;
-   Double_t light;
-   Double_t stemin=0, stemax=TGeoShape::Big();
-   TPoint *pxy = new TPoint[1];
-   TGeoVolume *nextvol;
-   Int_t up;
+   Double_t dir0[3] = {dir[0], dir[1], dir[2]};
+   if (fClippingShape) inclipst = fClippingShape->Contains(cop);
+
+   // Base color (-1 if nothing visible was hit) and light of each pixel
+   std::vector<Int_t> pixcolor(npx*npy, -1);
+   std::vector<Float_t> pixlight(npx*npy, 0.);
+   const Int_t kTileSize = 16;  // pixel columns traced by one task
+   Int_t ntiles = (npx+kTileSize-1)/kTileSize;
    Int_t ntotal = pxmax*pymax;
-   Int_t nrays = 0;
+   std::atomic<Int_t> nrays(0);
+   std::mutex progressMutex;
    TStopwatch *timer = new TStopwatch();
    timer->Start();
-   for (px=pxmin; px<pxmax; px++) {
-      for (py=pymin; py<pymax; py++) {
-         if ((nrays%100)==0) OpProgress("Raytracing",nrays,ntotal,timer,kFALSE);
-         nrays++;
-         base_color = 1;
-         steptot = 0;
-         inclip = inclipst;
-         xloc = gPad->AbsPixeltoX(pxmin+pxmax-px);
-         xloc = xloc*du-u0;
-         yloc = gPad->AbsPixeltoY(pymin+pymax-py);
-         yloc = yloc*dv-v0;
-         modloc = TMath::Sqrt(xloc*xloc+yloc*yloc+dproj*dproj);
-         local[0] = xloc/modloc;
-         local[1] = yloc/modloc;
-         local[2] = dproj/modloc;
-         LocalToMasterVect(local,dir);
-         fGeoManager->DoRestoreState();
-         fGeoManager->SetOutside(outside);
-         fGeoManager->SetCurrentPoint(cop);
-         fGeoManager->SetCurrentDirection(dir);
-//         fGeoManager->InitTrack(cop,dir);
-         // current ray pointing to pixel (px,py)
-         done = kFALSE;
-         norm = 0;
-         // propagate to the clipping shape if any
-         if (fClippingShape) {
-            if (inclip) {
-               stemin = fClippingShape->DistFromInside(cop,dir,3);
-               stemax = TGeoShape::Big();
-            } else {
-               stemax = fClippingShape->DistFromOutside(cop,dir,3);
-               stemin = 0;
-            }
-         }
 
-         while (!done) {
+   auto traceTile = [&](UInt_t itile) {
+      TGeoNavigator *nav = fGeoManager->GetCurrentNavigator();
+      Double_t ldir[3], llocal[3], normal[3];
+      memcpy(ldir, dir0, 3*sizeof(Double_t));
+      nav->InitTrack(cop, ldir);
+      Bool_t outside = nav->IsOutside();
+      nav->DoBackupState();
+      Bool_t inclip = kFALSE;
+      Double_t modloc;
+      TGeoNode *next = nullptr;
+      TGeoNode *nextnode = nullptr;
+      Double_t step,steptot;
+      Double_t *norm;
+      const Double_t *point = nav->GetCurrentPoint();
+      Double_t *ppoint = (Double_t*)point;
+      Double_t calf;
+      Bool_t done;
+      Int_t base_color;
+      Double_t stemin=0, stemax=TGeoShape::Big();
+      TGeoVolume *nextvol;
+      Int_t up;
+      Int_t ixmax = TMath::Min((Int_t)(itile+1)*kTileSize, npx);
+      for (Int_t ix=itile*kTileSize; ix<ixmax; ix++) {
+         for (Int_t iy=0; iy<npy; iy++) {
+            Int_t iray = nrays++;
+            if ((iray%100)==0) {
+               std::lock_guard<std::mutex> lock(progressMutex);
+               OpProgress("Raytracing",iray,ntotal,timer,kFALSE);
+            }
+            base_color = 1;
+            steptot = 0;
+            inclip = inclipst;
+            modloc = TMath::Sqrt(xlocs[ix]*xlocs[ix]+ylocs[iy]*ylocs[iy]+dproj*dproj);
+            llocal[0] = xlocs[ix]/modloc;
+            llocal[1] = ylocs[iy]/modloc;
+            llocal[2] = dproj/modloc;
+            LocalToMasterVect(llocal,ldir);
+            nav->DoRestoreState();
+            nav->SetOutside(outside);
+            nav->SetCurrentPoint(cop);
+            nav->SetCurrentDirection(ldir);
+            // current ray pointing to pixel (px,py)
+            done = kFALSE;
+            norm = 0;
+            // propagate to the clipping shape if any
             if (fClippingShape) {
-               if (stemin>1E10) break;
-               if (stemin>0) {
-                  // we are inside clipping shape
-                  fGeoManager->SetStep(stemin);
-                  next = fGeoManager->Step();
-                  steptot = 0;
+               if (inclip) {
+                  stemin = fClippingShape->DistFromInside(cop,ldir,3);
+                  stemax = TGeoShape::Big();
+               } else {
+                  stemax = fClippingShape->DistFromOutside(cop,ldir,3);
                   stemin = 0;
-                  up = 0;
-                  while (next) {
-                     // we found something after clipping region
-                     nextvol = next->GetVolume();
-                     if (nextvol->TestAttBit(TGeoAtt::kVisOnScreen)) {
-                        done = kTRUE;
-                        base_color = nextvol->GetLineColor();
-                        fClippingShape->ComputeNormal(ppoint, dir, normal);
-                        norm = normal;
-                        break;
+               }
+            }
+
+            while (!done) {
+               if (fClippingShape) {
+                  if (stemin>1E10) break;
+                  if (stemin>0) {
+                     // we are inside clipping shape
+                     nav->SetStep(stemin);
+                     next = nav->Step();
+                     steptot = 0;
+                     stemin = 0;
+                     up = 0;
+                     while (next) {
+                        // we found something after clipping region
+                        nextvol = next->GetVolume();
+                        if (nextvol->TestAttBit(TGeoAtt::kVisOnScreen)) {
+                           done = kTRUE;
+                           base_color = nextvol->GetLineColor();
+                           fClippingShape->ComputeNormal(ppoint, ldir, normal);
+                           norm = normal;
+                           break;
+                        }
+                        up++;
+                        next = nav->GetMother(up);
                      }
-                     up++;
-                     next = fGeoManager->GetMother(up);
-                  }
-                  if (done) break;
-                  inclip = fClippingShape->Contains(ppoint);
-                  fGeoManager->SetStep(1E-3);
-                  while (inclip) {
-                     fGeoManager->Step();
+                     if (done) break;
                      inclip = fClippingShape->Contains(ppoint);
+                     nav->SetStep(1E-3);
+                     while (inclip) {
+                        nav->Step();
+                        inclip = fClippingShape->Contains(ppoint);
+                     }
+                     stemax = fClippingShape->DistFromOutside(ppoint,ldir,3);
                   }
-                  stemax = fClippingShape->DistFromOutside(ppoint,dir,3);
                }
-            }
-            nextnode = fGeoManager->FindNextBoundaryAndStep();
-            step = fGeoManager->GetStep();
-            if (step>1E10) break;
-            steptot += step;
-            next = nextnode;
-            // Check the step
-            if (fClippingShape) {
-               if (steptot>stemax) {
-                  steptot = 0;
-                  inclip = fClippingShape->Contains(ppoint);
-                  if (inclip) {
-                     stemin = fClippingShape->DistFromInside(ppoint,dir,3);
-                     stemax = TGeoShape::Big();
-                     continue;
-                  } else {
-                     stemin = 0;
-                     stemax = fClippingShape->DistFromOutside(ppoint,dir,3);
+               nextnode = nav->FindNextBoundaryAndStep();
+               step = nav->GetStep();
+               if (step>1E10) break;
+               steptot += step;
+               next = nextnode;
+               // Check the step
+               if (fClippingShape) {
+                  if (steptot>stemax) {
+                     steptot = 0;
+                     inclip = fClippingShape->Contains(ppoint);
+                     if (inclip) {
+                        stemin = fClippingShape->DistFromInside(ppoint,ldir,3);
+                        stemax = TGeoShape::Big();
+                        continue;
+                     } else {
+                        stemin = 0;
+                        stemax = fClippingShape->DistFromOutside(ppoint,ldir,3);
+                     }
                   }
                }
+               // Check if next node is visible
+               if (!nextnode) continue;
+               nextvol = nextnode->GetVolume();
+               if (nextvol->TestAttBit(TGeoAtt::kVisOnScreen)) {
+                  done = kTRUE;
+                  base_color = nextvol->GetLineColor();
+                  next = nextnode;
+                  break;
+               }
             }
-            // Check if next node is visible
-            if (!nextnode) continue;
-            nextvol = nextnode->GetVolume();
-            if (nextvol->TestAttBit(TGeoAtt::kVisOnScreen)) {
-               done = kTRUE;
-               base_color = nextvol->GetLineColor();
-               next = nextnode;
-               break;
+            if (!done) continue;
+            // current ray intersect a visible volume having color=base_color
+            if (rtMode > 0) {
+               nav->MasterToLocal(nav->GetCurrentPoint(), llocal);
+               nav->MasterToLocalVect(nav->GetCurrentDirection(), ldir);
+               for (Int_t i=0; i<3; ++i) llocal[i] += 1.E-8*ldir[i];
+               step = next->GetVolume()->GetShape()->DistFromInside(llocal,ldir,3);
+               for (Int_t i=0; i<3; ++i) llocal[i] += step*ldir[i];
+               next->GetVolume()->GetShape()->ComputeNormal(llocal, ldir, normal);
+               norm = normal;
+            } else {
+               if (!norm) norm = nav->FindNormalFast();
+               if (!norm) continue;
             }
+            calf = norm[0]*tosource[0]+norm[1]*tosource[1]+norm[2]*tosource[2];
+            pixcolor[ix*npy+iy] = base_color;
+            pixlight[ix*npy+iy] = TMath::Abs(calf);
          }
-         if (!done) continue;
-         // current ray intersect a visible volume having color=base_color
-         if (rtMode > 0) {
-            fGeoManager->MasterToLocal(gGeoManager->GetCurrentPoint(), local);
-            fGeoManager->MasterToLocalVect(gGeoManager->GetCurrentDirection(), dir);
-            for (Int_t i=0; i<3; ++i) local[i] += 1.E-8*dir[i];
-            step = next->GetVolume()->GetShape()->DistFromInside(local,dir,3);
-            for (Int_t i=0; i<3; ++i) local[i] += step*dir[i];
-            next->GetVolume()->GetShape()->ComputeNormal(local, dir, normal);
-            norm = normal;
-         } else {
-            if (!norm) norm = fGeoManager->FindNormalFast();
-            if (!norm) continue;
-         }
-         calf = norm[0]*tosource[0]+norm[1]*tosource[1]+norm[2]*tosource[2];
-         light = TMath::Abs(calf);
-         color = GetColor(base_color, light);
-         // Now we know the color of the pixel, just draw it
+      }
+   };
+   fChecker->ExecuteTasks(ntiles, traceTile);
+
+   // Now we know the color of the pixels, just draw them
+   Int_t color;
+   TPoint *pxy = new TPoint[1];
+   for (px=pxmin; px<pxmax; px++) {
+      for (py=pymin; py<pymax; py++) {
+         Int_t ipix = (px-pxmin)*npy+py-pymin;
+         if (pixcolor[ipix] < 0) continue;
+         color = GetColor(pixcolor[ipix], pixlight[ipix]);
          gVirtualX->SetMarkerColor(color);
          pxy[0].fX = px;
          pxy[0].fY = py;
@@ -1809,7 +1850,7 @@ void TGeoPainter::Raytrace(Option_t *)
    }
    delete [] pxy;
    timer->Stop();
-   fChecker->OpProgress("Raytracing",nrays,ntotal,timer,kTRUE);
+   fChecker->OpProgress("Raytracing",nrays.load(),ntotal,timer,kTRUE);
    delete timer;
 }
 
@@ -0,0 +1,328 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_THistConcurrentFill
+#define ROOT_THistConcurrentFill
+
+#include "TH1.h"
+#include "TH2.h"
+#include "TH3.h"
+#include "TProfile.h"
+#include "TProfile2D.h"
+#include "TProfile3D.h"
+
+#include <algorithm>
+#include <mutex>
+#include <type_traits>
+
+namespace ROOT {
+
+template <class HIST, unsigned int SIZE>
+class THistConcurrentFillManager;
+
+namespace Internal {
+
+/// Number of coordinates of a fill of HIST.
+template <class HIST>
+struct THistFillDim {
+   static constexpr int value = std::is_base_of<TH3, HIST>::value ? 3 : (std::is_base_of<TH2, HIST>::value ? 2 : 1);
+};
+
+/// Number of entries whose bins are found at once by THistFillFixedN.
+constexpr Int_t kFillBlock = 1024;
+
+/// Whether the bins of the first ndim axes of h can be found without modifying h, concurrently with the filling
+/// of other entries: the axes cannot be extended, entries are not buffered by h, and no axis range restricts the
+/// statistics.
+inline bool THistHasFixedBins(TH1 &h, int ndim)
+{
+   if (h.GetBuffer())
+      return false;
+   TAxis *axes[] = {h.GetXaxis(), h.GetYaxis(), h.GetZaxis()};
+   for (int d = 0; d < ndim; ++d) {
+      if ((axes[d]->CanExtend() && !axes[d]->IsAlphanumeric()) || axes[d]->TestBit(TAxis::kAxisRange))
+         return false;
+   }
+   return true;
+}
+
+/// Find the global bins of n entries of a histogram with fixed bins (see THistHasFixedBins), and add their
+/// statistics to stats, ordered as in TH1::GetStats. Does not modify h.
+template <int NDIM>
+void THistFindBins(const TH1 &h, Int_t n, const Double_t *const *x, const Double_t *w, Int_t *bins, Double_t *stats)
+{
+   const TAxis *axes[] = {h.GetXaxis(), h.GetYaxis(), h.GetZaxis()};
+   Int_t axisBins[NDIM][kFillBlock];
+   Int_t nbins[NDIM];
+   for (int d = 0; d < NDIM; ++d) {
+      axes[d]->FindFixBinN(n, x[d], axisBins[d]);
+      nbins[d] = axes[d]->GetNbins();
+   }
+   const bool statOverflows = h.GetStatOverflows() == TH1::kNeutral ? TH1::GetDefaultStatOverflows()
+                                                                    : h.GetStatOverflows() == TH1::kConsider;
+   for (Int_t i = 0; i < n; ++i) {
+      Int_t bin = 0;
+      bool inRange = true;
+      for (int d = NDIM - 1; d >= 0; --d) {
+         bin = bin * (nbins[d] + 2) + axisBins[d][i];
+         inRange &= axisBins[d][i] > 0 && axisBins[d][i] <= nbins[d];
+      }
+      bins[i] = bin;
+      // as in TH1::Fill, TH2::Fill and TH3::Fill
+      if (!inRange && !statOverflows)
+         continue;
+      const Double_t ww = w ? w[i] : 1.;
+      stats[0] += ww;
+      stats[1] += ww * ww;
+      stats[2] += ww * x[0][i];
+      stats[3] += ww * x[0][i] * x[0][i];
+      if (NDIM > 1) {
+         stats[4] += ww * x[1][i];
+         stats[5] += ww * x[1][i] * x[1][i];
+         stats[6] += ww * x[0][i] * x[1][i];
+      }
+      if (NDIM > 2) {
+         stats[7] += ww * x[2][i];
+         stats[8] += ww * x[2][i] * x[2][i];
+         stats[9] += ww * x[0][i] * x[2][i];
+         stats[10] += ww * x[1][i] * x[2][i];
+      }
+   }
+}
+
+/// Add n entries whose bins and statistics were found by THistFindBins to h.
+inline void THistAddBins(TH1 &h, Int_t n, const Int_t *bins, const Double_t *w, const Double_t *stats)
+{
+   if (w && !h.GetSumw2N() && !h.TestBit(TH1::kIsNotW) &&
+       std::any_of(w, w + n, [](Double_t ww) { return ww != 1.; }))
+      h.Sumw2(); // must be called before AddBinContent
+   // before adding the bin contents, from which the statistics can be computed
+   Double_t hstats[TH1::kNstat] = {};
+   h.GetStats(hstats);
+   TArrayD &sumw2 = *h.GetSumw2();
+   for (Int_t i = 0; i < n; ++i) {
+      const Double_t ww = w ? w[i] : 1.;
+      if (sumw2.fN)
+         sumw2.fArray[bins[i]] += ww * ww;
+      h.AddBinContent(bins[i], ww);
+   }
+   for (Int_t k = 0; k < TH1::kNstat; ++k)
+      hstats[k] += stats[k];
+   h.PutStats(hstats);
+   h.SetEntries(h.GetEntries() + n);
+}
+
+/// Fill n entries into a histogram with fixed bins, by blocks.
+template <int NDIM>
+void THistFillFixedN(TH1 &h, Int_t n, const Double_t *const *x, const Double_t *w)
+{
+   Int_t bins[kFillBlock];
+   for (Int_t first = 0; first < n; first += kFillBlock) {
+      const Int_t nblock = std::min(kFillBlock, n - first);
+      const Double_t *xs[NDIM];
+      for (int d = 0; d < NDIM; ++d)
+         xs[d] = x[d] + first;
+      const Double_t *ws = w ? w + first : nullptr;
+      Double_t stats[TH1::kNstat] = {};
+      THistFindBins<NDIM>(h, nblock, xs, ws, bins, stats);
+      THistAddBins(h, nblock, bins, ws, stats);
+   }
+}
+
+inline void THistFillN(TH1 &h, Int_t n, const Double_t *const *x, const Double_t *w, std::integral_constant<int, 1>)
+{
+   h.FillN(n, x[0], w);
+}
+
+inline void THistFillN(TH1 &h, Int_t n, const Double_t *const *x, const Double_t *w, std::integral_constant<int, 2>)
+{
+   static_cast<TH2 &>(h).FillN(n, x[0], x[1], w);
+}
+
+/// TH3 has no FillN: the bins are found by blocks when the axes cannot be extended.
+inline void THistFillN(TH1 &h, Int_t n, const Double_t *const *x, const Double_t *w, std::integral_constant<int, 3>)
+{
+   if (THistHasFixedBins(h, 3)) {
+      THistFillFixedN<3>(h, n, x, w);
+      return;
+   }
+   TH3 &h3 = static_cast<TH3 &>(h);
+   for (Int_t i = 0; i < n; ++i)
+      h3.Fill(x[0][i], x[1][i], x[2][i], w ? w[i] : 1.);
+}
+
+} // namespace Internal
+
+/**
+ \class ROOT::THistConcurrentFiller
+ Buffers the Fill() calls of one thread and submits them by blocks of SIZE
+ entries to the THistConcurrentFillManager it was created from.
+
+ The filler is not thread-safe: each thread must use its own filler. The
+ histogram is only updated when the buffer is full, when Flush() is called
+ and when the filler is destroyed.
+ **/
+
+template <class HIST, unsigned int SIZE = 1024>
+class THistConcurrentFiller {
+public:
+   static constexpr int kNDim = Internal::THistFillDim<HIST>::value;
+   using Manager_t = THistConcurrentFillManager<HIST, SIZE>;
+
+private:
+   Manager_t *fManager;          ///< Manager receiving the buffered entries
+   Double_t fCoords[kNDim][SIZE]; ///< Buffered coordinates, one array per axis
+   Double_t fWeights[SIZE];       ///< Buffered weights
+   unsigned int fSize = 0;        ///< Number of buffered entries
+   bool fWeighted = false;        ///< Whether a buffered weight differs from 1
+
+public:
+   explicit THistConcurrentFiller(Manager_t &manager) : fManager(&manager) {}
+
+   THistConcurrentFiller(const THistConcurrentFiller &) = delete;
+   THistConcurrentFiller &operator=(const THistConcurrentFiller &) = delete;
+
+   THistConcurrentFiller(THistConcurrentFiller &&other) noexcept
+      : fManager(other.fManager), fSize(other.fSize), fWeighted(other.fWeighted)
+   {
+      for (int d = 0; d < kNDim; ++d)
+         std::copy(other.fCoords[d], other.fCoords[d] + fSize, fCoords[d]);
+      std::copy(other.fWeights, other.fWeights + fSize, fWeights);
+      other.fSize = 0;
+   }
+
+   ~THistConcurrentFiller() { Flush(); }
+
+   /// Buffer one entry: kNDim coordinates, optionally followed by a weight.
+   template <typename... Args>
+   void Fill(Args... args)
+   {
+      static_assert(sizeof...(Args) == kNDim || sizeof...(Args) == kNDim + 1,
+                    "Fill() needs one value per axis and optionally a weight");
+      const Double_t vals[] = {static_cast<Double_t>(args)...};
+      for (int d = 0; d < kNDim; ++d)
+         fCoords[d][fSize] = vals[d];
+      if (sizeof...(Args) > kNDim) {
+         fWeights[fSize] = vals[sizeof...(Args) - 1];
+         fWeighted |= (vals[sizeof...(Args) - 1] != 1.);
+      } else {
+         fWeights[fSize] = 1.;
+      }
+      if (++fSize == SIZE)
+         Flush();
+   }
+
+   /// Submit the buffered entries to the histogram.
+   void Flush()
+   {
+      if (!fSize)
+         return;
+      const Double_t *coords[kNDim];
+      for (int d = 0; d < kNDim; ++d)
+         coords[d] = fCoords[d];
+      fManager->FillN(fSize, coords, fWeighted ? fWeights : nullptr);
+      fSize = 0;
+      fWeighted = false;
+   }
+
+   HIST &GetHist() { return fManager->GetHist(); }
+};
+
+/**
+ \class ROOT::THistConcurrentFillManager
+ Lets several threads fill the same TH1, TH2 or TH3 without one clone of the
+ histogram per thread.
+
+ Each thread gets a THistConcurrentFiller from MakeFiller(). The fillers
+ buffer the entries and submit them by blocks. When the axes cannot be
+ extended, the bins and the statistics of a block are computed by the
+ submitting thread with the vectorized TAxis::FindFixBinN(), concurrently with
+ the other threads, and only the additions to the bin contents are serialized.
+ Otherwise, e.g. for axes that can be extended, the whole block is filled
+ under the lock.
+
+ The histogram must not be modified otherwise while fillers are in use.
+
+ ~~~{.cpp}
+ TH2D h("h", "h", 100, 0, 1, 100, 0, 1);
+ ROOT::THistConcurrentFillManager<TH2D> manager(h);
+ auto work = [&]() {
+    auto filler = manager.MakeFiller();
+    for (int i = 0; i < 1000000; ++i)
+       filler.Fill(gen(), gen());
+ }; // the remaining entries are flushed when the filler goes out of scope
+ ~~~
+
+ Profiles are not supported, since their fill signature is not the one of
+ the histogram they derive from.
+ **/
+
+template <class HIST, unsigned int SIZE = 1024>
+class THistConcurrentFillManager {
+   static_assert(std::is_base_of<TH1, HIST>::value, "THistConcurrentFillManager needs a TH1-derived histogram");
+   static_assert(!std::is_base_of<TProfile, HIST>::value && !std::is_base_of<TProfile2D, HIST>::value &&
+                    !std::is_base_of<TProfile3D, HIST>::value,
+                 "Profiles cannot be filled through THistConcurrentFillManager");
+
+public:
+   using Hist_t = HIST;
+   using Filler_t = THistConcurrentFiller<HIST, SIZE>;
+
+private:
+   HIST &fHist;
+   const bool fFixedBins; ///< Whether the bins can be found outside of the lock
+   std::mutex fFillMutex;
+
+public:
+   explicit THistConcurrentFillManager(HIST &hist)
+      : fHist(hist), fFixedBins(Internal::THistHasFixedBins(hist, Filler_t::kNDim))
+   {
+   }
+
+   Filler_t MakeFiller() { return Filler_t(*this); }
+
+   HIST &GetHist() { return fHist; }
+
+   /// Fill n entries, x[d] being the array of coordinates on axis d. If w is
+   /// null all weights are 1. Can be called concurrently.
+   void FillN(Int_t n, const Double_t *const *x, const Double_t *w)
+   {
+      constexpr int kNDim = Filler_t::kNDim;
+      if (!fFixedBins) {
+         std::lock_guard<std::mutex> lock(fFillMutex);
+         Internal::THistFillN(fHist, n, x, w, std::integral_constant<int, kNDim>());
+         return;
+      }
+      Int_t bins[Internal::kFillBlock];
+      for (Int_t first = 0; first < n; first += Internal::kFillBlock) {
+         const Int_t nblock = std::min(Internal::kFillBlock, n - first);
+         const Double_t *xs[kNDim];
+         for (int d = 0; d < kNDim; ++d)
+            xs[d] = x[d] + first;
+         const Double_t *ws = w ? w + first : nullptr;
+         Double_t stats[TH1::kNstat] = {};
+         Internal::THistFindBins<kNDim>(fHist, nblock, xs, ws, bins, stats);
+         std::lock_guard<std::mutex> lock(fFillMutex);
+         Internal::THistAddBins(fHist, nblock, bins, ws, stats);
+      }
+   }
+
+   /// Copy the current content of the histogram into target. Can be called
+   /// concurrently with FillN(); entries still buffered by fillers are not seen.
+   void Copy(HIST &target)
+   {
+      std::lock_guard<std::mutex> lock(fFillMutex);
+      fHist.Copy(target);
+   }
+};
+
+} // namespace ROOT
+
+#endif
@@ -0,0 +1,77 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_THnSparseConcurrentFill
+#define ROOT_THnSparseConcurrentFill
+
+#include "RtypesCore.h"
+
+#include <memory>
+#include <mutex>
+
+class THnSparse;
+
+namespace ROOT {
+
+namespace Internal {
+class THnSparseFillBuffer;
+}
+
+/**
+ \class ROOT::THnSparseConcurrentFillManager
+ Lets several threads fill the same THnSparse, each through its own
+ THnSparseConcurrentFiller. Only the merges of the fillers' bins into the
+ histogram are serialized. See the section "Concurrent Filling" of THnSparse.
+ **/
+
+class THnSparseConcurrentFillManager {
+private:
+   THnSparse &fHist;
+   std::mutex fMergeMutex;
+
+public:
+   explicit THnSparseConcurrentFillManager(THnSparse &hist) : fHist(hist) {}
+
+   THnSparse &GetHist() { return fHist; }
+
+   /// Add the bins and statistics accumulated in buffer to the histogram and
+   /// clear buffer. Can be called concurrently.
+   void Merge(Internal::THnSparseFillBuffer &buffer);
+};
+
+/**
+ \class ROOT::THnSparseConcurrentFiller
+ Fills a THnSparse on behalf of one thread. The weights are summed per bin in
+ a table owned by the filler, which holds at most maxBins distinct bins; it is
+ merged into the histogram when it is full, when Flush() is called and when
+ the filler is destroyed.
+
+ The filler is not thread-safe: each thread must use its own filler.
+ **/
+
+class THnSparseConcurrentFiller {
+private:
+   THnSparseConcurrentFillManager *fManager;
+   std::unique_ptr<Internal::THnSparseFillBuffer> fBuffer;
+
+public:
+   explicit THnSparseConcurrentFiller(THnSparseConcurrentFillManager &manager, Int_t maxBins = 8192);
+   THnSparseConcurrentFiller(const THnSparseConcurrentFiller &) = delete;
+   THnSparseConcurrentFiller &operator=(const THnSparseConcurrentFiller &) = delete;
+   THnSparseConcurrentFiller(THnSparseConcurrentFiller &&other);
+   ~THnSparseConcurrentFiller();
+
+   void Fill(const Double_t *x, Double_t w = 1.);
+   void Flush();
+};
+
+} // namespace ROOT
+
+#endif
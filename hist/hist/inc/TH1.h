@@ -271,6 +271,7 @@ public:
    virtual Double_t GetBinWithContent(Double_t c, Int_t &binx, Int_t firstx=0, Int_t lastx=0,Double_t maxdiff=0) const;
    virtual void     GetCenter(Double_t *center) const;
    static  Bool_t   GetDefaultSumw2();
+   static  Bool_t   GetDefaultStatOverflows();
    TDirectory      *GetDirectory() const {return fDirectory;}
    virtual Double_t GetEntries() const;
    virtual Double_t GetEffectiveEntries() const;
@@ -22,6 +22,9 @@
 
 #include "TH2.h"
 
+#include <atomic>
+#include <vector>
+
 class TH2PolyBin: public TObject{
 
 public:
@@ -142,7 +145,8 @@ protected:
 
 protected:
     enum {
-      kNOverflow       = 9  //  number of overflows bins
+      kNOverflow       = 9,   //  number of overflows bins
+      kMaxIndexCells   = 1024 //  maximum number of cells per axis of the bin index
    };
    TList   *fBins;              //List of bins. The list owns the contained objects
    Double_t fOverflow[kNOverflow];       //Overflow bins
@@ -156,8 +160,20 @@ protected:
    Bool_t   fFloat;             //When set to kTRUE, allows the histogram to expand if a bin outside the limits is added.
    Bool_t   fNewBinAdded;       //!For the 3D Painter
    Bool_t   fBinContentChanged; //!For the 3D Painter
+   std::atomic<Bool_t> fIndexValid; //!True when the bin index is up to date with the bins
+   Int_t    fIndexNx, fIndexNy; //!Number of cells of the bin index in x and y
+   Double_t fIndexInvStepX;     //!Inverse width of a cell of the bin index
+   Double_t fIndexInvStepY;     //!Inverse height of a cell of the bin index
+   std::vector<Int_t>       fIndexOffsets;  //!Offset of the candidates of each index cell
+   std::vector<Int_t>       fIndexEntries;  //!Candidate bins of each cell, -1-i if bin i covers the cell
+   std::vector<Double_t>    fIndexBoxes;    //!Bounding box (xmin, xmax, ymin, ymax) of each bin
+   std::vector<TH2PolyBin*> fIndexBins;     //!Bins by index
 
    void   AddBinToPartition(TH2PolyBin *bin);  // Adds the input bin into the partition matrix
+   void   BuildIndex();                        // Builds the bin index used by FindBin() and Fill()
+   void   UpdateIndex();                       // Builds the bin index once if it is not up to date
+   Int_t  GetIndexCell(Double_t x, Double_t y) const;
+   TH2PolyBin *LocateBin(Int_t cell, Double_t x, Double_t y) const;
    void   Initialize(Double_t xlow, Double_t xup, Double_t ylow, Double_t yup, Int_t n, Int_t m);
    Bool_t IsIntersecting(TH2PolyBin *bin, Double_t xclipl, Double_t xclipr, Double_t yclipb, Double_t yclipt);
    Bool_t IsIntersectingPolygon(Int_t bn, Double_t *x, Double_t *y, Double_t xclipl, Double_t xclipr, Double_t yclipb, Double_t yclipt);
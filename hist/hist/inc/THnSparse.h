@@ -21,7 +21,6 @@
 
 
 #include "THnBase.h"
-#include "TExMap.h"
 #include "THnSparse_Internal.h"
 
 // needed only for template instantiations of THnSparseT:
@@ -32,14 +31,18 @@
 #include "TArrayC.h"
 
 class THnSparseCompactBinCoord;
+class THnSparseBinIndex;
+
+namespace ROOT {
+class THnSparseConcurrentFillManager;
+}
 
 class THnSparse: public THnBase {
  private:
    Int_t      fChunkSize;    // number of entries for each chunk
    Long64_t   fFilledBins;   // number of filled bins
    TObjArray  fBinContent;   // array of THnSparseArrayChunk
-   TExMap     fBins;         //! filled bins
-   TExMap     fBinsContinued;//! filled bins for non-unique hashes, containing pairs of (bin index 0, bin index 1)
+   THnSparseBinIndex *fBinIndex; //! open addressing hash table of the filled bins
    THnSparseCompactBinCoord *fCompactCoord; //! compact coordinate
 
    THnSparse(const THnSparse&); // Not implemented
@@ -60,6 +63,7 @@ class THnSparse: public THnBase {
    void FillExMap();
    virtual TArray* GenerateArray() const = 0;
    Long64_t GetBinIndexForCurrentBin(Bool_t allocate);
+   Long64_t GetBinIndexForBuffer(const Char_t* buf, ULong64_t hash, Bool_t allocate);
 
    /// Increment the bin content of "bin" by "w",
    /// return the bin index.
@@ -70,6 +74,8 @@ class THnSparse: public THnBase {
    }
    void InitStorage(Int_t* nbins, Int_t chunkSize);
 
+   friend class ROOT::THnSparseConcurrentFillManager;
+
  public:
    virtual ~THnSparse();
 
@@ -420,6 +420,32 @@ Int_t TAxis::FindFixBin(Double_t x) const
    return bin;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Find the bin numbers of n abscissas x[0], x[stride], ..., x[(n-1)*stride]
+/// and store them in bins[0..n-1].
+///
+/// Identical to calling TAxis::FindFixBin for each value. For fixed size bins
+/// the loop has no branches and can be vectorized by the compiler.
+
+void TAxis::FindFixBinN(Int_t n, const Double_t *x, Int_t *bins, Int_t stride) const
+{
+   if (fXbins.fN) {
+      for (Int_t i = 0; i < n; i++) bins[i] = FindFixBin(x[i*stride]);
+      return;
+   }
+   const Double_t xmin = fXmin;
+   const Double_t xmax = fXmax;
+   const Int_t nbins = fNbins;
+   for (Int_t i = 0; i < n; i++) {
+      Double_t xi = x[i*stride];
+      Bool_t inside = (xi >= xmin) && (xi < xmax);
+      // use an in-range value for the conversion to avoid integer overflows
+      Double_t xc = inside ? xi : xmin;
+      Int_t bin = 1 + int (nbins*(xc-xmin)/(xmax-xmin));
+      bins[i] = inside ? bin : ((xi < xmin) ? 0 : nbins+1);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return label for bin
 
@@ -3393,6 +3393,35 @@ void TH1::DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stri
    fEntries += ntimes;
    Double_t ww = 1;
    Int_t nbins   = fXaxis.GetNbins();
+
+   // If the axis cannot be extended, the bins do not change while filling:
+   // find them by blocks with the vectorized TAxis::FindFixBinN
+   if (!fXaxis.CanExtend() || fXaxis.IsAlphanumeric()) {
+      const Int_t kBlock = 256;
+      Int_t bins[kBlock];
+      for (Int_t first=0;first<ntimes;first+=kBlock) {
+         Int_t nblock = TMath::Min(kBlock, ntimes-first);
+         fXaxis.FindFixBinN(nblock, &x[first*stride], bins, stride);
+         for (Int_t k=0;k<nblock;k++) {
+            i = (first+k)*stride;
+            bin = bins[k];
+            if (w) ww = w[i];
+            if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+            if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+            AddBinContent(bin, ww);
+            if (bin == 0 || bin > nbins) {
+               if (!GetStatOverflowsBehaviour()) continue;
+            }
+            Double_t z= ww;
+            fTsumw   += z;
+            fTsumw2  += z*z;
+            fTsumwx  += z*x[i];
+            fTsumwx2 += z*x[i]*x[i];
+         }
+      }
+      return;
+   }
+
    ntimes *= stride;
    for (i=0;i<ntimes;i+=stride) {
       bin =fXaxis.FindBin(x[i]);
@@ -4273,6 +4302,15 @@ Bool_t TH1::GetDefaultSumw2()
    return fgDefaultSumw2;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if the underflows and overflows are used in the statistics of the histograms
+/// whose own behaviour is TH1::kNeutral, see TH1::StatOverflows.
+
+Bool_t TH1::GetDefaultStatOverflows()
+{
+   return fgStatOverflows;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the current number of entries.
 
@@ -552,6 +552,47 @@ void TH2::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double
    }
 
    Double_t ww = 1;
+
+   // If the axes cannot be extended, the bins do not change while filling:
+   // find them by blocks with the vectorized TAxis::FindFixBinN
+   if ((!fXaxis.CanExtend() || fXaxis.IsAlphanumeric()) && (!fYaxis.CanExtend() || fYaxis.IsAlphanumeric())) {
+      const Int_t kBlock = 256;
+      Int_t binsx[kBlock], binsy[kBlock];
+      const Int_t nx = fXaxis.GetNbins();
+      const Int_t ny = fYaxis.GetNbins();
+      for (Int_t first=ifirst;first<ntimes;first+=kBlock*stride) {
+         Int_t nblock = TMath::Min(kBlock, (ntimes-first+stride-1)/stride);
+         fXaxis.FindFixBinN(nblock, &x[first], binsx, stride);
+         fYaxis.FindFixBinN(nblock, &y[first], binsy, stride);
+         for (Int_t k=0;k<nblock;k++) {
+            i = first + k*stride;
+            fEntries++;
+            binx = binsx[k];
+            biny = binsy[k];
+            bin  = biny*(nx+2) + binx;
+            if (w) ww = w[i];
+            if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+            if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+            AddBinContent(bin,ww);
+            if (binx == 0 || binx > nx) {
+               if (!GetStatOverflowsBehaviour()) continue;
+            }
+            if (biny == 0 || biny > ny) {
+               if (!GetStatOverflowsBehaviour()) continue;
+            }
+            Double_t z= ww;
+            fTsumw   += z;
+            fTsumw2  += z*z;
+            fTsumwx  += z*x[i];
+            fTsumwx2 += z*x[i]*x[i];
+            fTsumwy  += z*y[i];
+            fTsumwy2 += z*y[i]*y[i];
+            fTsumwxy += z*x[i]*y[i];
+         }
+      }
+      return;
+   }
+
    for (i=ifirst;i<ntimes;i+=stride) {
       fEntries++;
       binx = fXaxis.FindBin(x[i]);
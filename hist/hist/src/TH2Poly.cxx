@@ -16,6 +16,7 @@
 #include "TClass.h"
 #include "TList.h"
 #include "TMath.h"
+#include "TVirtualMutex.h"
 #include <cassert>
 
 ClassImp(TH2Poly);
@@ -139,6 +140,24 @@ filling, it also adds a constant time delay into the code. When `Fill()`
 is to be called many times, it is more efficient to divide the histogram into
 a large number cells. However, if the histogram is to be filled only a few
 times, it is better to divide into a small number of cells.
+
+## Bin Index
+For histograms with many bins (e.g. detector maps with 10^5 irregular
+bins) the coarse partition still leaves hundreds of candidates per cell.
+`FindBin()`, `Fill()` and `FillN()` therefore use an index built once from
+the partition rules, on the first lookup after bins were added. The index
+uses a finer grid, with about one cell per bin (at least the partition
+size, at most 1024 cells per axis), stores for each cell the candidate bins
+in a flat array, and marks the cells completely covered by a bin so that
+`IsInside()` is not called for them. Candidates are also rejected on their
+bounding box before `IsInside()` is called. Since candidates keep the bin
+order, the bin returned for a point is the same as with the partition.
+The index is built under the ROOT lock, so that `FindBin()` can be called
+from several threads once the bins are defined.
+
+`FillN()` classifies the whole array of coordinates into overflow regions
+and index cells in a first pass over the input, then fills the bins and
+accumulates the statistics in local variables.
 */
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -399,6 +418,9 @@ void TH2Poly::AddBinToPartition(TH2PolyBin *bin)
    Double_t xclipl, xclipr, yclipb, yclipt; // x and y coordinates of a cell
    Double_t binXmax, binXmin, binYmax, binYmin; // The max/min bin coordinates
 
+   // The bin index is rebuilt at the next lookup
+   fIndexValid = kFALSE;
+
    binXmax = bin->GetXMax();
    binXmin = bin->GetXMin();
    binYmax = bin->GetYMax();
@@ -468,6 +490,7 @@ void TH2Poly::ChangePartition(Int_t n, Int_t m)
 {
    fCellX = n;                          // Set the number of cells
    fCellY = m;                          // Set the number of cells
+   fIndexValid = kFALSE;                // The bin index depends on the partition
 
    delete [] fCells;                    // Deletes the old partition
 
@@ -499,6 +522,148 @@ void TH2Poly::ChangePartition(Int_t n, Int_t m)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Builds the bin index used by FindBin(), Fill() and FillN().
+/// The index is a grid finer than the partition, with about one cell per
+/// bin. Each bin is classified against the cells overlapping its bounding box
+/// with the same rules as in AddBinToPartition(). The candidates of a cell are
+/// stored in bin order and the list stops at the first bin covering the cell
+/// completely, since no later bin can be returned for a point of that cell.
+
+void TH2Poly::BuildIndex()
+{
+   Int_t nbins = fNcells - kNOverflow;
+   Double_t xmin = fXaxis.GetXmin();
+   Double_t ymin = fYaxis.GetXmin();
+   Double_t width  = fXaxis.GetXmax() - xmin;
+   Double_t height = fYaxis.GetXmax() - ymin;
+
+   Int_t ncell = TMath::Min((Int_t)kMaxIndexCells, (Int_t)TMath::Sqrt((Double_t)nbins) + 1);
+   fIndexNx = TMath::Max(fCellX, ncell);
+   fIndexNy = TMath::Max(fCellY, ncell);
+   Double_t stepx = width/fIndexNx;
+   Double_t stepy = height/fIndexNy;
+   fIndexInvStepX = (stepx > 0) ? 1./stepx : 0.;
+   fIndexInvStepY = (stepy > 0) ? 1./stepy : 0.;
+
+   fIndexBins.assign(nbins, (TH2PolyBin*)0);
+   fIndexBoxes.assign(4*nbins, 0.);
+   Int_t nindex = fIndexNx*fIndexNy;
+   std::vector<Int_t> cellOf;   // index cell of each (cell, candidate) pair
+   std::vector<Int_t> entryOf;  // candidate of each pair
+   std::vector<Int_t> covered(nindex, 0); // cells already covered by a bin
+
+   Double_t xclipl, xclipr, yclipb, yclipt;
+   TIter next(fBins);
+   TObject *obj;
+   Int_t ibin = 0;
+   while ((obj = next())) {
+      TH2PolyBin *bin = (TH2PolyBin*) obj;
+      fIndexBins[ibin] = bin;
+      Double_t binXmin = bin->GetXMin();
+      Double_t binXmax = bin->GetXMax();
+      Double_t binYmin = bin->GetYMin();
+      Double_t binYmax = bin->GetYMax();
+      fIndexBoxes[4*ibin]   = binXmin;
+      fIndexBoxes[4*ibin+1] = binXmax;
+      fIndexBoxes[4*ibin+2] = binYmin;
+      fIndexBoxes[4*ibin+3] = binYmax;
+
+      Int_t nl = (Int_t)(floor((binXmin - xmin)*fIndexInvStepX));
+      Int_t nr = (Int_t)(floor((binXmax - xmin)*fIndexInvStepX));
+      Int_t mb = (Int_t)(floor((binYmin - ymin)*fIndexInvStepY));
+      Int_t mt = (Int_t)(floor((binYmax - ymin)*fIndexInvStepY));
+      if (nr>=fIndexNx) nr = fIndexNx-1;
+      if (mt>=fIndexNy) mt = fIndexNy-1;
+      if (nl<0)         nl = 0;
+      if (mb<0)         mb = 0;
+
+      for (Int_t i = nl; i <= nr; i++) {
+         xclipl = xmin + i*stepx;
+         xclipr = xclipl + stepx;
+         for (Int_t j = mb; j <= mt; j++) {
+            Int_t cell = i + j*fIndexNx;
+            // A previous bin covers the cell, this one is never returned there
+            if (covered[cell]) continue;
+            yclipb = ymin + j*stepy;
+            yclipt = yclipb + stepy;
+            Int_t entry = ibin;
+            if ((binXmin >= xclipl) && (binXmax <= xclipr) &&
+                (binYmax <= yclipt) && (binYmin >= yclipb)) {
+               // bin completely inside the cell
+            } else if (IsIntersecting(bin, xclipl, xclipr, yclipb, yclipt)) {
+               // bin crossing the cell boundaries
+            } else if (bin->IsInside(xclipl,yclipb) || bin->IsInside(xclipl,yclipt) ||
+                       bin->IsInside(xclipr,yclipb) || bin->IsInside(xclipr,yclipt)) {
+               // no intersection and a corner inside: the cell is inside the bin
+               entry = -1-ibin;
+               covered[cell] = 1;
+            } else {
+               continue;
+            }
+            cellOf.push_back(cell);
+            entryOf.push_back(entry);
+         }
+      }
+      ibin++;
+   }
+
+   // Group the candidates by cell, keeping the bin order inside each cell
+   fIndexOffsets.assign(nindex+1, 0);
+   for (UInt_t k = 0; k < cellOf.size(); k++) fIndexOffsets[cellOf[k]+1]++;
+   for (Int_t c = 0; c < nindex; c++) fIndexOffsets[c+1] += fIndexOffsets[c];
+   fIndexEntries.resize(entryOf.size());
+   std::vector<Int_t> fill(fIndexOffsets.begin(), fIndexOffsets.end()-1);
+   for (UInt_t k = 0; k < cellOf.size(); k++) fIndexEntries[fill[cellOf[k]]++] = entryOf[k];
+
+   fIndexValid.store(kTRUE, std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Builds the bin index if the bins or the partition changed since it was
+/// last built. FindBin() may be called from several threads: the first one
+/// builds the index under the ROOT lock, the others wait for it and then only
+/// read the index.
+
+void TH2Poly::UpdateIndex()
+{
+   if (fIndexValid.load(std::memory_order_acquire)) return;
+   R__LOCKGUARD(gROOTMutex);
+   if (!fIndexValid.load(std::memory_order_relaxed)) BuildIndex();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the cell of the bin index containing the point (x,y), which must
+/// be inside the histogram limits.
+
+Int_t TH2Poly::GetIndexCell(Double_t x, Double_t y) const
+{
+   Int_t n = (Int_t)((x-fXaxis.GetXmin())*fIndexInvStepX);
+   Int_t m = (Int_t)((y-fYaxis.GetXmin())*fIndexInvStepY);
+   if (n>=fIndexNx) n = fIndexNx-1;
+   if (m>=fIndexNy) m = fIndexNy-1;
+   if (n<0)         n = 0;
+   if (m<0)         m = 0;
+   return n + fIndexNx*m;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the first bin of the given index cell containing the point (x,y),
+/// 0 if the point is in the sea.
+
+TH2PolyBin *TH2Poly::LocateBin(Int_t cell, Double_t x, Double_t y) const
+{
+   const Int_t last = fIndexOffsets[cell+1];
+   for (Int_t k = fIndexOffsets[cell]; k < last; k++) {
+      Int_t entry = fIndexEntries[k];
+      if (entry < 0) return fIndexBins[-1-entry];
+      const Double_t *box = &fIndexBoxes[4*entry];
+      if (x < box[0] || x > box[1] || y < box[2] || y > box[3]) continue;
+      if (fIndexBins[entry]->IsInside(x,y)) return fIndexBins[entry];
+   }
+   return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Make a complete copy of the underlying object.  If 'newname' is set,
 /// the copy's name will be set to that name.
@@ -581,29 +746,12 @@ Int_t TH2Poly::FindBin(Double_t x, Double_t y, Double_t)
    if      (x > fXaxis.GetXmax()) overflow += -2;
    else if (x > fXaxis.GetXmin()) overflow += -1;
    if (overflow != -5) return overflow;
+   if (fNcells <= kNOverflow) return -5;
 
-   // Finds the cell (x,y) coordinates belong to
-   Int_t n = (Int_t)(floor((x-fXaxis.GetXmin())/fStepX));
-   Int_t m = (Int_t)(floor((y-fYaxis.GetXmin())/fStepY));
-
-   // Make sure the array indices are correct.
-   if (n>=fCellX) n = fCellX-1;
-   if (m>=fCellY) m = fCellY-1;
-   if (n<0)       n = 0;
-   if (m<0)       m = 0;
-
-   if (fIsEmpty[n+fCellX*m]) return -5;
-
-   TH2PolyBin *bin;
-
-   TIter next(&fCells[n+fCellX*m]);
-   TObject *obj;
-
-   // Search for the bin in the cell
-   while ((obj=next())) {
-      bin  = (TH2PolyBin*)obj;
-      if (bin->IsInside(x,y)) return bin->GetBinNumber();
-   }
+   // Search for the bin in the index cell (x,y) coordinates belong to
+   UpdateIndex();
+   TH2PolyBin *bin = LocateBin(GetIndexCell(x, y), x, y);
+   if (bin) return bin->GetBinNumber();
 
    // If the search has not returned a bin, the point must be on "the sea"
    return -5;
@@ -648,52 +796,30 @@ Int_t TH2Poly::Fill(Double_t x, Double_t y, Double_t w)
       return overflow;
    }
 
-   // Finds the cell (x,y) coordinates belong to
-   Int_t n = (Int_t)(floor((x-fXaxis.GetXmin())/fStepX));
-   Int_t m = (Int_t)(floor((y-fYaxis.GetXmin())/fStepY));
-
-   // Make sure the array indices are correct.
-   if (n>=fCellX) n = fCellX-1;
-   if (m>=fCellY) m = fCellY-1;
-   if (n<0)       n = 0;
-   if (m<0)       m = 0;
-
-   if (fIsEmpty[n+fCellX*m]) {
-      fOverflow[4]+= w;
-      if (fSumw2.fN) fSumw2.fArray[4] += w*w;
-      return -5;
-   }
-
-   TH2PolyBin *bin;
-   Int_t bi;
-
-   TIter next(&fCells[n+fCellX*m]);
-   TObject *obj;
-
-   while ((obj=next())) {
-      bin  = (TH2PolyBin*)obj;
-      // needs to account offset in array for overflow bins
-      bi = bin->GetBinNumber()-1+kNOverflow;
-      if (bin->IsInside(x,y)) {
-         bin->Fill(w);
-
-         // Statistics
-         fTsumw   = fTsumw + w;
-         fTsumw2  = fTsumw2 + w*w;
-         fTsumwx  = fTsumwx + w*x;
-         fTsumwx2 = fTsumwx2 + w*x*x;
-         fTsumwy  = fTsumwy + w*y;
-         fTsumwy2 = fTsumwy2 + w*y*y;
-         if (fSumw2.fN) {
-            assert(bi < fSumw2.fN);
-            fSumw2.fArray[bi] += w*w;
-         }
-         fEntries++;
+   // Search for the bin in the index cell (x,y) coordinates belong to
+   UpdateIndex();
+   TH2PolyBin *bin = LocateBin(GetIndexCell(x, y), x, y);
+   if (bin) {
+      bin->Fill(w);
+
+      // Statistics
+      fTsumw   = fTsumw + w;
+      fTsumw2  = fTsumw2 + w*w;
+      fTsumwx  = fTsumwx + w*x;
+      fTsumwx2 = fTsumwx2 + w*x*x;
+      fTsumwy  = fTsumwy + w*y;
+      fTsumwy2 = fTsumwy2 + w*y*y;
+      if (fSumw2.fN) {
+         // needs to account offset in array for overflow bins
+         Int_t bi = bin->GetBinNumber()-1+kNOverflow;
+         assert(bi < fSumw2.fN);
+         fSumw2.fArray[bi] += w*w;
+      }
+      fEntries++;
 
-         SetBinContentChanged(kTRUE);
+      SetBinContentChanged(kTRUE);
 
-         return bin->GetBinNumber();
-      }
+      return bin->GetBinNumber();
    }
 
    fOverflow[4]+= w;
@@ -732,14 +858,97 @@ Int_t TH2Poly::Fill(const char* name, Double_t w)
 ///                      (array size must be ntimes*stride)
 /// \param [in] x:       array of x values to be histogrammed
 /// \param [in] y:       array of y values to be histogrammed
-/// \param [in] w:       array of weights
+/// \param [in] w:       array of weights, if 0 all weights are 1
 /// \param [in] stride:  step size through arrays x, y and w
+///
+/// The entries are processed in blocks: the overflow region and the index
+/// cell of each entry of a block are computed in a first loop without
+/// branches, then the bins are located and filled. The result is the same
+/// as calling Fill() for each entry.
 
 void TH2Poly::FillN(Int_t ntimes, const Double_t* x, const Double_t* y,
                                const Double_t* w, Int_t stride)
 {
-   for (int i = 0; i < ntimes; i += stride) {
-      Fill(x[i], y[i], w[i]);
+   if (fNcells <= kNOverflow) return;
+   if (stride < 1) stride = 1;
+
+   // create sum of weight square array if weights are different than 1
+   if (w && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+      for (Int_t i = 0; i < ntimes; i += stride) {
+         if (w[i] != 1.0) {
+            Sumw2();
+            break;
+         }
+      }
+   }
+   UpdateIndex();
+
+   const Double_t xmin = fXaxis.GetXmin();
+   const Double_t xmax = fXaxis.GetXmax();
+   const Double_t ymin = fYaxis.GetXmin();
+   const Double_t ymax = fYaxis.GetXmax();
+   const Double_t invstepx = fIndexInvStepX;
+   const Double_t invstepy = fIndexInvStepY;
+   const Int_t nx = fIndexNx;
+   const Int_t ny = fIndexNy;
+   Double_t *sumw2 = fSumw2.fN ? fSumw2.fArray : 0;
+
+   const Int_t kBlock = 256;
+   Double_t bx[kBlock], by[kBlock], bw[kBlock];
+   Int_t region[kBlock], cell[kBlock];
+
+   Double_t tsumw = 0, tsumw2 = 0, tsumwx = 0, tsumwx2 = 0, tsumwy = 0, tsumwy2 = 0;
+   Double_t entries = 0;
+
+   Int_t i = 0;
+   while (i < ntimes) {
+      Int_t nblock = 0;
+      for (; i < ntimes && nblock < kBlock; i += stride, nblock++) {
+         bx[nblock] = x[i];
+         by[nblock] = y[i];
+         bw[nblock] = w ? w[i] : 1.;
+      }
+      // Overflow region (-5 for the histogram range) and index cell of each entry
+      for (Int_t k = 0; k < nblock; k++) {
+         Int_t col = (bx[k] > xmin) + (bx[k] > xmax);
+         Int_t row = 2 - (by[k] > ymin) - (by[k] > ymax);
+         region[k] = -1 - col - 3*row;
+         Int_t n = (Int_t)((bx[k]-xmin)*invstepx);
+         Int_t m = (Int_t)((by[k]-ymin)*invstepy);
+         n = (n < 0) ? 0 : ((n >= nx) ? nx-1 : n);
+         m = (m < 0) ? 0 : ((m >= ny) ? ny-1 : m);
+         cell[k] = n + nx*m;
+      }
+      for (Int_t k = 0; k < nblock; k++) {
+         Double_t wk = bw[k];
+         TH2PolyBin *bin = (region[k] == -5) ? LocateBin(cell[k], bx[k], by[k]) : 0;
+         if (!bin) {
+            Int_t ov = -region[k] - 1;
+            fOverflow[ov] += wk;
+            if (sumw2) sumw2[ov] += wk*wk;
+            continue;
+         }
+         bin->Fill(wk);
+         if (sumw2) sumw2[bin->GetBinNumber()-1+kNOverflow] += wk*wk;
+         tsumw   += wk;
+         tsumw2  += wk*wk;
+         tsumwx  += wk*bx[k];
+         tsumwx2 += wk*bx[k]*bx[k];
+         tsumwy  += wk*by[k];
+         tsumwy2 += wk*by[k]*by[k];
+         entries++;
+      }
+   }
+
+   if (entries > 0) {
+      fTsumw   += tsumw;
+      fTsumw2  += tsumw2;
+      fTsumwx  += tsumwx;
+      fTsumwx2 += tsumwx2;
+      fTsumwy  += tsumwy;
+      fTsumwy2 += tsumwy2;
+      fEntries += entries;
+      SetBinContentChanged(kTRUE);
    }
 }
 
@@ -1051,6 +1260,11 @@ void TH2Poly::Initialize(Double_t xlow, Double_t xup,
    // 3D Painter flags
    SetNewBinAdded(kFALSE);
    SetBinContentChanged(kFALSE);
+
+   // Bin index, built at the first lookup
+   fIndexValid = kFALSE;
+   fIndexNx = fIndexNy = 0;
+   fIndexInvStepX = fIndexInvStepY = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
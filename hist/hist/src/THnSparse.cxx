@@ -10,6 +10,7 @@
  *************************************************************************/
 
 #include "THnSparse.h"
+#include "ROOT/THnSparseConcurrentFill.hxx"
 
 #include "TAxis.h"
 #include "TBuffer.h"
@@ -17,6 +18,10 @@
 #include "TDataMember.h"
 #include "TDataType.h"
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 namespace {
 //______________________________________________________________________________
 //
@@ -170,7 +175,7 @@ THnSparseCoordCompression::THnSparseCoordCompression(const THnSparseCoordCompres
    fNdimensions = other.fNdimensions;
    fCoordBufferSize = other.fCoordBufferSize;
    fBitOffsets = new Int_t[fNdimensions + 1];
-   memcpy(fBitOffsets, other.fBitOffsets, sizeof(Int_t) * fNdimensions);
+   memcpy(fBitOffsets, other.fBitOffsets, sizeof(Int_t) * (fNdimensions + 1));
 }
 
 
@@ -185,7 +190,7 @@ THnSparseCoordCompression& THnSparseCoordCompression::operator=(const THnSparseC
    fCoordBufferSize = other.fCoordBufferSize;
    delete [] fBitOffsets;
    fBitOffsets = new Int_t[fNdimensions + 1];
-   memcpy(fBitOffsets, other.fBitOffsets, sizeof(Int_t) * fNdimensions);
+   memcpy(fBitOffsets, other.fBitOffsets, sizeof(Int_t) * (fNdimensions + 1));
    return *this;
 }
 
@@ -319,9 +324,9 @@ ULong64_t THnSparseCoordCompression::GetHashFromBuffer(const Char_t* buf) const
 {
    // Bins are addressed in two different modes, depending
    // on whether the compact bin index fits into a Long64_t or not.
-   // If it does, we can use it as a "perfect hash" for the TExMap.
-   // If not we build a hash from the compact bin index, and use that
-   // as the TExMap's hash.
+   // If it does, we can use it as a "perfect hash" for THnSparseBinIndex.
+   // If not we build a hash from the compact bin index (FNV-1a), and use
+   // that as the THnSparseBinIndex's hash.
 
    if (fCoordBufferSize <= 8) {
       // fits into a Long64_t
@@ -331,11 +336,12 @@ ULong64_t THnSparseCoordCompression::GetHashFromBuffer(const Char_t* buf) const
    }
 
    // else: doesn't fit into a Long64_t:
-   ULong64_t hash = 5381;
-   const Char_t* str = buf;
-   while (str - buf < fCoordBufferSize) {
-      hash *= 5;
-      hash += *(str++);
+   ULong64_t hash = 14695981039346656037ULL;
+   const UChar_t* str = (const UChar_t*) buf;
+   const UChar_t* end = str + fCoordBufferSize;
+   while (str < end) {
+      hash ^= *(str++);
+      hash *= 1099511628211ULL;
    }
    return hash;
 }
@@ -410,6 +416,98 @@ THnSparseCompactBinCoord::~THnSparseCompactBinCoord()
    delete [] fCurrentBin;
 }
 
+/** \class THnSparseBinIndex
+THnSparseBinIndex is used internally by THnSparse to find the linear index
+of a filled bin from the hash of its compact coordinates. It is a flat open
+addressing hash table with linear probing: each slot holds the hash and the
+linear index of one bin, so that a lookup usually touches a single cache
+line, and bins with identical hashes simply occupy further slots.
+*/
+
+class THnSparseBinIndex {
+public:
+   struct Slot_t {
+      ULong64_t fHash;  // hash of the compact bin coordinates
+      Long64_t  fIndex; // linear bin index + 1; 0 for an empty slot
+   };
+
+   THnSparseBinIndex(): fSlots(0), fMask(0), fSize(0) {}
+   ~THnSparseBinIndex() { delete [] fSlots; }
+
+   void      Clear() { delete [] fSlots; fSlots = 0; fMask = 0; fSize = 0; }
+   Long64_t  GetCapacity() const { return fSlots ? (Long64_t) fMask + 1 : 0; }
+   Long64_t  GetSize() const { return fSize; }
+   /// Return the first slot to probe for hash; the table must not be empty.
+   ULong64_t GetFirstSlot(ULong64_t hash) const { return Mix(hash) & fMask; }
+   ULong64_t GetNextSlot(ULong64_t slot) const { return (slot + 1) & fMask; }
+   const Slot_t& GetSlot(ULong64_t slot) const { return fSlots[slot]; }
+   void      Insert(ULong64_t hash, Long64_t linidx);
+   void      Reserve(Long64_t nbins);
+
+   /// Spread the bits of the hash over the slot number: compact coordinates
+   /// that fit into a Long64_t are their own hash and differ in few bits.
+   static ULong64_t Mix(ULong64_t h) {
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      h *= 0xc4ceb9fe1a85ec53ULL;
+      h ^= h >> 33;
+      return h;
+   }
+
+private:
+   // intentionally not implemented
+   THnSparseBinIndex(const THnSparseBinIndex&);
+   // intentionally not implemented
+   THnSparseBinIndex& operator=(const THnSparseBinIndex&);
+
+   Slot_t   *fSlots; // [fMask + 1] slots
+   ULong64_t fMask;  // number of slots - 1; the number of slots is a power of 2
+   Long64_t  fSize;  // number of filled slots
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the bin with linear index linidx and hash "hash".
+/// The bin must not be in the table yet.
+
+void THnSparseBinIndex::Insert(ULong64_t hash, Long64_t linidx)
+{
+   Reserve(fSize + 1);
+   ULong64_t slot = GetFirstSlot(hash);
+   while (fSlots[slot].fIndex)
+      slot = GetNextSlot(slot);
+   fSlots[slot].fHash = hash;
+   fSlots[slot].fIndex = linidx + 1;
+   ++fSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Make room for nbins bins, keeping the table at most half full.
+
+void THnSparseBinIndex::Reserve(Long64_t nbins)
+{
+   const Long64_t capacity = GetCapacity();
+   if (2 * nbins <= capacity)
+      return;
+   Long64_t newCapacity = capacity ? capacity : 16;
+   while (newCapacity < 2 * nbins)
+      newCapacity *= 2;
+
+   Slot_t *oldSlots = fSlots;
+   fSlots = new Slot_t[newCapacity];
+   memset(fSlots, 0, newCapacity * sizeof(Slot_t));
+   fMask = newCapacity - 1;
+   for (Long64_t i = 0; i < capacity; ++i) {
+      if (!oldSlots[i].fIndex)
+         continue;
+      ULong64_t slot = GetFirstSlot(oldSlots[i].fHash);
+      while (fSlots[slot].fIndex)
+         slot = GetNextSlot(slot);
+      fSlots[slot] = oldSlots[i];
+   }
+   delete [] oldSlots;
+}
+
 /** \class THnSparseArrayChunk
 THnSparseArrayChunk is used internally by THnSparse.
 THnSparse stores its (dynamic size) array of bin coordinates and their
@@ -571,14 +669,31 @@ Translation from an n-dimensional bin coordinate to the linear index within
 the chunks is done by GetBin(). It creates a hash from the compacted bin
 coordinates (the hash of a bin coordinate is the compacted coordinate itself
 if it takes less than 8 bytes, the size of a Long64_t.
-This hash is used to lookup the linear index in the TExMap member fBins;
-the coordinates of the entry fBins points to is compared to the coordinates
-passed to GetBin(). If they do not match, these two coordinates have the same
-hash - which is extremely unlikely but (for the case where the compact bin
-coordinates are larger than 4 bytes) possible. In this case, fBinsContinued
-contains a chain of linear indexes with the same hash. Iterating through this
-chain and comparing each bin coordinates with the one passed to GetBin() will
-retrieve the matching bin.
+This hash is used to lookup the linear index in the open addressing hash
+table fBinIndex (see THnSparseBinIndex), which stores the hash next to the
+linear index of each bin. For each slot with the same hash, the coordinates
+of the bin are compared to the coordinates passed to GetBin(). They can only
+differ when the compact bin coordinates are larger than 8 bytes, in which
+case two different coordinates can have the same hash; the probing then
+continues with the next slot until the matching bin or an empty slot is found.
+
+## Concurrent Filling
+A THnSparse cannot be filled from several threads. Instead, each thread can
+fill through its own ROOT::THnSparseConcurrentFiller, obtained from a
+ROOT::THnSparseConcurrentFillManager. The filler accumulates the weights per
+bin in a small table of its own, and merges them into the histogram when
+that table is full, so the histogram is locked once per many fills:
+
+    THnSparseD hs("hs", "hs", 8, bins, xmin, xmax);
+    ROOT::THnSparseConcurrentFillManager manager(hs);
+    auto work = [&]() {
+       ROOT::THnSparseConcurrentFiller filler(manager);
+       for (...)
+          filler.Fill(x, w);
+    }; // remaining bins are merged when the filler goes out of scope
+
+The filler does not extend axes: coordinates outside of the axis range end up
+in the underflow and overflow bins.
 */
 
 
@@ -588,7 +703,7 @@ ClassImp(THnSparse);
 /// Construct an empty THnSparse.
 
 THnSparse::THnSparse():
-   fChunkSize(1024), fFilledBins(0), fCompactCoord(0)
+   fChunkSize(1024), fFilledBins(0), fBinIndex(new THnSparseBinIndex), fCompactCoord(0)
 {
    fBinContent.SetOwner();
 }
@@ -605,7 +720,7 @@ THnSparse::THnSparse(const char* name, const char* title, Int_t dim,
                      const Int_t* nbins, const Double_t* xmin, const Double_t* xmax,
                      Int_t chunksize):
    THnBase(name, title, dim, nbins, xmin, xmax),
-   fChunkSize(chunksize), fFilledBins(0), fCompactCoord(0)
+   fChunkSize(chunksize), fFilledBins(0), fBinIndex(new THnSparseBinIndex), fCompactCoord(0)
 {
    fCompactCoord = new THnSparseCompactBinCoord(dim, nbins);
    fBinContent.SetOwner();
@@ -615,6 +730,7 @@ THnSparse::THnSparse(const char* name, const char* title, Int_t dim,
 /// Destruct a THnSparse
 
 THnSparse::~THnSparse() {
+   delete fBinIndex;
    delete fCompactCoord;
 }
 
@@ -651,36 +767,23 @@ void THnSparse::InitStorage(Int_t* nbins, Int_t chunkSize)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-///We have been streamed; set up fBins
+///We have been streamed; set up fBinIndex
 
 void THnSparse::FillExMap()
 {
    TIter iChunk(&fBinContent);
    THnSparseArrayChunk* chunk = 0;
-   THnSparseCoordCompression compactCoord(*GetCompactCoord());
+   const THnSparseCompactBinCoord* compactCoord = GetCompactCoord();
    Long64_t idx = 0;
-   if (2 * GetNbins() > fBins.Capacity())
-      fBins.Expand(3 * GetNbins());
+   fBinIndex->Clear();
+   fBinIndex->Reserve(GetNbins());
    while ((chunk = (THnSparseArrayChunk*) iChunk())) {
       const Int_t chunkSize = chunk->GetEntries();
       Char_t* buf = chunk->fCoordinates;
       const Int_t singleCoordSize = chunk->fSingleCoordinateSize;
       const Char_t* endbuf = buf + singleCoordSize * chunkSize;
-      for (; buf < endbuf; buf += singleCoordSize, ++idx) {
-         Long64_t hash = compactCoord.GetHashFromBuffer(buf);
-         Long64_t linidx = fBins.GetValue(hash);
-         if (linidx) {
-            Long64_t nextidx = linidx;
-            while (nextidx) {
-               // must be a collision, so go to fBinsContinued.
-               linidx = nextidx;
-               nextidx = fBinsContinued.GetValue(linidx);
-            }
-            fBinsContinued.Add(linidx, idx + 1);
-         } else {
-            fBins.Add(hash, idx + 1);
-         }
-      }
+      for (; buf < endbuf; buf += singleCoordSize, ++idx)
+         fBinIndex->Insert(compactCoord->GetHashFromBuffer(buf), idx);
    }
 }
 
@@ -688,12 +791,10 @@ void THnSparse::FillExMap()
 /// Initialize storage for nbins
 
 void THnSparse::Reserve(Long64_t nbins) {
-   if (!fBins.GetSize() && fBinContent.GetSize()) {
+   if (!fBinIndex->GetSize() && GetNbins()) {
       FillExMap();
    }
-   if (2 * nbins > fBins.Capacity()) {
-      fBins.Expand(3 * nbins);
-   }
+   fBinIndex->Reserve(nbins);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -790,20 +891,27 @@ Double_t THnSparse::GetBinError2(Long64_t linidx) const {
 Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
 {
    THnSparseCompactBinCoord* cc = GetCompactCoord();
-   ULong64_t hash = cc->GetHash();
-   if (fBinContent.GetSize() && !fBins.GetSize())
-      FillExMap();
-   Long64_t linidx = (Long64_t) fBins.GetValue(hash);
-   while (linidx) {
-      // fBins stores index + 1!
-      THnSparseArrayChunk* chunk = GetChunk((linidx - 1)/ fChunkSize);
-      if (chunk->Matches((linidx - 1) % fChunkSize, cc->GetBuffer()))
-         return linidx - 1; // we store idx+1, 0 is "TExMap: not found"
+   return GetBinIndexForBuffer(cc->GetBuffer(), cc->GetHash(), allocate);
+}
 
-      Long64_t nextlinidx = fBinsContinued.GetValue(linidx);
-      if (!nextlinidx) break;
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of the bin with compact coordinates buf and hash "hash".
+/// If it doesn't exist then return -1, or allocate a new bin if allocate is set
 
-      linidx = nextlinidx;
+Long64_t THnSparse::GetBinIndexForBuffer(const Char_t* buf, ULong64_t hash, Bool_t allocate)
+{
+   if (GetNbins() && !fBinIndex->GetSize())
+      FillExMap();
+   if (fBinIndex->GetSize()) {
+      ULong64_t slot = fBinIndex->GetFirstSlot(hash);
+      while (Long64_t linidx = fBinIndex->GetSlot(slot).fIndex) {
+         // fBinIndex stores index + 1, 0 is an empty slot
+         --linidx;
+         if (fBinIndex->GetSlot(slot).fHash == hash
+             && GetChunk(linidx / fChunkSize)->Matches(linidx % fChunkSize, buf))
+            return linidx;
+         slot = fBinIndex->GetNextSlot(slot);
+      }
    }
    if (!allocate) return -1;
 
@@ -816,20 +924,11 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
       chunk = AddChunk();
       newidx = 0;
    }
-   chunk->AddBin(newidx, cc->GetBuffer());
+   chunk->AddBin(newidx, buf);
 
    // store translation between hash and bin
    newidx += (fBinContent.GetEntriesFast() - 1) * fChunkSize;
-   if (!linidx) {
-      // fBins didn't find it
-      if (2 * GetNbins() > fBins.Capacity())
-         fBins.Expand(3 * GetNbins());
-      fBins.Add(hash, newidx + 1);
-   } else {
-      // fBins contains one, but it's the wrong one;
-      // add entry to fBinsContinued.
-      fBinsContinued.Add(linidx, newidx + 1);
-   }
+   fBinIndex->Insert(hash, newidx);
    return newidx;
 }
 
@@ -881,7 +980,7 @@ Double_t THnSparse::GetSparseFractionMem() const {
 
    Double_t size = 0.;
    size += fBinContent.GetEntries() * (GetChunkSize() * sizePerChunkElement + sizeof(THnSparseArrayChunk));
-   size += + 3 * sizeof(Long64_t) * fBins.GetSize() /* TExMap */;
+   size += sizeof(THnSparseBinIndex::Slot_t) * fBinIndex->GetCapacity();
 
    Double_t nbinsTotal = 1.;
    for (Int_t d = 0; d < fNdimensions; ++d)
@@ -963,9 +1062,205 @@ void THnSparse::Sumw2()
 void THnSparse::Reset(Option_t *option /*= ""*/)
 {
    fFilledBins = 0;
-   fBins.Delete();
-   fBinsContinued.Clear();
+   fBinIndex->Clear();
    fBinContent.Delete();
    ResetBase(option);
 }
 
+/** \class ROOT::Internal::THnSparseFillBuffer
+THnSparseFillBuffer is used internally by ROOT::THnSparseConcurrentFiller.
+It sums the weights of the filled bins in a small open addressing hash
+table, keyed like THnSparse on the compact bin coordinates, together with
+the statistics of the fills.
+*/
+
+namespace ROOT {
+namespace Internal {
+
+class THnSparseFillBuffer {
+public:
+   THnSparseFillBuffer(THnSparse &hist, Int_t maxBins);
+
+   /// Add x with weight w; return whether the table is full.
+   Bool_t Fill(const Double_t *x, Double_t w);
+   void   Clear();
+   Int_t  GetNbins() const { return fHashes.size(); }
+
+   THnSparseCoordCompression fCompression; // compaction of the bin coordinates, as in the histogram
+   std::vector<TAxis*>     fAxes;      // axes of the histogram
+   std::vector<Int_t>      fCoord;     // bin coordinates of the current fill
+   std::vector<Char_t>     fCoordBuf;  // compact bin coordinates of the current fill
+   Int_t                   fMaxBins;   // number of bins after which the table must be merged
+   std::vector<Long64_t>   fSlots;     // hash table: index of the bin + 1, or 0 for an empty slot
+   std::vector<Char_t>     fBinCoords; // compact coordinates of the bins
+   std::vector<ULong64_t>  fHashes;    // hashes of the bins
+   std::vector<Double_t>   fSumw;      // sum of weights of the bins
+   std::vector<Double_t>   fSumw2;     // sum of squared weights of the bins
+   Double_t                fEntries;   // number of fills
+   Double_t                fTsumw;     // sum of weights
+   Double_t                fTsumw2;    // sum of squared weights
+   std::vector<Double_t>   fTsumwx;    // sum of weight*x per dimension
+   std::vector<Double_t>   fTsumwx2;   // sum of weight*x*x per dimension
+};
+
+namespace {
+THnSparseCoordCompression MakeCoordCompression(const THnSparse &hist)
+{
+   std::vector<Int_t> nbins(hist.GetNdimensions());
+   for (Int_t d = 0; d < hist.GetNdimensions(); ++d)
+      nbins[d] = hist.GetAxis(d)->GetNbins();
+   return THnSparseCoordCompression(hist.GetNdimensions(), nbins.data());
+}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a buffer for hist, holding at most maxBins bins.
+
+THnSparseFillBuffer::THnSparseFillBuffer(THnSparse &hist, Int_t maxBins):
+   fCompression(MakeCoordCompression(hist)), fAxes(hist.GetNdimensions()), fCoord(hist.GetNdimensions()),
+   fCoordBuf(std::max<Int_t>(fCompression.GetBufferSize(), sizeof(Long64_t))), fMaxBins(std::max(maxBins, 1)),
+   fEntries(0.), fTsumw(0.), fTsumw2(0.), fTsumwx(hist.GetNdimensions()), fTsumwx2(hist.GetNdimensions())
+{
+   for (Int_t d = 0; d < hist.GetNdimensions(); ++d)
+      fAxes[d] = hist.GetAxis(d);
+   size_t nslots = 16;
+   while (nslots < 2 * (size_t) fMaxBins)
+      nslots *= 2;
+   fSlots.resize(nslots);
+   fHashes.reserve(fMaxBins);
+   fSumw.reserve(fMaxBins);
+   fSumw2.reserve(fMaxBins);
+   fBinCoords.reserve((size_t) fMaxBins * fCompression.GetBufferSize());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add x with weight w to the bin table and the statistics.
+/// Return whether the table is full and must be merged.
+
+Bool_t THnSparseFillBuffer::Fill(const Double_t *x, Double_t w)
+{
+   const Int_t ndim = fAxes.size();
+   for (Int_t d = 0; d < ndim; ++d) {
+      fCoord[d] = fAxes[d]->FindFixBin(x[d]);
+      fTsumwx[d] += w * x[d];
+      fTsumwx2[d] += w * x[d] * x[d];
+   }
+   fEntries += 1;
+   fTsumw += w;
+   fTsumw2 += w * w;
+
+   const Int_t bufSize = fCompression.GetBufferSize();
+   const ULong64_t hash = fCompression.SetBufferFromCoord(fCoord.data(), fCoordBuf.data());
+   const size_t mask = fSlots.size() - 1;
+   size_t slot = THnSparseBinIndex::Mix(hash) & mask;
+   while (Long64_t idx = fSlots[slot]) {
+      --idx;
+      if (fHashes[idx] == hash
+          && (bufSize <= 8 || !memcmp(&fBinCoords[idx * bufSize], fCoordBuf.data(), bufSize))) {
+         fSumw[idx] += w;
+         fSumw2[idx] += w * w;
+         return kFALSE;
+      }
+      slot = (slot + 1) & mask;
+   }
+
+   fSlots[slot] = fHashes.size() + 1;
+   fHashes.push_back(hash);
+   fSumw.push_back(w);
+   fSumw2.push_back(w * w);
+   fBinCoords.insert(fBinCoords.end(), fCoordBuf.begin(), fCoordBuf.begin() + bufSize);
+   return GetNbins() >= fMaxBins;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove all bins and reset the statistics.
+
+void THnSparseFillBuffer::Clear()
+{
+   std::fill(fSlots.begin(), fSlots.end(), 0);
+   fBinCoords.clear();
+   fHashes.clear();
+   fSumw.clear();
+   fSumw2.clear();
+   fEntries = fTsumw = fTsumw2 = 0.;
+   std::fill(fTsumwx.begin(), fTsumwx.end(), 0.);
+   std::fill(fTsumwx2.begin(), fTsumwx2.end(), 0.);
+}
+
+} // namespace Internal
+} // namespace ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the bins and statistics accumulated in buffer to the histogram and
+/// clear buffer. Can be called concurrently.
+
+void ROOT::THnSparseConcurrentFillManager::Merge(Internal::THnSparseFillBuffer &buffer)
+{
+   if (!buffer.fEntries)
+      return;
+   {
+      std::lock_guard<std::mutex> lock(fMergeMutex);
+      THnSparse &h = fHist;
+      const Int_t bufSize = buffer.fCompression.GetBufferSize();
+      const Int_t nbins = buffer.GetNbins();
+      for (Int_t i = 0; i < nbins; ++i) {
+         Long64_t linidx = h.GetBinIndexForBuffer(&buffer.fBinCoords[i * bufSize], buffer.fHashes[i], kTRUE);
+         THnSparseArrayChunk* chunk = h.GetChunk(linidx / h.fChunkSize);
+         linidx %= h.fChunkSize;
+         chunk->fContent->SetAt(chunk->fContent->GetAt(linidx) + buffer.fSumw[i], linidx);
+         if (chunk->fSumw2)
+            chunk->fSumw2->fArray[linidx] += buffer.fSumw2[i];
+      }
+      h.fEntries += buffer.fEntries;
+      if (h.GetCalculateErrors()) {
+         h.fTsumw += buffer.fTsumw;
+         h.fTsumw2 += buffer.fTsumw2;
+         for (Int_t d = 0; d < h.fNdimensions; ++d) {
+            h.fTsumwx[d] += buffer.fTsumwx[d];
+            h.fTsumwx2[d] += buffer.fTsumwx2[d];
+         }
+      }
+      h.fIntegralStatus = THnSparse::kInvalidInt;
+   }
+   buffer.Clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a filler for the histogram of manager, summing at most maxBins
+/// distinct bins before merging them into the histogram.
+
+ROOT::THnSparseConcurrentFiller::THnSparseConcurrentFiller(THnSparseConcurrentFillManager &manager, Int_t maxBins):
+   fManager(&manager), fBuffer(new Internal::THnSparseFillBuffer(manager.GetHist(), maxBins))
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Move constructor.
+
+ROOT::THnSparseConcurrentFiller::THnSparseConcurrentFiller(THnSparseConcurrentFiller &&other) = default;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merge the remaining bins into the histogram.
+
+ROOT::THnSparseConcurrentFiller::~THnSparseConcurrentFiller()
+{
+   Flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the n-dimensional point x with weight w.
+
+void ROOT::THnSparseConcurrentFiller::Fill(const Double_t *x, Double_t w /*= 1.*/)
+{
+   if (fBuffer->Fill(x, w))
+      Flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merge the bins filled so far into the histogram.
+
+void ROOT::THnSparseConcurrentFiller::Flush()
+{
+   if (fBuffer)
+      fManager->Merge(*fBuffer);
+}
@@ -0,0 +1,118 @@
+// test TH2Poly bin lookup with many bins and FillN
+
+#include "gtest/gtest.h"
+
+#include "TH2Poly.h"
+#include "TList.h"
+#include "TMath.h"
+#include "TROOT.h"
+#include "TRandom3.h"
+
+#include <thread>
+#include <vector>
+
+// Honeycomb with rotated hexagons and a few overlapping squares on top
+TH2Poly *CreateLargeHist()
+{
+   TH2Poly *h2p = new TH2Poly("h2p", "many bins", 0, 100, 0, 100);
+   const Double_t a = 0.5;
+   const Double_t dx = a*TMath::Sqrt(3);
+   Double_t x[6], y[6];
+   for (Int_t j = 0; j < 110; j++) {
+      for (Int_t i = 0; i < 115; i++) {
+         Double_t xc = i*dx + ((j%2) ? 0.5*dx : 0.);
+         Double_t yc = j*1.5*a;
+         for (Int_t k = 0; k < 6; k++) {
+            Double_t phi = TMath::Pi()/6 + k*TMath::Pi()/3;
+            x[k] = xc + a*TMath::Cos(phi);
+            y[k] = yc + a*TMath::Sin(phi);
+         }
+         h2p->AddBin(6, x, y);
+      }
+   }
+   h2p->AddBin(10, 10, 20, 20);
+   h2p->AddBin(30, 30, 31, 31);
+   return h2p;
+}
+
+Int_t BruteForceFindBin(TH2Poly *h2p, Double_t x, Double_t y)
+{
+   TIter next(h2p->GetBins());
+   TObject *obj;
+   while ((obj = next())) {
+      TH2PolyBin *bin = (TH2PolyBin*)obj;
+      if (bin->IsInside(x, y)) return bin->GetBinNumber();
+   }
+   return -5;
+}
+
+TEST(TH2Poly, FindBinManyBins)
+{
+   TH2Poly *h2p = CreateLargeHist();
+   TRandom3 rndm(1);
+   for (Int_t i = 0; i < 20000; i++) {
+      Double_t x = rndm.Uniform(0.001, 99.999);
+      Double_t y = rndm.Uniform(0.001, 99.999);
+      EXPECT_EQ(BruteForceFindBin(h2p, x, y), h2p->FindBin(x, y));
+   }
+   // A bin added after the first lookup must be found
+   Int_t ibin = h2p->AddBin(97, 97, 99, 99);
+   EXPECT_EQ(ibin, h2p->FindBin(98.5, 98.5));
+   delete h2p;
+}
+
+TEST(TH2Poly, FillNSameAsFill)
+{
+   TH2Poly *h1 = CreateLargeHist();
+   TH2Poly *h2 = CreateLargeHist();
+   const Int_t n = 10000;
+   std::vector<Double_t> x(n), y(n), w(n);
+   TRandom3 rndm(2);
+   for (Int_t i = 0; i < n; i++) {
+      x[i] = rndm.Uniform(-10, 110);
+      y[i] = rndm.Uniform(-10, 110);
+      w[i] = rndm.Uniform(0.5, 2);
+      h1->Fill(x[i], y[i], w[i]);
+   }
+   h2->FillN(n, x.data(), y.data(), w.data());
+
+   for (Int_t bin = -9; bin <= h1->GetNumberOfBins(); bin++) {
+      if (bin == 0) continue;
+      EXPECT_DOUBLE_EQ(h1->GetBinContent(bin), h2->GetBinContent(bin));
+      EXPECT_DOUBLE_EQ(h1->GetBinError(bin), h2->GetBinError(bin));
+   }
+   Double_t s1[7], s2[7];
+   h1->GetStats(s1);
+   h2->GetStats(s2);
+   for (Int_t i = 0; i < 6; i++) EXPECT_NEAR(s1[i], s2[i], 1E-9*TMath::Abs(s1[i]));
+   EXPECT_EQ(h1->GetEntries(), h2->GetEntries());
+   delete h1;
+   delete h2;
+}
+
+TEST(TH2Poly, FindBinFromThreads)
+{
+   ROOT::EnableThreadSafety();
+   TH2Poly *h2p = CreateLargeHist();
+   const Int_t n = 5000;
+   std::vector<Double_t> x(n), y(n);
+   std::vector<Int_t> expected(n);
+   TRandom3 rndm(3);
+   for (Int_t i = 0; i < n; i++) {
+      x[i] = rndm.Uniform(0.001, 99.999);
+      y[i] = rndm.Uniform(0.001, 99.999);
+      expected[i] = BruteForceFindBin(h2p, x[i], y[i]);
+   }
+
+   // The first lookups of all threads race to build the index
+   std::vector<std::vector<Int_t>> found(4, std::vector<Int_t>(n));
+   std::vector<std::thread> threads;
+   for (UInt_t t = 0; t < found.size(); t++) {
+      threads.emplace_back([&, t]() {
+         for (Int_t i = 0; i < n; i++) found[t][i] = h2p->FindBin(x[i], y[i]);
+      });
+   }
+   for (auto &thread : threads) thread.join();
+   for (auto &bins : found) EXPECT_EQ(expected, bins);
+   delete h2p;
+}
@@ -0,0 +1,181 @@
+// test concurrent filling of TH1, TH2 and TH3 and the vectorized bin search used by FillN
+
+#include "gtest/gtest.h"
+
+#include "ROOT/THistConcurrentFill.hxx"
+#include "TAxis.h"
+#include "TH1D.h"
+#include "TH2D.h"
+#include "TH3D.h"
+#include "TMath.h"
+#include "TRandom3.h"
+
+#include <thread>
+#include <vector>
+
+const Int_t kNThreads = 4;
+const Int_t kNPerThread = 50000;
+
+// Values of one thread: coordinates on 3 axes, partly out of range, and weights
+struct FillData_t {
+   std::vector<Double_t> fX[3];
+   std::vector<Double_t> fW;
+   FillData_t(UInt_t seed)
+   {
+      TRandom3 rndm(seed);
+      for (auto &x : fX) {
+         x.resize(kNPerThread);
+         for (auto &v : x) v = rndm.Uniform(-1.2, 1.2);
+      }
+      fW.resize(kNPerThread);
+      for (auto &w : fW) w = rndm.Uniform(0.5, 2);
+   }
+};
+
+std::vector<FillData_t> MakeData()
+{
+   std::vector<FillData_t> data;
+   for (Int_t t = 0; t < kNThreads; t++) data.emplace_back(t+1);
+   return data;
+}
+
+void ExpectSameHist(const TH1 &h1, const TH1 &h2)
+{
+   ASSERT_EQ(h1.GetNcells(), h2.GetNcells());
+   for (Int_t bin = 0; bin < h1.GetNcells(); bin++) {
+      EXPECT_NEAR(h1.GetBinContent(bin), h2.GetBinContent(bin), 1E-9*TMath::Abs(h1.GetBinContent(bin)));
+      EXPECT_NEAR(h1.GetBinError(bin), h2.GetBinError(bin), 1E-9*h1.GetBinError(bin));
+   }
+   Double_t s1[TH1::kNstat], s2[TH1::kNstat];
+   h1.GetStats(s1);
+   h2.GetStats(s2);
+   for (Int_t i = 0; i < 11; i++) EXPECT_NEAR(s1[i], s2[i], 1E-9*TMath::Abs(s1[i]));
+   EXPECT_EQ(h1.GetEntries(), h2.GetEntries());
+}
+
+TEST(TAxis, FindFixBinN)
+{
+   TAxis fixed(10, -1, 1);
+   Double_t edges[] = {-1, -0.5, -0.2, 0, 0.1, 0.7, 1};
+   TAxis variable(6, edges);
+   std::vector<Double_t> x = {-2, -1, -0.99, -0.5, -0.2, 0, 0.05, 0.1, 0.3, 0.7, 0.9999, 1, 3};
+   TRandom3 rndm(7);
+   for (Int_t i = 0; i < 1000; i++) x.push_back(rndm.Uniform(-1.1, 1.1));
+   std::vector<Int_t> bins(x.size());
+   for (TAxis *axis : {&fixed, &variable}) {
+      axis->FindFixBinN(x.size(), x.data(), bins.data());
+      for (size_t i = 0; i < x.size(); i++) EXPECT_EQ(axis->FindFixBin(x[i]), bins[i]);
+   }
+   // strided input, as used by FillN with stride
+   std::vector<Int_t> strided(x.size()/2);
+   fixed.FindFixBinN(strided.size(), x.data(), strided.data(), 2);
+   for (size_t i = 0; i < strided.size(); i++) EXPECT_EQ(fixed.FindFixBin(x[2*i]), strided[i]);
+}
+
+TEST(THistConcurrentFill, TH1D)
+{
+   auto data = MakeData();
+   TH1D ref("ref", "ref", 100, -1, 1);
+   TH1D h("h", "h", 100, -1, 1);
+   for (auto &d : data)
+      for (Int_t i = 0; i < kNPerThread; i++) ref.Fill(d.fX[0][i], (i%2) ? d.fW[i] : 1.);
+
+   ROOT::THistConcurrentFillManager<TH1D> manager(h);
+   std::vector<std::thread> threads;
+   for (auto &d : data) {
+      threads.emplace_back([&manager, &d]() {
+         auto filler = manager.MakeFiller();
+         for (Int_t i = 0; i < kNPerThread; i++) {
+            if (i%2) filler.Fill(d.fX[0][i], d.fW[i]);
+            else filler.Fill(d.fX[0][i]);
+         }
+      });
+   }
+   for (auto &t : threads) t.join();
+   ExpectSameHist(ref, h);
+}
+
+TEST(THistConcurrentFill, TH2D)
+{
+   auto data = MakeData();
+   TH2D ref("ref", "ref", 50, -1, 1, 40, -1, 1);
+   TH2D h("h", "h", 50, -1, 1, 40, -1, 1);
+   for (auto &d : data)
+      for (Int_t i = 0; i < kNPerThread; i++) ref.Fill(d.fX[0][i], d.fX[1][i]);
+
+   ROOT::THistConcurrentFillManager<TH2D, 256> manager(h);
+   std::vector<std::thread> threads;
+   for (auto &d : data) {
+      threads.emplace_back([&manager, &d]() {
+         auto filler = manager.MakeFiller();
+         for (Int_t i = 0; i < kNPerThread; i++) filler.Fill(d.fX[0][i], d.fX[1][i]);
+      });
+   }
+   for (auto &t : threads) t.join();
+   ExpectSameHist(ref, h);
+}
+
+TEST(THistConcurrentFill, TH3D)
+{
+   auto data = MakeData();
+   TH3D ref("ref", "ref", 20, -1, 1, 20, -1, 1, 20, -1, 1);
+   TH3D h("h", "h", 20, -1, 1, 20, -1, 1, 20, -1, 1);
+   for (auto &d : data)
+      for (Int_t i = 0; i < kNPerThread; i++) ref.Fill(d.fX[0][i], d.fX[1][i], d.fX[2][i], d.fW[i]);
+
+   ROOT::THistConcurrentFillManager<TH3D> manager(h);
+   std::vector<std::thread> threads;
+   for (auto &d : data) {
+      threads.emplace_back([&manager, &d]() {
+         auto filler = manager.MakeFiller();
+         for (Int_t i = 0; i < kNPerThread; i++) filler.Fill(d.fX[0][i], d.fX[1][i], d.fX[2][i], d.fW[i]);
+         filler.Flush();
+      });
+   }
+   for (auto &t : threads) t.join();
+   ExpectSameHist(ref, h);
+}
+
+TEST(THistConcurrentFill, StatOverflows)
+{
+   auto data = MakeData();
+   TH2D ref("ref", "ref", 50, -1, 1, 40, -1, 1);
+   TH2D h("h", "h", 50, -1, 1, 40, -1, 1);
+   ref.SetStatOverflows(TH1::kConsider);
+   h.SetStatOverflows(TH1::kConsider);
+   for (auto &d : data)
+      for (Int_t i = 0; i < kNPerThread; i++) ref.Fill(d.fX[0][i], d.fX[1][i], d.fW[i]);
+
+   ROOT::THistConcurrentFillManager<TH2D> manager(h);
+   std::vector<std::thread> threads;
+   for (auto &d : data) {
+      threads.emplace_back([&manager, &d]() {
+         auto filler = manager.MakeFiller();
+         for (Int_t i = 0; i < kNPerThread; i++) filler.Fill(d.fX[0][i], d.fX[1][i], d.fW[i]);
+      });
+   }
+   for (auto &t : threads) t.join();
+   ExpectSameHist(ref, h);
+}
+
+// the axes can be extended: the blocks are filled under the lock
+TEST(THistConcurrentFill, CanExtend)
+{
+   auto data = MakeData();
+   TH1D h("h", "h", 10, 0, 0.1);
+   h.SetCanExtend(TH1::kAllAxes);
+
+   ROOT::THistConcurrentFillManager<TH1D> manager(h);
+   std::vector<std::thread> threads;
+   for (auto &d : data) {
+      threads.emplace_back([&manager, &d]() {
+         auto filler = manager.MakeFiller();
+         for (Int_t i = 0; i < kNPerThread; i++) filler.Fill(d.fX[0][i]);
+      });
+   }
+   for (auto &t : threads) t.join();
+   EXPECT_EQ(h.GetEntries(), kNThreads * kNPerThread);
+   EXPECT_DOUBLE_EQ(h.Integral(0, h.GetNbinsX() + 1), kNThreads * kNPerThread);
+   EXPECT_LE(h.GetXaxis()->GetXmin(), -1.2);
+   EXPECT_GE(h.GetXaxis()->GetXmax(), 1.2);
+}
@@ -0,0 +1,114 @@
+// test THnSparse bin lookup and concurrent filling
+
+#include "gtest/gtest.h"
+
+#include "ROOT/THnSparseConcurrentFill.hxx"
+#include "THnSparse.h"
+#include "TRandom3.h"
+
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// 10 dimensions with 100 bins: the compact coordinates take more than 8 bytes,
+// so different bins can have the same hash.
+const Int_t kNdim = 10;
+
+std::unique_ptr<THnSparseD> CreateSparse(const char *name)
+{
+   Int_t bins[kNdim];
+   Double_t xmin[kNdim], xmax[kNdim];
+   for (Int_t d = 0; d < kNdim; d++) {
+      bins[d] = 100;
+      xmin[d] = -5.;
+      xmax[d] = 5.;
+   }
+   std::unique_ptr<THnSparseD> h(new THnSparseD(name, name, kNdim, bins, xmin, xmax, 1024));
+   h->Sumw2();
+   return h;
+}
+
+void FillRandom(std::vector<Double_t> &x, UInt_t seed)
+{
+   TRandom3 rndm(seed);
+   for (auto &v : x) v = rndm.Gaus(0., 1.5);
+}
+
+void ExpectSameSparse(THnSparse &h1, THnSparse &h2)
+{
+   ASSERT_EQ(h1.GetNbins(), h2.GetNbins());
+   Int_t coord[kNdim];
+   for (Long64_t i = 0; i < h1.GetNbins(); i++) {
+      Double_t content = h1.GetBinContent(i, coord);
+      Long64_t bin2 = h2.GetBin(coord, kFALSE);
+      ASSERT_GE(bin2, 0);
+      EXPECT_NEAR(content, h2.GetBinContent(bin2), 1E-9*content);
+      EXPECT_NEAR(h1.GetBinError2(i), h2.GetBinError2(bin2), 1E-9*h1.GetBinError2(i));
+   }
+   EXPECT_EQ(h1.GetEntries(), h2.GetEntries());
+   EXPECT_NEAR(h1.GetWeightSum(), h2.GetWeightSum(), 1E-9*h1.GetWeightSum());
+}
+
+TEST(THnSparse, GetBinManyDimensions)
+{
+   auto h = CreateSparse("h");
+   std::map<std::vector<Int_t>, Double_t> ref;
+   std::vector<Double_t> x(kNdim);
+   std::vector<Int_t> coord(kNdim);
+   TRandom3 rndm(3);
+   for (Int_t i = 0; i < 100000; i++) {
+      FillRandom(x, i + 1);
+      // repeat some points to fill the same bins again
+      if (i % 3 == 0) FillRandom(x, i % 300 + 1);
+      Double_t w = rndm.Uniform(0.5, 2);
+      Long64_t bin = h->Fill(x.data(), w);
+      h->GetBinContent(bin, coord.data());
+      ref[coord] += w;
+   }
+   ASSERT_EQ((Long64_t)ref.size(), h->GetNbins());
+   for (auto &entry : ref) {
+      Long64_t bin = h->GetBin(entry.first.data(), kFALSE);
+      ASSERT_GE(bin, 0);
+      EXPECT_NEAR(entry.second, h->GetBinContent(bin), 1E-9*entry.second);
+   }
+
+   // A streamed copy rebuilds its bin index
+   std::unique_ptr<THnSparse> clone((THnSparse*)h->Clone("clone"));
+   ExpectSameSparse(*h, *clone);
+
+   // Unknown bins are not found, and not allocated
+   for (auto &c : coord) c = 0;
+   EXPECT_EQ(-1, h->GetBin(coord.data(), kFALSE));
+   EXPECT_EQ((Long64_t)ref.size(), h->GetNbins());
+
+   h->Reset();
+   EXPECT_EQ(0, h->GetNbins());
+   EXPECT_EQ(-1, h->GetBin(ref.begin()->first.data(), kFALSE));
+   EXPECT_EQ(0, h->GetBin(ref.begin()->first.data()));
+}
+
+TEST(THnSparse, ConcurrentFill)
+{
+   const Int_t nThreads = 4;
+   const Int_t nPerThread = 50000;
+   auto ref = CreateSparse("ref");
+   auto h = CreateSparse("h");
+
+   std::vector<std::vector<Double_t>> data(nThreads, std::vector<Double_t>(nPerThread * kNdim));
+   for (Int_t t = 0; t < nThreads; t++) FillRandom(data[t], t + 1);
+   for (auto &d : data)
+      for (Int_t i = 0; i < nPerThread; i++) ref->Fill(&d[i * kNdim], 1. + (i % 4));
+
+   ROOT::THnSparseConcurrentFillManager manager(*h);
+   std::vector<std::thread> threads;
+   for (auto &d : data) {
+      threads.emplace_back([&manager, &d]() {
+         // a small table forces many merges
+         ROOT::THnSparseConcurrentFiller filler(manager, 1000);
+         for (Int_t i = 0; i < nPerThread; i++) filler.Fill(&d[i * kNdim], 1. + (i % 4));
+      });
+   }
+   for (auto &t : threads) t.join();
+   ExpectSameSparse(*ref, *h);
+}
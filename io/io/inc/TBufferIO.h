@@ -25,7 +25,11 @@
 
 #include "TString.h"
 
-class TExMap;
+namespace ROOT {
+namespace Internal {
+class RExMap;
+}
+}
 
 class TBufferIO : public TBuffer {
 
@@ -36,8 +40,8 @@ protected:
    Int_t fMapSize{0};          ///< Default size of map
    Int_t fDisplacement{0};     ///< Value to be added to the map offsets
    UShort_t fPidOffset{0};     ///< Offset to be added to the pid index in this key/buffer.
-   TExMap *fMap{nullptr};      ///< Map containing object,offset pairs for reading/writing
-   TExMap *fClassMap{nullptr}; ///< Map containing object,class pairs for reading
+   ROOT::Internal::RExMap *fMap{nullptr};      ///< Map containing object,offset pairs for reading/writing
+   ROOT::Internal::RExMap *fClassMap{nullptr}; ///< Map containing object,class pairs for reading
 
    static Int_t fgMapSize; ///< Default map size for all TBuffer objects
 
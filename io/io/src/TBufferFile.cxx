@@ -23,7 +23,7 @@ The concrete implementation of TBuffer for writing/reading to/from a ROOT file o
 
 #include "TFile.h"
 #include "TBufferFile.h"
-#include "TExMap.h"
+#include "ROOT/RExMap.hxx"
 #include "TClass.h"
 #include "TStorage.h"
 #include "TError.h"
@@ -2502,9 +2502,8 @@ void TBufferFile::WriteObjectClass(const void *actualObjectStart, const TClass *
 
       ULong_t idx;
       UInt_t slot;
-      ULong_t hash = Void_Hash(actualObjectStart);
 
-      if ((idx = (ULong_t)fMap->GetValue(hash, (Long_t)actualObjectStart, slot)) != 0) {
+      if ((idx = (ULong_t)fMap->GetValue((Long_t)actualObjectStart, slot)) != 0) {
 
          // truncation is OK the value we did put in the map is an 30-bit offset
          // and not a pointer
@@ -2539,10 +2538,10 @@ void TBufferFile::WriteObjectClass(const void *actualObjectStart, const TClass *
             //MapObject(actualObjectStart, actualClass, cntpos+kMapOffset);
             UInt_t offset = cntpos+kMapOffset;
             if (mapsize == fMap->Capacity()) {
-               fMap->AddAt(slot, hash, (Long_t)actualObjectStart, offset);
+               fMap->AddAt(slot, (Long_t)actualObjectStart, offset);
             } else {
                // The slot depends on the capacity and WriteClass has induced an increase.
-               fMap->Add(hash, (Long_t)actualObjectStart, offset);
+               fMap->Add((Long_t)actualObjectStart, offset);
             }
             // No need to keep track of the class in write mode
             // fClassMap->Add(hash, (Long_t)obj, (Long_t)((TObject*)obj)->IsA());
@@ -2654,10 +2653,9 @@ void TBufferFile::WriteClass(const TClass *cl)
    R__ASSERT(IsWriting());
 
    ULong_t idx;
-   ULong_t hash = Void_Hash(cl);
    UInt_t slot;
 
-   if ((idx = (ULong_t)fMap->GetValue(hash, (Long_t)cl,slot)) != 0) {
+   if ((idx = (ULong_t)fMap->GetValue((Long_t)cl, slot)) != 0) {
 
       // truncation is OK the value we did put in the map is an 30-bit offset
       // and not a pointer
@@ -2679,7 +2677,7 @@ void TBufferFile::WriteClass(const TClass *cl)
 
       // store new class reference in fMap (+kMapOffset so it's != kNullTag)
       CheckCount(offset+kMapOffset);
-      fMap->AddAt(slot, hash, (Long_t)cl, offset+kMapOffset);
+      fMap->AddAt(slot, (Long_t)cl, offset+kMapOffset);
       fMapCount++;
    }
 }
@@ -19,7 +19,7 @@ Direct subclass of TBuffer, implements common methods for TBufferFile and TBuffe
 
 #include "TBufferIO.h"
 
-#include "TExMap.h"
+#include "ROOT/RExMap.hxx"
 #include "TClass.h"
 #include "TFile.h"
 #include "TError.h"
@@ -106,10 +106,9 @@ void TBufferIO::SetReadParam(Int_t mapsize)
 /// Set the initial size of the hashtable used to store object and class
 /// references during writing. The default size is TBufferFile::kMapSize.
 /// Increasing the default has the benefit that when writing many
-/// small objects the hashtable does not get too many collisions
+/// small objects the hashtable does not need to be resized too often
 /// (the system is always dynamic, even with the default everything
-/// will work, only a large number of collisions will cost performance).
-/// For optimal performance hashsize should always be a prime.
+/// will work, only the resizing will cost some time).
 /// This method can only be called directly after the creation of
 /// the TBuffer, before any writing is done. Globally this option
 /// can be changed using SetGlobalWriteParam().
@@ -130,14 +129,14 @@ void TBufferIO::InitMap()
 {
    if (IsWriting()) {
       if (!fMap) {
-         fMap = new TExMap(fMapSize);
+         fMap = new ROOT::Internal::RExMap(fMapSize);
          // No need to keep track of the class in write mode
          // fClassMap = new TExMap(fMapSize);
          fMapCount = 0;
       }
    } else {
       if (!fMap) {
-         fMap = new TExMap(fMapSize);
+         fMap = new ROOT::Internal::RExMap(fMapSize);
          fMap->Add(0, kNullTag); // put kNullTag in slot 0
          fMapCount = 1;
       } else if (fMapCount == 0) {
@@ -145,7 +144,7 @@ void TBufferIO::InitMap()
          fMapCount = 1;
       }
       if (!fClassMap) {
-         fClassMap = new TExMap(fMapSize);
+         fClassMap = new ROOT::Internal::RExMap(fMapSize);
          fClassMap->Add(0, kNullTag); // put kNullTag in slot 0
       }
    }
@@ -168,8 +167,7 @@ void TBufferIO::MapObject(const TObject *obj, UInt_t offset)
 
       if (obj) {
          CheckCount(offset);
-         ULong_t hash = Void_Hash(obj);
-         fMap->Add(hash, (Long_t)obj, offset);
+         fMap->Add((Long_t)obj, offset);
          // No need to keep track of the class in write mode
          // fClassMap->Add(hash, (Long_t)obj, (Long_t)((TObject*)obj)->IsA());
          fMapCount++;
@@ -201,8 +199,7 @@ void TBufferIO::MapObject(const void *obj, const TClass *cl, UInt_t offset)
 
       if (obj) {
          CheckCount(offset);
-         ULong_t hash = Void_Hash(obj);
-         fMap->Add(hash, (Long_t)obj, offset);
+         fMap->Add((Long_t)obj, offset);
          // No need to keep track of the class in write mode
          // fClassMap->Add(hash, (Long_t)obj, (Long_t)cl);
          fMapCount++;
@@ -244,9 +241,9 @@ Bool_t TBufferIO::CheckObject(const void *obj, const TClass *ptrClass)
    if (clActual && (ptrClass != clActual)) {
       const char *temp = (const char *)obj;
       temp -= clActual->GetBaseClassOffset(ptrClass);
-      idx = (ULong_t)fMap->GetValue(Void_Hash(temp), (Long_t)temp);
+      idx = (ULong_t)fMap->GetValue((Long_t)temp);
    } else {
-      idx = (ULong_t)fMap->GetValue(Void_Hash(obj), (Long_t)obj);
+      idx = (ULong_t)fMap->GetValue((Long_t)obj);
    }
 
    return idx ? kTRUE : kFALSE;
@@ -279,7 +276,7 @@ Long64_t TBufferIO::GetObjectTag(const void *obj)
    if (!obj || !fMap)
       return 0;
 
-   return fMap->GetValue(Void_Hash(obj), (Long_t)obj);
+   return fMap->GetValue((Long_t)obj);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
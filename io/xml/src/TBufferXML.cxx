@@ -41,7 +41,7 @@ There are limitations for complex objects like TTree, which can not be converted
 #include "TClass.h"
 #include "TClassTable.h"
 #include "TDataType.h"
-#include "TExMap.h"
+#include "ROOT/RExMap.hxx"
 #include "TMethodCall.h"
 #include "TStreamerInfo.h"
 #include "TStreamerElement.h"
@@ -786,7 +786,7 @@ XMLNodePointer_t TBufferXML::XmlWriteObject(const void *obj, const TClass *cl, B
    fXML->NewAttr(objnode, nullptr, xmlio::ObjClass, clname);
 
    if (cacheReuse)
-      fMap->Add(Void_Hash(obj), (Long_t)obj, (Long_t)objnode);
+      fMap->Add((Long_t)obj, (Long_t)objnode);
 
    PushStack(objnode);
 
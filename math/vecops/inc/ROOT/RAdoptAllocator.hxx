@@ -11,13 +11,25 @@
 #ifndef ROOT_TADOPTALLOCATOR
 #define ROOT_TADOPTALLOCATOR
 
+#include <cstddef>
 #include <iostream>
 #include <memory>
 
 namespace ROOT {
+namespace VecOps {
+void SetSmallBufferCacheCapacity(unsigned int nBuffers);
+unsigned int GetSmallBufferCacheCapacity();
+} // End NS VecOps
+
 namespace Detail {
 namespace VecOps {
 
+/// Size of the largest buffer recycled by AllocateSmallBuffer and DeallocateSmallBuffer
+constexpr std::size_t kMaxSmallBufferSize = 4096;
+
+void *AllocateSmallBuffer(std::size_t size);
+void DeallocateSmallBuffer(void *p, std::size_t size) noexcept;
+
 /**
 \class ROOT::Detail::VecOps::RAdoptAllocator
 \ingroup vecops
@@ -45,6 +57,13 @@ Upon a second allocation, the vector *v* ceases to be a proxy
 v.emplace_back(0.);
 ~~~
 now the vector *v* owns its memory as a regular vector.
+
+The memory owned by the allocator comes from a per-thread cache of small buffers when it is not
+larger than kMaxSmallBufferSize bytes: the buffers released by a thread are reused by its next
+allocations, rather than being returned to the heap. The per-event collections of an analysis are
+therefore allocated without any call to the memory allocator in the steady state, and without
+contention among threads. The number of buffers cached per thread and per size is set with
+ROOT::VecOps::SetSmallBufferCacheCapacity.
 **/
 
 template <typename T>
@@ -111,16 +130,25 @@ public:
          return fInitialAddress;
       }
       fAllocType = EAllocType::kOwning;
+      if (IsSmallBuffer(n))
+         return static_cast<pointer>(AllocateSmallBuffer(n * sizeof(T)));
       return StdAllocTraits_t::allocate(fStdAllocator, n);
    }
 
    /// \brief Dellocate some memory if that had not been adopted.
    void deallocate(pointer p, std::size_t n)
    {
-      if (p != fInitialAddress)
+      if (p == fInitialAddress)
+         return;
+      if (IsSmallBuffer(n))
+         DeallocateSmallBuffer(p, n * sizeof(T));
+      else
          StdAllocTraits_t::deallocate(fStdAllocator, p, n);
    }
 
+   /// Whether the allocator adopted a memory region, rather than allocating its memory.
+   bool IsAdoptingMemory() const { return EAllocType::kOwning != fAllocType; }
+
    template <class U>
    void destroy(U *p)
    {
@@ -138,6 +166,14 @@ public:
    bool operator!=(const RAdoptAllocator<T> &other) { return !(*this == other); }
 
    size_type max_size() const { return fStdAllocator.max_size(); };
+
+private:
+   // The small buffers are allocated with operator new: over-aligned types cannot use them.
+   // long double rather than std::max_align_t, which gcc 4.8 does not provide.
+   static bool IsSmallBuffer(std::size_t n)
+   {
+      return n <= kMaxSmallBufferSize / sizeof(T) && alignof(T) <= alignof(long double);
+   }
 };
 
 // The different semantics of std::vector<bool> make  memory adoption through a
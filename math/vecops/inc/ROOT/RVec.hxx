@@ -119,6 +119,91 @@ void EmplaceBack(std::vector<bool> &v, Args &&... args)
    v.push_back(std::forward<Args>(args)...);
 }
 
+// Whether the memory of a RVec is adopted: the operators must then not reuse it for their results.
+template <typename T>
+bool IsAdopting(const std::vector<T, ::ROOT::Detail::VecOps::RAdoptAllocator<T>> &v)
+{
+   return v.get_allocator().IsAdoptingMemory();
+}
+
+inline bool IsAdopting(const std::vector<bool> &)
+{
+   return false;
+}
+
+// The trigonometric and hyperbolic functions used by the physics helpers. The VDT implementations, when available,
+// are inlined and let the compiler vectorize the loops of the helpers.
+template <typename T>
+T FastCos(T x)
+{
+   return std::cos(x);
+}
+
+template <typename T>
+T FastSin(T x)
+{
+   return std::sin(x);
+}
+
+template <typename T>
+T FastSinh(T x)
+{
+   return std::sinh(x);
+}
+
+#ifdef R__HAS_VDT
+inline float FastCos(float x)
+{
+   return vdt::fast_cosf(x);
+}
+
+inline double FastCos(double x)
+{
+   return vdt::fast_cos(x);
+}
+
+inline float FastSin(float x)
+{
+   return vdt::fast_sinf(x);
+}
+
+inline double FastSin(double x)
+{
+   return vdt::fast_sin(x);
+}
+
+inline float FastSinh(float x)
+{
+   const auto e = vdt::fast_expf(x);
+   return 0.5f * (e - 1.f / e);
+}
+
+inline double FastSinh(double x)
+{
+   const auto e = vdt::fast_exp(x);
+   return 0.5 * (e - 1. / e);
+}
+#endif // R__HAS_VDT
+
+// Number of four-vectors converted at a time by the invariant mass helpers, into arrays on the stack.
+constexpr std::size_t kFourVectorBlock = 64;
+
+// Convert size four-vectors from the (pt, eta, phi, mass) to the (px, py, pz, e) coordinate system. Each component is
+// computed by its own loop over contiguous arrays, which the compiler can vectorize.
+template <typename T>
+void PtEtaPhiMToPxPyPzE(std::size_t size, const T *pt, const T *eta, const T *phi, const T *mass, T *px, T *py,
+                        T *pz, T *e)
+{
+   for (std::size_t i = 0u; i < size; ++i)
+      px[i] = pt[i] * FastCos(phi[i]);
+   for (std::size_t i = 0u; i < size; ++i)
+      py[i] = pt[i] * FastSin(phi[i]);
+   for (std::size_t i = 0u; i < size; ++i)
+      pz[i] = pt[i] * FastSinh(eta[i]);
+   for (std::size_t i = 0u; i < size; ++i)
+      e[i] = std::sqrt(px[i] * px[i] + py[i] * py[i] + pz[i] * pz[i] + mass[i] * mass[i]);
+}
+
 } // End of VecOps NS
 } // End of Internal NS
 
@@ -190,6 +275,13 @@ If any method which implies a re-allocation is called, e.g. *emplace_back* or *r
 memory is released and new one is allocated. The previous content is copied in the new memory and
 preserved.
 
+The memory owned by small RVecs, up to 4 kB, is recycled per thread rather than returned to the heap
+(see ROOT::VecOps::SetSmallBufferCacheCapacity): creating a RVec per event, e.g. in a Define, does not
+allocate memory in the steady state.
+The arithmetic operators and the mathematical functions reuse the memory of a temporary RVec owning
+its memory, if the result has the same type, so that expressions like `sqrt(px * px + py * py)` only
+allocate the memory of their result.
+
 ## <a name="#sorting"></a>Sorting and manipulation of indices
 
 ### Sorting
@@ -234,6 +326,21 @@ auto vf_2 = Take(vf, 2); // The content is {1.f, 2.f}
 auto vf_3 = Take(vf, -3); // The content is {2.f, 3.f, 4.f}
 ~~~
 
+### Physics helpers
+The `DeltaPhi`, `DeltaR`, `InvariantMass` and `InvariantMasses` helpers compute the kinematic
+quantities of particles stored as separate collections of their transverse momenta,
+pseudo-rapidities, azimuths and masses. They loop over the contiguous values of the collections,
+and use the VDT mathematical functions when ROOT is built with them, so that the compiler can
+vectorize the computation. The combinations of particles of a collection are described by the
+indices returned by `Combinations`:
+~~~{.cpp}
+auto pairs = Combinations(pt, 2);
+auto dr = DeltaR(pairs, eta, phi);                   // The distances of all pairs of particles
+auto masses = InvariantMasses(pairs, pt, eta, phi, m); // The invariant masses of all pairs
+auto byPt = Argsort(pt, [](double x, double y) { return x > y; });
+auto leadingEta = Take(Take(eta, byPt), 2);          // The eta of the two highest pt particles
+~~~
+
 ## <a name="usagetdataframe"></a>Usage in combination with RDataFrame
 RDataFrame leverages internally RVecs. Suppose to have a dataset stored in a
 TTree which holds these columns (here we choose C arrays to represent the
@@ -438,6 +545,17 @@ RVec<T> operator OP(const RVec<T> &v)                                          \
    for (auto &x : ret)                                                         \
       x = OP x;                                                                \
 return ret;                                                                    \
+}                                                                              \
+                                                                               \
+template <typename T>                                                          \
+RVec<T> operator OP(RVec<T> &&v)                                               \
+{                                                                              \
+   const RVec<T> &cv = v;                                                      \
+   if (ROOT::Internal::VecOps::IsAdopting(v.AsVector()))                       \
+      return OP cv;                                                            \
+   for (auto &x : v)                                                           \
+      x = OP x;                                                                \
+   return std::move(v);                                                        \
 }                                                                              \
 
 RVEC_UNARY_OPERATOR(+)
@@ -486,6 +604,79 @@ auto operator OP(const RVec<T0> &v0, const RVec<T1> &v1)                       \
    std::transform(v0.begin(), v0.end(), v1.begin(), ret.begin(), op);          \
    return ret;                                                                 \
 }                                                                              \
+                                                                               \
+/* The overloads for temporaries store the result in their memory */         \
+template <typename T0, typename T1>                                            \
+auto operator OP(RVec<T0> &&v, const T1 &y)                                    \
+  -> RVEC_SAME_RESULT(T0, OP, T1, T0)                                          \
+{                                                                              \
+   const RVec<T0> &cv = v;                                                     \
+   if (ROOT::Internal::VecOps::IsAdopting(v.AsVector()))                       \
+      return cv OP y;                                                          \
+   auto op = [&y](const T0 &x) { return x OP y; };                             \
+   std::transform(v.begin(), v.end(), v.begin(), op);                          \
+   return std::move(v);                                                        \
+}                                                                              \
+                                                                               \
+template <typename T0, typename T1>                                            \
+auto operator OP(const T0 &x, RVec<T1> &&v)                                    \
+  -> RVEC_SAME_RESULT(T0, OP, T1, T1)                                          \
+{                                                                              \
+   const RVec<T1> &cv = v;                                                     \
+   if (ROOT::Internal::VecOps::IsAdopting(v.AsVector()))                       \
+      return x OP cv;                                                          \
+   auto op = [&x](const T1 &y) { return x OP y; };                             \
+   std::transform(v.begin(), v.end(), v.begin(), op);                          \
+   return std::move(v);                                                        \
+}                                                                              \
+                                                                               \
+template <typename T0, typename T1>                                            \
+auto operator OP(RVec<T0> &&v0, const RVec<T1> &v1)                            \
+  -> RVEC_SAME_RESULT(T0, OP, T1, T0)                                          \
+{                                                                              \
+   const RVec<T0> &cv0 = v0;                                                   \
+   if (ROOT::Internal::VecOps::IsAdopting(v0.AsVector()))                      \
+      return cv0 OP v1;                                                        \
+   if (v0.size() != v1.size())                                                 \
+      throw std::runtime_error(ERROR_MESSAGE(OP));                             \
+                                                                               \
+   auto op = [](const T0 &x, const T1 &y) { return x OP y; };                  \
+   std::transform(v0.begin(), v0.end(), v1.begin(), v0.begin(), op);           \
+   return std::move(v0);                                                       \
+}                                                                              \
+                                                                               \
+template <typename T0, typename T1>                                            \
+auto operator OP(const RVec<T0> &v0, RVec<T1> &&v1)                            \
+  -> RVEC_SAME_RESULT(T0, OP, T1, T1)                                          \
+{                                                                              \
+   const RVec<T1> &cv1 = v1;                                                   \
+   if (ROOT::Internal::VecOps::IsAdopting(v1.AsVector()))                      \
+      return v0 OP cv1;                                                        \
+   if (v0.size() != v1.size())                                                 \
+      throw std::runtime_error(ERROR_MESSAGE(OP));                             \
+                                                                               \
+   auto op = [](const T0 &x, const T1 &y) { return x OP y; };                  \
+   std::transform(v0.begin(), v0.end(), v1.begin(), v1.begin(), op);           \
+   return std::move(v1);                                                       \
+}                                                                              \
+                                                                               \
+template <typename T0, typename T1>                                            \
+auto operator OP(RVec<T0> &&v0, RVec<T1> &&v1)                                 \
+  -> RVEC_SAME_RESULT(T0, OP, T1, T0)                                          \
+{                                                                              \
+   const RVec<T0> &cv0 = v0;                                                   \
+   if (ROOT::Internal::VecOps::IsAdopting(v0.AsVector()))                      \
+      return cv0 OP std::move(v1);                                             \
+   return std::move(v0) OP v1;                                                 \
+}                                                                              \
+
+/// \cond
+// The type of the result of the operators for temporaries, RVec<Ret>: only defined if
+// `T0 OP T1` is of type Ret, i.e. if the memory of the temporary can hold the result.
+#define RVEC_SAME_RESULT(T0, OP, T1, Ret)                                      \
+   typename std::enable_if<                                                    \
+      std::is_same<decltype(std::declval<T0>() OP std::declval<T1>()), Ret>::value, RVec<Ret>>::type
+/// \endcond
 
 RVEC_BINARY_OPERATOR(+)
 RVEC_BINARY_OPERATOR(-)
@@ -496,6 +687,7 @@ RVEC_BINARY_OPERATOR(^)
 RVEC_BINARY_OPERATOR(|)
 RVEC_BINARY_OPERATOR(&)
 #undef RVEC_BINARY_OPERATOR
+#undef RVEC_SAME_RESULT
 
 ///@}
 ///@name RVec Assignment Arithmetic Operators
@@ -610,6 +802,19 @@ using PromoteTypes = decltype(PromoteType<U>() + PromoteType<V>());
       auto f = [](const T &x) { return FUNC(x); };                             \
       std::transform(v.begin(), v.end(), ret.begin(), f);                      \
       return ret;                                                              \
+   }                                                                           \
+                                                                               \
+   /* The result is stored in the memory of the temporary, if it can hold it */ \
+   template <typename T>                                                       \
+   auto NAME(RVec<T> &&v)                                                      \
+      -> typename std::enable_if<std::is_same<PromoteType<T>, T>::value, RVec<T>>::type \
+   {                                                                           \
+      const RVec<T> &cv = v;                                                   \
+      if (ROOT::Internal::VecOps::IsAdopting(v.AsVector()))                    \
+         return NAME(cv);                                                      \
+      auto f = [](const T &x) { return FUNC(x); };                             \
+      std::transform(v.begin(), v.end(), v.begin(), f);                        \
+      return std::move(v);                                                     \
    }
 
 #define RVEC_BINARY_FUNCTION(NAME, FUNC)                                       \
@@ -1011,6 +1216,33 @@ RVec<typename RVec<T>::size_type> Argsort(const RVec<T> &v)
    return i;
 }
 
+/// Return an RVec of indices that sort the input RVec according to the comparison function c
+///
+/// Together with Take, the helper reorders several collections describing the same objects,
+/// for example the particles of an event by decreasing transverse momentum.
+///
+/// Example code, at the ROOT prompt:
+/// ~~~{.cpp}
+/// using namespace ROOT::VecOps;
+/// RVec<double> pt {20., 40., 30.};
+/// RVec<double> eta {0.5, -1.2, 2.1};
+/// auto sortIndices = Argsort(pt, [](double x, double y) { return x > y; });
+/// sortIndices
+/// // (ROOT::VecOps::RVec<unsigned long> &) { 1, 2, 0 }
+/// auto sortedEta = Take(eta, sortIndices);
+/// sortedEta
+/// // (ROOT::VecOps::RVec<double> &) { -1.2000000, 2.1000000, 0.50000000 }
+/// ~~~
+template <typename T, typename Compare>
+RVec<typename RVec<T>::size_type> Argsort(const RVec<T> &v, Compare &&c)
+{
+   using size_type = typename RVec<T>::size_type;
+   RVec<size_type> i(v.size());
+   std::iota(i.begin(), i.end(), 0);
+   std::sort(i.begin(), i.end(), [&v, &c](size_type i1, size_type i2) { return c(v[i1], v[i2]); });
+   return i;
+}
+
 /// Return elements of a vector at given indices
 ///
 /// Example code, at the ROOT prompt:
@@ -1215,9 +1447,15 @@ RVec<RVec<typename RVec<T>::size_type>> Combinations(const RVec<T>& v, const typ
    RVec<size_type> indices(s);
    for(size_type k=0; k<s; k++)
       indices[k] = k;
+   // The number of combinations is the binomial coefficient (s n), computed exactly one factor at a time
+   size_type nCombinations = 1;
+   for (size_type k = 0; k < n; k++)
+      nCombinations = nCombinations * (s - k) / (k + 1);
    RVec<RVec<size_type>> c(n);
-   for(size_type k=0; k<n; k++)
+   for(size_type k=0; k<n; k++) {
+      c[k].reserve(nCombinations);
       c[k].emplace_back(indices[k]);
+   }
    while (true) {
       bool run_through = true;
       long i = n - 1;
@@ -1442,14 +1680,12 @@ T DeltaPhi(T v1, T v2, const T c = M_PI)
 {
    static_assert(std::is_floating_point<T>::value,
                  "DeltaPhi must be called with floating point values.");
-   auto r = std::fmod(v2 - v1, 2.0 * c);
-   if (r < -c) {
-      r += 2.0 * c;
-   }
-   else if (r > c) {
-      r -= 2.0 * c;
-   }
-   return r;
+   // Same result as std::fmod followed by a shift into [-c, c], where an angle of exactly +-c keeps its sign, but
+   // computed without a call nor branches, so that the loops of the helpers below can be vectorized.
+   const T twoC = 2 * c;
+   const T d = v2 - v1;
+   const T r = d - twoC * std::trunc(d / twoC);
+   return r + twoC * (T(r < -c) - T(r > c));
 }
 
 /// Return the angle difference \f$\Delta \phi\f$ in radians of two vectors.
@@ -1461,12 +1697,13 @@ T DeltaPhi(T v1, T v2, const T c = M_PI)
 template <typename T>
 RVec<T> DeltaPhi(const RVec<T>& v1, const RVec<T>& v2, const T c = M_PI)
 {
-   using size_type = typename RVec<T>::size_type;
-   const size_type size = v1.size();
-   auto r = RVec<T>(size);
-   for (size_type i = 0; i < size; i++) {
-      r[i] = DeltaPhi(v1[i], v2[i], c);
-   }
+   const auto size = ::ROOT::Detail::VecOps::GetVectorsSize("DeltaPhi", v1, v2);
+   RVec<T> r(size);
+   const auto p1 = v1.data();
+   const auto p2 = v2.data();
+   const auto pr = r.data();
+   for (std::size_t i = 0u; i < size; ++i)
+      pr[i] = DeltaPhi(p1[i], p2[i], c);
    return r;
 }
 
@@ -1479,12 +1716,12 @@ RVec<T> DeltaPhi(const RVec<T>& v1, const RVec<T>& v2, const T c = M_PI)
 template <typename T>
 RVec<T> DeltaPhi(const RVec<T>& v1, T v2, const T c = M_PI)
 {
-   using size_type = typename RVec<T>::size_type;
-   const size_type size = v1.size();
-   auto r = RVec<T>(size);
-   for (size_type i = 0; i < size; i++) {
-      r[i] = DeltaPhi(v1[i], v2, c);
-   }
+   const std::size_t size = v1.size();
+   RVec<T> r(size);
+   const auto p1 = v1.data();
+   const auto pr = r.data();
+   for (std::size_t i = 0u; i < size; ++i)
+      pr[i] = DeltaPhi(p1[i], v2, c);
    return r;
 }
 
@@ -1497,12 +1734,12 @@ RVec<T> DeltaPhi(const RVec<T>& v1, T v2, const T c = M_PI)
 template <typename T>
 RVec<T> DeltaPhi(T v1, const RVec<T>& v2, const T c = M_PI)
 {
-   using size_type = typename RVec<T>::size_type;
-   const size_type size = v2.size();
-   auto r = RVec<T>(size);
-   for (size_type i = 0; i < size; i++) {
-      r[i] = DeltaPhi(v1, v2[i], c);
-   }
+   const std::size_t size = v2.size();
+   RVec<T> r(size);
+   const auto p2 = v2.data();
+   const auto pr = r.data();
+   for (std::size_t i = 0u; i < size; ++i)
+      pr[i] = DeltaPhi(v1, p2[i], c);
    return r;
 }
 
@@ -1516,8 +1753,19 @@ RVec<T> DeltaPhi(T v1, const RVec<T>& v2, const T c = M_PI)
 template <typename T>
 RVec<T> DeltaR2(const RVec<T>& eta1, const RVec<T>& eta2, const RVec<T>& phi1, const RVec<T>& phi2, const T c = M_PI)
 {
-   const auto dphi = DeltaPhi(phi1, phi2, c);
-   return (eta1 - eta2) * (eta1 - eta2) + dphi * dphi;
+   const auto size = ::ROOT::Detail::VecOps::GetVectorsSize("DeltaR2", eta1, eta2, phi1, phi2);
+   RVec<T> r(size);
+   const auto e1 = eta1.data();
+   const auto e2 = eta2.data();
+   const auto p1 = phi1.data();
+   const auto p2 = phi2.data();
+   const auto pr = r.data();
+   for (std::size_t i = 0u; i < size; ++i) {
+      const auto deta = e1[i] - e2[i];
+      const auto dphi = DeltaPhi(p1[i], p2[i], c);
+      pr[i] = deta * deta + dphi * dphi;
+   }
+   return r;
 }
 
 /// Return the distance on the \f$\eta\f$-\f$\phi\f$ plane (\f$\Delta R\f$) from
@@ -1547,6 +1795,54 @@ T DeltaR(T eta1, T eta2, T phi1, T phi2, const T c = M_PI)
    return std::sqrt((eta1 - eta2) * (eta1 - eta2) + dphi * dphi);
 }
 
+/// Return the square of the distance on the \f$\eta\f$-\f$\phi\f$ plane (\f$\Delta R\f$) of
+/// the pairs of elements of the collections eta and phi given by the indices idx.
+///
+/// The indices are the ones returned by the Combinations helpers: the pair k is made
+/// of the elements idx[0][k] and idx[1][k]. See the documentation of the DeltaR2 helper
+/// for the collections.
+template <typename T>
+RVec<T> DeltaR2(const RVec<RVec<std::size_t>> &idx, const RVec<T> &eta, const RVec<T> &phi, const T c = M_PI)
+{
+   ::ROOT::Detail::VecOps::GetVectorsSize("DeltaR2", eta, phi);
+   if (idx.size() != 2)
+      throw std::runtime_error("DeltaR2: the indices must describe pairs of elements.");
+   const auto size = ::ROOT::Detail::VecOps::GetVectorsSize("DeltaR2", idx[0], idx[1]);
+   RVec<T> r(size);
+   const auto i1 = idx[0].data();
+   const auto i2 = idx[1].data();
+   const auto e = eta.data();
+   const auto p = phi.data();
+   const auto pr = r.data();
+   for (std::size_t k = 0u; k < size; ++k) {
+      const auto deta = e[i1[k]] - e[i2[k]];
+      const auto dphi = DeltaPhi(p[i1[k]], p[i2[k]], c);
+      pr[k] = deta * deta + dphi * dphi;
+   }
+   return r;
+}
+
+/// Return the distance on the \f$\eta\f$-\f$\phi\f$ plane (\f$\Delta R\f$) of
+/// the pairs of elements of the collections eta and phi given by the indices idx.
+///
+/// The indices are the ones returned by the Combinations helpers: the pair k is made
+/// of the elements idx[0][k] and idx[1][k].
+///
+/// Example code, at the ROOT prompt:
+/// ~~~{.cpp}
+/// using namespace ROOT::VecOps;
+/// RVec<double> eta {0.5, -1.2, 2.1};
+/// RVec<double> phi {0.1, 3.0, -2.9};
+/// auto dr = DeltaR(Combinations(eta, 2), eta, phi);
+/// dr
+/// // (ROOT::VecOps::RVec<double> &) { 3.3615473, 3.4000000, 3.3221726 }
+/// ~~~
+template <typename T>
+RVec<T> DeltaR(const RVec<RVec<std::size_t>> &idx, const RVec<T> &eta, const RVec<T> &phi, const T c = M_PI)
+{
+   return sqrt(DeltaR2(idx, eta, phi, c));
+}
+
 /// Return the invariant mass of two particles given the collections of the quantities
 /// transverse momentum (pt), rapidity (eta), azimuth (phi) and mass.
 ///
@@ -1557,38 +1853,90 @@ RVec<T> InvariantMasses(
         const RVec<T>& pt1, const RVec<T>& eta1, const RVec<T>& phi1, const RVec<T>& mass1,
         const RVec<T>& pt2, const RVec<T>& eta2, const RVec<T>& phi2, const RVec<T>& mass2)
 {
-   std::size_t size = pt1.size();
-
-   R__ASSERT(eta1.size() == size && phi1.size() == size && mass1.size() == size);
-   R__ASSERT(pt2.size() == size && phi2.size() == size && mass2.size() == size);
+   const auto size =
+      ::ROOT::Detail::VecOps::GetVectorsSize("InvariantMasses", pt1, eta1, phi1, mass1, pt2, eta2, phi2, mass2);
 
    RVec<T> inv_masses(size);
-
-   for (std::size_t i = 0u; i < size; ++i) {
-      // Conversion from (pt, eta, phi, mass) to (x, y, z, e) coordinate system
-      const auto x1 = pt1[i] * std::cos(phi1[i]);
-      const auto y1 = pt1[i] * std::sin(phi1[i]);
-      const auto z1 = pt1[i] * std::sinh(eta1[i]);
-      const auto e1 = std::sqrt(x1 * x1 + y1 * y1 + z1 * z1 + mass1[i] * mass1[i]);
-
-      const auto x2 = pt2[i] * std::cos(phi2[i]);
-      const auto y2 = pt2[i] * std::sin(phi2[i]);
-      const auto z2 = pt2[i] * std::sinh(eta2[i]);
-      const auto e2 = std::sqrt(x2 * x2 + y2 * y2 + z2 * z2 + mass2[i] * mass2[i]);
+   const auto pm = inv_masses.data();
+
+   // Conversion from (pt, eta, phi, mass) to (x, y, z, e) coordinate system, by blocks of particles
+   constexpr auto kBlock = ::ROOT::Internal::VecOps::kFourVectorBlock;
+   T x1[kBlock], y1[kBlock], z1[kBlock], e1[kBlock];
+   T x2[kBlock], y2[kBlock], z2[kBlock], e2[kBlock];
+   for (std::size_t first = 0u; first < size; first += kBlock) {
+      const auto n = std::min(kBlock, size - first);
+      ::ROOT::Internal::VecOps::PtEtaPhiMToPxPyPzE(n, pt1.data() + first, eta1.data() + first, phi1.data() + first,
+                                                   mass1.data() + first, x1, y1, z1, e1);
+      ::ROOT::Internal::VecOps::PtEtaPhiMToPxPyPzE(n, pt2.data() + first, eta2.data() + first, phi2.data() + first,
+                                                   mass2.data() + first, x2, y2, z2, e2);
 
       // Addition of particle four-vector elements
-      const auto e = e1 + e2;
-      const auto x = x1 + x2;
-      const auto y = y1 + y2;
-      const auto z = z1 + z2;
-
-      inv_masses[i] = std::sqrt(e * e - x * x - y * y - z * z);
+      for (std::size_t i = 0u; i < n; ++i) {
+         const auto e = e1[i] + e2[i];
+         const auto x = x1[i] + x2[i];
+         const auto y = y1[i] + y2[i];
+         const auto z = z1[i] + z2[i];
+         pm[first + i] = std::sqrt(e * e - x * x - y * y - z * z);
+      }
    }
 
    // Return invariant mass with (+, -, -, -) metric
    return inv_masses;
 }
 
+/// Return the invariant masses of the combinations of particles of a collection given by
+/// the indices idx and the quantities transverse momentum (pt), rapidity (eta), azimuth (phi)
+/// and mass.
+///
+/// The indices are the ones returned by the Combinations helpers: the combination k is
+/// made of the particles idx[0][k], idx[1][k], ..., idx[n-1][k]. The four-vectors of the
+/// particles are computed once, whatever the number of combinations they appear in.
+///
+/// Example code, at the ROOT prompt:
+/// ~~~{.cpp}
+/// using namespace ROOT::VecOps;
+/// RVec<double> pt {20., 30., 40.};
+/// RVec<double> eta {0.5, -1.2, 2.1};
+/// RVec<double> phi {0.1, 3.0, -2.9};
+/// RVec<double> mass {0.105, 0.105, 0.105};
+/// auto pairMasses = InvariantMasses(Combinations(pt, 2), pt, eta, phi, mass);
+/// auto tripletMasses = InvariantMasses(Combinations(pt, 3), pt, eta, phi, mass);
+/// ~~~
+template <typename T>
+RVec<T> InvariantMasses(const RVec<RVec<std::size_t>> &idx, const RVec<T> &pt, const RVec<T> &eta,
+                        const RVec<T> &phi, const RVec<T> &mass)
+{
+   const auto nParticles = ::ROOT::Detail::VecOps::GetVectorsSize("InvariantMasses", pt, eta, phi, mass);
+   const auto size = idx.empty() ? 0u : idx[0].size();
+   for (const auto &i : idx) {
+      if (i.size() != size)
+         throw std::runtime_error("InvariantMasses: input RVec instances have different lengths!");
+   }
+
+   RVec<T> x(nParticles), y(nParticles), z(nParticles), e(nParticles);
+   ::ROOT::Internal::VecOps::PtEtaPhiMToPxPyPzE(nParticles, pt.data(), eta.data(), phi.data(), mass.data(), x.data(),
+                                                y.data(), z.data(), e.data());
+
+   // Sum the four-vectors of the particles of each combination, one particle of all combinations at a time
+   RVec<T> xSum(size), ySum(size), zSum(size), eSum(size);
+   const auto px = x.data(), py = y.data(), pz = z.data(), pe = e.data();
+   const auto pxSum = xSum.data(), pySum = ySum.data(), pzSum = zSum.data(), peSum = eSum.data();
+   for (const auto &i : idx) {
+      const auto pi = i.data();
+      for (std::size_t k = 0u; k < size; ++k) {
+         pxSum[k] += px[pi[k]];
+         pySum[k] += py[pi[k]];
+         pzSum[k] += pz[pi[k]];
+         peSum[k] += pe[pi[k]];
+      }
+   }
+
+   // Return invariant mass with (+, -, -, -) metric, reusing the memory of eSum
+   for (std::size_t k = 0u; k < size; ++k)
+      peSum[k] = std::sqrt(peSum[k] * peSum[k] - pxSum[k] * pxSum[k] - pySum[k] * pySum[k] - pzSum[k] * pzSum[k]);
+   return eSum;
+}
+
 /// Return the invariant mass of multiple particles given the collections of the
 /// quantities transverse momentum (pt), rapidity (eta), azimuth (phi) and mass.
 ///
@@ -1597,25 +1945,25 @@ RVec<T> InvariantMasses(
 template <typename T>
 T InvariantMass(const RVec<T>& pt, const RVec<T>& eta, const RVec<T>& phi, const RVec<T>& mass)
 {
-   const std::size_t size = pt.size();
-
-   R__ASSERT(eta.size() == size && phi.size() == size && mass.size() == size);
+   const auto size = ::ROOT::Detail::VecOps::GetVectorsSize("InvariantMass", pt, eta, phi, mass);
 
+   // Convert to (e, x, y, z) coordinate system by blocks of particles, and sum
+   constexpr auto kBlock = ::ROOT::Internal::VecOps::kFourVectorBlock;
+   T x[kBlock], y[kBlock], z[kBlock], e[kBlock];
    T x_sum = 0.;
    T y_sum = 0.;
    T z_sum = 0.;
    T e_sum = 0.;
-
-   for (std::size_t i = 0u; i < size; ++ i) {
-      // Convert to (e, x, y, z) coordinate system and update sums
-      const auto x = pt[i] * std::cos(phi[i]);
-      x_sum += x;
-      const auto y = pt[i] * std::sin(phi[i]);
-      y_sum += y;
-      const auto z = pt[i] * std::sinh(eta[i]);
-      z_sum += z;
-      const auto e = std::sqrt(x * x + y * y + z * z + mass[i] * mass[i]);
-      e_sum += e;
+   for (std::size_t first = 0u; first < size; first += kBlock) {
+      const auto n = std::min(kBlock, size - first);
+      ::ROOT::Internal::VecOps::PtEtaPhiMToPxPyPzE(n, pt.data() + first, eta.data() + first, phi.data() + first,
+                                                   mass.data() + first, x, y, z, e);
+      for (std::size_t i = 0u; i < n; ++i) {
+         x_sum += x[i];
+         y_sum += y[i];
+         z_sum += z[i];
+         e_sum += e[i];
+      }
    }
 
    // Return invariant mass with (+, -, -, -) metric
@@ -1 +1,110 @@
 #include <ROOT/RAdoptAllocator.hxx>
+
+#include <atomic>
+#include <new>
+#include <vector>
+
+namespace {
+
+// The sizes of the small buffers are the powers of two from kMinSmallBufferSize to kMaxSmallBufferSize
+constexpr std::size_t kMinSmallBufferSize = 32;
+constexpr std::size_t kNSmallBufferSizes = 8;
+static_assert(kMinSmallBufferSize << (kNSmallBufferSizes - 1) == ROOT::Detail::VecOps::kMaxSmallBufferSize,
+              "The small buffer sizes do not match kMaxSmallBufferSize");
+
+std::atomic<unsigned int> gSmallBufferCacheCapacity{64};
+
+std::size_t GetSizeIndex(std::size_t size)
+{
+   std::size_t index = 0;
+   for (auto bufferSize = kMinSmallBufferSize; bufferSize < size; bufferSize <<= 1)
+      ++index;
+   return index;
+}
+
+/// The small buffers released by a thread, for each size
+struct RSmallBufferCache {
+   std::vector<void *> fBuffers[kNSmallBufferSizes];
+   ~RSmallBufferCache();
+};
+
+// Trivially destructible, so it can be read during the destruction of the other thread-local objects,
+// which may release buffers after the cache is gone.
+thread_local bool gCacheDestroyed = false;
+
+RSmallBufferCache::~RSmallBufferCache()
+{
+   gCacheDestroyed = true;
+   for (auto &buffers : fBuffers)
+      for (auto p : buffers)
+         ::operator delete(p);
+}
+
+RSmallBufferCache &GetCache()
+{
+   thread_local RSmallBufferCache cache;
+   return cache;
+}
+
+} // anonymous namespace
+
+namespace ROOT {
+namespace VecOps {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of small buffers of each size that each thread keeps for reuse (64 by default).
+/// The buffers of the RVecs not larger than ROOT::Detail::VecOps::kMaxSmallBufferSize bytes are recycled.
+/// 0 disables the recycling: the buffers are then returned to the heap when released.
+void SetSmallBufferCacheCapacity(unsigned int nBuffers)
+{
+   gSmallBufferCacheCapacity = nBuffers;
+}
+
+unsigned int GetSmallBufferCacheCapacity()
+{
+   return gSmallBufferCacheCapacity;
+}
+
+} // End NS VecOps
+
+namespace Detail {
+namespace VecOps {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a buffer of at least `size` bytes, reusing one released by the thread if possible.
+/// `size` must not be larger than kMaxSmallBufferSize. The buffer must be released by DeallocateSmallBuffer.
+void *AllocateSmallBuffer(std::size_t size)
+{
+   const auto index = GetSizeIndex(size);
+   if (!gCacheDestroyed) {
+      auto &buffers = GetCache().fBuffers[index];
+      if (!buffers.empty()) {
+         auto p = buffers.back();
+         buffers.pop_back();
+         return p;
+      }
+   }
+   return ::operator new(kMinSmallBufferSize << index);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release a buffer returned by AllocateSmallBuffer, keeping it for reuse if the cache of the thread has room.
+/// Buffers can be released by a thread different from the one which allocated them.
+void DeallocateSmallBuffer(void *p, std::size_t size) noexcept
+{
+   if (!gCacheDestroyed) {
+      auto &buffers = GetCache().fBuffers[GetSizeIndex(size)];
+      if (buffers.size() < gSmallBufferCacheCapacity.load(std::memory_order_relaxed)) {
+         try {
+            buffers.push_back(p);
+            return;
+         } catch (const std::bad_alloc &) {
+         }
+      }
+   }
+   ::operator delete(p);
+}
+
+} // End NS VecOps
+} // End NS Detail
+} // End NS ROOT
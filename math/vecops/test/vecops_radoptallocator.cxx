@@ -98,3 +98,32 @@ TEST(RAdoptAllocator, Traits)
 
 }
 
+
+TEST(RAdoptAllocator, SmallBuffersRecycling)
+{
+   const auto capacity = ROOT::VecOps::GetSmallBufferCacheCapacity();
+   ROOT::VecOps::SetSmallBufferCacheCapacity(8);
+
+   const double *data = nullptr;
+   {
+      std::vector<double, RAdoptAllocator<double>> v(10);
+      data = v.data();
+   }
+   {
+      // same size class: the buffer is reused
+      std::vector<double, RAdoptAllocator<double>> v(12);
+      EXPECT_EQ(data, v.data());
+   }
+
+   ROOT::VecOps::SetSmallBufferCacheCapacity(0);
+   {
+      std::vector<double, RAdoptAllocator<double>> v(10);
+      data = v.data();
+      for (int i = 0; i < 1000; ++i)
+         v.emplace_back(i); // larger than the small buffers
+      EXPECT_EQ(1010u, v.size());
+      EXPECT_EQ(999., v.back());
+   }
+
+   ROOT::VecOps::SetSmallBufferCacheCapacity(capacity);
+}
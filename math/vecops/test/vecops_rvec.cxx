@@ -114,6 +114,47 @@ TEST(VecOps, MoveCtor)
    EXPECT_EQ(v2.size(), 3u);
 }
 
+TEST(VecOps, TemporariesReuseMemory)
+{
+   RVec<double> px{1., 2., 3.};
+   RVec<double> py{4., 5., 6.};
+
+   RVec<double> tmp{1., 2., 3.};
+   const auto tmpData = tmp.data();
+   auto twice = std::move(tmp) * 2.;
+   EXPECT_EQ(tmpData, twice.data());
+   CheckEqual(twice, RVec<double>{2., 4., 6.});
+
+   auto pt = sqrt(px * px + py * py);
+   CheckEqual(pt, RVec<double>{std::sqrt(17.), std::sqrt(29.), std::sqrt(45.)});
+   CheckEqual(1. - -px, RVec<double>{2., 3., 4.});
+   CheckEqual(px * 2. - py * py, RVec<double>{-14., -21., -30.});
+
+   // the result type differs: a new RVec is allocated
+   auto mixed = RVec<float>{1.f, 2.f} * RVec<double>{1., 2.};
+   CheckEqual(mixed, RVec<double>{1., 4.});
+   auto cond = RVec<float>{1.f, 2.f} > 1.f;
+   EXPECT_EQ(0, cond[0]);
+   EXPECT_EQ(1, cond[1]);
+
+   EXPECT_THROW(RVec<double>({1.}) + RVec<double>({1., 2.}), std::runtime_error);
+}
+
+TEST(VecOps, TemporariesDoNotModifyAdoptedMemory)
+{
+   std::vector<double> model{1., 2., 3.};
+   auto plusOne = RVec<double>(model.data(), model.size()) + 1.;
+   auto minus = -RVec<double>(model.data(), model.size());
+   auto logs = log(RVec<double>(model.data(), model.size()));
+   auto sum = RVec<double>(model.data(), model.size()) + RVec<double>(model.data(), model.size());
+
+   CheckEqual(plusOne, RVec<double>{2., 3., 4.});
+   CheckEqual(minus, RVec<double>{-1., -2., -3.});
+   CheckEqual(logs, RVec<double>{0., std::log(2.), std::log(3.)});
+   CheckEqual(sum, RVec<double>{2., 4., 6.});
+   EXPECT_EQ(model, std::vector<double>({1., 2., 3.}));
+}
+
 TEST(VecOps, Conversion)
 {
    ROOT::VecOps::RVec<float> fvec{1.0f, 2.0f, 3.0f};
@@ -663,6 +704,18 @@ TEST(VecOps, Argsort)
    CheckEqual(i, ref);
 }
 
+TEST(VecOps, ArgsortWithComparison)
+{
+   ROOT::VecOps::RVec<double> pt{20., 40., 30.};
+   ROOT::VecOps::RVec<double> eta{0.5, -1.2, 2.1};
+   using size_type = typename ROOT::VecOps::RVec<double>::size_type;
+   auto i = Argsort(pt, [](double x, double y) { return x > y; });
+   ROOT::VecOps::RVec<size_type> ref{1, 2, 0};
+   CheckEqual(i, ref);
+   ROOT::VecOps::RVec<double> refEta{-1.2, 2.1, 0.5};
+   CheckEqual(Take(eta, i), refEta);
+}
+
 TEST(VecOps, TakeIndices)
 {
    ROOT::VecOps::RVec<int> v0{2, 0, 1};
@@ -932,6 +985,14 @@ TEST(VecOps, DeltaPhi)
    EXPECT_EQ(DeltaPhi(0.f, -2.f * c2 + 1.f, c2), 1.f);
    EXPECT_EQ(DeltaPhi(0.f, -4.f * c2 + 1.f, c2), 1.f);
 
+   // An angle of exactly +-c keeps its sign, whatever the number of turns
+   EXPECT_EQ(DeltaPhi(0., 180., 180.), 180.);
+   EXPECT_EQ(DeltaPhi(0., -180., 180.), -180.);
+   EXPECT_EQ(DeltaPhi(0., 540., 180.), 180.);
+   EXPECT_EQ(DeltaPhi(0., -540., 180.), -180.);
+   EXPECT_EQ(DeltaPhi(0., 900., 180.), 180.);
+   EXPECT_EQ(DeltaPhi(100., 280., 180.), 180.);
+
    // Two vectors
    RVec<float> v1 = {0.f, 1.f, -0.5f, 0.f, 0.f, 0.f, 0.f};
    RVec<float> v2 = {2.f, 0.f, 0.5f, 2.f * c1 - 1.f, 4.f * c1 - 1.f, -2.f * c1 + 1.f, -4.f * c1 + 1.f};
@@ -1014,6 +1075,63 @@ TEST(VecOps, InvariantMass)
    EXPECT_NEAR(p5.M(), invMass3, 1e-4);
 }
 
+TEST(VecOps, InvariantMassOfManyParticles)
+{
+   // More particles than the number of four-vectors converted at a time
+   const std::size_t size = 150;
+   RVec<double> pt(size), eta(size), phi(size), mass(size);
+   for (std::size_t i = 0; i < size; i++) {
+      pt[i] = 1. + 0.1 * i;
+      eta[i] = -2. + 0.03 * i;
+      phi[i] = -3. + 0.04 * i;
+      mass[i] = 0.1 + 0.001 * i;
+   }
+
+   const auto invMasses = InvariantMasses(pt, eta, phi, mass, Reverse(pt), Reverse(eta), Reverse(phi), Reverse(mass));
+   TLorentzVector sum;
+   for (std::size_t i = 0; i < size; i++) {
+      TLorentzVector p1, p2;
+      p1.SetPtEtaPhiM(pt[i], eta[i], phi[i], mass[i]);
+      p2.SetPtEtaPhiM(pt[size - 1 - i], eta[size - 1 - i], phi[size - 1 - i], mass[size - 1 - i]);
+      EXPECT_NEAR((p1 + p2).M(), invMasses[i], 1e-4 * (p1 + p2).M());
+      sum += p1;
+   }
+   EXPECT_NEAR(sum.M(), InvariantMass(pt, eta, phi, mass), 1e-4 * sum.M());
+}
+
+TEST(VecOps, InvariantMassesOfCombinations)
+{
+   RVec<double> mass = {50,  50,  40,   0.1, 100};
+   RVec<double> pt =   {0,   5,   5,    10,  10};
+   RVec<double> eta =  {0.0, 0.0, -1.0, 0.5, 2.5};
+   RVec<double> phi =  {0.0, 1.0, 3.0,  -0.5, -2.4};
+
+   for (auto n : {1u, 2u, 3u}) {
+      const auto idx = Combinations(pt, n);
+      const auto invMasses = InvariantMasses(idx, pt, eta, phi, mass);
+      ASSERT_EQ(invMasses.size(), idx[0].size());
+      for (std::size_t k = 0; k < invMasses.size(); k++) {
+         TLorentzVector p;
+         for (const auto &i : idx) {
+            TLorentzVector pi;
+            pi.SetPtEtaPhiM(pt[i[k]], eta[i[k]], phi[i[k]], mass[i[k]]);
+            p += pi;
+         }
+         EXPECT_NEAR(p.M(), invMasses[k], 1e-4);
+      }
+   }
+
+   // The pairs of particles of a combination match the two collections helper
+   const auto idx = Combinations(pt, 2);
+   const auto invMasses = InvariantMasses(idx, pt, eta, phi, mass);
+   const auto ref = InvariantMasses(Take(pt, idx[0]), Take(eta, idx[0]), Take(phi, idx[0]), Take(mass, idx[0]),
+                                    Take(pt, idx[1]), Take(eta, idx[1]), Take(phi, idx[1]), Take(mass, idx[1]));
+   CheckEqual(invMasses, ref);
+
+   EXPECT_TRUE(InvariantMasses(Combinations(pt, 0), pt, eta, phi, mass).empty());
+   EXPECT_THROW(InvariantMasses(idx, pt, eta, phi, RVec<double>(2)), std::runtime_error);
+}
+
 TEST(VecOps, DeltaR)
 {
    RVec<double> eta1 =  {0.1, -1.0, -1.0, 0.5,  -2.5};
@@ -1039,6 +1157,26 @@ TEST(VecOps, DeltaR)
    }
 }
 
+TEST(VecOps, DeltaROfCombinations)
+{
+   RVec<double> eta = {0.1, -1.0, -1.0, 0.5, -2.5};
+   RVec<double> phi = {1.0, 5.0, -1.0, -0.5, 3.1};
+
+   const auto idx = Combinations(eta, 2);
+   const auto dr = DeltaR(idx, eta, phi);
+   ASSERT_EQ(dr.size(), 10u);
+   for (std::size_t k = 0; k < dr.size(); k++) {
+      TLorentzVector p1, p2;
+      p1.SetPtEtaPhiM(1.f, eta[idx[0][k]], phi[idx[0][k]], 1.f);
+      p2.SetPtEtaPhiM(1.f, eta[idx[1][k]], phi[idx[1][k]], 1.f);
+      EXPECT_NEAR(p1.DeltaR(p2), dr[k], 1e-6);
+   }
+   CheckEqual(DeltaR2(idx, eta, phi), dr * dr);
+
+   EXPECT_THROW(DeltaR(Combinations(eta, 3), eta, phi), std::runtime_error);
+   EXPECT_THROW(DeltaR(idx, eta, RVec<double>(2)), std::runtime_error);
+}
+
 TEST(VecOps, Map)
 {
    RVec<float> a({1.f, 2.f, 3.f});
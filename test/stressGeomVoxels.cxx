@@ -0,0 +1,127 @@
+#ifndef __CINT__
+#include <TRandom3.h>
+#include <TROOT.h>
+#include <TMath.h>
+#include <TStopwatch.h>
+#include <TGeoManager.h>
+#include <TGeoNavigator.h>
+#include <TGeoVolume.h>
+#include <TGeoBBox.h>
+#include <TGeoBVHFinder.h>
+#include <TGeoMatrix.h>
+#include <TApplication.h>
+
+void stressGeomVoxels(Int_t ngrid = 30);
+
+int main(int argc, char **argv)
+{
+   gROOT->SetBatch();
+   TApplication theApp("App", &argc, argv);
+   stressGeomVoxels();
+   return 0;
+}
+
+#endif
+//--- This macro compares the slice voxelization (TGeoVoxelFinder) with the
+//--- bounding volume hierarchy (TGeoBVHFinder) for a container holding
+//--- ngrid^3 randomly rotated boxes. For each finder it measures the build
+//--- time, the time to locate random points and the time to track random
+//--- rays, and checks that both finders give the same navigation results.
+//
+// To run this test with interactive CINT, do
+// root > .x stressGeomVoxels.cxx++
+
+struct VoxelsResult_t {
+   Double_t fBuild;
+   Double_t fLocate;
+   Double_t fTrack;
+   Long64_t fNodeSum;
+   Double_t fLength;
+};
+
+VoxelsResult_t run_finder(TGeoVolume *top, Int_t type, Int_t npoints, Int_t nrays)
+{
+   VoxelsResult_t res;
+   TStopwatch timer;
+   top->SetVoxelsType(type);
+   timer.Start();
+   top->Voxelize("");
+   top->FindOverlaps();
+   timer.Stop();
+   res.fBuild = timer.CpuTime();
+
+   TGeoNavigator *nav = gGeoManager->GetCurrentNavigator();
+   TGeoBBox *box = (TGeoBBox*)top->GetShape();
+   Double_t dx = box->GetDX();
+   Double_t dy = box->GetDY();
+   Double_t dz = box->GetDZ();
+   TRandom3 rndm(1234);
+   res.fNodeSum = 0;
+   timer.Start();
+   for (Int_t i=0; i<npoints; i++) {
+      TGeoNode *node = nav->FindNode(rndm.Uniform(-dx,dx), rndm.Uniform(-dy,dy), rndm.Uniform(-dz,dz));
+      if (node != gGeoManager->GetTopNode()) res.fNodeSum += nav->GetCurrentNode()->GetNumber();
+   }
+   timer.Stop();
+   res.fLocate = timer.CpuTime();
+
+   res.fLength = 0;
+   timer.Start();
+   Double_t dir[3];
+   for (Int_t i=0; i<nrays; i++) {
+      Double_t phi = 2.*TMath::Pi()*rndm.Rndm();
+      Double_t cost = 1.-2.*rndm.Rndm();
+      Double_t sint = TMath::Sqrt((1.+cost)*(1.-cost));
+      dir[0] = sint*TMath::Cos(phi);
+      dir[1] = sint*TMath::Sin(phi);
+      dir[2] = cost;
+      nav->InitTrack(0., 0., 0., dir[0], dir[1], dir[2]);
+      while (!nav->IsOutside()) {
+         TGeoNode *current = nav->GetCurrentNode();
+         nav->FindNextBoundaryAndStep();
+         if (current != gGeoManager->GetTopNode()) res.fLength += nav->GetStep();
+      }
+   }
+   timer.Stop();
+   res.fTrack = timer.CpuTime();
+   return res;
+}
+
+void stressGeomVoxels(Int_t ngrid)
+{
+   const Double_t cell = 2.;
+   delete gGeoManager;
+   new TGeoManager("voxels", "slices versus bounding volume hierarchy");
+   TGeoMedium *med = new TGeoMedium("vacuum", 1, new TGeoMaterial("vacuum", 0, 0, 0));
+   Double_t half = 0.5*ngrid*cell;
+   TGeoVolume *top = gGeoManager->MakeBox("TOP", med, half, half, half);
+   gGeoManager->SetTopVolume(top);
+   TGeoVolume *cube = gGeoManager->MakeBox("CUBE", med, 0.5, 0.5, 0.5);
+   TRandom3 rndm(4321);
+   Int_t copy = 0;
+   for (Int_t i=0; i<ngrid; i++) {
+      for (Int_t j=0; j<ngrid; j++) {
+         for (Int_t k=0; k<ngrid; k++) {
+            TGeoRotation *rot = new TGeoRotation("", 360.*rndm.Rndm(), 180.*rndm.Rndm(), 360.*rndm.Rndm());
+            top->AddNode(cube, copy++, new TGeoCombiTrans(-half+(i+0.5)*cell, -half+(j+0.5)*cell,
+                                                          -half+(k+0.5)*cell, rot));
+         }
+      }
+   }
+   gGeoManager->CloseGeometry("d");
+
+   const Int_t npoints = 1000000;
+   const Int_t nrays = 10000;
+   printf("Container with %d daughters, %d points, %d rays\n", top->GetNdaughters(), npoints, nrays);
+   VoxelsResult_t slices = run_finder(top, TGeoVolume::kVoxelsSlices, npoints, nrays);
+   printf("slices : build %8.3f s   locate %8.3f s   track %8.3f s\n", slices.fBuild, slices.fLocate, slices.fTrack);
+   VoxelsResult_t bvh = run_finder(top, TGeoVolume::kVoxelsBVH, npoints, nrays);
+   printf("BVH    : build %8.3f s   locate %8.3f s   track %8.3f s\n", bvh.fBuild, bvh.fLocate, bvh.fTrack);
+   TGeoBVHFinder *finder = (TGeoBVHFinder*)top->GetVoxels();
+   printf("BVH nodes=%d leaves=%d depth=%d\n", finder->GetNnodes(), finder->GetNleaves(), finder->GetDepth());
+
+   Bool_t ok = (slices.fNodeSum == bvh.fNodeSum) &&
+               (TMath::Abs(slices.fLength-bvh.fLength) <= 1.E-6*TMath::Max(1., slices.fLength));
+   printf("Navigation results: located %lld / %lld   tracked length %g / %g ...... %s\n",
+          slices.fNodeSum, bvh.fNodeSum, slices.fLength, bvh.fLength, ok ? "OK" : "FAILED");
+}
@@ -0,0 +1,114 @@
+#ifndef __CINT__
+#include <TRandom3.h>
+#include <TROOT.h>
+#include <TSystem.h>
+#include <TStopwatch.h>
+#include <THnSparse.h>
+#include <ROOT/THnSparseConcurrentFill.hxx>
+#include <TApplication.h>
+
+#include <thread>
+#include <vector>
+
+void stressSparseFill(Long64_t nfills = 100000000, Int_t nthreads = 4);
+
+int main(int argc, char **argv)
+{
+   gROOT->SetBatch();
+   TApplication theApp("App", &argc, argv);
+   Long64_t nfills = 100000000;
+   Int_t nthreads = 4;
+   if (theApp.Argc() > 1) nfills = atoll(theApp.Argv(1));
+   if (theApp.Argc() > 2) nthreads = atoi(theApp.Argv(2));
+   stressSparseFill(nfills, nthreads);
+   return 0;
+}
+
+#endif
+//--- This macro measures the fill rate and the memory of THnSparseD with
+//--- 6, 8 and 10 dimensions of 100 bins, filled nfills times with gaussian
+//--- points: once sequentially with THnSparse::Fill(), once from nthreads
+//--- threads through ROOT::THnSparseConcurrentFiller. It checks that both
+//--- give the same histogram.
+//
+// To run this test with interactive CINT, do
+// root > .x stressSparseFill.cxx++
+
+THnSparseD *make_sparse(const char *name, Int_t ndim)
+{
+   std::vector<Int_t> bins(ndim, 100);
+   std::vector<Double_t> xmin(ndim, -5.), xmax(ndim, 5.);
+   return new THnSparseD(name, name, ndim, bins.data(), xmin.data(), xmax.data());
+}
+
+// Fill n gaussian points generated from seed
+template <class FILL>
+void fill_points(Int_t ndim, Long64_t n, UInt_t seed, FILL &&fill)
+{
+   TRandom3 rndm(seed);
+   std::vector<Double_t> x(ndim);
+   for (Long64_t i = 0; i < n; i++) {
+      for (Int_t d = 0; d < ndim; d++) x[d] = rndm.Gaus(0., 1.);
+      fill(x.data());
+   }
+}
+
+Double_t resident_mb()
+{
+   ProcInfo_t info;
+   gSystem->GetProcInfo(&info);
+   return info.fMemResident / 1024.;
+}
+
+Bool_t run_dimension(Int_t ndim, Long64_t nfills, Int_t nthreads)
+{
+   TStopwatch timer;
+   const Long64_t nPerThread = nfills / nthreads;
+
+   Double_t mem0 = resident_mb();
+   THnSparseD *seq = make_sparse("seq", ndim);
+   timer.Start();
+   for (Int_t t = 0; t < nthreads; t++)
+      fill_points(ndim, nPerThread, t + 1, [seq](const Double_t *x) { seq->Fill(x); });
+   timer.Stop();
+   Double_t seqTime = timer.RealTime();
+   Double_t seqMem = resident_mb() - mem0;
+
+   THnSparseD *par = make_sparse("par", ndim);
+   ROOT::THnSparseConcurrentFillManager manager(*par);
+   timer.Start();
+   std::vector<std::thread> threads;
+   for (Int_t t = 0; t < nthreads; t++) {
+      threads.emplace_back([&manager, ndim, nPerThread, t]() {
+         ROOT::THnSparseConcurrentFiller filler(manager);
+         fill_points(ndim, nPerThread, t + 1, [&filler](const Double_t *x) { filler.Fill(x); });
+      });
+   }
+   for (auto &th : threads) th.join();
+   timer.Stop();
+   Double_t parTime = timer.RealTime();
+
+   Bool_t ok = seq->GetNbins() == par->GetNbins() && seq->GetEntries() == par->GetEntries();
+   std::vector<Int_t> coord(ndim);
+   for (Long64_t i = 0; ok && i < seq->GetNbins(); i += 97) {
+      Double_t content = seq->GetBinContent(i, coord.data());
+      ok = content == par->GetBinContent(par->GetBin(coord.data(), kFALSE));
+   }
+
+   const Double_t nfilled = nPerThread * nthreads;
+   printf("%2d dims: %10lld bins  %7.1f MB (index+chunks %5.3g of dense)\n", ndim, seq->GetNbins(), seqMem,
+          seq->GetSparseFractionMem());
+   printf("         Fill()           %8.2f Mfills/s\n", nfilled / seqTime / 1E6);
+   printf("         %2d fillers       %8.2f Mfills/s ...... %s\n", nthreads, nfilled / parTime / 1E6,
+          ok ? "OK" : "FAILED");
+   delete seq;
+   delete par;
+   return ok;
+}
+
+void stressSparseFill(Long64_t nfills, Int_t nthreads)
+{
+   printf("THnSparseD with 100 bins per dimension, %lld fills, %d threads\n", nfills, nthreads);
+   for (Int_t ndim : {6, 8, 10})
+      run_dimension(ndim, nfills, nthreads);
+}
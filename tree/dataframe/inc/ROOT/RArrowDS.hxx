@@ -8,6 +8,9 @@
 
 namespace arrow {
 class Table;
+namespace io {
+class RandomAccessFile;
+}
 }
 
 namespace ROOT {
@@ -21,6 +24,7 @@ namespace RDF {
 
 class RArrowDS final : public RDataSource {
 private:
+   std::shared_ptr<arrow::io::RandomAccessFile> fFile; // the memory-mapped file the table was read from, if any
    std::shared_ptr<arrow::Table> fTable;
    std::vector<std::pair<ULong64_t, ULong64_t>> fEntryRanges;
    std::vector<std::string> fColumnNames;
@@ -29,9 +33,11 @@ private:
    std::vector<std::pair<size_t, size_t>> fGetterIndex; // (columnId, visitorId)
    std::vector<std::unique_ptr<ROOT::Internal::RDF::TValueGetter>> fValueGetters; // Visitors to be used to track and get entries. One per column.
    std::vector<void *> GetColumnReadersImpl(std::string_view name, const std::type_info &type) override;
+   void SetupColumns();
 
 public:
    RArrowDS(std::shared_ptr<arrow::Table> table, std::vector<std::string> const &columns);
+   RArrowDS(std::string_view fileName, std::vector<std::string> const &columns);
    ~RArrowDS();
    const std::vector<std::string> &GetColumnNames() const override;
    std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges() override;
@@ -49,6 +55,12 @@ public:
 /// \param[in] table an apache::arrow table to use as a source.
 RDataFrame MakeArrowDataFrame(std::shared_ptr<arrow::Table> table, std::vector<std::string> const &columns);
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Factory method to create a Apache Arrow RDataFrame reading an Arrow IPC (Feather V2) file.
+/// \param[in] fileName the path of the Arrow IPC file, which is memory-mapped.
+/// \param[in] columns the name of the columns to use, all of them if empty.
+RDataFrame MakeArrowDataFrame(std::string_view fileName, std::vector<std::string> const &columns = {});
+
 } // namespace RDF
 
 } // namespace ROOT
@@ -0,0 +1,41 @@
+// @(#)root/dataframe:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RCACHEOPTIONS
+#define ROOT_RCACHEOPTIONS
+
+#include <Compression.h>
+#include <RtypesCore.h>
+#include <string>
+
+namespace ROOT {
+
+namespace RDF {
+/// A collection of options to steer the storage of the columns cached with RInterface::Cache
+struct RCacheOptions {
+   using ECAlgo = ROOT::ECompressionAlgorithm;
+   RCacheOptions() = default;
+   RCacheOptions(const RCacheOptions &) = default;
+   RCacheOptions(RCacheOptions &&) = default;
+   explicit RCacheOptions(ULong64_t memoryBudget) : fMemoryBudget(memoryBudget) {}
+   RCacheOptions(ULong64_t memoryBudget, ECAlgo comprAlgo, int comprLevel, const std::string &spillDirectory = "")
+      : fMemoryBudget(memoryBudget), fCompressionAlgorithm(comprAlgo), fCompressionLevel(comprLevel),
+        fSpillDirectory(spillDirectory)
+   {
+   }
+   ULong64_t fMemoryBudget = 0;               ///< Bytes of compressed columns kept in memory, 0 to keep them uncompressed
+   ECAlgo fCompressionAlgorithm = ROOT::kLZ4; ///< Compression algorithm of the cached columns
+   int fCompressionLevel = 1;                 ///< Compression level of the cached columns
+   std::string fSpillDirectory;               ///< Directory of the temporary files, the system one if empty
+};
+} // ns RDF
+} // ns ROOT
+
+#endif
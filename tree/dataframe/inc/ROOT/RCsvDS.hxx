@@ -14,15 +14,23 @@
 #include "ROOT/RDataFrame.hxx"
 #include "ROOT/RDataSource.hxx"
 
+#include <cstddef>
 #include <deque>
 #include <list>
 #include <map>
+#include <memory>
 #include <vector>
 
 #include <TRegexp.h>
 
 namespace ROOT {
 
+namespace Internal {
+namespace RDF {
+class RCsvFileBuffer;
+}
+}
+
 namespace RDF {
 
 class RCsvDS final : public ROOT::RDF::RDataSource {
@@ -32,19 +40,23 @@ private:
    using ColType_t = char;
    static const std::map<ColType_t, std::string> fgColTypeMap;
 
-   std::streampos fDataPos = 0;
+   std::unique_ptr<ROOT::Internal::RDF::RCsvFileBuffer> fFile; // content of the file, memory-mapped when possible
+   std::size_t fDataBegin = 0;                                  // offset of the first record in the file
+   std::size_t fNextRangesBegin = 0; // offset of the first record not yet returned by GetEntryRanges
    bool fReadHeaders = false;
    unsigned int fNSlots = 0U;
-   std::ifstream fStream;
    const char fDelimiter;
    const Long64_t fLinesChunkSize;
-   ULong64_t fEntryRangesRequested = 0ULL;
    ULong64_t fProcessedLines = 0ULL; // marks the progress of the consumption of the csv lines
    std::vector<std::string> fHeaders;
    std::map<std::string, ColType_t> fColTypes;
    std::list<ColType_t> fColTypesList;
+   std::vector<ColType_t> fColTypesVec;                    // fColTypesVec[column], the same as fColTypesList
+   std::map<ULong64_t, std::size_t> fRangeBegins;          // offset of the first record of each range of the chunk
+   std::vector<std::size_t> fSlotOffsets;                  // offset of the next record each slot can parse
+   std::vector<ULong64_t> fSlotEntries;                    // entry of the next record each slot can parse
+   std::vector<std::vector<std::string>> fSlotFields;      // fields of the record being parsed by each slot
    std::vector<std::vector<void *>> fColAddresses;         // fColAddresses[column][slot]
-   std::vector<Record_t> fRecords;                         // fRecords[entry][column]
    std::vector<std::vector<double>> fDoubleEvtValues;      // one per column per slot
    std::vector<std::vector<Long64_t>> fLong64EvtValues;    // one per column per slot
    std::vector<std::vector<std::string>> fStringEvtValues; // one per column per slot
@@ -55,13 +67,13 @@ private:
    static TRegexp intRegex, doubleRegex1, doubleRegex2, trueRegex, falseRegex;
 
    void FillHeaders(const std::string &);
-   void FillRecord(const std::string &, Record_t &);
    void GenerateHeaders(size_t);
    std::vector<void *> GetColumnReadersImpl(std::string_view, const std::type_info &);
    void InferColTypes(std::vector<std::string> &);
    void InferType(const std::string &, unsigned int);
    std::vector<std::string> ParseColumns(const std::string &);
-   size_t ParseValue(const std::string &, std::vector<std::string> &, size_t);
+   std::size_t Tokenize(const char *, const char *, std::vector<std::string> &) const;
+   void SeekSlot(unsigned int slot, ULong64_t entry);
    ColType_t GetType(std::string_view colName) const;
 
 protected:
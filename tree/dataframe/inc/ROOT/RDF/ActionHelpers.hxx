@@ -25,9 +25,11 @@
 #include "ROOT/RStringView.hxx"
 #include "ROOT/RVec.hxx"
 #include "ROOT/TBufferMerger.hxx" // for SnapshotHelper
+#include "ROOT/RDF/RCacheStore.hxx" // for CacheHelper
 #include "ROOT/RDF/RCutFlowReport.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RMakeUnique.hxx"
+#include "ROOT/THistConcurrentFill.hxx"
 #include "ROOT/RSnapshotOptions.hxx"
 #include "ROOT/TypeTraits.hxx"
 #include "ROOT/RDF/RDisplay.hxx"
@@ -157,9 +159,16 @@ public:
    std::string GetActionName() { return "Report"; }
 };
 
+/// Fills a histogram whose range is only known at the end of the event loop: the values are buffered, and the range of
+/// the histogram is set to the range of the values before filling it.
+/// The buffers are bounded: when the buffer of a slot is full, its values are moved to a histogram with
+/// fgSketchBinsFactor times more bins than the result, whose axis is extended as needed. The contents of these
+/// sketches are then rebinned into the result histogram, with a resolution of one bin of the sketch. The partial
+/// results of a slot with a sketch are rebinned the same way, on the range of the values of that slot.
 class FillHelper : public RActionImpl<FillHelper> {
-   // this sets a total initial size of 16 MB for the buffers (can increase)
+   // this sets a total size of 16 MB for the buffers
    static constexpr unsigned int fgTotalBufSize = 2097152;
+   static constexpr int fgSketchBinsFactor = 64;
    using BufEl_t = double;
    using Buf_t = std::vector<BufEl_t>;
 
@@ -170,10 +179,39 @@ class FillHelper : public RActionImpl<FillHelper> {
    unsigned int fBufSize;
    /// Histograms containing "snapshots" of partial results. Non-null only if a registered callback requires it.
    Results<std::unique_ptr<Hist_t>> fPartialHists;
+   /// Histograms filled instead of the buffers once these are full, null for the slots whose buffer is not full
+   std::vector<std::unique_ptr<Hist_t>> fSketches;
    Buf_t fMin;
    Buf_t fMax;
 
    void UpdateMinMax(unsigned int slot, double v);
+   void MakeSketch(unsigned int slot);
+   static void AddSketch(Hist_t &result, const Hist_t &sketch, double min, double max);
+
+   void Buffer(unsigned int slot, double v)
+   {
+      UpdateMinMax(slot, v);
+      if (fSketches[slot]) {
+         fSketches[slot]->Fill(v);
+         return;
+      }
+      fBuffers[slot].emplace_back(v);
+      if (fBuffers[slot].size() >= fBufSize)
+         MakeSketch(slot);
+   }
+
+   void Buffer(unsigned int slot, double v, double w)
+   {
+      UpdateMinMax(slot, v);
+      if (fSketches[slot]) {
+         fSketches[slot]->Fill(v, w);
+         return;
+      }
+      fBuffers[slot].emplace_back(v);
+      fWBuffers[slot].emplace_back(w);
+      if (fBuffers[slot].size() >= fBufSize)
+         MakeSketch(slot);
+   }
 
 public:
    FillHelper(const std::shared_ptr<Hist_t> &h, const unsigned int nSlots);
@@ -186,42 +224,27 @@ public:
    template <typename T, typename std::enable_if<IsContainer<T>::value, int>::type = 0>
    void Exec(unsigned int slot, const T &vs)
    {
-      auto &thisBuf = fBuffers[slot];
-      for (auto &v : vs) {
-         UpdateMinMax(slot, v);
-         thisBuf.emplace_back(v); // TODO: Can be optimised in case T == BufEl_t
-      }
+      for (auto &v : vs)
+         Buffer(slot, v);
    }
 
    template <typename T, typename W,
              typename std::enable_if<IsContainer<T>::value && IsContainer<W>::value, int>::type = 0>
    void Exec(unsigned int slot, const T &vs, const W &ws)
    {
-      auto &thisBuf = fBuffers[slot];
-
-      for (auto &v : vs) {
-         UpdateMinMax(slot, v);
-         thisBuf.emplace_back(v);
-      }
-
-      auto &thisWBuf = fWBuffers[slot];
-      for (auto &w : ws) {
-         thisWBuf.emplace_back(w); // TODO: Can be optimised in case T == BufEl_t
-      }
+      if (vs.size() != ws.size())
+         throw std::runtime_error("Cannot fill weighted histogram with values in containers of different sizes.");
+      auto wIt = std::begin(ws);
+      for (auto &v : vs)
+         Buffer(slot, v, *wIt++);
    }
 
    template <typename T, typename W,
              typename std::enable_if<IsContainer<T>::value && !IsContainer<W>::value, int>::type = 0>
    void Exec(unsigned int slot, const T &vs, const W w)
    {
-      auto &thisBuf = fBuffers[slot];
-      for (auto &v : vs) {
-         UpdateMinMax(slot, v);
-         thisBuf.emplace_back(v); // TODO: Can be optimised in case T == BufEl_t
-      }
-
-      auto &thisWBuf = fWBuffers[slot];
-      thisWBuf.insert(thisWBuf.end(), vs.size(), w);
+      for (auto &v : vs)
+         Buffer(slot, v, w);
    }
 
    // ROOT-10092: Filling with a scalar as first column and a collection as second is not supported
@@ -254,6 +277,17 @@ extern template void FillHelper::Exec(unsigned int, const std::vector<int> &, co
 extern template void
 FillHelper::Exec(unsigned int, const std::vector<unsigned int> &, const std::vector<unsigned int> &);
 
+/// Whether FillParHelper<HIST> can fill blocks of values of NCOLS columns in one go: one column per axis and
+/// optionally a weight, for histograms that are not profiles
+template <typename HIST, std::size_t NCOLS>
+struct IsBulkFillable
+   : std::integral_constant<bool, std::is_base_of<TH1, HIST>::value && !std::is_base_of<TProfile, HIST>::value &&
+                                     !std::is_base_of<TProfile2D, HIST>::value &&
+                                     !std::is_base_of<TProfile3D, HIST>::value &&
+                                     (NCOLS == std::size_t(THistFillDim<HIST>::value) ||
+                                      NCOLS == std::size_t(THistFillDim<HIST>::value) + 1)> {
+};
+
 template <typename HIST = Hist_t>
 class FillParHelper : public RActionImpl<FillParHelper<HIST>> {
    std::vector<HIST *> fObjects;
@@ -296,6 +330,18 @@ public:
       fObjects[slot]->Fill(x0, x1, x2, x3);
    }
 
+   /// Fill the n selected entries buffered in bulk execution mode, one array of values per column, in one go:
+   /// the bins are found by blocks (see TAxis::FindFixBinN)
+   template <typename... Xs, typename H = HIST,
+             typename std::enable_if<IsBulkFillable<H, sizeof...(Xs)>::value, int>::type = 0>
+   void ExecBulk(unsigned int slot, std::size_t n, const Xs *... xs)
+   {
+      constexpr int nDim = THistFillDim<HIST>::value;
+      const double *vals[] = {xs...};
+      const double *w = int(sizeof...(Xs)) > nDim ? vals[sizeof...(Xs) - 1] : nullptr;
+      THistFillN(*fObjects[slot], static_cast<Int_t>(n), vals, w, std::integral_constant<int, nDim>());
+   }
+
    template <typename X0, typename std::enable_if<IsContainer<X0>::value, int>::type = 0>
    void Exec(unsigned int slot, const X0 &x0s)
    {
@@ -434,6 +480,116 @@ public:
    std::string GetActionName() { return "FillPar"; }
 };
 
+/// True if any of the types is a container
+template <typename... Ts>
+struct AnyContainer : std::false_type {
+};
+
+template <typename T, typename... Ts>
+struct AnyContainer<T, Ts...> : std::integral_constant<bool, IsContainer<T>::value || AnyContainer<Ts...>::value> {
+};
+
+/// Fills a single histogram from all slots through a ROOT::THistConcurrentFillManager, instead of one clone of the
+/// histogram per slot as FillParHelper does. Used for histograms too large to be cloned once per slot.
+template <typename HIST>
+class FillConcurrentHelper : public RActionImpl<FillConcurrentHelper<HIST>> {
+   using Manager_t = ROOT::THistConcurrentFillManager<HIST>;
+   using Filler_t = typename Manager_t::Filler_t;
+
+   const std::shared_ptr<HIST> fResultHist;
+   std::unique_ptr<Manager_t> fManager;
+   std::vector<std::unique_ptr<Filler_t>> fFillers;
+   /// Histograms containing "snapshots" of partial results. Non-null only if a registered callback requires it.
+   std::vector<std::unique_ptr<HIST>> fPartialHists;
+
+   template <typename T, typename std::enable_if<IsContainer<T>::value, int>::type = 0>
+   static std::size_t SizeOf(const T &c, std::size_t)
+   {
+      return c.size();
+   }
+
+   template <typename T, typename std::enable_if<!IsContainer<T>::value, int>::type = 0>
+   static std::size_t SizeOf(const T &, std::size_t n)
+   {
+      return n;
+   }
+
+   template <typename T, typename std::enable_if<IsContainer<T>::value, int>::type = 0>
+   static double ElementAt(const T &c, std::size_t i)
+   {
+      return c[i];
+   }
+
+   template <typename T, typename std::enable_if<!IsContainer<T>::value, int>::type = 0>
+   static double ElementAt(const T &v, std::size_t)
+   {
+      return v;
+   }
+
+public:
+   FillConcurrentHelper(FillConcurrentHelper &&) = default;
+   FillConcurrentHelper(const FillConcurrentHelper &) = delete;
+
+   FillConcurrentHelper(const std::shared_ptr<HIST> &h, const unsigned int nSlots)
+      : fResultHist(h), fManager(std::make_unique<Manager_t>(*h)), fFillers(nSlots), fPartialHists(nSlots)
+   {
+      for (auto &filler : fFillers)
+         filler = std::make_unique<Filler_t>(*fManager);
+   }
+
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   template <typename X0, typename... Xs,
+             typename std::enable_if<!IsContainer<X0>::value && !AnyContainer<Xs...>::value, int>::type = 0>
+   void Exec(unsigned int slot, const X0 &x0, const Xs &... xs)
+   {
+      fFillers[slot]->Fill(x0, xs...);
+   }
+
+   // ROOT-10092: Filling with a scalar as first column and a collection as second is not supported
+   template <typename X0, typename... Xs,
+             typename std::enable_if<!IsContainer<X0>::value && AnyContainer<Xs...>::value, int>::type = 0>
+   void Exec(unsigned int, const X0 &, const Xs &...)
+   {
+      throw std::runtime_error(
+        "Cannot fill object if the type of the first column is a scalar and the one of the second a container.");
+   }
+
+   template <typename X0, typename... Xs, typename std::enable_if<IsContainer<X0>::value, int>::type = 0>
+   void Exec(unsigned int slot, const X0 &x0s, const Xs &... xs)
+   {
+      const auto n = x0s.size();
+      const std::size_t sizes[] = {n, SizeOf(xs, n)...};
+      for (auto size : sizes) {
+         if (size != n)
+            throw std::runtime_error("Cannot fill histogram with values in containers of different sizes.");
+      }
+      auto &filler = *fFillers[slot];
+      for (std::size_t i = 0; i < n; ++i)
+         filler.Fill(ElementAt(x0s, i), ElementAt(xs, i)...);
+   }
+
+   void Initialize() { /* noop */}
+
+   void Finalize()
+   {
+      for (auto &filler : fFillers)
+         filler->Flush();
+   }
+
+   HIST &PartialUpdate(unsigned int slot)
+   {
+      fFillers[slot]->Flush();
+      auto &partialHist = fPartialHists[slot];
+      if (!partialHist)
+         partialHist = std::make_unique<HIST>();
+      fManager->Copy(*partialHist);
+      return *partialHist;
+   }
+
+   std::string GetActionName() { return "FillConcurrent"; }
+};
+
 class FillTGraphHelper : public ROOT::Detail::RDF::RActionImpl<FillTGraphHelper> {
 public:
    using Result_t = ::TGraph;
@@ -1408,6 +1564,92 @@ public:
    std::string GetActionName() { return "Snapshot"; }
 };
 
+/// Helper object for a Cache action with a memory budget.
+/// Each slot copies the values of the columns and fills its own TTree, in a part of the RCacheStore. The part of a slot
+/// is closed as soon as the parts in memory exceed the budget: the next entries go to a new part, on disk.
+template <typename... BranchTypes>
+class CacheHelper : public RActionImpl<CacheHelper<BranchTypes...>> {
+   const std::shared_ptr<RCacheStore> fStore;
+   std::vector<std::unique_ptr<TFile>> fFiles;
+   std::vector<std::unique_ptr<TTree>> fTrees;
+   std::vector<std::tuple<BranchTypes...>> fValues; // the branches of the trees point to these copies of the values
+   std::vector<int> fIsInMemory;          // vector<bool> does not allow concurrent writing of different elements
+   std::vector<Long64_t> fAccountedBytes; // size of the files in memory already added to the usage of the store
+   std::vector<BoolArrayMap> fBoolArrays; // needed by SetBranchesHelper, unused since RVecs are written as vectors
+
+   template <std::size_t... S>
+   void SetBranches(unsigned int slot, std::index_sequence<S...> /*dummy*/)
+   {
+      TBranch *branch = nullptr;
+      void *branchAddress = nullptr;
+      int expander[] = {(SetBranchesHelper(fBoolArrays[slot], /*inputTree=*/nullptr, *fTrees[slot], "",
+                                           RCacheStore::GetBranchName(S), branch, branchAddress,
+                                           &std::get<S>(fValues[slot])),
+                         0)...,
+                        0};
+      (void)expander; // avoid unused variable warnings for older compilers such as gcc 4.9
+      (void)slot;     // avoid unused variable warnings in gcc6.2
+   }
+
+   void OpenPart(unsigned int slot)
+   {
+      fFiles[slot] = fStore->OpenPartForWriting();
+      fIsInMemory[slot] = fFiles[slot]->InheritsFrom(TMemFile::Class());
+      fAccountedBytes[slot] = 0;
+      fTrees[slot] = std::make_unique<TTree>(RCacheStore::fgTreeName, RCacheStore::fgTreeName, /*splitlevel=*/99,
+                                             /*dir=*/fFiles[slot].get());
+      SetBranches(slot, std::index_sequence_for<BranchTypes...>());
+   }
+
+   void ClosePart(unsigned int slot)
+   {
+      const auto accountedBytes = fIsInMemory[slot] ? fAccountedBytes[slot] : 0LL;
+      fStore->ClosePart(std::move(fFiles[slot]), std::move(fTrees[slot]), accountedBytes);
+   }
+
+public:
+   using ColumnTypes_t = TypeList<BranchTypes...>;
+   CacheHelper(const std::shared_ptr<RCacheStore> &store, const unsigned int nSlots)
+      : fStore(store), fFiles(nSlots), fTrees(nSlots), fValues(nSlots), fIsInMemory(nSlots, 0),
+        fAccountedBytes(nSlots, 0), fBoolArrays(nSlots)
+   {
+   }
+   CacheHelper(const CacheHelper &) = delete;
+   CacheHelper(CacheHelper &&) = default;
+
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   void Exec(unsigned int slot, const BranchTypes &... values)
+   {
+      if (!fTrees[slot])
+         OpenPart(slot);
+      fValues[slot] = std::tie(values...);
+      fTrees[slot]->Fill();
+      if (!fIsInMemory[slot])
+         return;
+      // the file in memory grows when the tree writes a basket
+      const auto size = fFiles[slot]->GetSize();
+      if (size != fAccountedBytes[slot]) {
+         fStore->AddMemoryUsage(size - fAccountedBytes[slot]);
+         fAccountedBytes[slot] = size;
+         if (fStore->IsOverBudget())
+            ClosePart(slot);
+      }
+   }
+
+   void Initialize() { /* noop */}
+
+   void Finalize()
+   {
+      for (auto slot = 0u; slot < fTrees.size(); ++slot) {
+         if (fTrees[slot])
+            ClosePart(slot);
+      }
+   }
+
+   std::string GetActionName() { return "Cache"; }
+};
+
 template <typename Acc, typename Merge, typename R, typename T, typename U,
           bool MustCopyAssign = std::is_same<R, U>::value>
 class AggregateHelper : public RActionImpl<AggregateHelper<Acc, Merge, R, T, U, MustCopyAssign>> {
@@ -127,7 +127,7 @@ struct HistoUtils<T, false> {
    static bool HasAxisLimits(T &) { return true; }
 };
 
-// Generic filling (covers Histo2D, Histo3D, Profile1D and Profile2D actions, with and without weights)
+// Generic filling (covers Profile1D and Profile2D actions, with and without weights)
 template <typename... BranchTypes, typename ActionTag, typename ActionResultType, typename PrevNodeType>
 std::unique_ptr<RActionBase>
 BuildAction(const ColumnNames_t &bl, const std::shared_ptr<ActionResultType> &h, const unsigned int nSlots,
@@ -138,6 +138,42 @@ BuildAction(const ColumnNames_t &bl, const std::shared_ptr<ActionResultType> &h,
    return std::make_unique<Action_t>(Helper_t(h, nSlots), bl, std::move(prevNode), std::move(customColumns));
 }
 
+/// Minimum number of cells a histogram must have for its per-slot clones to be replaced by concurrent filling
+constexpr Int_t kConcurrentFillMinCells = 1 << 20;
+
+// Histo2D and Histo3D filling: large histograms are filled concurrently instead of being cloned for each slot
+template <typename... BranchTypes, typename HIST, typename PrevNodeType>
+std::unique_ptr<RActionBase>
+BuildHistoNDAction(const ColumnNames_t &bl, const std::shared_ptr<HIST> &h, const unsigned int nSlots,
+                   std::shared_ptr<PrevNodeType> prevNode, RDFInternal::RBookedCustomColumns &&customColumns)
+{
+   if (nSlots > 1 && h->GetNcells() >= kConcurrentFillMinCells) {
+      using Helper_t = FillConcurrentHelper<HIST>;
+      using Action_t = RAction<Helper_t, PrevNodeType, TTraits::TypeList<BranchTypes...>>;
+      return std::make_unique<Action_t>(Helper_t(h, nSlots), bl, std::move(prevNode), std::move(customColumns));
+   } else {
+      using Helper_t = FillParHelper<HIST>;
+      using Action_t = RAction<Helper_t, PrevNodeType, TTraits::TypeList<BranchTypes...>>;
+      return std::make_unique<Action_t>(Helper_t(h, nSlots), bl, std::move(prevNode), std::move(customColumns));
+   }
+}
+
+template <typename... BranchTypes, typename PrevNodeType>
+std::unique_ptr<RActionBase> BuildAction(const ColumnNames_t &bl, const std::shared_ptr<::TH2D> &h,
+                                         const unsigned int nSlots, std::shared_ptr<PrevNodeType> prevNode,
+                                         ActionTags::Histo2D, RDFInternal::RBookedCustomColumns &&customColumns)
+{
+   return BuildHistoNDAction<BranchTypes...>(bl, h, nSlots, std::move(prevNode), std::move(customColumns));
+}
+
+template <typename... BranchTypes, typename PrevNodeType>
+std::unique_ptr<RActionBase> BuildAction(const ColumnNames_t &bl, const std::shared_ptr<::TH3D> &h,
+                                         const unsigned int nSlots, std::shared_ptr<PrevNodeType> prevNode,
+                                         ActionTags::Histo3D, RDFInternal::RBookedCustomColumns &&customColumns)
+{
+   return BuildHistoNDAction<BranchTypes...>(bl, h, nSlots, std::move(prevNode), std::move(customColumns));
+}
+
 // Histo1D filling (must handle the special case of distinguishing FillParHelper and FillHelper
 template <typename... BranchTypes, typename PrevNodeType>
 std::unique_ptr<RActionBase> BuildAction(const ColumnNames_t &bl, const std::shared_ptr<::TH1D> &h,
@@ -248,6 +284,10 @@ void CheckCustomColumn(std::string_view definedCol, TTree *treePtr, const Column
 
 std::string PrettyPrintAddr(const void *const addr);
 
+std::vector<RColumnPredicate> FindColumnPredicates(const std::string &expression, TTree &tree,
+                                                   const std::map<std::string, std::string> &aliasMap,
+                                                   const RDFInternal::RBookedCustomColumns &customCols);
+
 void BookFilterJit(RJittedFilter *jittedFilter, void *prevNodeOnHeap, std::string_view name,
                    std::string_view expression, const std::map<std::string, std::string> &aliasMap,
                    const ColumnNames_t &branches, const RDFInternal::RBookedCustomColumns &customCols, TTree *tree,
@@ -493,6 +533,11 @@ ColumnNames_t FindUnknownColumns(const ColumnNames_t &requiredCols, const Column
 
 bool IsInternalColumn(std::string_view colName);
 
+/// Return the names of the columns used in a just-in-time compiled expression
+std::vector<std::string> FindUsedColumnNames(std::string_view expression, ColumnNames_t branches,
+                                             const ColumnNames_t &customColumns, const ColumnNames_t &dsColumns,
+                                             const std::map<std::string, std::string> &aliasMap);
+
 /// Returns the list of Filters defined in the whole graph
 std::vector<std::string> GetFilterNames(const std::shared_ptr<RLoopManager> &loopManager);
 
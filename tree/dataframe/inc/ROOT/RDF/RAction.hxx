@@ -21,6 +21,8 @@
 #include <cstddef> // std::size_t
 #include <memory>
 #include <string>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 namespace ROOT {
@@ -70,15 +72,17 @@ public:
 template <std::size_t... S, typename... ColTypes>
 void InitRDFValues(unsigned int slot, std::vector<RTypeErasedColumnValue> &values, TTreeReader *r,
                    const ColumnNames_t &bn, const RBookedCustomColumns &customCols, std::index_sequence<S...>,
-                   ROOT::TypeTraits::TypeList<ColTypes...>, const std::array<bool, sizeof...(S)> &isTmpColumn)
+                   ROOT::TypeTraits::TypeList<ColTypes...>, const std::array<bool, sizeof...(S)> &isTmpColumn,
+                   RNodeProfile *readProfile = nullptr)
 {
    using expander = int[];
    (void)slot; // avoid bogus 'unused parameter' warning
    (void)r; // avoid bogus 'unused parameter' warning
+   (void)readProfile;
    (void)expander{(values.emplace_back(std::make_unique<RColumnValue<ColTypes>>()), 0)..., 0};
    (void)expander{(isTmpColumn[S]
                       ? values[S].Cast<ColTypes>()->SetTmpColumn(slot, customCols.GetColumns().at(bn.at(S)).get())
-                      : values[S].Cast<ColTypes>()->MakeProxy(r, bn.at(S)),
+                      : values[S].Cast<ColTypes>()->MakeProxy(r, bn.at(S), slot, readProfile),
                    0)...,
                   0};
 }
@@ -96,6 +100,40 @@ void ResetRDFValueTuple(std::vector<RTypeErasedColumnValue> &values, std::index_
 template <typename Helper, typename PrevDataFrame, typename ColumnTypes_t>
 class RAction;
 
+/// Whether the values of all column types can be converted to double and buffered for bulk execution.
+template <typename... ColTypes>
+struct AllBulkColumns : std::true_type {
+};
+
+template <typename T, typename... ColTypes>
+struct AllBulkColumns<T, ColTypes...>
+   : std::integral_constant<bool, std::is_arithmetic<T>::value && AllBulkColumns<ColTypes...>::value> {
+};
+
+template <typename T>
+using BulkColumn_t = const double *;
+
+/// Whether Helper can process blocks of values of the given column types, converted to double, through
+/// `ExecBulk(slot, n, const double *...)`, with one array per column. See RLoopManager::SetBulkSize.
+template <typename Helper, typename ColumnTypes_t, typename = void>
+struct HasExecBulk : std::false_type {
+};
+
+template <typename Helper, typename... ColTypes>
+struct HasExecBulk<Helper, ROOT::TypeTraits::TypeList<ColTypes...>,
+                   decltype(std::declval<Helper &>().ExecBulk(0u, std::size_t(0),
+                                                              std::declval<BulkColumn_t<ColTypes>>()...),
+                            void())>
+   : std::integral_constant<bool, (sizeof...(ColTypes) > 0) && AllBulkColumns<ColTypes...>::value> {
+};
+
+/// Values of the selected entries not processed yet by an action in bulk execution mode, for one slot.
+struct RBulkBlock {
+   /// The values of column c are at [c * bulkSize, c * bulkSize + fN)
+   std::vector<double> fValues;
+   unsigned int fN = 0;
+};
+
 /// A common template base class for all RActions. Avoids code repetition for specializations of RActions
 /// for different helpers, implementing all of the common logic.
 template <typename Helper, typename PrevDataFrame, typename ColumnTypes_t>
@@ -132,7 +170,12 @@ public:
 
    Helper &GetHelper() { return fHelper; }
 
-   void Initialize() final { fHelper.Initialize(); }
+   void Initialize() final
+   {
+      fProfile.Init(fLoopManager->GetProfiler(), GetNSlots());
+      static_cast<Action_t *>(this)->InitBulk();
+      fHelper.Initialize();
+   }
 
    void InitSlot(TTreeReader *r, unsigned int slot) final
    {
@@ -145,14 +188,26 @@ public:
    void Run(unsigned int slot, Long64_t entry) final
    {
       // check if entry passes all filters
-      if (fPrevData.CheckFilters(slot, entry))
+      if (fPrevData.CheckFilters(slot, entry)) {
+         RProfileScope profileScope(&fProfile, slot);
          static_cast<Action_t *>(this)->Exec(slot, entry, TypeInd_t());
+      }
    }
 
+   /// Bulk execution is not supported by default: hidden by RAction when the helper supports it
+   void InitBulk() {}
+   void FlushBulk(unsigned int) {}
+
    void TriggerChildrenCount() final { fPrevData.IncrChildrenCount(); }
 
+   RNodeBase *GetPrevNode() final { return &fPrevData; }
+
    void FinalizeSlot(unsigned int slot) final
    {
+      {
+         RProfileScope profileScope(&fProfile, slot, /*countCall=*/false);
+         static_cast<Action_t *>(this)->FlushBulk(slot);
+      }
       ClearValueReaders(slot);
       for (auto &column : GetCustomColumns().GetColumns()) {
          column.second->ClearValueReaders(slot);
@@ -175,7 +230,7 @@ public:
 
       // Action nodes do not need to ask an helper to create the graph nodes. They are never common nodes between
       // multiple branches
-      auto thisNode = std::make_shared<RDFGraphDrawing::GraphNode>(fHelper.GetActionName());
+      auto thisNode = std::make_shared<RDFGraphDrawing::GraphNode>(fHelper.GetActionName() + fProfile.GetSummary());
       auto evaluatedNode = thisNode;
       for (auto &column : GetCustomColumns().GetColumns()) {
          /* Each column that this node has but the previous hadn't has been defined in between,
@@ -195,9 +250,18 @@ public:
       return thisNode;
    }
 
+   std::string GetActionName() final { return fHelper.GetActionName(); }
+
    /// This method is invoked to update a partial result during the event loop, right before passing the result to a
    /// user-defined callback registered via RResultPtr::RegisterCallback
-   void *PartialUpdate(unsigned int slot) final { return PartialUpdateImpl(slot); }
+   void *PartialUpdate(unsigned int slot) final
+   {
+      {
+         RProfileScope profileScope(&fProfile, slot, /*countCall=*/false);
+         static_cast<Action_t *>(this)->FlushBulk(slot);
+      }
+      return PartialUpdateImpl(slot);
+   }
 
 private:
    // this overload is SFINAE'd out if Helper does not implement `PartialUpdate`
@@ -215,28 +279,86 @@ private:
 /// An action node in a RDF computation graph.
 template <typename Helper, typename PrevDataFrame, typename ColumnTypes_t = typename Helper::ColumnTypes_t>
 class RAction final : public RActionCRTP<RAction<Helper, PrevDataFrame, ColumnTypes_t>> {
+   using HasExecBulk_t = HasExecBulk<Helper, ColumnTypes_t>;
+
    std::vector<RDFValueTuple_t<ColumnTypes_t>> fValues;
+   /// Values of the selected entries not processed yet, per slot. Only used in bulk execution mode.
+   std::vector<RBulkBlock> fBulkBlocks;
+   /// Number of entries in a block after which they are processed, 0 if bulk execution is disabled.
+   unsigned int fBulkSize = 0;
+
+   template <std::size_t... S>
+   void BufferValues(unsigned int slot, Long64_t entry, std::index_sequence<S...>, std::true_type)
+   {
+      auto &block = fBulkBlocks[slot];
+      double *values = block.fValues.data() + block.fN;
+      using expander = int[];
+      (void)expander{(values[S * fBulkSize] = std::get<S>(fValues[slot]).Get(entry), 0)..., 0};
+      if (++block.fN == fBulkSize)
+         FlushBulk(slot);
+   }
+
+   template <std::size_t... S>
+   void BufferValues(unsigned int, Long64_t, std::index_sequence<S...>, std::false_type)
+   {
+   }
+
+   template <std::size_t... S>
+   void ExecBulk(unsigned int slot, std::index_sequence<S...>, std::true_type)
+   {
+      auto &block = fBulkBlocks[slot];
+      if (block.fN == 0)
+         return;
+      const double *values = block.fValues.data();
+      ActionCRTP_t::GetHelper().ExecBulk(slot, block.fN, (values + S * fBulkSize)...);
+      block.fN = 0;
+   }
+
+   template <std::size_t... S>
+   void ExecBulk(unsigned int, std::index_sequence<S...>, std::false_type)
+   {
+   }
 
 public:
    using ActionCRTP_t = RActionCRTP<RAction<Helper, PrevDataFrame, ColumnTypes_t>>;
 
    RAction(Helper &&h, const ColumnNames_t &bl, std::shared_ptr<PrevDataFrame> pd,
            RBookedCustomColumns &&customColumns)
-      : ActionCRTP_t(std::forward<Helper>(h), bl, std::move(pd), std::move(customColumns)), fValues(GetNSlots()) { }
+      : ActionCRTP_t(std::forward<Helper>(h), bl, std::move(pd), std::move(customColumns)), fValues(GetNSlots()),
+        fBulkBlocks(GetNSlots())
+   {
+   }
 
    void InitColumnValues(TTreeReader *r, unsigned int slot)
    {
       InitRDFValues(slot, fValues[slot], r, RActionBase::GetColumnNames(), RActionBase::GetCustomColumns(),
-                    typename ActionCRTP_t::TypeInd_t{}, ActionCRTP_t::fIsCustomColumn);
+                    typename ActionCRTP_t::TypeInd_t{}, ActionCRTP_t::fIsCustomColumn,
+                    RActionBase::GetLoopManager()->GetReadProfile());
+   }
+
+   /// Enable bulk execution for the next event loop if it was requested and the helper supports it
+   void InitBulk()
+   {
+      fBulkSize = HasExecBulk_t::value ? RActionBase::GetLoopManager()->GetBulkSize() : 0;
+      for (auto &block : fBulkBlocks) {
+         block.fValues.resize(fBulkSize * ColumnTypes_t::list_size);
+         block.fN = 0;
+      }
    }
 
    template <std::size_t... S>
-   void Exec(unsigned int slot, Long64_t entry, std::index_sequence<S...>)
+   void Exec(unsigned int slot, Long64_t entry, std::index_sequence<S...> s)
    {
       (void)entry; // avoid bogus 'unused parameter' warning in gcc4.9
-      ActionCRTP_t::GetHelper().Exec(slot, std::get<S>(fValues[slot]).Get(entry)...);
+      if (fBulkSize)
+         BufferValues(slot, entry, s, HasExecBulk_t{});
+      else
+         ActionCRTP_t::GetHelper().Exec(slot, std::get<S>(fValues[slot]).Get(entry)...);
    }
 
+   /// Process the buffered values of slot, in bulk execution mode
+   void FlushBulk(unsigned int slot) { ExecBulk(slot, typename ActionCRTP_t::TypeInd_t{}, HasExecBulk_t{}); }
+
    template <std::size_t... S>
    void ResetColumnValues(unsigned int slot, std::index_sequence<S...> s)
    {
@@ -278,7 +400,8 @@ public:
    void InitColumnValues(TTreeReader *r, unsigned int slot)
    {
       InitRDFValues(slot, fValues[slot], r, RActionBase::GetColumnNames(), RActionBase::GetCustomColumns(),
-                    typename ActionCRTP_t::TypeInd_t{}, ColumnTypes_t{}, ActionCRTP_t::fIsCustomColumn);
+                    typename ActionCRTP_t::TypeInd_t{}, ColumnTypes_t{}, ActionCRTP_t::fIsCustomColumn,
+                    RActionBase::GetLoopManager()->GetReadProfile());
    }
 
    template <std::size_t... S>
@@ -318,7 +441,8 @@ public:
    void InitColumnValues(TTreeReader *r, unsigned int slot)
    {
       InitRDFValues(slot, fValues[slot], r, RActionBase::GetColumnNames(), RActionBase::GetCustomColumns(),
-                    typename ActionCRTP_t::TypeInd_t{}, ColumnTypes_t{}, ActionCRTP_t::fIsCustomColumn);
+                    typename ActionCRTP_t::TypeInd_t{}, ColumnTypes_t{}, ActionCRTP_t::fIsCustomColumn,
+                    RActionBase::GetLoopManager()->GetReadProfile());
    }
 
    template <std::size_t... S>
@@ -12,6 +12,7 @@
 #define ROOT_RACTIONBASE
 
 #include "ROOT/RDF/RBookedCustomColumns.hxx"
+#include "ROOT/RDF/RNodeProfile.hxx"
 #include "ROOT/RDF/Utils.hxx" // ColumnNames_t
 #include "RtypesCore.h"
 
@@ -24,6 +25,7 @@ namespace Detail {
 namespace RDF {
 class RLoopManager;
 class RCustomColumnBase;
+class RNodeBase;
 }
 }
 
@@ -46,6 +48,7 @@ protected:
    /// A raw pointer to the RLoopManager at the root of this functional graph.
    /// Never null: children nodes have shared ownership of parent nodes in the graph.
    RLoopManager *fLoopManager;
+   RNodeProfile fProfile; ///< Timings of the executions of this action, see RLoopManager::SetProfiling
 
 private:
    const unsigned int fNSlots; ///< Number of thread slots used by this node.
@@ -80,6 +83,11 @@ public:
    virtual void SetHasRun() { fHasRun = true; }
 
    virtual std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> GetGraph() = 0;
+   virtual std::string GetActionName() = 0;
+   // overridden by RJittedAction
+   virtual const RNodeProfile &GetProfile() const { return fProfile; }
+   /// The node upstream of this action, null if not known yet
+   virtual RNodeBase *GetPrevNode() = 0;
 };
 
 } // ns RDF
@@ -0,0 +1,254 @@
+// @(#)root/dataframe:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RCACHEDS
+#define ROOT_RCACHEDS
+
+#include "ROOT/RDataSource.hxx"
+#include "ROOT/RDF/RCacheStore.hxx"
+#include "ROOT/RDF/Utils.hxx"
+#include "ROOT/RIntegerSequence.hxx"
+#include "ROOT/RMakeUnique.hxx"
+#include "ROOT/RResultPtr.hxx"
+#include "ROOT/RVec.hxx"
+#include "TFile.h"
+#include "TTree.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// Value of a cached column read back from the tree of a part of a RCacheStore
+template <typename T>
+struct RCachedValue {
+   T fValue{};
+   void SetBranchAddress(TTree &tree, const std::string &branchName)
+   {
+      tree.SetBranchAddress(branchName.c_str(), &fValue);
+   }
+   void Update() {}
+};
+
+/// RVecs are written as std::vectors: the RVec is a view on the vector read from the tree
+template <typename T>
+struct RCachedValue<ROOT::VecOps::RVec<T>> {
+   std::vector<T> fVector;
+   ROOT::VecOps::RVec<T> fValue;
+   void SetBranchAddress(TTree &tree, const std::string &branchName)
+   {
+      tree.SetBranchAddress(branchName.c_str(), &fVector);
+   }
+   void Update()
+   {
+      ROOT::VecOps::RVec<T> rvec(fVector.data(), fVector.size());
+      std::swap(fValue, rvec);
+   }
+};
+
+/// std::vector<bool> has no data(): the content is copied
+template <>
+inline void RCachedValue<ROOT::VecOps::RVec<bool>>::Update()
+{
+   ROOT::VecOps::RVec<bool> rvec(fVector.begin(), fVector.end());
+   std::swap(fValue, rvec);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief The RDataSource of the RDataFrame returned by Cache when a memory budget is given.
+///
+/// The columns are read from the parts of a RCacheStore, which the Cache action of the parent data frame fills.
+/// As for RLazyDS, the event loop of the parent data frame runs when the one of this data source starts.
+/// Each slot opens its own file and tree, so the slots read and decompress the baskets in parallel. The ranges of
+/// entries never span two parts.
+template <typename... ColumnTypes>
+class RCacheDS final : public ROOT::RDF::RDataSource {
+   using Values_t = std::tuple<RCachedValue<ColumnTypes>...>;
+
+   ROOT::RDF::RResultPtr<RCacheStore> fStore;
+   const std::vector<std::string> fColNames;
+   const std::map<std::string, std::string> fColTypesMap;
+   unsigned int fNSlots{0};
+   std::vector<std::unique_ptr<Values_t>> fValues;  // per slot
+   std::vector<std::vector<void *>> fValuePtrs;     // per column, per slot: the cursors returned to RDataFrame
+   std::vector<std::unique_ptr<TFile>> fFiles;      // per slot
+   std::vector<TTree *> fTrees;                     // per slot, owned by the file
+   std::vector<int> fSlotParts;                     // per slot, part opened by the slot, -1 if none
+   std::vector<ULong64_t> fPartFirstEntries;        // first entry of each part, followed by the total number of entries
+   std::vector<std::pair<ULong64_t, ULong64_t>> fEntryRanges{};
+
+   Record_t GetColumnReadersImpl(std::string_view colName, const std::type_info &id)
+   {
+      const auto colNameStr = std::string(colName);
+      const auto it = fColTypesMap.find(colNameStr);
+      if (fColTypesMap.end() == it) {
+         std::string err = "The specified column name, \"" + colNameStr + "\" is not known to the data source.";
+         throw std::runtime_error(err);
+      }
+      const auto idName = ROOT::Internal::RDF::TypeID2TypeName(id);
+      if (it->second != idName) {
+         std::string err = "Column " + colNameStr + " has type " + it->second +
+                           " while the id specified is associated to type " + idName;
+         throw std::runtime_error(err);
+      }
+
+      const auto index = std::distance(fColNames.begin(), std::find(fColNames.begin(), fColNames.end(), colName));
+      Record_t ret(fNSlots);
+      for (auto slot = 0u; slot < fNSlots; ++slot)
+         ret[slot] = &fValuePtrs[index][slot];
+      return ret;
+   }
+
+   template <std::size_t... S>
+   void SetValuePtrs(unsigned int slot, std::index_sequence<S...>)
+   {
+      std::initializer_list<int> expander{(fValuePtrs[S][slot] = &std::get<S>(*fValues[slot]).fValue, 0)...};
+      (void)expander; // avoid unused variable warnings
+   }
+
+   template <std::size_t... S>
+   void SetBranchAddresses(unsigned int slot, std::index_sequence<S...>)
+   {
+      std::initializer_list<int> expander{
+         (std::get<S>(*fValues[slot]).SetBranchAddress(*fTrees[slot], RCacheStore::GetBranchName(S)), 0)...};
+      (void)expander; // avoid unused variable warnings
+   }
+
+   template <std::size_t... S>
+   void UpdateValues(unsigned int slot, std::index_sequence<S...>)
+   {
+      std::initializer_list<int> expander{(std::get<S>(*fValues[slot]).Update(), 0)...};
+      (void)expander; // avoid unused variable warnings
+   }
+
+   void CloseFiles()
+   {
+      for (auto slot = 0u; slot < fNSlots; ++slot) {
+         fTrees[slot] = nullptr;
+         fFiles[slot].reset();
+         fSlotParts[slot] = -1;
+      }
+   }
+
+protected:
+   std::string AsString() { return "cache data source"; };
+
+public:
+   RCacheDS(const std::vector<std::string> &colNames, const ROOT::RDF::RResultPtr<RCacheStore> &store)
+      : fStore(store), fColNames(colNames), fColTypesMap(MakeColTypesMap(colNames))
+   {
+   }
+
+   ~RCacheDS()
+   {
+      // the trees must go before the values they read into
+      CloseFiles();
+   }
+
+   static std::map<std::string, std::string> MakeColTypesMap(const std::vector<std::string> &colNames)
+   {
+      const std::vector<std::string> typeNames{ROOT::Internal::RDF::TypeID2TypeName(typeid(ColumnTypes))...};
+      std::map<std::string, std::string> colTypes;
+      for (auto i = 0u; i < colNames.size(); ++i)
+         colTypes[colNames[i]] = typeNames[i];
+      return colTypes;
+   }
+
+   const std::vector<std::string> &GetColumnNames() const { return fColNames; }
+
+   bool HasColumn(std::string_view colName) const
+   {
+      return fColTypesMap.end() != fColTypesMap.find(std::string(colName));
+   }
+
+   std::string GetTypeName(std::string_view colName) const { return fColTypesMap.at(std::string(colName)); }
+
+   void SetNSlots(unsigned int nSlots)
+   {
+      fNSlots = nSlots;
+      fValuePtrs.assign(fColNames.size(), std::vector<void *>(fNSlots, nullptr));
+      fFiles.resize(fNSlots);
+      fTrees.assign(fNSlots, nullptr);
+      fSlotParts.assign(fNSlots, -1);
+      for (auto slot = 0u; slot < fNSlots; ++slot) {
+         fValues.emplace_back(std::make_unique<Values_t>());
+         SetValuePtrs(slot, std::index_sequence_for<ColumnTypes...>());
+      }
+   }
+
+   void Initialise()
+   {
+      // this runs the event loop of the parent data frame, the first time
+      const auto &parts = fStore->GetParts();
+      fPartFirstEntries.assign(1, 0ULL);
+      for (const auto &part : parts)
+         fPartFirstEntries.emplace_back(fPartFirstEntries.back() + part.fEntries);
+
+      // a few ranges per slot and part, to balance the load
+      fEntryRanges.clear();
+      for (const auto &part : parts) {
+         const auto first = fPartFirstEntries[&part - parts.data()];
+         const auto nRanges = std::min<ULong64_t>(part.fEntries, 1U == fNSlots ? 1U : 2U * fNSlots);
+         for (auto i = 0ULL; i < nRanges; ++i)
+            fEntryRanges.emplace_back(first + i * part.fEntries / nRanges, first + (i + 1) * part.fEntries / nRanges);
+      }
+   }
+
+   std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges()
+   {
+      auto entryRanges(std::move(fEntryRanges)); // empty fEntryRanges
+      return entryRanges;
+   }
+
+   void InitSlot(unsigned int slot, ULong64_t firstEntry)
+   {
+      const int part =
+         std::upper_bound(fPartFirstEntries.begin(), fPartFirstEntries.end(), firstEntry) - fPartFirstEntries.begin() -
+         1;
+      if (part == fSlotParts[slot])
+         return;
+      fTrees[slot] = nullptr;
+      fFiles[slot] = fStore->OpenPartForReading(part);
+      fTrees[slot] = static_cast<TTree *>(fFiles[slot]->Get(RCacheStore::fgTreeName));
+      if (!fTrees[slot])
+         throw std::runtime_error("Cannot read the tree of the part " + std::to_string(part) +
+                                  " of the cached columns.");
+      if (fFiles[slot]->InheritsFrom(TMemFile::Class()))
+         fTrees[slot]->SetCacheSize(0); // the baskets are in memory already
+      SetBranchAddresses(slot, std::index_sequence_for<ColumnTypes...>());
+      fSlotParts[slot] = part;
+   }
+
+   bool SetEntry(unsigned int slot, ULong64_t entry)
+   {
+      fTrees[slot]->GetEntry(entry - fPartFirstEntries[fSlotParts[slot]]);
+      UpdateValues(slot, std::index_sequence_for<ColumnTypes...>());
+      return true;
+   }
+
+   void Finalise() { CloseFiles(); }
+
+   std::string GetLabel() { return "CacheDS"; }
+};
+
+} // ns RDF
+} // ns Internal
+} // ns ROOT
+
+#endif
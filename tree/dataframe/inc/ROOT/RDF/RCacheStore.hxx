@@ -0,0 +1,74 @@
+// @(#)root/dataframe:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RCACHESTORE
+#define ROOT_RCACHESTORE
+
+#include "ROOT/RCacheOptions.hxx"
+#include "RtypesCore.h"
+#include "TMemFile.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class TFile;
+class TTree;
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// Storage of the columns cached by RInterface::Cache when a memory budget is given.
+///
+/// The columns are written as the branches of TTrees, in parts that hold a subset of the entries. Each part is a
+/// ROOT file, so the values are kept compressed, in baskets. The parts are ROOT files in memory while the memory
+/// budget allows it, temporary ROOT files on local disk afterwards. The temporary files are removed by the destructor.
+class RCacheStore {
+public:
+   struct RPart {
+      TMemFile::ExternalDataPtr_t fData; ///< Content of the ROOT file of a part kept in memory
+      std::string fFileName;             ///< Name of the temporary ROOT file of a part spilled to disk
+      ULong64_t fEntries = 0;            ///< Number of entries of the part
+   };
+
+private:
+   const ROOT::RDF::RCacheOptions fOptions;
+   std::atomic<Long64_t> fMemoryUsage{0};   ///< Bytes of the parts in memory, including the ones being written
+   std::mutex fMutex;                       ///< Protects fParts and fTempFileNames
+   std::vector<RPart> fParts;               ///< Parts closed so far
+   std::vector<std::string> fTempFileNames; ///< Temporary files created so far
+
+public:
+   static constexpr const char *fgTreeName = "cache";
+   static std::string GetBranchName(unsigned int column) { return "c" + std::to_string(column); }
+
+   RCacheStore(const ROOT::RDF::RCacheOptions &options);
+   RCacheStore(const RCacheStore &) = delete;
+   RCacheStore &operator=(const RCacheStore &) = delete;
+   ~RCacheStore();
+
+   std::unique_ptr<TFile> OpenPartForWriting();
+   void AddMemoryUsage(Long64_t bytes) { fMemoryUsage += bytes; }
+   bool IsOverBudget() const { return ULong64_t(fMemoryUsage.load()) > fOptions.fMemoryBudget; }
+   Long64_t GetMemoryUsage() const { return fMemoryUsage; }
+   void ClosePart(std::unique_ptr<TFile> file, std::unique_ptr<TTree> tree, Long64_t accountedBytes);
+
+   const std::vector<RPart> &GetParts() const { return fParts; }
+   std::unique_ptr<TFile> OpenPartForReading(std::size_t part) const;
+};
+
+} // ns RDF
+} // ns Internal
+} // ns ROOT
+
+#endif
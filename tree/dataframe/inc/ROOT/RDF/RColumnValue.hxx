@@ -74,7 +74,7 @@ class R__CLING_PTRCHECK(off) RColumnValue {
    enum class EColumnKind { kTree, kCustomColumn, kDataSource, kInvalid };
    // Set to the correct value by MakeProxy or SetTmpColumn
    EColumnKind fColumnKind = EColumnKind::kInvalid;
-   /// The slot this value belongs to. Only needed when querying custom column values, it is set in `SetTmpColumn`.
+   /// The slot this value belongs to. Needed when querying custom column values or profiling the reading of branches.
    unsigned int fSlot = std::numeric_limits<unsigned int>::max();
 
    // Each element of the following stacks will be in use by a _single task_.
@@ -98,6 +98,8 @@ class R__CLING_PTRCHECK(off) RColumnValue {
    /// If MustUseRVec, i.e. we are reading an array, we return a reference to this RVec to clients
    RVec<ColumnValue_t> fRVec;
    bool fCopyWarningPrinted = false;
+   /// Timings of the reading of the data, non-null only for TTree branches read during a profiled event loop.
+   RNodeProfile *fReadProfile = nullptr;
 
 public:
    RColumnValue(){};
@@ -145,10 +147,12 @@ public:
       fSlot = slot;
    }
 
-   void MakeProxy(TTreeReader *r, const std::string &bn)
+   void MakeProxy(TTreeReader *r, const std::string &bn, unsigned int slot = 0, RNodeProfile *readProfile = nullptr)
    {
       fColumnKind = EColumnKind::kTree;
       fTreeReader = std::make_unique<TreeReader_t>(*r, bn.c_str());
+      fSlot = slot;
+      fReadProfile = readProfile;
    }
 
    /// This overload is used to return scalar quantities (i.e. types that are not read into a RVec)
@@ -159,6 +163,8 @@ public:
    T &Get(Long64_t entry)
    {
       if (fColumnKind == EColumnKind::kTree) {
+         // branches are read and decompressed on demand, here
+         RProfileScope profileScope(fReadProfile, fSlot);
          return *(fTreeReader->Get());
       } else {
          fCustomColumn->Update(fSlot, entry);
@@ -175,6 +181,7 @@ public:
    T &Get(Long64_t entry)
    {
       if (fColumnKind == EColumnKind::kTree) {
+         RProfileScope profileScope(fReadProfile, fSlot);
          auto &readerArray = *fTreeReader;
          // We only use TTreeReaderArrays to read columns that users flagged as type `RVec`, so we need to check
          // that the branch stores the array as contiguous memory that we can actually wrap in an `RVec`.
@@ -242,6 +249,7 @@ public:
    T &Get(Long64_t entry)
    {
       if (fColumnKind == EColumnKind::kTree) {
+         RProfileScope profileScope(fReadProfile, fSlot);
          auto &readerArray = *fTreeReader;
          const auto readerArraySize = readerArray.GetSize();
          if (readerArraySize > 0) {
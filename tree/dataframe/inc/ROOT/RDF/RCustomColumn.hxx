@@ -14,6 +14,7 @@
 #include "ROOT/RDF/NodesUtils.hxx"
 #include "ROOT/RDF/RColumnValue.hxx"
 #include "ROOT/RDF/RCustomColumnBase.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RIntegerSequence.hxx"
 #include "ROOT/RStringView.hxx"
@@ -113,7 +114,8 @@ public:
    {
       if (!fIsInitialized[slot]) {
          fIsInitialized[slot] = true;
-         RDFInternal::InitRDFValues(slot, fValues[slot], r, fColumnNames, fCustomColumns, TypeInd_t(), fIsCustomColumn);
+         RDFInternal::InitRDFValues(slot, fValues[slot], r, fColumnNames, fCustomColumns, TypeInd_t(), fIsCustomColumn,
+                                    fLoopManager->GetReadProfile());
       }
    }
 
@@ -123,6 +125,7 @@ public:
    {
       if (entry != fLastCheckedEntry[slot]) {
          // evaluate this filter, cache the result
+         RDFInternal::RProfileScope profileScope(&fProfile, slot);
          UpdateHelper(slot, entry, TypeInd_t(), ColumnTypes_t(), ExtraArgsTag{});
          fLastCheckedEntry[slot] = entry;
       }
@@ -140,6 +143,8 @@ public:
          fIsInitialized[slot] = false;
       }
    }
+
+   const ColumnNames_t &GetColumnNames() const final { return fColumnNames; }
 };
 
 } // ns RDF
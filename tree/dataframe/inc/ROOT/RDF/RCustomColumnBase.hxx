@@ -13,6 +13,7 @@
 
 #include "ROOT/RDF/GraphNode.hxx"
 #include "ROOT/RDF/RBookedCustomColumns.hxx"
+#include "ROOT/RDF/RNodeProfile.hxx"
 
 #include <memory>
 #include <string>
@@ -43,6 +44,7 @@ protected:
    const unsigned int fID = GetNextID();
    RDFInternal::RBookedCustomColumns fCustomColumns;
    std::deque<bool> fIsInitialized; // because vector<bool> is not thread-safe
+   RDFInternal::RNodeProfile fProfile; ///< Timings of the evaluations of this column, see RLoopManager::SetProfiling
 
    static unsigned int GetNextID();
 
@@ -63,6 +65,11 @@ public:
    virtual void InitNode();
    /// Return the unique identifier of this RCustomColumnBase.
    unsigned int GetID() const { return fID; }
+   virtual const RDFInternal::RNodeProfile &GetProfile() const { return fProfile; }
+   /// The names of the columns this column is computed from
+   virtual const std::vector<std::string> &GetColumnNames() const = 0;
+   /// The custom columns that were defined when this column was, i.e. the ones its input columns can refer to
+   virtual const RDFInternal::RBookedCustomColumns &GetBookedColumns() const { return fCustomColumns; }
 };
 
 } // ns RDF
@@ -83,13 +83,15 @@ public:
 
    bool CheckFilters(unsigned int slot, Long64_t entry) final
    {
+      if (IsReordered())
+         return CheckReorderedChain(slot, entry);
       if (entry != fLastCheckedEntry[slot]) {
          if (!fPrevData.CheckFilters(slot, entry)) {
             // a filter upstream returned false, cache the result
             fLastResult[slot] = false;
          } else {
             // evaluate this filter, cache the result
-            auto passed = CheckFilterHelper(slot, entry, TypeInd_t());
+            auto passed = EvalPredicate(slot, entry);
             passed ? ++fAccepted[slot] : ++fRejected[slot];
             fLastResult[slot] = passed;
          }
@@ -98,6 +100,16 @@ public:
       return fLastResult[slot];
    }
 
+   bool EvalPredicate(unsigned int slot, Long64_t entry) final
+   {
+      RDFInternal::RProfileScope profileScope(&fProfile, slot);
+      return CheckFilterHelper(slot, entry, TypeInd_t());
+   }
+
+   RNodeBase *GetPrevNode() final { return &fPrevData; }
+
+   const ColumnNames_t &GetColumnNames() const final { return fColumnNames; }
+
    template <std::size_t... S>
    bool CheckFilterHelper(unsigned int slot, Long64_t entry, std::index_sequence<S...>)
    {
@@ -111,7 +123,8 @@ public:
    {
       for (auto &bookedBranch : fCustomColumns.GetColumns())
          bookedBranch.second->InitSlot(r, slot);
-      RDFInternal::InitRDFValues(slot, fValues[slot], r, fColumnNames, fCustomColumns, TypeInd_t(), fIsCustomColumn);
+      RDFInternal::InitRDFValues(slot, fValues[slot], r, fColumnNames, fCustomColumns, TypeInd_t(), fIsCustomColumn,
+                                 fLoopManager->GetReadProfile());
    }
 
    // recursive chain of `Report`s
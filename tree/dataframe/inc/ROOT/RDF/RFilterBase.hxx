@@ -13,6 +13,8 @@
 
 #include "ROOT/RDF/RBookedCustomColumns.hxx"
 #include "ROOT/RDF/RNodeBase.hxx"
+#include "ROOT/RDF/RNodeProfile.hxx"
+#include "ROOT/RDF/Utils.hxx" // ColumnNames_t
 #include "RtypesCore.h"
 #include "TError.h" // R_ASSERT
 
@@ -27,6 +29,32 @@ namespace RDF {
 class RCutFlowReport;
 } // ns RDF
 
+namespace Internal {
+namespace RDF {
+/// A comparison of a TTree branch with a constant, which entries must satisfy to pass a filter.
+/// Used to skip the clusters of entries whose range of values cannot satisfy it, see TTreeClusterStats.
+struct RColumnPredicate {
+   enum class EOp { kLess, kLessEqual, kGreater, kGreaterEqual, kEqual };
+   std::string fColumn;
+   EOp fOp;
+   double fValue;
+
+   /// Whether some value in [min, max] satisfies the predicate. NaN values satisfy none.
+   bool MayPass(double min, double max) const
+   {
+      switch (fOp) {
+      case EOp::kLess: return min < fValue;
+      case EOp::kLessEqual: return min <= fValue;
+      case EOp::kGreater: return max > fValue;
+      case EOp::kGreaterEqual: return max >= fValue;
+      case EOp::kEqual: return min <= fValue && fValue <= max;
+      }
+      return true;
+   }
+};
+} // ns RDF
+} // ns Internal
+
 namespace Detail {
 namespace RDF {
 namespace RDFInternal = ROOT::Internal::RDF;
@@ -34,6 +62,35 @@ namespace RDFInternal = ROOT::Internal::RDF;
 class RLoopManager;
 
 class RFilterBase : public RNodeBase {
+   /// Cost and selectivity of this filter, measured in one processing slot while learning the best evaluation order
+   struct RFilterStats {
+      ULong64_t fNEvaluations = 0;
+      ULong64_t fNPassed = 0;
+      double fRealTime = 0.;
+   };
+   /// Evaluation order of the chain of filters ending with this filter, in one processing slot
+   struct RChainState {
+      std::vector<unsigned int> fOrder; ///< indices in fChain
+      ULong64_t fNChecked = 0;          ///< number of entries that reached the chain
+   };
+
+   /// If the filter reordering is enabled, the consecutive unnamed filters that end with this one, in booking order
+   std::vector<RFilterBase *> fChain;
+   /// For each filter of fChain, the filters of fChain that must be evaluated before it
+   std::vector<std::vector<unsigned int>> fChainDeps;
+   RNodeBase *fChainPrev = nullptr; ///< The node upstream of fChain
+   std::vector<RChainState> fChainStates;
+   std::vector<RFilterStats> fStats;
+   std::vector<Long64_t> fLastEvaluatedEntry; ///< Entry of the last evaluation of this filter's own predicate
+   std::vector<int> fLastPredicateResult;
+   /// Number of entries used to measure cost and selectivity of the filters in each slot, 0 if reordering is disabled
+   ULong64_t fNLearningEntries = 0;
+   /// Comparisons that all entries passing this filter satisfy, see RLoopManager::InitClusterSkipping
+   std::vector<RDFInternal::RColumnPredicate> fPredicates;
+
+   bool CheckPredicate(unsigned int slot, Long64_t entry);
+   void ComputeChainOrder(unsigned int slot);
+
 protected:
    std::vector<Long64_t> fLastCheckedEntry;
    std::vector<int> fLastResult = {true}; // std::vector<bool> cannot be used in a MT context safely
@@ -43,6 +100,10 @@ protected:
    const unsigned int fNSlots; ///< Number of thread slots used by this node, inherited from parent node.
 
    RDFInternal::RBookedCustomColumns fCustomColumns;
+   RDFInternal::RNodeProfile fProfile; ///< Timings of the evaluations of this filter, see RLoopManager::SetProfiling
+
+   bool IsReordered() const { return !fChain.empty(); }
+   bool CheckReorderedChain(unsigned int slot, Long64_t entry);
 
 public:
    RFilterBase(RLoopManager *df, std::string_view name, const unsigned int nSlots,
@@ -67,6 +128,16 @@ public:
    virtual void ClearTask(unsigned int slot) = 0;
    virtual void InitNode();
    virtual void AddFilterName(std::vector<std::string> &filters) = 0;
+   virtual const RDFInternal::RNodeProfile &GetProfile() const { return fProfile; }
+   /// Evaluate the predicate of this filter alone, regardless of the upstream filters
+   virtual bool EvalPredicate(unsigned int slot, Long64_t entry) = 0;
+   virtual RNodeBase *GetPrevNode() = 0;
+   virtual const ColumnNames_t &GetColumnNames() const = 0;
+   virtual const RDFInternal::RBookedCustomColumns &GetBookedColumns() const { return fCustomColumns; }
+   void InitReordering(ULong64_t nLearningEntries);
+   void SetChain(const std::vector<RFilterBase *> &chain, RNodeBase *chainPrev);
+   void SetPredicates(const std::vector<RDFInternal::RColumnPredicate> &predicates) { fPredicates = predicates; }
+   const std::vector<RDFInternal::RColumnPredicate> &GetPredicates() const { return fPredicates; }
 };
 
 } // ns RDF
@@ -14,12 +14,16 @@
 #include "ROOT/RDataSource.hxx"
 #include "ROOT/RDF/ActionHelpers.hxx"
 #include "ROOT/RDF/RBookedCustomColumns.hxx"
+#include "ROOT/RDF/RCacheDS.hxx"
 #include "ROOT/RDF/HistoModels.hxx"
 #include "ROOT/RDF/InterfaceUtils.hxx"
+#include "ROOT/RDF/RProfileReport.hxx"
 #include "ROOT/RDF/RRange.hxx"
+#include "ROOT/RDF/RVariations.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RIntegerSequence.hxx"
 #include "ROOT/RDF/RLazyDSImpl.hxx"
+#include "ROOT/RCacheOptions.hxx"
 #include "ROOT/RResultPtr.hxx"
 #include "ROOT/RSnapshotOptions.hxx"
 #include "ROOT/RStringView.hxx"
@@ -107,6 +111,9 @@ class RInterface {
    /// Contains the custom columns defined up to this node.
    RDFInternal::RBookedCustomColumns fCustomColumns;
 
+   /// The systematic variations declared up to this node, see Vary().
+   RDFInternal::RVariations_t<Proxied> fVariations;
+
 public:
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Copy-assignment operator for RInterface.
@@ -150,7 +157,7 @@ public:
    operator RNode() const
    {
       return RNode(std::static_pointer_cast<::ROOT::Detail::RDF::RNodeBase>(fProxiedPtr), *fLoopManager, fCustomColumns,
-                   fDataSource);
+                   fDataSource, RDFInternal::ConvertVariations<::ROOT::Detail::RDF::RNodeBase>(fVariations));
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -195,9 +202,16 @@ public:
 
       using F_t = RDFDetail::RFilter<F, Proxied>;
 
+      // varied filters are not named, so that they do not appear in the cutflow report
+      auto variations = VaryNode<F_t>(validColumnNames, [&](const RDFInternal::RVariation<Proxied> &v) {
+         return std::make_shared<F_t>(RDFInternal::CopyForVariation(f), v.Substitute(validColumnNames), v.fNode,
+                                      newColumns, "");
+      });
+
       auto filterPtr = std::make_shared<F_t>(std::move(f), validColumnNames, fProxiedPtr, newColumns, name);
       fLoopManager->Book(filterPtr.get());
-      return RInterface<F_t, DS_t>(std::move(filterPtr), *fLoopManager, newColumns, fDataSource);
+      SetNominalNode(variations, filterPtr);
+      return RInterface<F_t, DS_t>(std::move(filterPtr), *fLoopManager, newColumns, fDataSource, std::move(variations));
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -247,19 +261,29 @@ public:
    /// ~~~
    RInterface<RDFDetail::RJittedFilter, DS_t> Filter(std::string_view expression, std::string_view name = "")
    {
-      // deleted by the jitted call to JitFilterHelper
-      auto upcastNodeOnHeap = RDFInternal::MakeSharedOnHeap(RDFInternal::UpcastNode(fProxiedPtr));
-      using BaseNodeType_t = typename std::remove_pointer<decltype(upcastNodeOnHeap)>::type::element_type;
-      RInterface<BaseNodeType_t> upcastInterface(*upcastNodeOnHeap, *fLoopManager, fCustomColumns, fDataSource);
-      const auto jittedFilter = std::make_shared<RDFDetail::RJittedFilter>(fLoopManager, name);
+      CheckNoVariedColumns(expression, "Filter");
 
-      RDFInternal::BookFilterJit(jittedFilter.get(), upcastNodeOnHeap, name, expression, fLoopManager->GetAliasMap(),
-                                 fLoopManager->GetBranchNames(), fCustomColumns, fLoopManager->GetTree(), fDataSource,
-                                 fLoopManager->GetID());
+      auto bookJittedFilter = [&](const std::shared_ptr<Proxied> &prevNode, std::string_view filterName) {
+         // deleted by the jitted call to JitFilterHelper
+         auto upcastNodeOnHeap = RDFInternal::MakeSharedOnHeap(RDFInternal::UpcastNode(prevNode));
+         const auto jittedFilter = std::make_shared<RDFDetail::RJittedFilter>(fLoopManager, filterName);
 
-      fLoopManager->Book(jittedFilter.get());
+         RDFInternal::BookFilterJit(jittedFilter.get(), upcastNodeOnHeap, filterName, expression,
+                                    fLoopManager->GetAliasMap(), fLoopManager->GetBranchNames(), fCustomColumns,
+                                    fLoopManager->GetTree(), fDataSource, fLoopManager->GetID());
+
+         fLoopManager->Book(jittedFilter.get());
+         return jittedFilter;
+      };
+
+      // the expression does not read varied columns: the filter is repeated only in the branches of the graph that
+      // already diverged from the nominal one
+      auto variations = VaryNode<RDFDetail::RJittedFilter>(
+         {}, [&](const RDFInternal::RVariation<Proxied> &v) { return bookJittedFilter(v.fNode, ""); });
+      auto jittedFilter = bookJittedFilter(fProxiedPtr, name);
+      SetNominalNode(variations, jittedFilter);
       return RInterface<RDFDetail::RJittedFilter, DS_t>(std::move(jittedFilter), *fLoopManager, fCustomColumns,
-                                                        fDataSource);
+                                                        fDataSource, std::move(variations));
    }
 
    // clang-format off
@@ -374,6 +398,7 @@ public:
       RDFInternal::CheckCustomColumn(name, fLoopManager->GetTree(), fCustomColumns.GetNames(),
                                      fLoopManager->GetAliasMap(),
                                      fDataSource ? fDataSource->GetColumnNames() : ColumnNames_t{});
+      CheckNoVariedColumns(expression, "Define");
 
       auto jittedCustomColumn =
          std::make_shared<RDFDetail::RJittedCustomColumn>(fLoopManager, name, fLoopManager->GetNSlots());
@@ -387,7 +412,7 @@ public:
 
       fLoopManager->RegisterCustomColumn(jittedCustomColumn.get());
 
-      RInterface<Proxied, DS_t> newInterface(fProxiedPtr, *fLoopManager, std::move(newCols), fDataSource);
+      RInterface<Proxied, DS_t> newInterface(fProxiedPtr, *fLoopManager, std::move(newCols), fDataSource, fVariations);
 
       return newInterface;
    }
@@ -424,8 +449,91 @@ public:
       RDFInternal::RBookedCustomColumns newCols(fCustomColumns);
 
       newCols.AddName(alias);
-      RInterface<Proxied, DS_t> newInterface(fProxiedPtr, *fLoopManager, std::move(newCols), fDataSource);
+      RInterface<Proxied, DS_t> newInterface(fProxiedPtr, *fLoopManager, std::move(newCols), fDataSource, fVariations);
+
+      return newInterface;
+   }
+
+   // clang-format off
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Declare systematic variations of a column
+   /// \param[in] colName Name of the column to vary.
+   /// \param[in] expression Callable that returns a RVec with one varied value of `colName` for each variation tag.
+   /// \param[in] inputColumns Names of the columns in input to the expression.
+   /// \param[in] variationTags Names of the variations, e.g. `{"down", "up"}`.
+   /// \param[in] variationName Name of the systematic, `colName` if empty.
+   /// \return the first node of the computation graph for which the variations are defined.
+   ///
+   /// Downstream of this node, all Filters, Defines and actions that depend on `colName` are booked once more for each
+   /// variation `"<variationName>:<tag>"`, with the varied value of the column. Everything that does not depend on
+   /// the variation is shared with the nominal computation graph and evaluated once per entry, and all variations are
+   /// computed in the same event loop. The varied results are retrieved with ROOT::RDF::VariationsFor().
+   ///
+   /// The expression is evaluated once per entry with the nominal values of its input columns. It must return a RVec
+   /// (or std::vector) of the type of `colName` with `variationTags.size()` elements. Several columns can be varied
+   /// together by the same systematic by calling Vary for each of them with the same `variationName` and tags.
+   ///
+   /// Variations propagate through the overloads of Filter, Define, DefineSlot and DefineSlotEntry that take a C++
+   /// callable, which must be copy-constructible, and through Range, Alias, Count and the histogram, graph, profile,
+   /// Fill, Min, Max, Mean, StdDev, Sum and Stats actions. Just-in-time compiled Filters and Defines cannot read varied
+   /// columns. The other actions only produce the nominal result.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// auto scale = [](float pt) { return ROOT::RVec<float>{0.98f * pt, 1.02f * pt}; };
+   /// auto h = df.Vary("pt", scale, {"pt"}, {"down", "up"}, "ptScale")
+   ///            .Filter([](float pt) { return pt > 20; }, {"pt"})
+   ///            .Histo1D<float>({"h", "h", 100, 0., 200.}, "pt");
+   /// auto histos = ROOT::RDF::VariationsFor(h); // keys "nominal", "ptScale:down" and "ptScale:up"
+   /// ~~~
+   // clang-format on
+   template <typename F, typename std::enable_if<!std::is_convertible<F, std::string>::value, int>::type = 0>
+   RInterface<Proxied, DS_t> Vary(std::string_view colName, F expression, const ColumnNames_t &inputColumns,
+                                  const std::vector<std::string> &variationTags, std::string_view variationName = "")
+   {
+      using Values_t = typename TTraits::CallableTraits<F>::ret_type;
+      static_assert(RDFInternal::IsContainer<Values_t>::value,
+                    "Vary: the expression must return a RVec with one value per variation");
+      using Value_t = typename Values_t::value_type;
+
+      if (variationTags.empty())
+         throw std::runtime_error("Vary: at least one variation tag is needed.");
+      const auto nominalColumn = GetValidatedColumnNames(1, {std::string(colName)})[0];
+      const std::string systName(variationName.empty() ? nominalColumn : std::string(variationName));
+      for (const auto &tag : variationTags) {
+         for (const auto &v : fVariations) {
+            if (v.fName == systName + ":" + tag && v.fColumns.count(nominalColumn))
+               throw std::runtime_error("Vary: column \"" + nominalColumn + "\" already has variation \"" + v.fName +
+                                        "\".");
+         }
+      }
 
+      // all the varied values are computed once per entry, each variation picks its own
+      const auto valuesColumn = MakeVariedColumnName();
+      auto newInterface = DefineImpl<F, RDFDetail::CustomColExtraArgs::None>(valuesColumn, std::move(expression),
+                                                                             inputColumns, false);
+      const auto nTags = variationTags.size();
+      for (std::size_t i = 0u; i < nTags; ++i) {
+         const auto variationFullName = systName + ":" + variationTags[i];
+         auto pick = [i, nTags, variationFullName](const Values_t &values) {
+            if (values.size() != nTags)
+               throw std::runtime_error("Vary: the expression of variation \"" + variationFullName + "\" returned " +
+                                        std::to_string(values.size()) + " values instead of " + std::to_string(nTags));
+            return static_cast<Value_t>(values[i]);
+         };
+         const auto variedColumn = MakeVariedColumnName();
+         newInterface = newInterface.template DefineImpl<decltype(pick), RDFDetail::CustomColExtraArgs::None>(
+            variedColumn, std::move(pick), {valuesColumn}, false);
+
+         auto &variations = newInterface.fVariations;
+         auto it = std::find_if(variations.begin(), variations.end(),
+                                [&](const RDFInternal::RVariation<Proxied> &v) { return v.fName == variationFullName; });
+         if (it == variations.end()) {
+            variations.push_back({variationFullName, fProxiedPtr, {}});
+            it = std::prev(variations.end());
+         }
+         it->fColumns[nominalColumn] = variedColumn;
+      }
       return newInterface;
    }
 
@@ -591,6 +699,18 @@ public:
    /// Use `Cache` if you know you will only need a subset of the (`Filter`ed) data that
    /// fits in memory and that will be accessed many times.
    ///
+   /// ### Caching with a memory budget
+   /// If the options passed as last argument have a non-zero RCacheOptions::fMemoryBudget, the cached columns
+   /// are stored compressed instead, in the baskets of TTrees held by ROOT files in memory. Once the compressed
+   /// columns in memory exceed the budget, the following entries are written to temporary ROOT files on local
+   /// disk, in RCacheOptions::fSpillDirectory, which are removed when the cached `RDataFrame` is destroyed.
+   /// The cached `RDataFrame` reads and decompresses the columns in parallel if implicit multi-threading is
+   /// enabled. The columns are cached the first time an event loop of the cached `RDataFrame` runs.
+   /// ~~~{.cpp}
+   /// // keep at most 2 GB of LZ4-compressed columns in memory
+   /// auto cached = df.Filter("pt > 20").Cache({"pt", "eta", "jets_pt"}, RCacheOptions(2000000000ULL));
+   /// ~~~
+   ///
    /// ### Example usage:
    ///
    /// **Types and columns specified:**
@@ -608,19 +728,20 @@ public:
    /// auto cache_all_cols_df = df.Cache(myRegexp);
    /// ~~~
    template <typename... ColumnTypes>
-   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList)
+   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList, const RCacheOptions &options = RCacheOptions())
    {
       auto staticSeq = std::make_index_sequence<sizeof...(ColumnTypes)>();
-      return CacheImpl<ColumnTypes...>(columnList, staticSeq);
+      return CacheImpl<ColumnTypes...>(columnList, options, staticSeq);
    }
 
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Save selected columns in memory
    /// \param[in] columns to be cached in memory
+   /// \param[in] options RCacheOptions struct with extra options to pass to the cache
    /// \return a `RDataFrame` that wraps the cached dataset.
    ///
    /// See the previous overloads for more information.
-   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList)
+   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList, const RCacheOptions &options = RCacheOptions())
    {
       // Early return: if the list of columns is empty, just return an empty RDF
       // If we proceed, the jitted call will not compile!
@@ -637,7 +758,7 @@ public:
       RInterface<TTraits::TakeFirstParameter_t<decltype(upcastNode)>> upcastInterface(fProxiedPtr, *fLoopManager,
                                                                                       fCustomColumns, fDataSource);
       // build a string equivalent to
-      // "(RInterface<nodetype*>*)(this)->Cache<Ts...>(*(ColumnNames_t*)(&columnList))"
+      // "(RInterface<nodetype*>*)(this)->Cache<Ts...>(*(ColumnNames_t*)(&columnList), *(RCacheOptions*)(&options))"
       RInterface<RLoopManager> resRDF(std::make_shared<ROOT::Detail::RDF::RLoopManager>(0));
       cacheCall << "*reinterpret_cast<ROOT::RDF::RInterface<ROOT::Detail::RDF::RLoopManager>*>("
                 << RDFInternal::PrettyPrintAddr(&resRDF)
@@ -655,7 +776,8 @@ public:
       if (!columnList.empty())
          cacheCall.seekp(-2, cacheCall.cur);                         // remove the last ",
       cacheCall << ">(*reinterpret_cast<std::vector<std::string>*>(" // vector<string> should be ColumnNames_t
-                << RDFInternal::PrettyPrintAddr(&columnList) << "));";
+                << RDFInternal::PrettyPrintAddr(&columnList) << "), *reinterpret_cast<ROOT::RDF::RCacheOptions*>("
+                << RDFInternal::PrettyPrintAddr(&options) << "));";
       // jit cacheCall, return result
       fLoopManager->JitDeclarations(); // some type aliases might be needed by the code jitted in the next line
       RDFInternal::InterpreterCalc(cacheCall.str(), "Cache");
@@ -665,28 +787,32 @@ public:
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Save selected columns in memory
    /// \param[in] columnNameRegexp The regular expression to match the column names to be selected. The presence of a '^' and a '$' at the end of the string is implicitly assumed if they are not specified. The dialect supported is PCRE via the TPRegexp class. An empty string signals the selection of all columns.
+   /// \param[in] options RCacheOptions struct with extra options to pass to the cache
    /// \return a `RDataFrame` that wraps the cached dataset.
    ///
    /// The existing columns are matched against the regular expression. If the string provided
    /// is empty, all columns are selected. See the previous overloads for more information.
-   RInterface<RLoopManager> Cache(std::string_view columnNameRegexp = "")
+   RInterface<RLoopManager>
+   Cache(std::string_view columnNameRegexp = "", const RCacheOptions &options = RCacheOptions())
    {
 
       auto selectedColumns = RDFInternal::ConvertRegexToColumns(fCustomColumns, fLoopManager->GetTree(), fDataSource,
                                                                 columnNameRegexp, "Cache");
-      return Cache(selectedColumns);
+      return Cache(selectedColumns, options);
    }
 
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Save selected columns in memory
    /// \param[in] columns to be cached in memory.
+   /// \param[in] options RCacheOptions struct with extra options to pass to the cache
    /// \return a `RDataFrame` that wraps the cached dataset.
    ///
    /// See the previous overloads for more information.
-   RInterface<RLoopManager> Cache(std::initializer_list<std::string> columnList)
+   RInterface<RLoopManager>
+   Cache(std::initializer_list<std::string> columnList, const RCacheOptions &options = RCacheOptions())
    {
       ColumnNames_t selectedColumns(columnList);
-      return Cache(selectedColumns);
+      return Cache(selectedColumns, options);
    }
 
    // clang-format off
@@ -715,9 +841,16 @@ public:
       CheckIMTDisabled("Range");
 
       using Range_t = RDFDetail::RRange<Proxied>;
+      auto variations = VaryNode<Range_t>({}, [&](const RDFInternal::RVariation<Proxied> &v) {
+         auto variedRange = std::make_shared<Range_t>(begin, end, stride, v.fNode);
+         fLoopManager->Book(variedRange.get());
+         return variedRange;
+      });
       auto rangePtr = std::make_shared<Range_t>(begin, end, stride, fProxiedPtr);
       fLoopManager->Book(rangePtr.get());
-      RInterface<RDFDetail::RRange<Proxied>> tdf_r(std::move(rangePtr), *fLoopManager, fCustomColumns, fDataSource);
+      SetNominalNode(variations, rangePtr);
+      RInterface<RDFDetail::RRange<Proxied>> tdf_r(std::move(rangePtr), *fLoopManager, fCustomColumns, fDataSource,
+                                                   std::move(variations));
       return tdf_r;
    }
 
@@ -876,10 +1009,16 @@ public:
       auto cSPtr = std::make_shared<ULong64_t>(0);
       using Helper_t = RDFInternal::CountHelper;
       using Action_t = RDFInternal::RAction<Helper_t, Proxied>;
-      auto action =
-         std::make_unique<Action_t>(Helper_t(cSPtr, nSlots), ColumnNames_t({}), fProxiedPtr, std::move(fCustomColumns));
-      fLoopManager->Book(action.get());
-      return MakeResultPtr(cSPtr, *fLoopManager, std::move(action));
+      auto bookCount = [&](const std::shared_ptr<Proxied> &prevNode, const ColumnNames_t &,
+                           const std::shared_ptr<ULong64_t> &count) {
+         auto action = std::make_unique<Action_t>(Helper_t(count, nSlots), ColumnNames_t({}), prevNode,
+                                                  RDFInternal::RBookedCustomColumns(fCustomColumns));
+         fLoopManager->Book(action.get());
+         return MakeResultPtr(count, *fLoopManager, std::move(action));
+      };
+      auto resPtr = bookCount(fProxiedPtr, {}, cSPtr);
+      BookVariedActions(resPtr, {}, cSPtr, bookCount);
+      return resPtr;
    }
 
    ////////////////////////////////////////////////////////////////////////////
@@ -971,6 +1110,9 @@ public:
    ///
    /// This overload uses a default model histogram TH1D(name, title, 128u, 0., 0.).
    /// The "name" and "title" strings are built starting from the input column name.
+   /// The range of the histogram is the range of the values. Up to 16 MB of values are buffered until it is known;
+   /// beyond that, each processing slot fills a histogram with 64 times more bins whose range is extended as needed,
+   /// and the contents of its bins are moved to the bins of the result that contain their centers.
    /// See the description of the first Histo1D overload for more details.
    ///
    /// ### Example usage:
@@ -1989,6 +2131,114 @@ public:
    /// ~~~
    unsigned int GetNSlots() const { return fLoopManager->GetNSlots(); }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Enable or disable the bulk filling of the histograms of this computation graph
+   /// \param[in] bulkSize Number of selected entries filled at once by each histogram action; 0 disables bulk execution
+   ///
+   /// In bulk execution mode, the histogram actions with a model (Histo1D, Histo2D and Histo3D, not the profiles)
+   /// do not fill each entry as soon as it passed the filters. Instead, each processing slot stores the values of the
+   /// selected entries, converted to double, in one contiguous array per column, and fills the histogram with blocks
+   /// of `bulkSize` entries, whose bins are found in one go by the vectorized TAxis::FindFixBinN when the axes cannot
+   /// be extended. The columns are still read, and the filters evaluated, one entry at a time, and the other actions
+   /// are not affected.
+   /// The setting applies to the whole computation graph and takes effect at the next event loop. Results are the
+   /// same as in the default mode, up to the rounding of the statistics of the histograms, which can be summed in a
+   /// different order. Partial results passed to callbacks include all the entries processed so far.
+   ///
+   /// Example usage:
+   /// ~~~{.cpp}
+   /// ROOT::RDataFrame df("t", "f.root");
+   /// df.SetBulkSize(1024);
+   /// auto h = df.Filter("pt > 20").Histo1D({"h", "pt", 100, 0., 200.}, "pt");
+   /// ~~~
+   void SetBulkSize(unsigned int bulkSize) { fLoopManager->SetBulkSize(bulkSize); }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Enable or disable the profiling of the event loops of this computation graph
+   /// \param[in] enable Whether the following event loops are profiled
+   ///
+   /// In a profiled event loop each Define, Filter and action records, per processing slot, how many times it was
+   /// evaluated and the wall-clock and CPU time spent evaluating it. The time spent reading the input is recorded
+   /// separately: TTree branches are read and decompressed on demand, so this time would otherwise be attributed to
+   /// the first node that uses each branch. Times are exclusive: the time spent in a Define evaluated on demand by a
+   /// Filter is attributed to the Define only. The timings are retrieved with ProfileReport() and annotate the graph
+   /// produced by ROOT::RDF::SaveGraph. Profiling adds two clock readings per node evaluation; when it is disabled,
+   /// which is the default, the overhead is a check of a null pointer.
+   ///
+   /// Example usage:
+   /// ~~~{.cpp}
+   /// ROOT::RDataFrame df("t", "f.root");
+   /// df.EnableProfiling();
+   /// auto h = df.Define("pt", ComputePt, {"px", "py"}).Filter("pt > 20").Histo1D("pt");
+   /// h->Draw();
+   /// df.ProfileReport().Print();
+   /// ROOT::RDF::SaveGraph(df, "profile.dot");
+   /// ~~~
+   void EnableProfiling(bool enable = true) { fLoopManager->SetProfiling(enable); }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Enable or disable the automatic reordering of consecutive unnamed filters of this computation graph
+   /// \param[in] enable Whether the filters of the following event loops are reordered
+   /// \param[in] nLearningEntries Number of entries per processing slot used to measure cost and selectivity of filters
+   ///
+   /// By default, filters are evaluated in the order in which they were booked, even if a cheap filter that rejects
+   /// most entries follows an expensive one. With filter reordering enabled, each processing slot times the filters
+   /// and counts the entries they accept during the first `nLearningEntries` entries, in booking order. Then it
+   /// evaluates each chain of consecutive unnamed filters in the order that minimizes the expected cost per entry.
+   /// The entries selected by each node of the graph do not change, but the filters of a chain are no longer
+   /// guaranteed to be evaluated on the entries that pass the filters booked before them, so:
+   /// - a filter that reads a column defined after another filter of the chain is always evaluated after it;
+   /// - named filters and ranges delimit the chains, so that cutflow reports (see Report) and ranges count exactly the
+   ///   same entries;
+   /// - filters must not rely on other filters to skip entries on which they or the columns they read, when these were
+   ///   defined before the other filters, cannot be evaluated (e.g. reading the first element of an empty collection);
+   /// - filters must not have side effects that depend on the order of evaluation.
+   /// The setting applies to the whole computation graph and takes effect at the next event loop.
+   ///
+   /// Example usage:
+   /// ~~~{.cpp}
+   /// ROOT::RDataFrame df("t", "f.root");
+   /// df.EnableFilterReordering();
+   /// // "nMuon == 2" is evaluated first after the learning phase, if it rejects most entries
+   /// auto h = df.Filter(ExpensiveJetSelection, {"jets"}).Filter("nMuon == 2").Histo1D("muonPt");
+   /// ~~~
+   void EnableFilterReordering(bool enable = true, ULong64_t nLearningEntries = 1000)
+   {
+      fLoopManager->SetFilterReordering(enable ? std::max(nLearningEntries, 1ull) : 0ull);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Enable or disable the late materialization of the branches that no filter reads
+   /// \param[in] enable Whether the following event loops over a TTree read the other branches on demand only
+   ///
+   /// By default, the TTreeCache learns which branches the event loop reads during the first entries and then
+   /// prefetches and decompresses all their baskets, also the ones that only contain entries rejected by the filters.
+   /// With late materialization enabled, the TTreeCache prefetches the baskets of the branches that the filters read,
+   /// directly or through the columns they use. The baskets of the other branches are only read from storage and
+   /// decompressed when an entry that passed the filters needs them, all at once for that entry. This reduces the
+   /// amount of data read and decompressed considerably for selective analyses, e.g. skims that keep less than a
+   /// percent of the entries, and costs more read requests when many entries pass the filters.
+   /// The setting applies to the whole computation graph, takes effect at the next event loop and has no effect on
+   /// empty sources and data sources.
+   ///
+   /// Example usage:
+   /// ~~~{.cpp}
+   /// ROOT::RDataFrame df("Events", "skim.root");
+   /// df.EnableLateMaterialization();
+   /// // the baskets of "Jet_pt" are only read if they contain an entry with two muons
+   /// df.Filter("nMuon == 2").Snapshot("Events", "out.root", {"nMuon", "Jet_pt"});
+   /// ~~~
+   void EnableLateMaterialization(bool enable = true) { fLoopManager->SetLateMaterialization(enable); }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Gather the timings recorded by the nodes of the computation graph in the profiled event loops
+   /// \return a RProfileReport with an entry per node that ran in a profiled event loop
+   ///
+   /// Unlike Report, this method does not trigger an event loop: it reports the timings of the event loops that
+   /// already ran with profiling enabled, see EnableProfiling. The timings of successive event loops add up.
+   /// The report always covers the whole computation graph, whichever node it is called on.
+   RProfileReport ProfileReport() { return fLoopManager->GetProfileReport(); }
+
    // clang-format off
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Execute a user-defined accumulation operation on the processed column values in each processing slot
@@ -2302,10 +2552,17 @@ private:
 
       const auto nSlots = fLoopManager->GetNSlots();
 
-      auto action = RDFInternal::BuildAction<BranchTypes...>(validColumnNames, r, nSlots, fProxiedPtr, ActionTag{},
-                                                             std::move(newColumns));
-      fLoopManager->Book(action.get());
-      return MakeResultPtr(r, *fLoopManager, std::move(action));
+      auto bookAction = [&](const std::shared_ptr<Proxied> &prevNode, const ColumnNames_t &actionColumns,
+                            const std::shared_ptr<ActionResultType> &result) {
+         auto action = RDFInternal::BuildAction<BranchTypes...>(actionColumns, result, nSlots, prevNode, ActionTag{},
+                                                                RDFInternal::RBookedCustomColumns(newColumns));
+         fLoopManager->Book(action.get());
+         return MakeResultPtr(result, *fLoopManager, std::move(action));
+      };
+      auto resPtr = bookAction(fProxiedPtr, validColumnNames, r);
+      if (!std::is_same<ActionTag, RDFInternal::ActionTags::Display>::value)
+         BookVariedActions(resPtr, validColumnNames, r, bookAction);
+      return resPtr;
    }
 
    // User did not specify type, do type inference
@@ -2322,26 +2579,119 @@ private:
       const unsigned int nSlots = fLoopManager->GetNSlots();
 
       auto tree = fLoopManager->GetTree();
-      auto rOnHeap = RDFInternal::MakeSharedOnHeap(r);
 
-      auto upcastNodeOnHeap = RDFInternal::MakeSharedOnHeap(RDFInternal::UpcastNode(fProxiedPtr));
-      using BaseNodeType_t = typename std::remove_pointer<decltype(upcastNodeOnHeap)>::type::element_type;
-      RInterface<BaseNodeType_t> upcastInterface(*upcastNodeOnHeap, *fLoopManager, fCustomColumns, fDataSource);
+      auto bookAction = [&](const std::shared_ptr<Proxied> &prevNode, const ColumnNames_t &actionColumns,
+                            const std::shared_ptr<ActionResultType> &result) {
+         auto rOnHeap = RDFInternal::MakeSharedOnHeap(result);
+         auto upcastNodeOnHeap = RDFInternal::MakeSharedOnHeap(RDFInternal::UpcastNode(prevNode));
+
+         auto jittedActionOnHeap =
+            RDFInternal::MakeSharedOnHeap(std::make_shared<RDFInternal::RJittedAction>(*fLoopManager));
+
+         auto toJit = RDFInternal::JitBuildAction(
+            actionColumns, upcastNodeOnHeap, typeid(std::shared_ptr<ActionResultType>), typeid(ActionTag), rOnHeap,
+            tree, nSlots, fCustomColumns, fDataSource, jittedActionOnHeap, fLoopManager->GetID());
+         fLoopManager->Book(jittedActionOnHeap->get());
+         fLoopManager->ToJitExec(toJit);
+         return MakeResultPtr(result, *fLoopManager, *jittedActionOnHeap);
+      };
+      auto resPtr = bookAction(fProxiedPtr, validColumnNames, r);
+      if (!std::is_same<ActionTag, RDFInternal::ActionTags::Display>::value)
+         BookVariedActions(resPtr, validColumnNames, r, bookAction);
+      return resPtr;
+   }
+
+   /// Book the action that produced `nominal` once more for each systematic variation that affects it, with the varied
+   /// columns and nodes, and attach the varied results to `nominal`, see Vary() and VariationsFor().
+   /// Each varied action fills a copy of the initial state of the nominal result.
+   template <typename ActionResultType, typename BookAction_t>
+   void BookVariedActions(RResultPtr<ActionResultType> &nominal, const ColumnNames_t &columns,
+                          const std::shared_ptr<ActionResultType> &r, BookAction_t &bookAction)
+   {
+      BookVariedActions(nominal, columns, r, bookAction, std::is_copy_constructible<ActionResultType>());
+   }
 
-      auto jittedActionOnHeap =
-         RDFInternal::MakeSharedOnHeap(std::make_shared<RDFInternal::RJittedAction>(*fLoopManager));
+   template <typename ActionResultType, typename BookAction_t>
+   void BookVariedActions(RResultPtr<ActionResultType> &nominal, const ColumnNames_t &columns,
+                          const std::shared_ptr<ActionResultType> &r, BookAction_t &bookAction, std::true_type)
+   {
+      std::map<std::string, RResultPtr<ActionResultType>> variedResults;
+      for (const auto &v : fVariations) {
+         if (v.IsAffected(fProxiedPtr, columns))
+            variedResults[v.fName] =
+               bookAction(v.fNode, v.Substitute(columns), std::make_shared<ActionResultType>(*r));
+      }
+      if (!variedResults.empty())
+         nominal.fVariedResults = std::make_shared<const std::map<std::string, RResultPtr<ActionResultType>>>(
+            std::move(variedResults));
+   }
 
-      auto toJit = RDFInternal::JitBuildAction(
-         validColumnNames, upcastNodeOnHeap, typeid(std::shared_ptr<ActionResultType>), typeid(ActionTag), rOnHeap,
-         tree, nSlots, fCustomColumns, fDataSource, jittedActionOnHeap, fLoopManager->GetID());
-      fLoopManager->Book(jittedActionOnHeap->get());
-      fLoopManager->ToJitExec(toJit);
-      return MakeResultPtr(r, *fLoopManager, *jittedActionOnHeap);
+   template <typename ActionResultType, typename BookAction_t>
+   void BookVariedActions(RResultPtr<ActionResultType> &, const ColumnNames_t &columns,
+                          const std::shared_ptr<ActionResultType> &, BookAction_t &, std::false_type)
+   {
+      for (const auto &v : fVariations) {
+         if (v.IsAffected(fProxiedPtr, columns))
+            throw std::runtime_error("Results of actions affected by systematic variations must be copy-constructible.");
+      }
+   }
+
+   /// Create the varied versions of a node appended to this one: the variations that the node depends on, because
+   /// it reads varied `columns` or because the branch already diverged from the nominal graph, get the node returned
+   /// by `makeVaried`. The other variations keep a null node, to be set with SetNominalNode().
+   template <typename NewNode_t, typename MakeVaried_t>
+   RDFInternal::RVariations_t<NewNode_t> VaryNode(const ColumnNames_t &columns, MakeVaried_t &&makeVaried)
+   {
+      RDFInternal::RVariations_t<NewNode_t> variations;
+      for (const auto &v : fVariations) {
+         std::shared_ptr<NewNode_t> node;
+         if (v.IsAffected(fProxiedPtr, columns))
+            node = makeVaried(v);
+         variations.push_back({v.fName, std::move(node), v.fColumns});
+      }
+      return variations;
+   }
+
+   template <typename NewNode_t>
+   static void
+   SetNominalNode(RDFInternal::RVariations_t<NewNode_t> &variations, const std::shared_ptr<NewNode_t> &nominal)
+   {
+      for (auto &v : variations) {
+         if (!v.fNode)
+            v.fNode = nominal;
+      }
+   }
+
+   /// Throw if a just-in-time compiled expression reads columns with systematic variations: only the nominal version
+   /// of the expression could be evaluated.
+   void CheckNoVariedColumns(std::string_view expression, const std::string &callerName)
+   {
+      if (fVariations.empty())
+         return;
+      const auto &aliasMap = fLoopManager->GetAliasMap();
+      const auto usedColumns = RDFInternal::FindUsedColumnNames(
+         expression, fLoopManager->GetBranchNames(), fCustomColumns.GetNames(),
+         fDataSource ? fDataSource->GetColumnNames() : ColumnNames_t{}, aliasMap);
+      for (const auto &usedColumn : usedColumns) {
+         const auto aliasIt = aliasMap.find(usedColumn);
+         const auto &column = aliasIt != aliasMap.end() ? aliasIt->second : usedColumn;
+         for (const auto &v : fVariations) {
+            if (v.fColumns.find(column) != v.fColumns.end())
+               throw std::runtime_error(callerName + ": column \"" + usedColumn + "\" has systematic variations, " +
+                                        "which are only supported by the overloads that take a C++ callable.");
+         }
+      }
+   }
+
+   /// Return a new name for a varied version of a column
+   std::string MakeVariedColumnName()
+   {
+      return "rdfvaried" + std::to_string(fLoopManager->GetNextVariedColumnID()) + "_";
    }
 
    template <typename F, typename CustomColumnType, typename RetType = typename TTraits::CallableTraits<F>::ret_type>
    typename std::enable_if<std::is_default_constructible<RetType>::value, RInterface<Proxied, DS_t>>::type
-   DefineImpl(std::string_view name, F &&expression, const ColumnNames_t &columns)
+   DefineImpl(std::string_view name, F &&expression, const ColumnNames_t &columns, bool propagateVariations = true)
    {
       RDFInternal::CheckCustomColumn(name, fLoopManager->GetTree(), fCustomColumns.GetNames(),
                                      fLoopManager->GetAliasMap(),
@@ -2357,6 +2707,27 @@ private:
 
       const auto validColumnNames = GetValidatedColumnNames(nColumns, columns);
 
+      // Define the varied versions of the new column, one for each systematic variation of its inputs
+      auto variedInterface = *this;
+      std::vector<std::pair<std::size_t, std::string>> variedColumnNames;
+      for (std::size_t i = 0u; propagateVariations && i < fVariations.size(); ++i) {
+         const auto &v = fVariations[i];
+         if (!std::any_of(validColumnNames.begin(), validColumnNames.end(),
+                          [&v](const std::string &c) { return v.fColumns.find(c) != v.fColumns.end(); }))
+            continue;
+         variedColumnNames.emplace_back(i, MakeVariedColumnName());
+         variedInterface = variedInterface.template DefineImpl<F, CustomColumnType>(
+            variedColumnNames.back().second, RDFInternal::CopyForVariation(expression), v.Substitute(validColumnNames),
+            false);
+      }
+      if (!variedColumnNames.empty()) {
+         auto newInterface = variedInterface.template DefineImpl<F, CustomColumnType>(
+            name, std::forward<F>(expression), validColumnNames, false);
+         for (const auto &variedColumn : variedColumnNames)
+            newInterface.fVariations[variedColumn.first].fColumns[std::string(name)] = variedColumn.second;
+         return newInterface;
+      }
+
       auto newColumns = CheckAndFillDSColumns(validColumnNames, std::make_index_sequence<nColumns>(), ColTypes_t());
 
       using NewCol_t = RDFDetail::RCustomColumn<F, CustomColumnType>;
@@ -2383,7 +2754,7 @@ private:
       newCols.AddName(name);
       newCols.AddColumn(newColumn, name);
 
-      RInterface<Proxied> newInterface(fProxiedPtr, *fLoopManager, std::move(newCols), fDataSource);
+      RInterface<Proxied> newInterface(fProxiedPtr, *fLoopManager, std::move(newCols), fDataSource, fVariations);
 
       return newInterface;
    }
@@ -2395,7 +2766,7 @@ private:
              bool IsFStringConv = std::is_convertible<F, std::string>::value,
              bool IsRetTypeDefConstr = std::is_default_constructible<RetType>::value>
    typename std::enable_if<!IsFStringConv && !IsRetTypeDefConstr, RInterface<Proxied, DS_t>>::type
-   DefineImpl(std::string_view, F, const ColumnNames_t &)
+   DefineImpl(std::string_view, F, const ColumnNames_t &, bool = true)
    {
       static_assert(std::is_default_constructible<typename TTraits::CallableTraits<F>::ret_type>::value,
                     "Error in `Define`: type returned by expression is not default-constructible");
@@ -2458,7 +2829,8 @@ private:
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Implementation of cache
    template <typename... BranchTypes, std::size_t... S>
-   RInterface<RLoopManager> CacheImpl(const ColumnNames_t &columnList, std::index_sequence<S...> s)
+   RInterface<RLoopManager>
+   CacheImpl(const ColumnNames_t &columnList, const RCacheOptions &options, std::index_sequence<S...> s)
    {
       // Check at compile time that the columns types are copy constructible
       constexpr bool areCopyConstructible =
@@ -2469,6 +2841,9 @@ private:
       // in memory!
       RDFInternal::CheckTypesAndPars(sizeof...(BranchTypes), columnList.size());
 
+      if (options.fMemoryBudget > 0)
+         return CacheWithBudgetImpl<BranchTypes...>(columnList, options);
+
       auto colHolders = std::make_tuple(Take<BranchTypes>(columnList[S])...);
       auto ds = std::make_unique<RLazyDS<BranchTypes...>>(std::make_pair(columnList[S], std::get<S>(colHolders))...);
 
@@ -2479,10 +2854,36 @@ private:
       return cachedRDF;
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Implementation of cache with a memory budget: a snapshot to a RCacheStore
+   template <typename... BranchTypes>
+   RInterface<RLoopManager> CacheWithBudgetImpl(const ColumnNames_t &columnList, const RCacheOptions &options)
+   {
+      const auto validCols = GetValidatedColumnNames(columnList.size(), columnList);
+
+      auto newColumns = CheckAndFillDSColumns(validCols, std::index_sequence_for<BranchTypes...>(),
+                                              TTraits::TypeList<BranchTypes...>());
+
+      using Helper_t = RDFInternal::CacheHelper<BranchTypes...>;
+      using Action_t = RDFInternal::RAction<Helper_t, Proxied>;
+      auto store = std::make_shared<RDFInternal::RCacheStore>(options);
+      auto action = std::make_unique<Action_t>(Helper_t(store, fLoopManager->GetNSlots()), validCols, fProxiedPtr,
+                                               std::move(newColumns));
+      fLoopManager->Book(action.get());
+      auto storePtr = MakeResultPtr(store, *fLoopManager, std::move(action));
+
+      auto ds = std::make_unique<RDFInternal::RCacheDS<BranchTypes...>>(columnList, storePtr);
+      RInterface<RLoopManager> cachedRDF(std::make_shared<RLoopManager>(std::move(ds), columnList));
+
+      return cachedRDF;
+   }
+
 protected:
    RInterface(const std::shared_ptr<Proxied> &proxied, RLoopManager &lm,
-              const RDFInternal::RBookedCustomColumns &columns, RDataSource *ds)
-      : fProxiedPtr(proxied), fLoopManager(&lm), fDataSource(ds), fCustomColumns(columns)
+              const RDFInternal::RBookedCustomColumns &columns, RDataSource *ds,
+              RDFInternal::RVariations_t<Proxied> variations = {})
+      : fProxiedPtr(proxied), fLoopManager(&lm), fDataSource(ds), fCustomColumns(columns),
+        fVariations(std::move(variations))
    {
    }
 
@@ -50,6 +50,9 @@ public:
    void ClearValueReaders(unsigned int slot) final;
 
    std::shared_ptr<GraphDrawing::GraphNode> GetGraph();
+   std::string GetActionName() final;
+   const RNodeProfile &GetProfile() const final;
+   RNodeBase *GetPrevNode() final;
 };
 
 } // ns RDF
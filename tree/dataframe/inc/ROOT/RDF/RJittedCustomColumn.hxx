@@ -47,6 +47,9 @@ public:
    void Update(unsigned int slot, Long64_t entry) final;
    void ClearValueReaders(unsigned int slot) final;
    void InitNode() final;
+   const RDFInternal::RNodeProfile &GetProfile() const final;
+   const std::vector<std::string> &GetColumnNames() const final;
+   const RDFInternal::RBookedCustomColumns &GetBookedColumns() const final;
 };
 
 } // ns RDF
@@ -59,6 +59,11 @@ public:
    void InitNode() final;
    void AddFilterName(std::vector<std::string> &filters) final;
    void ClearTask(unsigned int slot) final;
+   const RDFInternal::RNodeProfile &GetProfile() const final;
+   bool EvalPredicate(unsigned int slot, Long64_t entry) final;
+   RNodeBase *GetPrevNode() final;
+   const ColumnNames_t &GetColumnNames() const final;
+   const RDFInternal::RBookedCustomColumns &GetBookedColumns() const final;
    std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph();
 };
 
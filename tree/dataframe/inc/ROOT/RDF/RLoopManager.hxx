@@ -13,6 +13,7 @@
 
 #include "ROOT/RDF/RNodeBase.hxx"
 #include "ROOT/RDF/NodesUtils.hxx"
+#include "ROOT/RDF/RNodeProfile.hxx"
 
 #include <functional>
 #include <map>
@@ -27,6 +28,7 @@ namespace ROOT {
 namespace RDF {
 class RCutFlowReport;
 class RDataSource;
+class RProfileReport;
 } // ns RDF
 
 namespace Internal {
@@ -107,6 +109,20 @@ class RLoopManager : public RNodeBase {
    const ColumnNames_t fDefaultColumns;
    const ULong64_t fNEmptyEntries{0};
    const unsigned int fNSlots{1};
+   /// Number of selected entries that the histogram actions buffer before filling them in one go.
+   /// 0 disables bulk execution.
+   unsigned int fBulkSize{0};
+   unsigned int fNVariedColumns{0}; ///< Number of varied versions of columns defined so far, see RInterface::Vary
+   /// Number of entries per slot used to learn the best evaluation order of consecutive unnamed filters.
+   /// 0 disables filter reordering.
+   ULong64_t fNFilterReorderingEntries{0};
+   /// Whether the TTreeCache only prefetches the branches read by filters, see SetLateMaterialization
+   bool fLateMaterialization{false};
+   /// Branches read by the filters in the current event loop, only filled if fLateMaterialization is true
+   ColumnNames_t fFilterBranchNames;
+   /// For each action and named filter, the upstream filters whose predicates can exclude whole clusters of entries.
+   /// Empty if clusters cannot be skipped in the current event loop, see InitClusterSkipping.
+   std::vector<std::vector<RFilterBase *>> fClusterSkippingFilters;
    bool fMustRunNamedFilters{true};
    const ELoopType fLoopType; ///< The kind of event loop that is going to be run (e.g. on ROOT files, on no files)
    std::string fToJitDeclare; ///< Code that should be just-in-time declared right before the event loop
@@ -123,6 +139,11 @@ class RLoopManager : public RNodeBase {
    /// Cache of the tree/chain branch names. Never access directy, always use GetBranchNames().
    ColumnNames_t fValidBranchNames;
 
+   /// State of the profiling of the event loop, null if profiling is disabled
+   std::unique_ptr<RDFInternal::RProfiler> fProfiler;
+   /// Timings of the reading of entries and branches from the TTree or the data source
+   RDFInternal::RNodeProfile fReadProfile;
+
    void CheckIndexedFriends();
    void RunEmptySourceMT();
    void RunEmptySource();
@@ -131,8 +152,17 @@ class RLoopManager : public RNodeBase {
    void RunDataSourceMT();
    void RunDataSource();
    void RunAndCheckFilters(unsigned int slot, Long64_t entry);
+   bool ReadTreeEntry(TTreeReader &r, unsigned int slot);
+   bool ReadDataSourceEntry(unsigned int slot, ULong64_t entry);
    void InitNodeSlots(TTreeReader *r, unsigned int slot);
    void InitNodes();
+   void InitFilterReordering();
+   ColumnNames_t GetFilterColumnNames() const;
+   void SetupLateMaterialization(TTree &tree) const;
+   void ResetLateMaterialization(TTree &tree) const;
+   void InitClusterSkipping();
+   bool IsClusterSelected(TTree &tree, Long64_t start, Long64_t end) const;
+   std::vector<std::pair<Long64_t, Long64_t>> GetSkippedClusters(TTree &tree) const;
    void CleanUpNodes();
    void CleanUpTask(unsigned int slot);
    void EvalChildrenCounts();
@@ -154,6 +184,7 @@ public:
    ::TDirectory *GetDirectory() const;
    ULong64_t GetNEmptyEntries() const { return fNEmptyEntries; }
    RDataSource *GetDataSource() const { return fDataSource.get(); }
+   static unsigned int RunGraphs(const std::vector<RLoopManager *> &loopManagers);
    void Book(RDFInternal::RActionBase *actionPtr);
    void Deregister(RDFInternal::RActionBase *actionPtr);
    void Book(RFilterBase *filterPtr);
@@ -162,6 +193,8 @@ public:
    void Deregister(RRangeBase *rangePtr);
    bool CheckFilters(unsigned int, Long64_t) final;
    unsigned int GetNSlots() const { return fNSlots; }
+   unsigned int GetBulkSize() const { return fBulkSize; }
+   void SetBulkSize(unsigned int bulkSize) { fBulkSize = bulkSize > 1 ? bulkSize : 0; }
    void Report(ROOT::RDF::RCutFlowReport &rep) const final;
    /// End of recursive chain of calls, does nothing
    void PartialReport(ROOT::RDF::RCutFlowReport &) const final {}
@@ -174,6 +207,14 @@ public:
    const std::map<std::string, std::string> &GetAliasMap() const { return fAliasColumnNameMap; }
    void RegisterCallback(ULong64_t everyNEvents, std::function<void(unsigned int)> &&f);
    unsigned int GetID() const { return fID; }
+   unsigned int GetNextVariedColumnID() { return fNVariedColumns++; }
+   void SetProfiling(bool enable);
+   void SetFilterReordering(ULong64_t nLearningEntries) { fNFilterReorderingEntries = nLearningEntries; }
+   void SetLateMaterialization(bool enable) { fLateMaterialization = enable; }
+   RDFInternal::RProfiler *GetProfiler() const { return fProfiler.get(); }
+   /// The profile that nodes reading TTree branches fill, null if profiling is disabled
+   RDFInternal::RNodeProfile *GetReadProfile() { return fProfiler ? &fReadProfile : nullptr; }
+   ROOT::RDF::RProfileReport GetProfileReport();
 
    /// End of recursive chain of calls, does nothing
    void AddFilterName(std::vector<std::string> &) {}
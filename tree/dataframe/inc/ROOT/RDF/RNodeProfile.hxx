@@ -0,0 +1,127 @@
+// @(#)root/dataframe:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RNODEPROFILE
+#define ROOT_RDF_RNODEPROFILE
+
+#include "ROOT/RDF/RProfileReport.hxx"
+#include "RtypesCore.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+using ROOT::RDF::RNodeTimings;
+
+/// CPU time consumed so far by the calling thread, in seconds
+double GetThreadCpuTime();
+
+/// Per-slot state of the profiling of an event loop, see RLoopManager::SetProfiling.
+class RProfiler {
+public:
+   /// Time spent in the nodes evaluated while evaluating the current node of a slot
+   struct RSlotState {
+      double fNestedRealTime = 0.;
+      double fNestedCpuTime = 0.;
+      char fPadding[48]; ///< keep the states of different slots in different cache lines
+   };
+
+private:
+   std::vector<RSlotState> fSlotStates;
+
+public:
+   RProfiler(unsigned int nSlots) : fSlotStates(nSlots) {}
+   RSlotState &GetSlotState(unsigned int slot) { return fSlotStates[slot]; }
+};
+
+/// Cumulative per-slot timings of a node of the computation graph.
+/// The timings are only filled during event loops that run with profiling enabled.
+class RNodeProfile {
+   friend class RProfileScope;
+
+   std::vector<RNodeTimings> fSlots;
+   RProfiler *fProfiler = nullptr; ///< Null if the node is not being profiled
+
+public:
+   /// To be called before each event loop: timings of successive profiled event loops add up
+   void Init(RProfiler *profiler, unsigned int nSlots)
+   {
+      fProfiler = profiler;
+      if (profiler && fSlots.size() < nSlots)
+         fSlots.resize(nSlots);
+   }
+   const std::vector<RNodeTimings> &GetSlots() const { return fSlots; }
+   /// Whether the node ran at least once with profiling enabled
+   bool HasTimings() const;
+   /// Short summary of the timings to annotate the node in the graph representation, empty if no timings
+   std::string GetSummary() const;
+};
+
+/// Measure the time spent in a node from construction to destruction, if the node is being profiled.
+/// The time spent in the nodes profiled meanwhile in the same slot is not attributed to this node.
+class RProfileScope {
+   RNodeTimings *fTimings = nullptr;
+   RProfiler::RSlotState *fState = nullptr;
+   std::chrono::steady_clock::time_point fStart;
+   double fStartCpu = 0.;
+   double fOuterNestedRealTime = 0.;
+   double fOuterNestedCpuTime = 0.;
+
+   void Start(RNodeProfile &profile, unsigned int slot, bool countCall);
+   void Stop();
+
+public:
+   RProfileScope(RNodeProfile *profile, unsigned int slot, bool countCall = true)
+   {
+      if (profile && profile->fProfiler)
+         Start(*profile, slot, countCall);
+   }
+   ~RProfileScope()
+   {
+      if (fTimings)
+         Stop();
+   }
+   RProfileScope(const RProfileScope &) = delete;
+   RProfileScope &operator=(const RProfileScope &) = delete;
+};
+
+inline void RProfileScope::Start(RNodeProfile &profile, unsigned int slot, bool countCall)
+{
+   fTimings = &profile.fSlots[slot];
+   if (countCall)
+      ++fTimings->fCalls;
+   fState = &profile.fProfiler->GetSlotState(slot);
+   fOuterNestedRealTime = fState->fNestedRealTime;
+   fOuterNestedCpuTime = fState->fNestedCpuTime;
+   fState->fNestedRealTime = 0.;
+   fState->fNestedCpuTime = 0.;
+   fStartCpu = GetThreadCpuTime();
+   fStart = std::chrono::steady_clock::now();
+}
+
+inline void RProfileScope::Stop()
+{
+   const double realTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - fStart).count();
+   const double cpuTime = GetThreadCpuTime() - fStartCpu;
+   fTimings->fRealTime += realTime - fState->fNestedRealTime;
+   fTimings->fCpuTime += cpuTime - fState->fNestedCpuTime;
+   fState->fNestedRealTime = fOuterNestedRealTime + realTime;
+   fState->fNestedCpuTime = fOuterNestedCpuTime + cpuTime;
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif
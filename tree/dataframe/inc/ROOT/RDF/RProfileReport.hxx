@@ -0,0 +1,91 @@
+// @(#)root/dataframe:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RPROFILEREPORT
+#define ROOT_RPROFILEREPORT
+
+#include "ROOT/RStringView.hxx"
+#include "RtypesCore.h"
+
+#include <string>
+#include <vector>
+
+namespace ROOT {
+
+namespace Detail {
+namespace RDF {
+class RLoopManager;
+} // End NS RDF
+} // End NS Detail
+
+namespace RDF {
+
+/// Cumulative timings of a node of the computation graph, in one processing slot or summed over all slots.
+/// Times are in seconds and do not include the time spent in the other nodes the node triggered, e.g. the Defines
+/// evaluated on demand while evaluating a Filter.
+struct RNodeTimings {
+   ULong64_t fCalls = 0;  ///< Number of evaluations of the node
+   double fRealTime = 0.; ///< Wall-clock time
+   double fCpuTime = 0.;  ///< CPU time of the thread that evaluated the node
+
+   RNodeTimings &operator+=(const RNodeTimings &other)
+   {
+      fCalls += other.fCalls;
+      fRealTime += other.fRealTime;
+      fCpuTime += other.fCpuTime;
+      return *this;
+   }
+};
+
+class RNodeProfileInfo {
+   friend class RProfileReport;
+
+private:
+   std::string fKind;
+   std::string fName;
+   std::vector<RNodeTimings> fSlots;
+   RNodeTimings fTotal;
+
+   RNodeProfileInfo(const std::string &kind, const std::string &name, const std::vector<RNodeTimings> &slots);
+
+public:
+   /// The kind of node: "Read", "Define", "Filter" or "Action"
+   const std::string &GetKind() const { return fKind; }
+   const std::string &GetName() const { return fName; }
+   /// Timings of each processing slot
+   const std::vector<RNodeTimings> &GetSlots() const { return fSlots; }
+   /// Timings summed over all processing slots
+   const RNodeTimings &GetTotal() const { return fTotal; }
+};
+
+class RProfileReport {
+   friend class ROOT::Detail::RDF::RLoopManager;
+
+private:
+   std::vector<RNodeProfileInfo> fInfos;
+   void AddNode(const std::string &kind, const std::string &name, const std::vector<RNodeTimings> &slots)
+   {
+      fInfos.emplace_back(RNodeProfileInfo(kind, name, slots));
+   }
+
+public:
+   using const_iterator = typename std::vector<RNodeProfileInfo>::const_iterator;
+   void Print() const;
+   const RNodeProfileInfo &operator[](std::string_view nodeName) const;
+   const RNodeProfileInfo &At(std::string_view nodeName) const { return operator[](nodeName); }
+   const_iterator begin() const { return fInfos.begin(); }
+   const_iterator end() const { return fInfos.end(); }
+   std::size_t size() const { return fInfos.size(); }
+};
+
+} // End NS RDF
+} // End NS ROOT
+
+#endif
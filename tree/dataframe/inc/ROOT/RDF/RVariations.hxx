@@ -0,0 +1,94 @@
+// @(#)root/dataframe:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RVARIATIONS
+#define ROOT_RDF_RVARIATIONS
+
+#include "ROOT/RDF/Utils.hxx" // ColumnNames_t
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+using ColumnNames_t = ROOT::Detail::RDF::ColumnNames_t;
+
+/// The state of one systematic variation in a branch of the computation graph, see RInterface::Vary.
+/// Nodes and columns that do not depend on the variation are shared with the nominal graph.
+template <typename Proxied>
+struct RVariation {
+   /// Name of the variation, e.g. "pt:up"
+   std::string fName;
+   /// Node of the varied graph that corresponds to the nominal node, the nominal node itself as long as no selection
+   /// depends on the variation
+   std::shared_ptr<Proxied> fNode;
+   /// Name of the varied version of each nominal column that depends on the variation
+   std::map<std::string, std::string> fColumns;
+
+   /// Whether an operation reading `columns` downstream of `nominal` must be repeated for this variation
+   bool IsAffected(const std::shared_ptr<Proxied> &nominal, const ColumnNames_t &columns) const
+   {
+      if (fNode != nominal)
+         return true;
+      return std::any_of(columns.begin(), columns.end(),
+                         [this](const std::string &c) { return fColumns.find(c) != fColumns.end(); });
+   }
+
+   /// Replace the names of the varied columns by the names of their varied versions
+   ColumnNames_t Substitute(const ColumnNames_t &columns) const
+   {
+      ColumnNames_t varied(columns);
+      for (auto &c : varied) {
+         const auto it = fColumns.find(c);
+         if (it != fColumns.end())
+            c = it->second;
+      }
+      return varied;
+   }
+};
+
+template <typename Proxied>
+using RVariations_t = std::vector<RVariation<Proxied>>;
+
+/// Convert the nodes of the variations, e.g. when a node is converted to RNode
+template <typename To, typename From>
+RVariations_t<To> ConvertVariations(const RVariations_t<From> &variations)
+{
+   RVariations_t<To> converted;
+   for (const auto &v : variations)
+      converted.push_back({v.fName, std::static_pointer_cast<To>(v.fNode), v.fColumns});
+   return converted;
+}
+
+/// Copy a callable for a varied node. Nodes that depend on a variation need their own copy of the user's callable.
+template <typename F>
+typename std::enable_if<std::is_copy_constructible<F>::value, F>::type CopyForVariation(const F &f)
+{
+   return f;
+}
+
+template <typename F>
+typename std::enable_if<!std::is_copy_constructible<F>::value, F>::type CopyForVariation(const F &)
+{
+   throw std::runtime_error("Callables used on columns with systematic variations must be copy-constructible.");
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif
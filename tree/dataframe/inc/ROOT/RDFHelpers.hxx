@@ -136,6 +136,43 @@ void SaveGraph(NodeType node, const std::string &outputFile)
    out.close();
 }
 
+// clang-format off
+/// Run the event loops that produce several results, concurrently if implicit multi-threading is enabled.
+/// \param[in] results results of actions booked on one or more, usually different, computation graphs
+/// \return the number of event loops that were run
+///
+/// Each RDataFrame runs its own event loop, which, with implicit multi-threading, occupies the whole thread pool until
+/// it ends. When many small datasets are processed with one RDataFrame each, running the graphs one after the other
+/// leaves cores idle at the end of every event loop. RunGraphs starts the event loops of all graphs at once, so that
+/// their tasks are interleaved on the same thread pool, and just-in-time compiles the code of all graphs in one go.
+/// Results that are already available and results of the same graph trigger no additional event loop.
+/// ~~~{.cpp}
+/// ROOT::EnableImplicitMT();
+/// ROOT::RDataFrame df1("t", "sample1.root"), df2("t", "sample2.root");
+/// auto h1 = df1.Histo1D("x");
+/// auto h2 = df2.Filter("x > 0").Count();
+/// ROOT::RDF::RunGraphs(h1, h2); // both event loops run here, concurrently
+/// ~~~
+// clang-format on
+template <typename... Ts>
+unsigned int RunGraphs(const RResultPtr<Ts> &... results)
+{
+   return ROOT::Detail::RDF::RLoopManager::RunGraphs({RDFInternal::GetLoopManagerToRun(results)...});
+}
+
+// clang-format off
+/// Run the event loops that produce several results of the same type, concurrently if implicit multi-threading is
+/// enabled. See the variadic overload.
+// clang-format on
+template <typename T>
+unsigned int RunGraphs(const std::vector<RResultPtr<T>> &results)
+{
+   std::vector<ROOT::Detail::RDF::RLoopManager *> loopManagers;
+   for (const auto &r : results)
+      loopManagers.emplace_back(RDFInternal::GetLoopManagerToRun(r));
+   return ROOT::Detail::RDF::RLoopManager::RunGraphs(loopManagers);
+}
+
 // clang-format off
 /// Cast a RDataFrame node to the common type ROOT::RDF::RNode
 /// \param[in] Any node of a RDataFrame graph
@@ -16,8 +16,10 @@
 #include "ROOT/TypeTraits.hxx"
 #include "TError.h" // Warning
 
-#include <memory>
 #include <functional>
+#include <map>
+#include <memory>
+#include <string>
 
 namespace ROOT {
 namespace Internal {
@@ -33,6 +35,13 @@ namespace RDF {
 template <typename T>
 class RResultPtr;
 
+// Fwd decl for friendship, RInterface sets the varied results
+template <typename Proxied, typename DataSource>
+class RInterface;
+
+template <typename T>
+std::map<std::string, RResultPtr<T>> VariationsFor(const RResultPtr<T> &nominal);
+
 } // ns RDF
 
 namespace Detail {
@@ -44,6 +53,13 @@ RResultPtr<T> MakeResultPtr(const std::shared_ptr<T> &r, RLoopManager &df,
                             std::shared_ptr<ROOT::Internal::RDF::RActionBase> actionPtr);
 } // ns RDF
 } // ns Detail
+namespace Internal {
+namespace RDF {
+/// Return the RLoopManager whose event loop produces the result, or nullptr if the result is already available
+template <typename T>
+ROOT::Detail::RDF::RLoopManager *GetLoopManagerToRun(const ROOT::RDF::RResultPtr<T> &r);
+} // ns RDF
+} // ns Internal
 namespace RDF {
 namespace RDFInternal = ROOT::Internal::RDF;
 namespace RDFDetail = ROOT::Detail::RDF;
@@ -95,6 +111,13 @@ class RResultPtr {
 
    friend class ROOT::Internal::RDF::GraphDrawing::GraphCreatorHelper;
 
+   template <typename T1>
+   friend RDFDetail::RLoopManager *RDFInternal::GetLoopManagerToRun(const RResultPtr<T1> &r);
+   template <typename Proxied, typename DataSource>
+   friend class RInterface;
+   template <typename T1>
+   friend std::map<std::string, RResultPtr<T1>> VariationsFor(const RResultPtr<T1> &nominal);
+
    /// \cond HIDDEN_SYMBOLS
    template <typename V, bool hasBeginEnd = TTraits::HasBeginAndEnd<V>::value>
    struct RIterationHelper {
@@ -118,6 +141,8 @@ class RResultPtr {
    /// Owning pointer to the action that will produce this result.
    /// Ownership is shared with other copies of this ResultPtr.
    std::shared_ptr<RDFInternal::RActionBase> fActionPtr;
+   /// Results of the same action for the systematic variations that affect it, by variation name. Null if none.
+   std::shared_ptr<const std::map<std::string, RResultPtr<T>>> fVariedResults;
 
    /// Triggers the event loop in the RLoopManager
    void TriggerRun();
@@ -299,6 +324,29 @@ void RResultPtr<T>::TriggerRun()
    fLoopManager->Run();
 }
 
+// clang-format off
+/// \brief Return the results of an action for all the systematic variations that affect it
+/// \param[in] nominal the result of an action booked downstream of RInterface::Vary
+/// \return the nominal result, with key "nominal", and the varied results, with keys "<variation>:<tag>"
+///
+/// All results are produced by the same event loop, which runs when any of them is accessed for the first time.
+/// Variations that do not affect the action, e.g. because they vary columns it does not read, are not included.
+/// ~~~{.cpp}
+/// auto h = df.Vary("pt", scalePt, {"pt"}, {"down", "up"}).Histo1D<float>({"h", "h", 100, 0., 100.}, "pt");
+/// auto histos = ROOT::RDF::VariationsFor(h);
+/// histos["pt:up"]->Draw();
+/// ~~~
+// clang-format on
+template <typename T>
+std::map<std::string, RResultPtr<T>> VariationsFor(const RResultPtr<T> &nominal)
+{
+   std::map<std::string, RResultPtr<T>> results;
+   if (nominal.fVariedResults)
+      results = *nominal.fVariedResults;
+   results["nominal"] = nominal;
+   return results;
+}
+
 template <class T1, class T2>
 bool operator==(const RResultPtr<T1> &lhs, const RResultPtr<T2> &rhs)
 {
@@ -349,6 +397,18 @@ MakeResultPtr(const std::shared_ptr<T> &r, RLoopManager &lm, std::shared_ptr<RDF
 }
 } // end NS RDF
 } // end NS Detail
+
+namespace Internal {
+namespace RDF {
+template <typename T>
+ROOT::Detail::RDF::RLoopManager *GetLoopManagerToRun(const ROOT::RDF::RResultPtr<T> &r)
+{
+   if (!r.fActionPtr || r.fActionPtr->HasRun())
+      return nullptr;
+   return r.fLoopManager;
+}
+} // end NS RDF
+} // end NS Internal
 } // end NS ROOT
 
 #endif // ROOT_TRESULTPROXY
@@ -23,6 +23,16 @@ ROOT::RDF::MakeArrowDataFrame, which accepts one parameter:
 The types of the columns are derived from the types in the associated
 arrow::Schema.
 
+A RDataFrame can also read an Arrow IPC file (the format of Feather V2 files)
+directly, using the overload of ROOT::RDF::MakeArrowDataFrame which accepts:
+1. The path of the file.
+2. The names of the columns to use (optional, all of them by default).
+
+The file is memory-mapped and its record batches are not copied: the values
+of the columns of numeric types, and of lists of numeric types, are read
+from the mapped memory. Each record batch is a range of entries, processed
+by a single slot.
+
 */
 // clang-format on
 
@@ -40,6 +50,9 @@ arrow::Schema.
 #pragma GCC diagnostic ignored "-Wshadow"
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 #endif
+#include <arrow/io/file.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/record_batch.h>
 #include <arrow/table.h>
 #include <arrow/stl.h>
 #if defined(__GNUC__)
@@ -207,6 +220,11 @@ private:
    std::vector<ULong64_t> fLastChunkPerSlot;
    std::vector<ULong64_t> fFirstEntryPerChunk;
    std::vector<ArrayPtrVisitor> fArrayVisitorPerSlot;
+   /// For the columns of numeric types, the address of the value of the first entry of the current
+   /// chunk of each slot: the values of the other entries of the chunk are found without visiting it.
+   std::vector<const char *> fChunkValuesPerSlot;
+   /// Size of a value for the columns of numeric types, 0 for the others.
+   size_t fValueSize = 0;
    /// Since data can be chunked in different arrays we need to construct an
    /// index which contains the first element of each chunk, so that we can
    /// quickly move to the correct chunk.
@@ -227,6 +245,18 @@ public:
       for (size_t si = 0, se = fValuesPtrPerSlot.size(); si != se; ++si) {
          fArrayVisitorPerSlot.push_back(ArrayPtrVisitor{fValuesPtrPerSlot.data() + si});
       }
+      fChunkValuesPerSlot.resize(slots, nullptr);
+      if (!fChunks.empty()) {
+         switch (fChunks.front()->type_id()) {
+         case arrow::Type::INT32:
+         case arrow::Type::UINT32:
+         case arrow::Type::FLOAT: fValueSize = 4; break;
+         case arrow::Type::INT64:
+         case arrow::Type::UINT64:
+         case arrow::Type::DOUBLE: fValueSize = 8; break;
+         default: break;
+         }
+      }
    }
 
    /// This returns the ptr to the ptr to actual data.
@@ -272,6 +302,10 @@ public:
          msg += std::to_string(slot) + " looking at entry " + std::to_string(entry);
          throw std::runtime_error(msg);
       }
+      if (fValueSize) {
+         const auto entryInChunk = entry - fFirstEntryPerChunk[fLastChunkPerSlot[slot]];
+         fChunkValuesPerSlot[slot] = static_cast<const char *>(fValuesPtrPerSlot[slot]) - entryInChunk * fValueSize;
+      }
    }
 
    /// Set the current entry to be retrieved
@@ -281,6 +315,14 @@ public:
       if (fLastEntryPerSlot[slot] == entry) {
          return;
       }
+      // Same chunk as before, for numeric types: no need to visit the array
+      const auto chunk = fLastChunkPerSlot[slot];
+      if (fChunkValuesPerSlot[slot] && fFirstEntryPerChunk[chunk] <= entry && entry < fChunkIndex[chunk]) {
+         fValuesPtrPerSlot[slot] =
+            const_cast<char *>(fChunkValuesPerSlot[slot] + (entry - fFirstEntryPerChunk[chunk]) * fValueSize);
+         fLastEntryPerSlot[slot] = entry;
+         return;
+      }
       UncachedSlotLookup(slot, entry);
    }
 };
@@ -379,6 +421,37 @@ public:
    using ::arrow::TypeVisitor::Visit;
 };
 
+namespace {
+
+/// Read the record batches of an Arrow IPC file, memory-mapped, in a table. The buffers of the table point
+/// to the memory-mapped file.
+std::shared_ptr<arrow::Table> ReadArrowFile(const std::string &fileName, std::shared_ptr<arrow::io::RandomAccessFile> &file)
+{
+   auto throwIfNotOk = [&fileName](const arrow::Status &status) {
+      if (!status.ok()) {
+         std::string msg = "Cannot read the Arrow file ";
+         msg += fileName + ": " + status.ToString();
+         throw std::runtime_error(msg);
+      }
+   };
+
+   std::shared_ptr<arrow::io::MemoryMappedFile> mappedFile;
+   throwIfNotOk(arrow::io::MemoryMappedFile::Open(fileName, arrow::io::FileMode::READ, &mappedFile));
+   std::shared_ptr<arrow::ipc::RecordBatchFileReader> reader;
+   throwIfNotOk(arrow::ipc::RecordBatchFileReader::Open(mappedFile.get(), &reader));
+
+   std::vector<std::shared_ptr<arrow::RecordBatch>> batches(reader->num_record_batches());
+   for (int i = 0; i < reader->num_record_batches(); ++i)
+      throwIfNotOk(reader->ReadRecordBatch(i, &batches[i]));
+
+   std::shared_ptr<arrow::Table> table;
+   throwIfNotOk(arrow::Table::FromRecordBatches(reader->schema(), batches, &table));
+   file = mappedFile;
+   return table;
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////
 /// Constructor to create an Arrow RDataSource for RDataFrame.
 /// \param[in] table the arrow Table to observe.
@@ -386,6 +459,22 @@ public:
 /// In case columns is empty, we use all the columns found in the table
 RArrowDS::RArrowDS(std::shared_ptr<arrow::Table> inTable, std::vector<std::string> const &inColumns)
    : fTable{inTable}, fColumnNames{inColumns}
+{
+   SetupColumns();
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor to create an Arrow RDataSource for RDataFrame reading an Arrow IPC file.
+/// \param[in] fileName the path of the Arrow IPC file, which is memory-mapped
+/// \param[in] columns the name of the columns to use
+/// In case columns is empty, we use all the columns found in the file
+RArrowDS::RArrowDS(std::string_view fileName, std::vector<std::string> const &inColumns) : fColumnNames{inColumns}
+{
+   fTable = ReadArrowFile(std::string(fileName), fFile);
+   SetupColumns();
+}
+
+void RArrowDS::SetupColumns()
 {
    auto &columnNames = fColumnNames;
    auto &table = fTable;
@@ -528,6 +617,19 @@ void splitInEqualRanges(std::vector<std::pair<ULong64_t, ULong64_t>> &ranges, in
    ranges.back().second += remainder;
 }
 
+/// One range per chunk of the column, e.g. per record batch of the file the table was read from.
+void splitInChunkRanges(std::vector<std::pair<ULong64_t, ULong64_t>> &ranges, const arrow::ArrayVector &chunks)
+{
+   ranges.clear();
+   ULong64_t start = 0ULL;
+   for (auto &chunk : chunks) {
+      if (chunk->length() == 0)
+         continue;
+      ranges.emplace_back(start, start + chunk->length());
+      start += chunk->length();
+   }
+}
+
 int getNRecords(std::shared_ptr<arrow::Table> &table, std::vector<std::string> &columnNames)
 {
    auto index = table->schema()->GetFieldIndex(columnNames.front());
@@ -571,8 +673,14 @@ std::vector<void *> RArrowDS::GetColumnReadersImpl(std::string_view colName, con
 
 void RArrowDS::Initialise()
 {
-   auto nRecords = getNRecords(fTable, fColumnNames);
-   splitInEqualRanges(fEntryRanges, nRecords, fNSlots);
+   // Ranges do not span chunks, if there are several: a slot reads a single chunk per range
+   const auto &chunks = fTable->column(fGetterIndex.front().first)->data()->chunks();
+   if (chunks.size() > 1) {
+      splitInChunkRanges(fEntryRanges, chunks);
+   } else {
+      auto nRecords = getNRecords(fTable, fColumnNames);
+      splitInEqualRanges(fEntryRanges, nRecords, fNSlots);
+   }
 }
 
 std::string RArrowDS::GetLabel()
@@ -590,6 +698,16 @@ RDataFrame MakeArrowDataFrame(std::shared_ptr<arrow::Table> table, std::vector<s
    return tdf;
 }
 
+/// Creates a RDataFrame reading an Arrow IPC file, memory-mapped.
+/// \param[in] fileName the path of the Arrow IPC file
+/// \param[in] columnNames the name of the columns to use
+/// In case columnNames is empty, we use all the columns found in the file
+RDataFrame MakeArrowDataFrame(std::string_view fileName, std::vector<std::string> const &columnNames)
+{
+   ROOT::RDataFrame tdf(std::make_unique<RArrowDS>(fileName, columnNames));
+   return tdf;
+}
+
 } // namespace RDF
 
 } // namespace ROOT
@@ -0,0 +1,119 @@
+// @(#)root/dataframe:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RCacheStore.hxx"
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TString.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+constexpr const char *RCacheStore::fgTreeName;
+
+RCacheStore::RCacheStore(const ROOT::RDF::RCacheOptions &options) : fOptions(options) {}
+
+RCacheStore::~RCacheStore()
+{
+   for (const auto &fileName : fTempFileNames)
+      gSystem->Unlink(fileName.c_str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the file of a new part: in memory while the memory budget is not exceeded, a temporary file otherwise.
+/// The current directory is not changed.
+std::unique_ptr<TFile> RCacheStore::OpenPartForWriting()
+{
+   ::TDirectory::TContext ctxt;
+   const auto compress = ROOT::CompressionSettings(fOptions.fCompressionAlgorithm, fOptions.fCompressionLevel);
+   if (!IsOverBudget()) {
+      // small budgets need blocks smaller than the default ones to be respected
+      const Long64_t blockSize = std::max(64 * 1024ULL, std::min(2 * 1024 * 1024ULL, fOptions.fMemoryBudget / 32));
+      return std::unique_ptr<TFile>(new TMemFile("RDFCache", "RECREATE", "", compress, blockSize));
+   }
+
+   const auto dir = fOptions.fSpillDirectory.empty() ? gSystem->TempDirectory() : fOptions.fSpillDirectory.c_str();
+   TString fileName("RDFCache");
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      auto f = gSystem->TempFileName(fileName, dir);
+      if (!f)
+         throw std::runtime_error(std::string("Cannot create a temporary file in ") + dir +
+                                  " to store the cached columns.");
+      fclose(f);
+      fTempFileNames.emplace_back(fileName.Data());
+   }
+   std::unique_ptr<TFile> file(TFile::Open(fileName, "RECREATE", "", compress));
+   if (!file || file->IsZombie())
+      throw std::runtime_error(std::string("Cannot open the temporary file ") + fileName.Data() +
+                               " to store the cached columns.");
+   return file;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the tree of a part to its file and make the part available for reading.
+/// \param[in] file The file returned by OpenPartForWriting
+/// \param[in] tree The tree filled with the entries of the part, in the file
+/// \param[in] accountedBytes The size of the file already added to the memory usage
+///
+/// The content of a file in memory is copied to a contiguous buffer, which the readers share.
+void RCacheStore::ClosePart(std::unique_ptr<TFile> file, std::unique_ptr<TTree> tree, Long64_t accountedBytes)
+{
+   const ULong64_t entries = tree->GetEntries();
+   {
+      ::TDirectory::TContext ctxt(file.get());
+      file->Write();
+   }
+   // must destroy the TTree first, otherwise TFile will delete it too leading to a double delete
+   tree.reset();
+
+   RPart part;
+   part.fEntries = entries;
+   if (auto memFile = dynamic_cast<TMemFile *>(file.get())) {
+      if (entries > 0) {
+         auto data = std::make_shared<std::vector<char>>(memFile->GetEND());
+         memFile->CopyTo(data->data(), data->size());
+         part.fData = data;
+      }
+      file.reset();
+      AddMemoryUsage((part.fData ? Long64_t(part.fData->size()) : 0LL) - accountedBytes);
+   } else {
+      part.fFileName = file->GetName();
+      file->Close();
+   }
+
+   if (entries > 0) {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fParts.emplace_back(std::move(part));
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Open the file of a part for reading. Each reader must open its own file.
+std::unique_ptr<TFile> RCacheStore::OpenPartForReading(std::size_t part) const
+{
+   ::TDirectory::TContext ctxt;
+   const auto &p = fParts[part];
+   std::unique_ptr<TFile> file(p.fData ? new TMemFile("RDFCache", p.fData) : TFile::Open(p.fFileName.c_str()));
+   if (!file || file->IsZombie())
+      throw std::runtime_error("Cannot open the part " + std::to_string(part) + " of the cached columns.");
+   return file;
+}
+
+} // ns RDF
+} // ns Internal
+} // ns ROOT
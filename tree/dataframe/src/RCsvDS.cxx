@@ -65,12 +65,18 @@ double-quote characters must be represented by a pair of double-quote characters
     2000,Mercury,Cougar
 ~~~
 
-The current implementation of RCsvDS reads the entire CSV file content into memory before
-RDataFrame starts processing it. Therefore, before creating a CSV RDataFrame, it is
-important to check both how much memory is available and the size of the CSV file.
+- Empty lines are skipped. Lines can be terminated by `\n` or by `\r\n`.
+
+The CSV file is memory-mapped, where the platform allows it, rather than read into memory.
+GetEntryRanges only looks for the line breaks of the records to split them into ranges of entries:
+the records are tokenized and their fields converted by each slot, for its own entries, so that
+this work runs in parallel when the implicit multi-threading is enabled.
+The fourth parameter of ROOT::RDF::MakeCsvDataFrame, `linesChunkSize`, limits the number of
+records split into ranges at every call of GetEntryRanges (default -1, all of them).
 */
 // clang-format on
 
+#include <ROOT/RConfig.hxx>
 #include <ROOT/RDF/Utils.hxx>
 #include <ROOT/TSeq.hxx>
 #include <ROOT/RCsvDS.hxx>
@@ -78,14 +84,127 @@ important to check both how much memory is available and the size of the CSV fil
 #include <TError.h>
 
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
-#include <sstream>
+#include <iterator>
+#include <limits>
 #include <string>
 
+#ifndef R__WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace ROOT {
 
+namespace Internal {
+namespace RDF {
+
+/// Read-only content of a CSV file. The file is memory-mapped when possible, read into memory otherwise.
+class RCsvFileBuffer {
+   const char *fData = nullptr;
+   std::size_t fSize = 0;
+   void *fMapping = nullptr;   // the address returned by mmap, if the file is mapped
+   std::vector<char> fContent; // the content of the file, if it is not mapped
+
+public:
+   RCsvFileBuffer(const std::string &fileName)
+   {
+#ifndef R__WIN32
+      const auto fd = open(fileName.c_str(), O_RDONLY);
+      if (fd >= 0) {
+         struct stat st;
+         if (0 == fstat(fd, &st) && S_ISREG(st.st_mode) && st.st_size > 0) {
+            auto mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (MAP_FAILED != mapping) {
+               fMapping = mapping;
+               fSize = st.st_size;
+               fData = static_cast<const char *>(mapping);
+#ifdef MADV_SEQUENTIAL
+               madvise(mapping, fSize, MADV_SEQUENTIAL);
+#endif
+            }
+         }
+         close(fd);
+      }
+      if (fMapping)
+         return;
+#endif
+      std::ifstream stream(fileName, std::ios::binary);
+      if (!stream) {
+         std::string msg = "Cannot open CSV file ";
+         msg += fileName;
+         throw std::runtime_error(msg);
+      }
+      fContent.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+      fData = fContent.data();
+      fSize = fContent.size();
+   }
+
+   RCsvFileBuffer(const RCsvFileBuffer &) = delete;
+   RCsvFileBuffer &operator=(const RCsvFileBuffer &) = delete;
+
+   ~RCsvFileBuffer()
+   {
+#ifndef R__WIN32
+      if (fMapping)
+         munmap(fMapping, fSize);
+#endif
+   }
+
+   const char *Data() const { return fData; }
+   std::size_t Size() const { return fSize; }
+};
+
+} // ns RDF
+} // ns Internal
+
 namespace RDF {
 
+namespace {
+
+/// Return the offset of the end of the line starting at `pos`, i.e. of its line break or of the end of the buffer.
+std::size_t FindLineEnd(const char *data, std::size_t size, std::size_t pos)
+{
+   auto lineEnd = static_cast<const char *>(std::memchr(data + pos, '\n', size - pos));
+   return lineEnd ? lineEnd - data : size;
+}
+
+/// Return the offset of the line following the one starting at `pos`.
+std::size_t NextLine(const char *data, std::size_t size, std::size_t pos)
+{
+   const auto lineEnd = FindLineEnd(data, size, pos);
+   return lineEnd == size ? size : lineEnd + 1;
+}
+
+/// Return the offset of the first line, starting from `pos`, which is not empty, or `size` if there is none.
+std::size_t SkipEmptyLines(const char *data, std::size_t size, std::size_t pos)
+{
+   while (pos < size && ('\n' == data[pos] || ('\r' == data[pos] && pos + 1 < size && '\n' == data[pos + 1])))
+      pos = NextLine(data, size, pos);
+   return pos;
+}
+
+/// Return the offset of the first record after the `n` records starting at `pos`.
+std::size_t SkipRecords(const char *data, std::size_t size, std::size_t pos, ULong64_t n)
+{
+   for (; n > 0; --n)
+      pos = SkipEmptyLines(data, size, NextLine(data, size, pos));
+   return pos;
+}
+
+/// Return the end of the content of the line [begin, end), without the carriage return of a `\r\n` line break.
+const char *TrimLineBreak(const char *begin, const char *end)
+{
+   return (end != begin && '\r' == *(end - 1)) ? end - 1 : end;
+}
+
+} // anonymous namespace
+
 std::string RCsvDS::AsString()
 {
    return "CSV data source";
@@ -109,41 +228,6 @@ void RCsvDS::FillHeaders(const std::string &line)
    }
 }
 
-void RCsvDS::FillRecord(const std::string &line, Record_t &record)
-{
-   std::istringstream lineStream(line);
-   auto i = 0U;
-
-   auto columns = ParseColumns(line);
-
-   for (auto &col : columns) {
-      auto colType = fColTypes[fHeaders[i]];
-
-      switch (colType) {
-      case 'd': {
-         record.emplace_back(new double(std::stod(col)));
-         break;
-      }
-      case 'l': {
-         record.emplace_back(new Long64_t(std::stoll(col)));
-         break;
-      }
-      case 'b': {
-         auto b = new bool();
-         record.emplace_back(b);
-         std::istringstream is(col);
-         is >> std::boolalpha >> *b;
-         break;
-      }
-      case 's': {
-         record.emplace_back(new std::string(col));
-         break;
-      }
-      }
-      ++i;
-   }
-}
-
 void RCsvDS::GenerateHeaders(size_t size)
 {
    for (size_t i = 0; i < size; ++i) {
@@ -215,37 +299,44 @@ void RCsvDS::InferType(const std::string &col, unsigned int idxCol)
 std::vector<std::string> RCsvDS::ParseColumns(const std::string &line)
 {
    std::vector<std::string> columns;
-
-   for (size_t i = 0; i < line.size(); ++i) {
-      i = ParseValue(line, columns, i);
-   }
-
+   const auto begin = line.data();
+   columns.resize(Tokenize(begin, TrimLineBreak(begin, begin + line.size()), columns));
    return columns;
 }
 
-size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &columns, size_t i)
+////////////////////////////////////////////////////////////////////////
+/// Split the record [begin, end) into its fields, unquoting them.
+/// The strings of `fields` are reused, and `fields` is only grown: the number of fields of the record is returned.
+std::size_t RCsvDS::Tokenize(const char *begin, const char *end, std::vector<std::string> &fields) const
 {
-   std::stringstream val;
-   bool quoted = false;
-
-   for (; i < line.size(); ++i) {
-      if (line[i] == fDelimiter && !quoted) {
-         break;
-      } else if (line[i] == '"') {
-         // Keep just one quote for escaped quotes, none for the normal quotes
-         if (line[i + 1] != '"') {
-            quoted = !quoted;
+   std::size_t nFields = 0;
+   for (auto c = begin; c < end; ++c) {
+      if (fields.size() == nFields)
+         fields.emplace_back();
+      auto &field = fields[nFields++];
+      field.clear();
+      bool quoted = false;
+      for (; c < end; ++c) {
+         if (*c == fDelimiter && !quoted) {
+            break;
+         } else if (*c == '"') {
+            // Keep just one quote for escaped quotes, none for the normal quotes
+            if (c + 1 == end || *(c + 1) != '"') {
+               quoted = !quoted;
+            } else {
+               field += *(++c);
+            }
          } else {
-            val << line[++i];
+            // append at once the run of characters which are neither quotes nor delimiters
+            auto runEnd = c + 1;
+            while (runEnd < end && *runEnd != '"' && *runEnd != fDelimiter)
+               ++runEnd;
+            field.append(c, runEnd);
+            c = runEnd - 1;
          }
-      } else {
-         val << line[i];
       }
    }
-
-   columns.emplace_back(val.str());
-
-   return i;
+   return nFields;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -255,17 +346,21 @@ size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &col
 ///                        (default `true`).
 /// \param[in] delimiter Delimiter character (default ',').
 RCsvDS::RCsvDS(std::string_view fileName, bool readHeaders, char delimiter, Long64_t linesChunkSize) // TODO: Let users specify types?
-   : fReadHeaders(readHeaders),
-     fStream(std::string(fileName)),
+   : fFile(std::make_unique<ROOT::Internal::RDF::RCsvFileBuffer>(std::string(fileName))),
+     fReadHeaders(readHeaders),
      fDelimiter(delimiter),
      fLinesChunkSize(linesChunkSize)
 {
-   std::string line;
+   const auto data = fFile->Data();
+   const auto size = fFile->Size();
+   auto pos = SkipEmptyLines(data, size, 0);
 
    // Read the headers if present
    if (fReadHeaders) {
-      if (std::getline(fStream, line)) {
-         FillHeaders(line);
+      if (pos < size) {
+         const auto lineEnd = FindLineEnd(data, size, pos);
+         FillHeaders(std::string(data + pos, lineEnd));
+         pos = SkipEmptyLines(data, size, NextLine(data, size, pos));
       } else {
          std::string msg = "Error reading headers of CSV file ";
          msg += fileName;
@@ -273,9 +368,11 @@ RCsvDS::RCsvDS(std::string_view fileName, bool readHeaders, char delimiter, Long
       }
    }
 
-   fDataPos = fStream.tellg();
-   if (std::getline(fStream, line)) {
-      auto columns = ParseColumns(line);
+   fDataBegin = pos;
+   fNextRangesBegin = pos;
+   if (pos < size) {
+      const auto lineEnd = FindLineEnd(data, size, pos);
+      auto columns = ParseColumns(std::string(data + pos, lineEnd));
 
       // Generate headers if not present
       if (!fReadHeaders) {
@@ -284,55 +381,28 @@ RCsvDS::RCsvDS(std::string_view fileName, bool readHeaders, char delimiter, Long
 
       // Infer types of columns with first record
       InferColTypes(columns);
-
-      // rewind one line
-      fStream.seekg(fDataPos);
    }
+   fColTypesVec.assign(fColTypesList.begin(), fColTypesList.end());
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Kept for backward compatibility: the records are not stored anymore, they are parsed by SetEntry.
 void RCsvDS::FreeRecords()
 {
-   for (auto &record : fRecords) {
-      for (size_t i = 0; i < record.size(); ++i) {
-         void *p = record[i];
-         const auto colType = fColTypes[fHeaders[i]];
-         switch (colType) {
-         case 'd': {
-            delete static_cast<double *>(p);
-            break;
-         }
-         case 'l': {
-            delete static_cast<Long64_t *>(p);
-            break;
-         }
-         case 'b': {
-            delete static_cast<bool *>(p);
-            break;
-         }
-         case 's': {
-            delete static_cast<std::string *>(p);
-            break;
-         }
-         }
-      }
-   }
-   fRecords.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////
 /// Destructor.
 RCsvDS::~RCsvDS()
 {
-   FreeRecords();
 }
 
 void RCsvDS::Finalise()
 {
-   fStream.clear();
-   fStream.seekg(fDataPos);
+   fNextRangesBegin = fDataBegin;
    fProcessedLines = 0ULL;
-   fEntryRangesRequested = 0ULL;
-   FreeRecords();
+   fRangeBegins.clear();
+   std::fill(fSlotEntries.begin(), fSlotEntries.end(), std::numeric_limits<ULong64_t>::max());
 }
 
 const std::vector<std::string> &RCsvDS::GetColumnNames() const
@@ -342,49 +412,69 @@ const std::vector<std::string> &RCsvDS::GetColumnNames() const
 
 std::vector<std::pair<ULong64_t, ULong64_t>> RCsvDS::GetEntryRanges()
 {
-
-   // Read records and store them in memory
+   // Count the records of the chunk: only their line breaks are looked for, they are parsed by SetEntry
+   const auto data = fFile->Data();
+   const auto size = fFile->Size();
    auto linesToRead = fLinesChunkSize;
-   FreeRecords();
-
-   std::string line;
-   while ((-1LL == fLinesChunkSize || 0 != linesToRead--) && std::getline(fStream, line)) {
-      fRecords.emplace_back();
-      FillRecord(line, fRecords.back());
+   ULong64_t nRecords = 0ULL;
+   auto pos = fNextRangesBegin;
+   while ((-1LL == fLinesChunkSize || 0 != linesToRead--) && pos < size) {
+      pos = SkipEmptyLines(data, size, NextLine(data, size, pos));
+      ++nRecords;
    }
+   const auto chunkEnd = pos;
 
    if (gDebug > 0) {
       if (fLinesChunkSize == -1LL) {
-         Info("GetEntryRanges", "Attempted to read entire CSV file into memory, %lu lines read", fRecords.size());
+         Info("GetEntryRanges", "Attempted to read entire CSV file, %llu lines read", nRecords);
       } else {
-         Info("GetEntryRanges", "Attempted to read chunk of %lld lines of CSV file into memory, %lu lines read", fLinesChunkSize, fRecords.size());
+         Info("GetEntryRanges", "Attempted to read chunk of %lld lines of CSV file, %llu lines read", fLinesChunkSize,
+              nRecords);
       }
    }
 
    std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
-   const auto nRecords = fRecords.size();
+   fRangeBegins.clear();
    if (0 == nRecords)
       return entryRanges;
 
    const auto chunkSize = nRecords / fNSlots;
    const auto remainder = 1U == fNSlots ? 0 : nRecords % fNSlots;
-   auto start = 0ULL == fEntryRangesRequested ? 0ULL : fProcessedLines;
+   auto start = fProcessedLines;
    auto end = start;
 
+   // Remember where the records of each range begin, for the slots to find them
+   pos = fNextRangesBegin;
    for (auto i : ROOT::TSeqU(fNSlots)) {
       start = end;
       end += chunkSize;
       entryRanges.emplace_back(start, end);
+      fRangeBegins[start] = pos;
+      pos = SkipRecords(data, size, pos, chunkSize);
       (void)i;
    }
    entryRanges.back().second += remainder;
 
    fProcessedLines += nRecords;
-   fEntryRangesRequested++;
+   fNextRangesBegin = chunkEnd;
 
    return entryRanges;
 }
 
+////////////////////////////////////////////////////////////////////////
+/// Move the cursor of the slot to the record of the given entry, from the beginning of its range.
+void RCsvDS::SeekSlot(unsigned int slot, ULong64_t entry)
+{
+   auto rangeBegin = fRangeBegins.upper_bound(entry);
+   if (fRangeBegins.begin() == rangeBegin || entry >= fProcessedLines) {
+      std::string msg = "Entry " + std::to_string(entry) + " is not part of the ranges of the CSV file being processed";
+      throw std::runtime_error(msg);
+   }
+   --rangeBegin;
+   fSlotOffsets[slot] = SkipRecords(fFile->Data(), fFile->Size(), rangeBegin->second, entry - rangeBegin->first);
+   fSlotEntries[slot] = entry;
+}
+
 RCsvDS::ColType_t RCsvDS::GetType(std::string_view colName) const
 {
    if (!HasColumn(colName)) {
@@ -408,32 +498,53 @@ bool RCsvDS::HasColumn(std::string_view colName) const
 
 bool RCsvDS::SetEntry(unsigned int slot, ULong64_t entry)
 {
-   // Here we need to normalise the entry to the number of lines we already processed.
-   const auto offset = (fEntryRangesRequested - 1) * fLinesChunkSize;
-   const auto recordPos = entry - offset;
-   int colIndex = 0;
-   for (auto &colType : fColTypesList) {
-      auto dataPtr = fRecords[recordPos][colIndex];
-      switch (colType) {
+   if (entry != fSlotEntries[slot])
+      SeekSlot(slot, entry);
+
+   const auto data = fFile->Data();
+   const auto size = fFile->Size();
+   const auto pos = fSlotOffsets[slot];
+   const auto lineEnd = FindLineEnd(data, size, pos);
+   auto &fields = fSlotFields[slot];
+   const auto nFields = Tokenize(data + pos, TrimLineBreak(data + pos, data + lineEnd), fields);
+   if (nFields != fColTypesVec.size()) {
+      std::string msg = "Record " + std::to_string(entry) + " of the CSV file has " + std::to_string(nFields) +
+                        " fields instead of " + std::to_string(fColTypesVec.size());
+      throw std::runtime_error(msg);
+   }
+
+   for (auto colIndex : ROOT::TSeqU(nFields)) {
+      auto &field = fields[colIndex];
+      const auto str = field.c_str();
+      char *strEnd = nullptr;
+      switch (fColTypesVec[colIndex]) {
       case 'd': {
-         fDoubleEvtValues[colIndex][slot] = *static_cast<double *>(dataPtr);
+         fDoubleEvtValues[colIndex][slot] = std::strtod(str, &strEnd);
          break;
       }
       case 'l': {
-         fLong64EvtValues[colIndex][slot] = *static_cast<Long64_t *>(dataPtr);
+         fLong64EvtValues[colIndex][slot] = std::strtoll(str, &strEnd, 10);
          break;
       }
       case 'b': {
-         fBoolEvtValues[colIndex][slot] = *static_cast<bool *>(dataPtr);
+         fBoolEvtValues[colIndex][slot] = field == "true";
          break;
       }
       case 's': {
-         fStringEvtValues[colIndex][slot] = *static_cast<std::string *>(dataPtr);
+         std::swap(fStringEvtValues[colIndex][slot], field);
          break;
       }
       }
-      colIndex++;
+      if (str == strEnd) {
+         std::string msg = "Cannot convert \"" + field + "\" to " + fgColTypeMap.at(fColTypesVec[colIndex]) +
+                           " for column \"" + fHeaders[colIndex] + "\" of record " + std::to_string(entry) +
+                           " of the CSV file";
+         throw std::runtime_error(msg);
+      }
    }
+
+   fSlotOffsets[slot] = SkipEmptyLines(data, size, lineEnd == size ? size : lineEnd + 1);
+   fSlotEntries[slot] = entry + 1;
    return true;
 }
 
@@ -452,6 +563,11 @@ void RCsvDS::SetNSlots(unsigned int nSlots)
    fLong64EvtValues.resize(nColumns, std::vector<Long64_t>(fNSlots));
    fStringEvtValues.resize(nColumns, std::vector<std::string>(fNSlots));
    fBoolEvtValues.resize(nColumns, std::deque<bool>(fNSlots));
+
+   // Initialize the per slot parsing state
+   fSlotOffsets.resize(fNSlots, fDataBegin);
+   fSlotEntries.resize(fNSlots, std::numeric_limits<ULong64_t>::max());
+   fSlotFields.resize(fNSlots);
 }
 
 std::string RCsvDS::GetLabel()
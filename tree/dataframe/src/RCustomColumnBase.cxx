@@ -49,4 +49,5 @@ std::string RCustomColumnBase::GetName() const
 void RCustomColumnBase::InitNode()
 {
    fLastCheckedEntry = std::vector<Long64_t>(fNSlots, -1);
+   fProfile.Init(fLoopManager->GetProfiler(), fNSlots);
 }
@@ -46,30 +46,74 @@ void FillHelper::UpdateMinMax(unsigned int slot, double v)
 }
 
 FillHelper::FillHelper(const std::shared_ptr<Hist_t> &h, const unsigned int nSlots)
-   : fResultHist(h), fNSlots(nSlots), fBufSize(fgTotalBufSize / nSlots), fPartialHists(fNSlots),
+   : fResultHist(h), fNSlots(nSlots), fBufSize(fgTotalBufSize / nSlots), fPartialHists(fNSlots), fSketches(fNSlots),
      fMin(nSlots, std::numeric_limits<BufEl_t>::max()), fMax(nSlots, std::numeric_limits<BufEl_t>::lowest())
 {
-   fBuffers.reserve(fNSlots);
-   fWBuffers.reserve(fNSlots);
-   for (unsigned int i = 0; i < fNSlots; ++i) {
-      Buf_t v;
-      v.reserve(fBufSize);
-      fBuffers.emplace_back(v);
-      fWBuffers.emplace_back(v);
-   }
+   fBuffers.resize(fNSlots);
+   fWBuffers.resize(fNSlots);
 }
 
 void FillHelper::Exec(unsigned int slot, double v)
 {
-   UpdateMinMax(slot, v);
-   fBuffers[slot].emplace_back(v);
+   Buffer(slot, v);
 }
 
 void FillHelper::Exec(unsigned int slot, double v, double w)
 {
-   UpdateMinMax(slot, v);
-   fBuffers[slot].emplace_back(v);
-   fWBuffers[slot].emplace_back(w);
+   Buffer(slot, v, w);
+}
+
+/// Move the values buffered in a slot to a histogram covering their range, which is filled from now on instead of the
+/// buffer. Its axis is extended, halving the resolution, if later values are out of range.
+void FillHelper::MakeSketch(unsigned int slot)
+{
+   const auto nBins = fgSketchBinsFactor * fResultHist->GetNbinsX();
+   const auto min = fMin[slot];
+   // the maximum must be inside the last bin
+   const auto max = fMax[slot] > min ? fMax[slot] + (fMax[slot] - min) / nBins : min + 1.;
+   auto &sketch = fSketches[slot];
+   // copy the result, like for the partial results, rather than registering a new histogram to the current directory
+   sketch = std::make_unique<Hist_t>(*fResultHist);
+   sketch->SetDirectory(nullptr);
+   sketch->SetBins(nBins, min, max);
+   sketch->SetCanExtend(TH1::kAllAxes);
+   auto weights = fWBuffers[slot].empty() ? nullptr : fWBuffers[slot].data();
+   sketch->FillN(fBuffers[slot].size(), fBuffers[slot].data(), weights);
+   Buf_t().swap(fBuffers[slot]);
+   Buf_t().swap(fWBuffers[slot]);
+}
+
+/// Add the contents of a sketch to a result histogram. The content of each bin of the sketch is added to the bin
+/// of the result that contains the center of the part of the bin within [min, max], the range of all values.
+void FillHelper::AddSketch(Hist_t &result, const Hist_t &sketch, double min, double max)
+{
+   if (sketch.GetSumw2N() > 0 && result.GetSumw2N() == 0)
+      result.Sumw2();
+   Double_t stats[TH1::kNstat], sketchStats[TH1::kNstat];
+   result.GetStats(stats);
+   sketch.GetStats(sketchStats);
+   const auto entries = result.GetEntries() + sketch.GetEntries();
+
+   const auto &axis = *sketch.GetXaxis();
+   const auto nBins = axis.GetNbins();
+   for (auto bin = 1; bin <= nBins; ++bin) {
+      const auto content = sketch.GetBinContent(bin);
+      if (content == 0.)
+         continue;
+      const auto low = std::max(axis.GetBinLowEdge(bin), min);
+      const auto up = std::min(axis.GetBinUpEdge(bin), max);
+      const auto resultBin = result.FindBin(0.5 * (low + up));
+      result.AddBinContent(resultBin, content);
+      if (result.GetSumw2N() > 0) {
+         const auto error2 = sketch.GetSumw2N() > 0 ? sketch.GetSumw2()->At(bin) : content;
+         result.GetSumw2()->AddAt(result.GetSumw2()->At(resultBin) + error2, resultBin);
+      }
+   }
+
+   for (auto i = 0; i < TH1::kNstat; ++i)
+      stats[i] += sketchStats[i];
+   result.PutStats(stats);
+   result.SetEntries(entries);
 }
 
 Hist_t &FillHelper::PartialUpdate(unsigned int slot)
@@ -77,6 +121,15 @@ Hist_t &FillHelper::PartialUpdate(unsigned int slot)
    auto &partialHist = fPartialHists[slot];
    // TODO it is inefficient to re-create the partial histogram everytime the callback is called
    //      ideally we could incrementally fill it with the latest entries in the buffers
+   if (fSketches[slot]) {
+      // rebin the sketch like Finalize does, so that the partial result has the binning that the final result would
+      // have with the values of this slot
+      partialHist = std::make_unique<Hist_t>(*fResultHist);
+      if (partialHist->CanExtendAllAxes())
+         partialHist->SetBins(partialHist->GetNbinsX(), fMin[slot], fMax[slot]);
+      AddSketch(*partialHist, *fSketches[slot], fMin[slot], fMax[slot]);
+      return *partialHist;
+   }
    partialHist = std::make_unique<Hist_t>(*fResultHist);
    auto weights = fWBuffers[slot].empty() ? nullptr : fWBuffers[slot].data();
    partialHist->FillN(fBuffers[slot].size(), fBuffers[slot].data(), weights);
@@ -103,6 +156,11 @@ void FillHelper::Finalize()
       auto weights = fWBuffers[i].empty() ? nullptr : fWBuffers[i].data();
       fResultHist->FillN(fBuffers[i].size(), fBuffers[i].data(), weights);
    }
+
+   for (const auto &sketch : fSketches) {
+      if (sketch)
+         AddSketch(*fResultHist, *sketch, globalMin, globalMax);
+   }
 }
 
 template void FillHelper::Exec(unsigned int, const std::vector<float> &);
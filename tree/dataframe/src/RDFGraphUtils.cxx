@@ -88,7 +88,7 @@ CreateDefineNode(const std::string &columnName, const ROOT::Detail::RDF::RCustom
       return duplicateDefine;
    }
 
-   auto node = std::make_shared<GraphNode>("Define\n" + columnName);
+   auto node = std::make_shared<GraphNode>("Define\n" + columnName + columnPtr->GetProfile().GetSummary());
    node->SetDefine();
 
    sColumnsMap[columnPtr] = node;
@@ -106,7 +106,7 @@ std::shared_ptr<GraphNode> CreateFilterNode(const ROOT::Detail::RDF::RFilterBase
       return duplicateFilter;
    }
    auto filterName = (filterPtr->HasName() ? filterPtr->GetName() : "Filter");
-   auto node = std::make_shared<GraphNode>(filterName);
+   auto node = std::make_shared<GraphNode>(filterName + filterPtr->GetProfile().GetSummary());
 
    sFiltersMap[filterPtr] = node;
    node->SetFilter();
@@ -20,6 +20,9 @@
 #include <TClassEdit.h>
 #include <TFriendElement.h>
 #include <TInterpreter.h>
+#include <TLeaf.h>
+#include <TLeafF.h>
+#include <TLeafI.h>
 #include <TObject.h>
 #include <TRegexp.h>
 #include <TPRegexp.h>
@@ -38,6 +41,9 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
 #include <iosfwd>
 #include <set>
 #include <stdexcept>
@@ -593,6 +599,137 @@ std::string PrettyPrintAddr(const void *const addr)
    return s.str();
 }
 
+/// Split the expression at the && operators that are not enclosed in brackets. Return an empty vector if the
+/// expression is not a conjunction of terms, i.e. if it contains other operators of lower precedence than &&.
+static std::vector<std::string> SplitConjunction(const std::string &expr)
+{
+   std::vector<std::string> terms;
+   if (expr.find_first_of(";\"'") != std::string::npos || expr.find("//") != std::string::npos ||
+       expr.find("/*") != std::string::npos)
+      return terms;
+   int depth = 0;
+   std::string::size_type termStart = 0;
+   const auto size = expr.size();
+   for (std::string::size_type i = 0; i < size; ++i) {
+      const auto c = expr[i];
+      if (std::isalpha(c) || c == '_') {
+         // skip identifiers, rejecting the ones that change the structure of the expression
+         auto end = i;
+         while (end < size && (std::isalnum(expr[end]) || expr[end] == '_'))
+            ++end;
+         const auto word = expr.substr(i, end - i);
+         if (word == "or" || word == "and" || word == "return")
+            return {};
+         i = end - 1;
+      } else if (c == '(' || c == '[' || c == '{') {
+         ++depth;
+      } else if (c == ')' || c == ']' || c == '}') {
+         --depth;
+      } else if (depth == 0 && (c == '?' || c == ',' || (c == '|' && i + 1 < size && expr[i + 1] == '|'))) {
+         return {};
+      } else if (depth == 0 && c == '&' && i + 1 < size && expr[i + 1] == '&') {
+         terms.emplace_back(expr.substr(termStart, i - termStart));
+         termStart = i + 2;
+         ++i;
+      }
+   }
+   terms.emplace_back(expr.substr(termStart));
+   return terms;
+}
+
+/// Parse a decimal floating point or integer literal, with an optional sign, that spans the whole string.
+static bool ParseNumber(const std::string &str, double &value, bool &isInteger, bool &isFloat)
+{
+   const auto digits = str.find_first_not_of("+-");
+   if (digits > 1 || digits == std::string::npos || !(std::isdigit(str[digits]) || str[digits] == '.'))
+      return false;
+   isInteger = str.find_first_of(".eE") == std::string::npos;
+   // octal literals
+   if (isInteger && str[digits] == '0' && digits + 1 < str.size())
+      return false;
+   char *end = nullptr;
+   value = std::strtod(str.c_str(), &end);
+   isFloat = !isInteger && (*end == 'f' || *end == 'F');
+   if (isFloat)
+      ++end;
+   return end == str.c_str() + str.size();
+}
+
+/// Parse a comparison of a column with a literal, e.g. `pt > 500` or `1.5 <= eta`.
+static bool ParseComparison(std::string term, std::string &column, RColumnPredicate::EOp &op, double &value,
+                            bool &isInteger, bool &isFloat)
+{
+   using EOp = RColumnPredicate::EOp;
+   term.erase(std::remove_if(term.begin(), term.end(), [](char c) { return std::isspace(c); }), term.end());
+   const auto opPos = term.find_first_of("<>=");
+   if (opPos == std::string::npos || opPos == 0)
+      return false;
+   auto opEnd = opPos + 1;
+   if (opEnd < term.size() && term[opEnd] == '=')
+      ++opEnd;
+   const auto opStr = term.substr(opPos, opEnd - opPos);
+   if (opStr == "=")
+      return false;
+   auto lhs = term.substr(0, opPos);
+   auto rhs = term.substr(opEnd);
+   bool isReversed = false;
+   if (ParseNumber(lhs, value, isInteger, isFloat)) {
+      std::swap(lhs, rhs);
+      isReversed = true;
+   } else if (!ParseNumber(rhs, value, isInteger, isFloat)) {
+      return false;
+   }
+   if (!IsValidCppVarName(lhs) && TPRegexp("^[a-zA-Z_][a-zA-Z0-9_]*(\\.[a-zA-Z_][a-zA-Z0-9_]*)+$").Match(lhs) == 0)
+      return false;
+   column = lhs;
+   if (opStr == "==")
+      op = EOp::kEqual;
+   else if (opStr == "<")
+      op = isReversed ? EOp::kGreater : EOp::kLess;
+   else if (opStr == "<=")
+      op = isReversed ? EOp::kGreaterEqual : EOp::kLessEqual;
+   else if (opStr == ">")
+      op = isReversed ? EOp::kLess : EOp::kGreater;
+   else
+      op = isReversed ? EOp::kLessEqual : EOp::kGreaterEqual;
+   return true;
+}
+
+/// Return the comparisons of a branch of the tree with a constant that all entries passing a filter expression
+/// satisfy, i.e. the comparisons joined by && at the top level of the expression.
+/// Other terms of the expression are ignored, and so are comparisons with columns that are not branches of the tree.
+std::vector<RColumnPredicate> FindColumnPredicates(const std::string &expression, TTree &tree,
+                                                   const std::map<std::string, std::string> &aliasMap,
+                                                   const RDFInternal::RBookedCustomColumns &customCols)
+{
+   std::vector<RColumnPredicate> predicates;
+   for (const auto &term : SplitConjunction(expression)) {
+      RColumnPredicate predicate;
+      bool isInteger, isFloat;
+      if (!ParseComparison(term, predicate.fColumn, predicate.fOp, predicate.fValue, isInteger, isFloat) ||
+          customCols.HasName(predicate.fColumn))
+         continue;
+      const auto aliasIt = aliasMap.find(predicate.fColumn);
+      if (aliasIt != aliasMap.end())
+         predicate.fColumn = aliasIt->second;
+      // only branches of the tree itself, with a single leaf, can have statistics
+      auto branch = tree.GetBranch(predicate.fColumn.c_str());
+      if (!branch || branch->GetTree() != tree.GetTree() || branch->GetListOfLeaves()->GetEntriesFast() != 1)
+         continue;
+      auto leaf = static_cast<TLeaf *>(branch->GetListOfLeaves()->UncheckedAt(0));
+      if (isInteger && std::abs(predicate.fValue) > 2147483647.)
+         continue;
+      // comparisons of unsigned int with negative integers are performed in unsigned arithmetic
+      if (isInteger && predicate.fValue < 0. && leaf->IsUnsigned() && leaf->IsA() == TLeafI::Class())
+         continue;
+      // integer literals are converted to float when compared with floats
+      if (isFloat || (isInteger && leaf->IsA() == TLeafF::Class()))
+         predicate.fValue = float(predicate.fValue);
+      predicates.emplace_back(predicate);
+   }
+   return predicates;
+}
+
 // Jit a string filter expression and jit-and-call this->Filter with the appropriate arguments
 // Return pointer to the new functional chain node returned by the call, cast to Long_t
 
@@ -646,6 +783,9 @@ void BookFilterJit(RJittedFilter *jittedFilter, void *prevNodeOnHeap, std::strin
                     << ");";
 
    lm->ToJitExec(filterInvocation.str());
+
+   if (tree)
+      jittedFilter->SetPredicates(FindColumnPredicates(std::string(expression), *tree, aliasMap, customCols));
 }
 
 // Jit a Define call
@@ -69,6 +69,7 @@ Transformations are a way to manipulate the data.
 | [DefineSlotEntry](classROOT_1_1RDF_1_1RInterface.html#a4f17074d5771916e3df18f8458186de7) | Same as `DefineSlot`, but the entry number is passed in addition to the slot number. This is meant as a helper in case some dependency on the entry number needs to be honoured. |
 | [Filter](classROOT_1_1RDF_1_1RInterface.html#a70284a3bedc72b19610aaa91b5007ebd) | Filter the rows of the dataset. |
 | [Range](classROOT_1_1RDF_1_1RInterface.html#a1b36b7868831de2375e061bb06cfc225) | Creates a node that filters entries based on range of entries |
+| [Vary](classROOT_1_1RDF_1_1RInterface.html) | Declares systematic variations of a column: downstream transformations and actions are repeated for each variation, in the same event loop. See [Systematic variations](#systematic-variations). |
 
 ### Actions
 Actions are a way to produce a result out of the data. Each one is described in more detail in the reference guide.
@@ -84,7 +85,7 @@ produce several different results in one event loop. Instant actions trigger the
 |------------------|-----------------|
 | [Aggregate](classROOT_1_1RDF_1_1RInterface.html#ae540b00addc441f9b504cbae0ef0a24d) | Execute a user-defined accumulation operation on the processed column values. |
 | [Book](classROOT_1_1RDF_1_1RInterface.html#a9b2f61f3333d1669e57055b9ae8be9d9) | Book execution of a custom action using a user-defined helper object. |
-| [Cache](classROOT_1_1RDF_1_1RInterface.html#aaaa0a7bb8eb21315d8daa08c3e25f6c9) | Caches in contiguous memory columns' entries. Custom columns can be cached as well, filtered entries are not cached. Users can specify which columns to save (default is all). |
+| [Cache](classROOT_1_1RDF_1_1RInterface.html#aaaa0a7bb8eb21315d8daa08c3e25f6c9) | Caches in contiguous memory columns' entries. Custom columns can be cached as well, filtered entries are not cached. Users can specify which columns to save (default is all). With a memory budget, the columns are kept compressed and spilled to temporary files on disk beyond the budget. |
 | [Count](classROOT_1_1RDF_1_1RInterface.html#a37f9e00c2ece7f53fae50b740adc1456) | Return the number of events processed. |
 | [Display](classROOT_1_1RDF_1_1RInterface.html#aee68f4411f16f00a1d46eccb6d296f01) | Obtains the events in the dataset for the requested columns. The method returns a [RDisplay](classROOT_1_1RDF_1_1RDisplay.html) instance which can be queried to get a compressed tabular representation on the standard output or a complete representation as a string. |
 | [Fill](classROOT_1_1RDF_1_1RInterface.html#a0cac4d08297c23d16de81ff25545440a) | Fill a user-defined object with the values of the specified branches, as if by calling `Obj.Fill(branch1, branch2, ...). |
@@ -119,6 +120,9 @@ produce several different results in one event loop. Instant actions trigger the
 | [GetFilterNames](classROOT_1_1RDF_1_1RInterface.html#a25026681111897058299161a70ad9bb2) | Get all the filters defined. If called on a root node, all filters will be returned. For any other node, only the filters upstream of that node. |
 | [Display](classROOT_1_1RDF_1_1RInterface.html#a652f9ab3e8d2da9335b347b540a9a941) | Provides an ASCII representation of the columns types and contents of the dataset printable by the user. |
 | [SaveGraph](namespaceROOT_1_1RDF.html#adc17882b283c3d3ba85b1a236197c533) | Store the computation graph of an RDataFrame in graphviz format for easy inspection. |
+| [EnableFilterReordering](classROOT_1_1RDF_1_1RInterface.html) | Evaluate the cheapest and most selective of consecutive unnamed filters first, based on the timings of a learning phase. See [Filter reordering](#filter-reordering). |
+| [EnableLateMaterialization](classROOT_1_1RDF_1_1RInterface.html) | Only prefetch the branches read by filters, read the others for the selected entries. See [Late materialization](#late-materialization). |
+| [EnableProfiling](classROOT_1_1RDF_1_1RInterface.html) | Record call counts and timings of each node in the following event loops, retrieved with `ProfileReport`. See [Profiling the computation graph](#profiling). |
 
 
 ## <a name="introduction"></a>Introduction
@@ -622,6 +626,35 @@ ROOT::RDF::SaveGraph(rd1, "./mydot.dot");
 ROOT::RDF::SaveGraph(rd1);
 ~~~
 
+### <a name="profiling"></a>Profiling the computation graph
+After a call to `EnableProfiling`, each Define, Filter and action records how many times it was evaluated and the
+wall-clock and CPU time spent evaluating it, separately for each processing slot. The time spent reading the input
+data is recorded as well. `ProfileReport` gathers these timings, and the graph printed by ROOT::RDF::SaveGraph shows
+the number of calls and the time spent in each node:
+~~~{.cpp}
+ROOT::RDataFrame df("tree", "f.root");
+df.EnableProfiling();
+auto h = df.Define("pt", ComputePt, {"px", "py"}).Filter("pt > 20", "ptCut").Histo1D("pt");
+h->Draw(); // runs the event loop
+df.ProfileReport().Print(); // a line per node: calls, real and CPU time, time per call
+ROOT::RDF::SaveGraph(df, "profile.dot");
+~~~
+Times are exclusive, i.e. the time spent in a Define that a Filter evaluated on demand is attributed to the Define.
+
+### <a name="systematic-variations"></a>Systematic variations
+`Vary` declares alternative values of a column, e.g. the up and down variations of an energy scale. Downstream of it,
+every `Filter`, `Define` or action that depends on the varied column, directly or through other columns and filters, is
+booked once more for each variation, while everything else is shared with the nominal computation. All variations are
+computed in the same event loop, and `ROOT::RDF::VariationsFor` returns the results of an action for all variations:
+~~~{.cpp}
+auto scale = [](float pt) { return ROOT::RVec<float>{0.98f * pt, 1.02f * pt}; };
+auto h = df.Vary("pt", scale, {"pt"}, {"down", "up"}, "ptScale")
+           .Filter([](float pt) { return pt > 20; }, {"pt"})
+           .Histo1D<float>({"h", "h", 100, 0., 200.}, "pt");
+auto histos = ROOT::RDF::VariationsFor(h); // keys "nominal", "ptScale:down" and "ptScale:up"
+~~~
+Filters and Defines that read varied columns must be expressed as C++ callables rather than strings.
+
 ### RDataFrame variables as function arguments and return values
 RDataFrame variables/nodes are relatively cheap to copy and it's possible to both pass them to (or move them into)
 functions and to return them from functions. However, in general each dataframe node will have a different C++ type,
@@ -682,6 +715,35 @@ relative all named filters in the section of the chain between the main `RDataFr
 Stats are stored in the same order as named filters have been added to the graph, and *refer to the latest event-loop*
 that has been run using the relevant `RDataFrame`.
 
+#### <a name="filter-reordering"></a>Filter reordering
+When `EnableFilterReordering` is called on the main `RDataFrame` object, the filters of each sequence of consecutive
+unnamed filters are re-ordered at runtime: during a learning phase over the first entries processed by each slot the
+filters are evaluated in the order they were booked while their cost and selectivity are measured, then the cheapest
+and most selective filters are evaluated first. The set of entries that pass the sequence is unchanged. Named filters
+and ranges are never moved and delimit the sequences, so cutflow reports are not affected, and a filter that reads a
+column defined after another filter is always evaluated after it. Since the evaluation order changes, filters must be
+free of side effects for reordering to be safe.
+
+#### <a name="late-materialization"></a>Late materialization
+When reading a TTree, the branches used by the computation graph are read through a TTreeCache, which prefetches and
+decompresses all their baskets. After a call to `EnableLateMaterialization` on the main `RDataFrame` object, only the
+branches read by the filters, directly or through custom columns, are prefetched: the baskets of the other branches are
+read and decompressed only if they contain an entry that passed the filters. This can save most of the I/O of analyses
+that select a small fraction of the entries.
+
+#### <a name="cluster-skipping"></a>Skipping clusters with branch statistics
+A TTree can record the minimum and maximum values of some of its numerical branches in each cluster of entries, if
+`TTree::EnableClusterStats` was called before filling it. `RDataFrame` then skips the clusters that cannot contain
+entries that pass the filters, without reading them: comparisons of these branches with a number, like `pt > 500`,
+joined by `&&` in jitted filter expressions are checked against the statistics of each cluster. A cluster is skipped
+only if it cannot contain an entry processed by an action or counted by a named filter, so results and cutflow reports
+are unchanged. Ranges, entry lists and `OnPartialResult` callbacks disable the skipping.
+~~~{.cpp}
+// the tree "t" was filled after a call to t.EnableClusterStats("pt")
+ROOT::RDataFrame df("t", "file.root");
+auto h = df.Filter("pt > 500").Histo1D("m"); // only the clusters with pt values above 500 are read
+~~~
+
 ### <a name="ranges"></a>Ranges
 When `RDataFrame` is not being used in a multi-thread environment (i.e. no call to `EnableImplicitMT` was made),
 `Range` transformations are available. These act very much like filters but instead of basing their decision on
@@ -744,6 +806,19 @@ Actions can be **instant** or **lazy**. Instant actions are executed as soon as
 executed whenever the object they return is accessed for the first time. As a rule of thumb, actions with a return value
 are lazy, the others are instant.
 
+### Bulk execution
+By default each action processes the values of an entry as soon as the entry passes the filters. After calling
+`SetBulkSize(n)` on any node of a computation graph, the histogram actions with a model (`Histo1D`, `Histo2D` and
+`Histo3D`) instead store the values of the selected entries into one contiguous array per column, and fill the
+histogram with blocks of `n` entries, whose bins are found in one go when the axes cannot be extended. Columns are
+still read and filters still evaluated one entry at a time, and the other actions are not affected, so the gain is
+limited to the filling of the histograms.
+~~~{.cpp}
+RDataFrame d("myTree", "file.root");
+d.SetBulkSize(1024);
+auto h = d.Filter("x > 0").Histo1D({"h", "h", 100, 0., 10.}, "x"); // filled 1024 selected entries at a time
+~~~
+
 ##  <a name="parallel-execution"></a>Parallel execution
 As pointed out before in this document, `RDataFrame` can transparently perform multi-threaded event loops to speed up
 the execution of its actions. Users have to call `ROOT::EnableImplicitMT()` *before* constructing the `RDataFrame`
@@ -754,6 +829,17 @@ processing of these batches. There are no guarantees on the order the batches ar
 order entries of the dataset are processed. Note that this in turn means that, for multi-thread event loops, there is no
 guarantee on the order in which `Snapshot` will _write_ entries: they could be scrambled with respect to the input dataset.
 
+Each `RDataFrame` runs its own event loop. To process several datasets, each with its own `RDataFrame`, without waiting
+for the end of each event loop before starting the next, pass their results to `ROOT::RDF::RunGraphs`: the event loops
+then run concurrently and share the thread pool.
+~~~{.cpp}
+ROOT::EnableImplicitMT();
+ROOT::RDataFrame df1("Events", "sample1.root"), df2("Events", "sample2.root");
+auto h1 = df1.Histo1D("pt");
+auto h2 = df2.Histo1D("pt");
+ROOT::RDF::RunGraphs(h1, h2); // both event loops run here
+~~~
+
 ### Thread-safety of user-defined expressions
 RDataFrame operations such as `Histo1D` or `Snapshot` are guaranteed to work correctly in multi-thread event loops.
 User-defined expressions, such as strings or lambdas passed to `Filter`, `Define`, `Foreach`, `Reduce` or `Aggregate`
@@ -10,6 +10,10 @@
 
 #include "ROOT/RDF/RCutFlowReport.hxx"
 #include "ROOT/RDF/RFilterBase.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
+#include <algorithm>
+#include <chrono>
+#include <limits>
 #include <numeric> // std::accumulate
 
 using namespace ROOT::Detail::RDF;
@@ -44,6 +48,130 @@ void RFilterBase::FillReport(ROOT::RDF::RCutFlowReport &rep) const
 void RFilterBase::InitNode()
 {
    fLastCheckedEntry = std::vector<Long64_t>(fNSlots, -1);
+   fProfile.Init(fLoopManager->GetProfiler(), fNSlots);
    if (!fName.empty()) // if this is a named filter we care about its report count
       ResetReportCount();
 }
+
+/// Prepare the measurement of the cost and selectivity of this filter for the next event loop, and forget the chain of
+/// filters it ended. `nLearningEntries` is 0 if filter reordering is disabled, see RLoopManager::SetFilterReordering.
+void RFilterBase::InitReordering(ULong64_t nLearningEntries)
+{
+   fNLearningEntries = nLearningEntries;
+   fChain.clear();
+   fChainDeps.clear();
+   fChainPrev = nullptr;
+   fChainStates.clear();
+   if (nLearningEntries == 0)
+      return;
+   fStats = std::vector<RFilterStats>(fNSlots);
+   fLastEvaluatedEntry = std::vector<Long64_t>(fNSlots, -1);
+   fLastPredicateResult = std::vector<int>(fNSlots, true);
+}
+
+/// Let this filter evaluate the consecutive filters that end with it, itself included, in the order that minimizes
+/// the expected cost. A filter that reads a column defined after another filter of the chain is always evaluated after
+/// it, since that column might only be valid for entries that pass it.
+void RFilterBase::SetChain(const std::vector<RFilterBase *> &chain, RNodeBase *chainPrev)
+{
+   fChain = chain;
+   fChainPrev = chainPrev;
+   const auto nFilters = chain.size();
+   fChainDeps.assign(nFilters, {});
+   for (auto i = 0u; i < nFilters; ++i) {
+      const auto &columns = chain[i]->GetBookedColumns();
+      for (auto j = 0u; j < i; ++j) {
+         const auto &prevColumns = chain[j]->GetBookedColumns();
+         for (const auto &c : chain[i]->GetColumnNames()) {
+            if (columns.HasName(c) && !prevColumns.HasName(c)) {
+               fChainDeps[i].emplace_back(j);
+               break;
+            }
+         }
+      }
+   }
+   RChainState initialState;
+   for (auto i = 0u; i < nFilters; ++i)
+      initialState.fOrder.emplace_back(i);
+   fChainStates.assign(fNSlots, initialState);
+}
+
+/// Evaluate the predicate of this filter, or return the result of its last evaluation for this entry.
+/// The first evaluations in each slot are timed to estimate the cost of the filter.
+bool RFilterBase::CheckPredicate(unsigned int slot, Long64_t entry)
+{
+   if (entry == fLastEvaluatedEntry[slot])
+      return fLastPredicateResult[slot];
+   auto &stats = fStats[slot];
+   bool passed;
+   if (stats.fNEvaluations < fNLearningEntries) {
+      const auto start = std::chrono::steady_clock::now();
+      passed = EvalPredicate(slot, entry);
+      stats.fRealTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      ++stats.fNEvaluations;
+      stats.fNPassed += passed;
+   } else {
+      passed = EvalPredicate(slot, entry);
+   }
+   fLastEvaluatedEntry[slot] = entry;
+   fLastPredicateResult[slot] = passed;
+   return passed;
+}
+
+/// Evaluate the chain of filters that ends with this filter, in the current order of the slot.
+/// After the first fNLearningEntries entries that reached the chain, the order is recomputed from the measured costs
+/// and pass fractions.
+bool RFilterBase::CheckReorderedChain(unsigned int slot, Long64_t entry)
+{
+   if (entry == fLastCheckedEntry[slot])
+      return fLastResult[slot];
+   bool passed = fChainPrev->CheckFilters(slot, entry);
+   if (passed) {
+      auto &state = fChainStates[slot];
+      for (auto i : state.fOrder) {
+         if (!fChain[i]->CheckPredicate(slot, entry)) {
+            passed = false;
+            break;
+         }
+      }
+      if (++state.fNChecked == fNLearningEntries)
+         ComputeChainOrder(slot);
+   }
+   fLastCheckedEntry[slot] = entry;
+   fLastResult[slot] = passed;
+   return passed;
+}
+
+/// Among the filters whose dependencies have been placed, repeatedly pick the one with the lowest expected cost per
+/// rejected entry, i.e. cost / (1 - pass fraction). Without dependencies this is the order of minimum expected cost for
+/// independent filters. Filters that were never evaluated keep their relative order, after the others.
+void RFilterBase::ComputeChainOrder(unsigned int slot)
+{
+   const auto nFilters = fChain.size();
+   std::vector<double> rank(nFilters, std::numeric_limits<double>::max());
+   for (auto i = 0u; i < nFilters; ++i) {
+      const auto &stats = fChain[i]->fStats[slot];
+      if (stats.fNEvaluations == 0)
+         continue;
+      const auto cost = stats.fRealTime / stats.fNEvaluations;
+      const auto rejectFraction = 1. - double(stats.fNPassed) / stats.fNEvaluations;
+      rank[i] = rejectFraction > 0. ? cost / rejectFraction : std::numeric_limits<double>::max() / 2;
+   }
+
+   std::vector<unsigned int> order;
+   std::vector<int> isPlaced(nFilters, false);
+   while (order.size() < nFilters) {
+      auto best = nFilters;
+      for (auto i = 0u; i < nFilters; ++i) {
+         if (isPlaced[i])
+            continue;
+         const auto &deps = fChainDeps[i];
+         const auto canBePlaced = std::all_of(deps.begin(), deps.end(), [&isPlaced](unsigned int d) { return isPlaced[d]; });
+         if (canBePlaced && (best == nFilters || rank[i] < rank[best]))
+            best = i;
+      }
+      isPlaced[best] = true;
+      order.emplace_back(best);
+   }
+   fChainStates[slot].fOrder = std::move(order);
+}
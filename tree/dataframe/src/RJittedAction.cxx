@@ -87,3 +87,21 @@ std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> RJittedAction::Get
    R__ASSERT(fConcreteAction != nullptr);
    return fConcreteAction->GetGraph();
 }
+
+std::string RJittedAction::GetActionName()
+{
+   R__ASSERT(fConcreteAction != nullptr);
+   return fConcreteAction->GetActionName();
+}
+
+const ROOT::Internal::RDF::RNodeProfile &RJittedAction::GetProfile() const
+{
+   // the action might not have been jitted yet
+   return fConcreteAction ? fConcreteAction->GetProfile() : fProfile;
+}
+
+ROOT::Detail::RDF::RNodeBase *RJittedAction::GetPrevNode()
+{
+   // the action might not have been jitted yet
+   return fConcreteAction ? fConcreteAction->GetPrevNode() : nullptr;
+}
@@ -48,3 +48,21 @@ void RJittedCustomColumn::InitNode()
    R__ASSERT(fConcreteCustomColumn != nullptr);
    fConcreteCustomColumn->InitNode();
 }
+
+const ROOT::Internal::RDF::RNodeProfile &RJittedCustomColumn::GetProfile() const
+{
+   // the column might not have been jitted yet
+   return fConcreteCustomColumn ? fConcreteCustomColumn->GetProfile() : fProfile;
+}
+
+const std::vector<std::string> &RJittedCustomColumn::GetColumnNames() const
+{
+   R__ASSERT(fConcreteCustomColumn != nullptr);
+   return fConcreteCustomColumn->GetColumnNames();
+}
+
+const ROOT::Internal::RDF::RBookedCustomColumns &RJittedCustomColumn::GetBookedColumns() const
+{
+   R__ASSERT(fConcreteCustomColumn != nullptr);
+   return fConcreteCustomColumn->GetBookedColumns();
+}
@@ -32,9 +32,36 @@ void RJittedFilter::InitSlot(TTreeReader *r, unsigned int slot)
 bool RJittedFilter::CheckFilters(unsigned int slot, Long64_t entry)
 {
    R__ASSERT(fConcreteFilter != nullptr);
+   // the chain of reordered filters is set on the node that was booked, i.e. this one
+   if (IsReordered())
+      return CheckReorderedChain(slot, entry);
    return fConcreteFilter->CheckFilters(slot, entry);
 }
 
+bool RJittedFilter::EvalPredicate(unsigned int slot, Long64_t entry)
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   return fConcreteFilter->EvalPredicate(slot, entry);
+}
+
+RNodeBase *RJittedFilter::GetPrevNode()
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   return fConcreteFilter->GetPrevNode();
+}
+
+const ColumnNames_t &RJittedFilter::GetColumnNames() const
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   return fConcreteFilter->GetColumnNames();
+}
+
+const ROOT::Internal::RDF::RBookedCustomColumns &RJittedFilter::GetBookedColumns() const
+{
+   R__ASSERT(fConcreteFilter != nullptr);
+   return fConcreteFilter->GetBookedColumns();
+}
+
 void RJittedFilter::Report(ROOT::RDF::RCutFlowReport &cr) const
 {
    R__ASSERT(fConcreteFilter != nullptr);
@@ -98,9 +125,17 @@ void RJittedFilter::ClearTask(unsigned int slot)
 void RJittedFilter::InitNode()
 {
    R__ASSERT(fConcreteFilter != nullptr);
+   // the cached results of this node are used when it evaluates a chain of reordered filters
+   RFilterBase::InitNode();
    fConcreteFilter->InitNode();
 }
 
+const ROOT::Internal::RDF::RNodeProfile &RJittedFilter::GetProfile() const
+{
+   // the filter might not have been jitted yet
+   return fConcreteFilter ? fConcreteFilter->GetProfile() : fProfile;
+}
+
 void RJittedFilter::AddFilterName(std::vector<std::string> &filters)
 {
    if (fConcreteFilter == nullptr) {
@@ -1,8 +1,10 @@
 #include "RConfigure.h" // R__USE_IMT
+#include "ROOT/RDF/InterfaceUtils.hxx" // IsInternalColumn
 #include "ROOT/RDF/RActionBase.hxx"
 #include "ROOT/RDF/RCustomColumnBase.hxx"
 #include "ROOT/RDF/RFilterBase.hxx"
 #include "ROOT/RDF/RLoopManager.hxx"
+#include "ROOT/RDF/RProfileReport.hxx"
 #include "ROOT/RDF/RRangeBase.hxx"
 #include "ROOT/RDF/RSlotStack.hxx"
 #include "ROOT/TTreeProcessorMT.hxx"
@@ -13,12 +15,16 @@
 #include "TError.h"
 #include "TInterpreter.h"
 #include "TROOT.h" // IsImplicitMTEnabled
+#include "TTreeCache.h"
+#include "TTreeClusterStats.h"
 #include "TTreeReader.h"
 
 #ifdef R__USE_IMT
+#include "ROOT/TTaskGroup.hxx"
 #include "ROOT/TThreadExecutor.hxx"
 #endif
 
+#include <algorithm>
 #include <atomic>
 #include <functional>
 #include <memory>
@@ -282,6 +288,12 @@ void RLoopManager::RunTreeProcessorMT()
    RSlotStack slotStack(fNSlots);
    const auto &entryList = fTree->GetEntryList() ? *fTree->GetEntryList() : TEntryList();
    auto tp = std::make_unique<ROOT::TTreeProcessorMT>(*fTree, entryList);
+   if (fLateMaterialization)
+      fFilterBranchNames = GetFilterColumnNames();
+   InitClusterSkipping();
+   if (!fClusterSkippingFilters.empty())
+      tp->SetClusterFilter(
+         [this](TTree &tree, Long64_t start, Long64_t end) { return IsClusterSelected(tree, start, end); });
 
    std::atomic<ULong64_t> entryCount(0ull);
 
@@ -291,8 +303,14 @@ void RLoopManager::RunTreeProcessorMT()
       const auto entryRange = r.GetEntriesRange(); // we trust TTreeProcessorMT to call SetEntriesRange
       const auto nEntries = entryRange.second - entryRange.first;
       auto count = entryCount.fetch_add(nEntries);
+      // the cache is set up once the reader loaded the first tree, before any branch is read
+      bool mustSetupCache = fLateMaterialization;
       // recursive call to check filters and conditionally execute actions
-      while (r.Next()) {
+      while (ReadTreeEntry(r, slot)) {
+         if (mustSetupCache) {
+            SetupLateMaterialization(*r.GetTree());
+            mustSetupCache = false;
+         }
          RunAndCheckFilters(slot, count++);
       }
       CleanUpTask(slot);
@@ -309,13 +327,44 @@ void RLoopManager::RunTreeReader()
    if (0 == fTree->GetEntriesFast())
       return;
    InitNodeSlots(&r, 0);
+   if (fLateMaterialization)
+      fFilterBranchNames = GetFilterColumnNames();
+   // the cache is set up once the reader loaded the first tree, before any branch is read
+   bool mustSetupCache = fLateMaterialization;
+   InitClusterSkipping();
+   // the clusters of the current tree whose entries cannot pass the filters, in chain entry numbers
+   Int_t skippedTreeNumber = -1;
+   std::vector<std::pair<Long64_t, Long64_t>> skippedClusters;
+   auto nextSkippedCluster = skippedClusters.cend();
 
    // recursive call to check filters and conditionally execute actions
    // in the non-MT case processing can be stopped early by ranges, hence the check on fNStopsReceived
-   while (r.Next() && fNStopsReceived < fNChildren) {
-      RunAndCheckFilters(0, r.GetCurrentEntry());
+   while (ReadTreeEntry(r, 0u) && fNStopsReceived < fNChildren) {
+      if (mustSetupCache) {
+         SetupLateMaterialization(*fTree);
+         mustSetupCache = false;
+      }
+      const auto entry = r.GetCurrentEntry();
+      if (!fClusterSkippingFilters.empty()) {
+         if (fTree->GetTreeNumber() != skippedTreeNumber) {
+            skippedTreeNumber = fTree->GetTreeNumber();
+            skippedClusters = GetSkippedClusters(*fTree->GetTree());
+            nextSkippedCluster = skippedClusters.cbegin();
+         }
+         while (nextSkippedCluster != skippedClusters.cend() && nextSkippedCluster->second <= entry)
+            ++nextSkippedCluster;
+         if (nextSkippedCluster != skippedClusters.cend() && nextSkippedCluster->first <= entry) {
+            // the next call to ReadTreeEntry moves to the first entry after the cluster
+            r.SetEntry(nextSkippedCluster->second - 1);
+            continue;
+         }
+      }
+      RunAndCheckFilters(0, entry);
    }
    CleanUpTask(0u);
+   // the tree outlives the event loop: do not let the next event loops inherit the branches to prefetch
+   if (fLateMaterialization)
+      ResetLateMaterialization(*fTree);
 }
 
 /// Run event loop over data accessed through a DataSource, in sequence.
@@ -330,7 +379,7 @@ void RLoopManager::RunDataSource()
       for (const auto &range : ranges) {
          auto end = range.second;
          for (auto entry = range.first; entry < end; ++entry) {
-            if (fDataSource->SetEntry(0u, entry)) {
+            if (ReadDataSourceEntry(0u, entry)) {
                RunAndCheckFilters(0u, entry);
             }
          }
@@ -357,7 +406,7 @@ void RLoopManager::RunDataSourceMT()
       fDataSource->InitSlot(slot, range.first);
       const auto end = range.second;
       for (auto entry = range.first; entry < end; ++entry) {
-         if (fDataSource->SetEntry(slot, entry)) {
+         if (ReadDataSourceEntry(slot, entry)) {
             RunAndCheckFilters(slot, entry);
          }
       }
@@ -388,6 +437,158 @@ void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
       callback(slot);
 }
 
+/// Move the TTreeReader to the next entry. Branches are not read here but on demand, by the nodes that use them.
+bool RLoopManager::ReadTreeEntry(TTreeReader &r, unsigned int slot)
+{
+   RProfileScope profileScope(GetReadProfile(), slot);
+   return r.Next();
+}
+
+/// Ask the data source to load an entry. Return false if the entry must be skipped.
+bool RLoopManager::ReadDataSourceEntry(unsigned int slot, ULong64_t entry)
+{
+   RProfileScope profileScope(GetReadProfile(), slot);
+   return fDataSource->SetEntry(slot, entry);
+}
+
+/// Return the names of the columns read by the booked filters, directly or through the custom columns they use.
+/// Custom columns are not in the list, but the columns they are computed from are.
+ColumnNames_t RLoopManager::GetFilterColumnNames() const
+{
+   ColumnNames_t columnNames;
+   std::vector<std::pair<const ColumnNames_t *, const RDFInternal::RBookedCustomColumns *>> toVisit;
+   for (auto filter : fBookedFilters)
+      toVisit.emplace_back(&filter->GetColumnNames(), &filter->GetBookedColumns());
+   std::vector<const RCustomColumnBase *> visitedColumns;
+   while (!toVisit.empty()) {
+      const auto names = toVisit.back().first;
+      const auto customColumns = toVisit.back().second;
+      toVisit.pop_back();
+      for (const auto &name : *names) {
+         if (customColumns->HasName(name)) {
+            const RCustomColumnBase *column = customColumns->GetColumns().at(name).get();
+            if (std::find(visitedColumns.begin(), visitedColumns.end(), column) == visitedColumns.end()) {
+               visitedColumns.emplace_back(column);
+               toVisit.emplace_back(&column->GetColumnNames(), &column->GetBookedColumns());
+            }
+         } else if (std::find(columnNames.begin(), columnNames.end(), name) == columnNames.end()) {
+            columnNames.emplace_back(name);
+         }
+      }
+   }
+   return columnNames;
+}
+
+/// Let the TTreeCache of the tree prefetch only the branches read by the filters, see SetLateMaterialization.
+/// The baskets of the other branches are then only read and decompressed when an entry that passed the filters
+/// needs them. The miss cache of the TTreeCache fetches the baskets of all these branches for that entry in one go.
+void RLoopManager::SetupLateMaterialization(TTree &tree) const
+{
+   if (fFilterBranchNames.empty()) // no filter reads the tree, nothing to gain
+      return;
+   auto currentTree = tree.GetTree();
+   auto cache = currentTree && currentTree->GetCurrentFile()
+                   ? currentTree->GetReadCache(currentTree->GetCurrentFile(), /*create=*/true)
+                   : nullptr;
+   if (!cache) // the cache was disabled by the user
+      return;
+
+   cache->DropBranch("*", true);
+   for (const auto &name : fFilterBranchNames) {
+      // what is left after resolving custom columns are branches, possibly of friend trees, and internal columns
+      auto branch = currentTree->GetBranch(name.c_str());
+      if (branch && branch->GetTree() == currentTree)
+         cache->AddBranch(name.c_str(), true);
+   }
+   cache->StopLearningPhase();
+   cache->SetOptimizeMisses(true);
+}
+
+/// Let the TTreeCache of the tree learn again which branches to prefetch, see SetupLateMaterialization.
+void RLoopManager::ResetLateMaterialization(TTree &tree) const
+{
+   auto currentTree = tree.GetTree();
+   auto cache = currentTree && currentTree->GetCurrentFile() ? currentTree->GetReadCache(currentTree->GetCurrentFile())
+                                                             : nullptr;
+   if (cache) {
+      cache->SetOptimizeMisses(false);
+      cache->StartLearningPhase();
+   }
+}
+
+/// Find out whether whole clusters of entries can be skipped in the next event loop, thanks to the minimum and maximum
+/// values of branches recorded for each cluster (see TTree::EnableClusterStats and TTreeClusterStats).
+/// A cluster is skipped if, for each action and named filter, one of the upstream filters has a predicate that no
+/// value in the cluster satisfies. Named filters themselves do not count, so that cutflow reports are unchanged.
+/// Ranges, entry lists and callbacks, which count the entries that are processed, disable the skipping.
+void RLoopManager::InitClusterSkipping()
+{
+   fClusterSkippingFilters.clear();
+   if (!fTree || fTree->GetEntryList() || !fBookedRanges.empty() || !fCallbacks.empty() || fBookedActions.empty())
+      return;
+
+   std::vector<RNodeBase *> prevNodes;
+   for (auto action : fBookedActions)
+      prevNodes.emplace_back(action->GetPrevNode());
+   for (auto namedFilter : fBookedNamedFilters)
+      prevNodes.emplace_back(namedFilter->GetPrevNode());
+
+   std::vector<std::vector<RFilterBase *>> skippingFilters;
+   for (auto node : prevNodes) {
+      std::vector<RFilterBase *> filters;
+      while (auto filter = dynamic_cast<RFilterBase *>(node)) {
+         if (!filter->GetPredicates().empty())
+            filters.emplace_back(filter);
+         node = filter->GetPrevNode();
+      }
+      if (filters.empty()) // all entries of all clusters can reach this node
+         return;
+      skippingFilters.emplace_back(std::move(filters));
+   }
+   fClusterSkippingFilters = std::move(skippingFilters);
+}
+
+/// Return false if no entry in [start, end) of the tree can reach an action or a named filter, see
+/// InitClusterSkipping. Only reads the booked nodes: safe to call concurrently.
+bool RLoopManager::IsClusterSelected(TTree &tree, Long64_t start, Long64_t end) const
+{
+   const auto stats = tree.GetClusterStats();
+   if (!stats)
+      return true;
+   Double_t min, max;
+   auto excludesCluster = [&](const RFilterBase *filter) {
+      for (const auto &predicate : filter->GetPredicates()) {
+         if (stats->GetRange(predicate.fColumn.c_str(), start, end, min, max) && !predicate.MayPass(min, max))
+            return true;
+      }
+      return false;
+   };
+   for (const auto &filters : fClusterSkippingFilters) {
+      if (std::none_of(filters.begin(), filters.end(), excludesCluster))
+         return true;
+   }
+   return false;
+}
+
+/// Return the ranges of entries of the clusters of the tree that are not selected, see IsClusterSelected.
+/// The entry numbers are those of the chain the tree belongs to, if any.
+std::vector<std::pair<Long64_t, Long64_t>> RLoopManager::GetSkippedClusters(TTree &tree) const
+{
+   std::vector<std::pair<Long64_t, Long64_t>> skippedClusters;
+   if (!tree.GetClusterStats())
+      return skippedClusters;
+   const auto offset = tree.GetChainOffset();
+   const auto nEntries = tree.GetEntries();
+   auto clusterIt = tree.GetClusterIterator(0);
+   Long64_t start = 0;
+   while ((start = clusterIt()) < nEntries) {
+      const auto end = clusterIt.GetNextEntry();
+      if (!IsClusterSelected(tree, start, end))
+         skippedClusters.emplace_back(start + offset, end + offset);
+   }
+   return skippedClusters;
+}
+
 /// Build TTreeReaderValues for all nodes
 /// This method loops over all filters, actions and other booked objects and
 /// calls their `InitRDFValues` methods. It is called once per node per slot, before
@@ -410,16 +611,49 @@ void RLoopManager::InitNodeSlots(TTreeReader *r, unsigned int slot)
 void RLoopManager::InitNodes()
 {
    EvalChildrenCounts();
+   fReadProfile.Init(fProfiler.get(), fNSlots);
    for (auto column : fCustomColumns)
       column->InitNode();
    for (auto &filter : fBookedFilters)
       filter->InitNode();
+   InitFilterReordering();
    for (auto &range : fBookedRanges)
       range->InitNode();
    for (auto &ptr : fBookedActions)
       ptr->Initialize();
 }
 
+/// If filter reordering is enabled, let each unnamed filter evaluate the consecutive unnamed filters that end with it.
+/// Named filters and ranges delimit the chains of filters that can be reordered, so that cutflow reports and ranges
+/// count the same entries as without reordering.
+void RLoopManager::InitFilterReordering()
+{
+   for (auto filter : fBookedFilters)
+      filter->InitReordering(fNFilterReorderingEntries);
+   if (fNFilterReorderingEntries == 0)
+      return;
+
+   auto canBeReordered = [this](RNodeBase *node) -> RFilterBase * {
+      auto filter = dynamic_cast<RFilterBase *>(node);
+      if (!filter || filter->HasName() ||
+          std::find(fBookedFilters.begin(), fBookedFilters.end(), filter) == fBookedFilters.end())
+         return nullptr;
+      return filter;
+   };
+   for (auto filter : fBookedFilters) {
+      if (!canBeReordered(filter))
+         continue;
+      std::vector<RFilterBase *> chain{filter};
+      auto prev = filter->GetPrevNode();
+      while (auto prevFilter = canBeReordered(prev)) {
+         chain.insert(chain.begin(), prevFilter);
+         prev = prevFilter->GetPrevNode();
+      }
+      // also chains of one filter, so that the predicate of each filter is evaluated at most once per entry
+      filter->SetChain(chain, prev);
+   }
+}
+
 /// Perform clean-up operations. To be called at the end of each event loop.
 void RLoopManager::CleanUpNodes()
 {
@@ -517,6 +751,47 @@ void RLoopManager::Run()
    CleanUpNodes();
 }
 
+/// Run the event loops of several computation graphs. If implicit multi-threading is enabled, the event loops run
+/// concurrently and their tasks are interleaved on the same thread pool, otherwise they run one after the other.
+/// The code that all graphs need to just-in-time compile is declared and executed with one interpreter call each.
+/// Null pointers and repeated RLoopManagers are skipped. Return the number of event loops that were run.
+unsigned int RLoopManager::RunGraphs(const std::vector<RLoopManager *> &loopManagers)
+{
+   std::vector<RLoopManager *> toRun;
+   for (auto lm : loopManagers) {
+      if (lm && std::find(toRun.begin(), toRun.end(), lm) == toRun.end())
+         toRun.emplace_back(lm);
+   }
+
+   std::string toJitDeclare;
+   std::string toJitExec;
+   for (auto lm : toRun) {
+      toJitDeclare.append(lm->fToJitDeclare);
+      lm->fToJitDeclare.clear();
+      toJitExec.append(lm->fToJitExec);
+      lm->fToJitExec.clear();
+   }
+   if (!toJitDeclare.empty())
+      RDFInternal::InterpreterDeclare(toJitDeclare);
+   if (!toJitExec.empty())
+      RDFInternal::InterpreterCalc(toJitExec, "RLoopManager::RunGraphs");
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && toRun.size() > 1) {
+      // the TThreadExecutor of each event loop submits its tasks to the same pool
+      ROOT::Experimental::TTaskGroup tasks;
+      for (auto lm : toRun)
+         tasks.Run([lm]() { lm->Run(); });
+      tasks.Wait();
+      return toRun.size();
+   }
+#endif
+
+   for (auto lm : toRun)
+      lm->Run();
+   return toRun.size();
+}
+
 /// Return the list of default columns -- empty if none was provided when constructing the RDataFrame
 const ColumnNames_t &RLoopManager::GetDefaultColumnNames() const
 {
@@ -585,6 +860,50 @@ void RLoopManager::RegisterCallback(ULong64_t everyNEvents, std::function<void(u
       fCallbacks.emplace_back(everyNEvents, std::move(f), fNSlots);
 }
 
+/// Enable or disable the profiling of the following event loops. When enabled, each Define, Filter and action records
+/// how many times it was evaluated and the time spent evaluating it, in each processing slot, and the time spent reading
+/// the data is recorded separately. Timings of successive profiled event loops add up.
+void RLoopManager::SetProfiling(bool enable)
+{
+   if (!enable)
+      fProfiler.reset();
+   else if (!fProfiler)
+      fProfiler.reset(new RDFInternal::RProfiler(fNSlots));
+}
+
+/// Collect the timings recorded by the nodes of the graph in the profiled event loops, see SetProfiling.
+/// Nodes that never ran with profiling enabled are not reported.
+ROOT::RDF::RProfileReport RLoopManager::GetProfileReport()
+{
+   ROOT::RDF::RProfileReport report;
+   // jitted nodes forward to the same profile as the concrete node they wrap, which might be registered as well
+   std::vector<const RDFInternal::RNodeProfile *> reported;
+   auto addNode = [&report, &reported](const std::string &kind, const std::string &name,
+                                       const RDFInternal::RNodeProfile &profile) {
+      if (!profile.HasTimings() || std::find(reported.begin(), reported.end(), &profile) != reported.end())
+         return;
+      reported.emplace_back(&profile);
+      report.AddNode(kind, name, profile.GetSlots());
+   };
+
+   std::string source;
+   if (fDataSource)
+      source = fDataSource->GetLabel();
+   else if (fTree)
+      source = fTree->GetName();
+   addNode("Read", source, fReadProfile);
+   for (auto column : fCustomColumns) {
+      // data-source columns only forward pointers to the values read by the data source
+      if (!RDFInternal::IsInternalColumn(column->GetName()) && !column->IsDataSourceColumn())
+         addNode("Define", column->GetName(), column->GetProfile());
+   }
+   for (auto filter : fBookedFilters)
+      addNode("Filter", filter->HasName() ? filter->GetName() : "Unnamed Filter", filter->GetProfile());
+   for (auto action : GetAllActions())
+      addNode("Action", action->GetActionName(), action->GetProfile());
+   return report;
+}
+
 std::vector<std::string> RLoopManager::GetFiltersNames()
 {
    std::vector<std::string> filters;
@@ -614,7 +933,7 @@ std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> RLoopManager::GetG
       name = std::to_string(fNEmptyEntries);
    }
 
-   auto thisNode = std::make_shared<ROOT::Internal::RDF::GraphDrawing::GraphNode>(name);
+   auto thisNode = std::make_shared<ROOT::Internal::RDF::GraphDrawing::GraphNode>(name + fReadProfile.GetSummary());
    thisNode->SetRoot();
    thisNode->SetCounter(0);
    return thisNode;
@@ -0,0 +1,100 @@
+// @(#)root/dataframe:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RNodeProfile.hxx"
+#include "ROOT/RDF/RProfileReport.hxx"
+#include "TString.h" // Printf
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <stdexcept>
+#include <time.h> // clock_gettime
+
+namespace ROOT {
+
+namespace Internal {
+namespace RDF {
+
+double GetThreadCpuTime()
+{
+#ifdef CLOCK_THREAD_CPUTIME_ID
+   timespec ts;
+   if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+      return ts.tv_sec + 1e-9 * ts.tv_nsec;
+#endif
+   // no per-thread clock: fall back to the CPU time of the process
+   return double(std::clock()) / CLOCKS_PER_SEC;
+}
+
+bool RNodeProfile::HasTimings() const
+{
+   return std::any_of(fSlots.begin(), fSlots.end(), [](const RNodeTimings &t) { return t.fCalls > 0; });
+}
+
+std::string RNodeProfile::GetSummary() const
+{
+   if (!HasTimings())
+      return "";
+   RNodeTimings total;
+   for (const auto &t : fSlots)
+      total += t;
+   char summary[64];
+   snprintf(summary, sizeof(summary), "\n%llu calls, %.3g ms", total.fCalls, 1e3 * total.fRealTime);
+   return summary;
+}
+
+} // End NS RDF
+} // End NS Internal
+
+namespace RDF {
+
+RNodeProfileInfo::RNodeProfileInfo(const std::string &kind, const std::string &name,
+                                   const std::vector<RNodeTimings> &slots)
+   : fKind(kind), fName(name), fSlots(slots)
+{
+   for (const auto &t : fSlots)
+      fTotal += t;
+}
+
+void RProfileReport::Print() const
+{
+   double realTime = 0.;
+   for (auto &&info : fInfos)
+      realTime += info.GetTotal().fRealTime;
+   Printf("%-8s %-24s %12s %12s %12s %10s %8s", "Kind", "Name", "Calls", "Real [ms]", "CPU [ms]", "ns/call",
+          "Real %");
+   for (auto &&info : fInfos) {
+      const auto &t = info.GetTotal();
+      const auto nsPerCall = t.fCalls > 0 ? 1e9 * t.fRealTime / t.fCalls : 0.;
+      const auto fraction = realTime > 0. ? 100. * t.fRealTime / realTime : 0.;
+      Printf("%-8s %-24s %12llu %12.3f %12.3f %10.1f %8.2f", info.GetKind().c_str(), info.GetName().c_str(), t.fCalls,
+             1e3 * t.fRealTime, 1e3 * t.fCpuTime, nsPerCall, fraction);
+   }
+}
+
+const RNodeProfileInfo &RProfileReport::operator[](std::string_view nodeName) const
+{
+   auto pred = [&nodeName](const RNodeProfileInfo &info) { return info.GetName() == nodeName; };
+   const auto it = std::find_if(fInfos.begin(), fInfos.end(), pred);
+   if (it == fInfos.end()) {
+      std::string err = "Cannot find a profiled node called \"";
+      err += nodeName;
+      err += "\". Available nodes are: \n";
+      for (auto &&info : fInfos)
+         err += " - " + info.GetKind() + " " + info.GetName() + "\n";
+      throw std::runtime_error(err);
+   }
+   return *it;
+}
+
+} // End NS RDF
+
+} // End NS ROOT
@@ -8,6 +8,7 @@
 #include "gtest/gtest.h"
 
 #include <algorithm>
+#include <cstring>
 
 using namespace ROOT::RDF;
 using namespace ROOT::VecOps;
@@ -336,3 +337,80 @@ TEST(Cache, Carrays)
 }
 
 #endif // R__B64
+
+// the number of files in a directory, or -1 if it cannot be opened
+static int CountFiles(const char *dirName)
+{
+   auto dir = gSystem->OpenDirectory(dirName);
+   if (!dir)
+      return -1;
+   int n = 0;
+   while (const char *entry = gSystem->GetDirEntry(dir)) {
+      if (strcmp(entry, ".") != 0 && strcmp(entry, "..") != 0)
+         ++n;
+   }
+   gSystem->FreeDirectory(dir);
+   return n;
+}
+
+TEST(Cache, MemoryBudget)
+{
+   const auto spillDir = "CacheMemoryBudget";
+   gSystem->mkdir(spillDir);
+   {
+      ROOT::RDataFrame tdf(100000);
+      auto d = tdf.Define("i", [](ULong64_t e) { return int(e * 7919 % 1000); }, {"rdfentry_"})
+                  .Define("v", [](int i) { return RVec<float>(i % 4, float(i)); }, {"i"})
+                  .Define("b", [](int i) { return RVec<bool>(i % 3, i % 2 == 0); }, {"i"});
+      // a budget much smaller than the compressed columns: most entries go to disk
+      const RCacheOptions options(64 * 1024, ROOT::kLZ4, 1, spillDir);
+      auto cached = d.Cache<int, RVec<float>, RVec<bool>>({"i", "v", "b"}, options);
+      auto ref = d.Cache<int, RVec<float>, RVec<bool>>({"i", "v", "b"});
+
+      auto check = [](ROOT::RDF::RNode df, int &sum, std::size_t &nv, std::size_t &nb) {
+         df.Foreach(
+            [&](int i, const RVec<float> &v, const RVec<bool> &b) {
+               sum += i;
+               nv += v.size();
+               nb += std::count(b.begin(), b.end(), true);
+               EXPECT_TRUE(v.empty() || v[0] == float(i));
+            },
+            {"i", "v", "b"});
+      };
+      int sum = 0, refSum = 0;
+      std::size_t nv = 0, refNv = 0, nb = 0, refNb = 0;
+      check(cached, sum, nv, nb);
+      check(ref, refSum, refNv, refNb);
+      EXPECT_EQ(refSum, sum);
+      EXPECT_EQ(refNv, nv);
+      EXPECT_EQ(refNb, nb);
+      EXPECT_GT(CountFiles(spillDir), 0);
+
+      // a second event loop reads the same parts
+      EXPECT_EQ(100000ULL, *cached.Count());
+      EXPECT_EQ(refSum, *cached.Sum<int>("i"));
+
+      // jitted, with a budget large enough to keep everything in memory
+      auto cachedj = d.Cache({"i", "v"}, RCacheOptions(1024 * 1024 * 1024));
+      EXPECT_EQ(refSum, *cachedj.Sum<int>("i"));
+   }
+   // the temporary files are removed with the cached data frames
+   EXPECT_EQ(0, CountFiles(spillDir));
+   gSystem->Unlink(spillDir);
+}
+
+#ifdef R__USE_IMT
+TEST(Cache, MemoryBudgetMT)
+{
+   ROOT::EnableImplicitMT(4);
+   {
+      ROOT::RDataFrame tdf(200000);
+      auto d = tdf.Define("i", [](ULong64_t e) { return int(e % 1000); }, {"rdfentry_"});
+      auto cached = d.Cache<int>({"i"}, RCacheOptions(64 * 1024));
+      auto refSum = d.Sum<int>("i");
+      EXPECT_EQ(200000ULL, *cached.Count());
+      EXPECT_EQ(*refSum, *cached.Sum<int>("i"));
+   }
+   ROOT::DisableImplicitMT();
+}
+#endif
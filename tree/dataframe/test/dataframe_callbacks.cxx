@@ -326,6 +326,32 @@ TEST_F(RDFCallbacks, FreeFunction)
    EXPECT_EQ(freeFunctionCounter, gNEvents);
 }
 
+TEST(RDFCallbacksMore, AutoBinnedHistoPartialResultBinning)
+{
+   // more entries than the buffer of the auto-binned histogram holds: the partial result comes from the sketch of the
+   // values and must have the binning of the final result
+   const ULong64_t nEntries = 3000000ull;
+   auto d = ROOT::RDataFrame(nEntries).Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"});
+   auto h = d.Histo1D<double>("x");
+   using value_t = typename decltype(h)::Value_t;
+   unsigned int nCalls = 0;
+   int nBins = 0;
+   double xMin = 0., xMax = 0., entries = 0.;
+   h.OnPartialResult(nEntries, [&](value_t &h_) {
+      ++nCalls;
+      nBins = h_.GetNbinsX();
+      xMin = h_.GetXaxis()->GetXmin();
+      xMax = h_.GetXaxis()->GetXmax();
+      entries = h_.GetEntries();
+   });
+   EXPECT_EQ(h->GetEntries(), double(nEntries));
+   EXPECT_EQ(nCalls, 1u);
+   EXPECT_EQ(nBins, h->GetNbinsX());
+   EXPECT_DOUBLE_EQ(xMin, h->GetXaxis()->GetXmin());
+   EXPECT_DOUBLE_EQ(xMax, h->GetXaxis()->GetXmax());
+   EXPECT_EQ(entries, double(nEntries));
+}
+
 
 #ifdef R__USE_IMT
 /******** Multi-thread tests **********/
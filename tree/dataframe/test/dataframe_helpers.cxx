@@ -275,3 +275,37 @@ TEST(RDFHelpers, SaveGraphToFile)
 
    gSystem->Unlink(outFileName);
 }
+
+TEST(RDFHelpers, RunGraphs)
+{
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+   std::vector<ROOT::RDataFrame> dfs;
+   for (auto i : {100ull, 200ull, 300ull})
+      dfs.emplace_back(i);
+   std::vector<RResultPtr<ULong64_t>> counts;
+   for (auto &df : dfs)
+      counts.emplace_back(df.Define("x", "rdfentry_ % 2").Filter("x == 0").Count());
+   auto sum = dfs[0].Define("y", [] { return 1; }).Sum<int>("y");
+   auto mean = dfs[1].Define("y", [] { return 2.; }).Mean<double>("y");
+
+   // the graphs of sum and mean are the same as the ones of counts[0] and counts[1]
+   EXPECT_EQ(3u, RunGraphs(counts));
+   EXPECT_EQ(50ull, *counts[0]);
+   EXPECT_EQ(100ull, *counts[1]);
+   EXPECT_EQ(150ull, *counts[2]);
+   EXPECT_EQ(100, *sum);
+   EXPECT_DOUBLE_EQ(2., *mean);
+
+   // results already available do not trigger event loops
+   EXPECT_EQ(0u, RunGraphs(counts[0], sum, mean));
+   auto max = dfs[2].Max<ULong64_t>("rdfentry_");
+   auto count = dfs[1].Count();
+   EXPECT_EQ(2u, RunGraphs(counts[0], max, count, max));
+   EXPECT_EQ(299ull, *max);
+   EXPECT_EQ(200ull, *count);
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+}
@@ -1,5 +1,6 @@
 #include "TRandom.h"
 #include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDFHelpers.hxx"
 #include "ROOT/TSeq.hxx"
 #include "gtest/gtest.h"
 
@@ -97,3 +98,39 @@ TEST(RDataFrameReport, ActionLazyness)
    EXPECT_TRUE(hasRun);
 
 }
+
+TEST(RDataFrameReport, Profiling)
+{
+   ROOT::RDataFrame d(100);
+   auto dd = d.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"})
+                .Filter([](double x) { return x > 9; }, {"x"}, "xcut");
+   auto count = dd.Count();
+
+   // profiling is disabled by default
+   *count;
+   EXPECT_EQ(0u, d.ProfileReport().size());
+   EXPECT_EQ(std::string::npos, ROOT::RDF::SaveGraph(d).find("calls"));
+
+   d.EnableProfiling();
+   auto sum = dd.Sum<double>("x");
+   *sum;
+   auto report = d.ProfileReport();
+   EXPECT_EQ(100ull, report["x"].GetTotal().fCalls);
+   EXPECT_EQ("Define", report["x"].GetKind());
+   EXPECT_EQ(100ull, report["xcut"].GetTotal().fCalls);
+   EXPECT_EQ(90ull, report["Sum"].GetTotal().fCalls);
+   EXPECT_EQ(d.GetNSlots(), report["Sum"].GetSlots().size());
+   for (auto &&node : report) {
+      EXPECT_GE(node.GetTotal().fRealTime, 0.);
+      EXPECT_GE(node.GetTotal().fCpuTime, 0.);
+   }
+   EXPECT_NE(std::string::npos, ROOT::RDF::SaveGraph(d).find("100 calls"));
+   EXPECT_ANY_THROW(report["y"]);
+
+   // timings of successive event loops add up, until profiling is disabled
+   *dd.Count();
+   EXPECT_EQ(200ull, d.ProfileReport()["xcut"].GetTotal().fCalls);
+   d.EnableProfiling(false);
+   *dd.Count();
+   EXPECT_EQ(200ull, d.ProfileReport()["xcut"].GetTotal().fCalls);
+}
@@ -12,7 +12,9 @@
 
 #include <algorithm> // std::sort
 #include <array>
+#include <atomic>
 #include <chrono>
+#include <cmath>
 #include <thread>
 #include <set>
 #include <random>
@@ -1035,6 +1037,204 @@ TEST(RDFSimpleTests, ScalarValuesCollectionWeights)
    EXPECT_ANY_THROW(*h);
 }
 
+TEST_P(RDFSimpleTests, BulkExecution)
+{
+   auto fill = [](unsigned int bulkSize) {
+      ROOT::RDataFrame r(10000);
+      r.SetBulkSize(bulkSize);
+      auto d = r.Define("x", [](ULong64_t e) { return (e % 1000) / 1000.; }, {"rdfentry_"})
+                  .Define("y", [](ULong64_t e) { return int(e % 7); }, {"rdfentry_"})
+                  .Define("w", [](ULong64_t e) { return float(1 + e % 3); }, {"rdfentry_"})
+                  .Filter([](int y) { return y != 3; }, {"y"});
+      auto h = d.Histo1D<double>({"h", "h", 100, 0., 1.}, "x");
+      auto hw = d.Histo1D<double, float>({"hw", "hw", 100, 0., 1.}, "x", "w");
+      auto h2 = d.Histo2D<double, int, float>({"h2", "h2", 10, 0., 1., 7, 0., 7.}, "x", "y", "w");
+      auto h3 = d.Histo3D<double, int, ULong64_t, float>({"h3", "h3", 10, 0., 1., 7, 0., 7., 5, 0., 10000.}, "x",
+                                                         "y", "rdfentry_", "w");
+      auto s = d.Sum<double>("x");
+      auto si = d.Sum<int>("y");
+      auto m = d.Mean<float>("w");
+      auto mi = d.Min<int>("y");
+      auto ma = d.Max<double>("x");
+      std::vector<double> res{*s, double(*si), *m, double(*mi), *ma, h->GetMean(), hw->GetMean(), h2->GetMean(2),
+                              h->GetEntries(), hw->GetEntries(), h2->GetEntries(), hw->GetBinContent(50),
+                              h2->GetBinContent(5, 5), h3->GetMean(3), h3->GetRMS(1), h3->GetEntries(),
+                              h3->GetBinContent(5, 5, 2), h3->GetBinError(5, 5, 2)};
+      return res;
+   };
+
+   const auto ref = fill(0);
+   for (auto bulkSize : {16u, 1000u}) {
+      const auto res = fill(bulkSize);
+      ASSERT_EQ(ref.size(), res.size());
+      for (auto i = 0u; i < ref.size(); ++i)
+         EXPECT_NEAR(ref[i], res[i], 1e-12 * std::abs(ref[i])) << "bulk size " << bulkSize << ", result " << i;
+   }
+}
+
+TEST_P(RDFSimpleTests, FilterReordering)
+{
+   struct Result {
+      ULong64_t fCount;
+      ULong64_t fNExpensiveEvals;
+      ULong64_t fNBadDefineEvals;
+      ULong64_t fNamedAll;
+      ULong64_t fNamedPass;
+   };
+   auto run = [](bool reorder) {
+      std::atomic<ULong64_t> nExpensive{0};
+      std::atomic<ULong64_t> nBadDefine{0};
+      ROOT::RDataFrame r(10000);
+      r.EnableFilterReordering(reorder, 100);
+      // expensive and not selective
+      auto expensive = [&nExpensive](ULong64_t x) {
+         ++nExpensive;
+         double s = 0.;
+         for (int i = 0; i < 1000; ++i)
+            s += std::sqrt(double(x + i));
+         return s > 0. && x % 10 != 3;
+      };
+      // "y" must only be evaluated for entries that passed the expensive filter
+      auto defineY = [&nBadDefine](ULong64_t x) {
+         if (x % 10 == 3)
+            ++nBadDefine;
+         return x;
+      };
+      auto d = r.Define("x", [](ULong64_t e) { return e; }, {"rdfentry_"})
+                  .Filter(expensive, {"x"})
+                  .Define("y", defineY, {"x"})
+                  .Filter([](ULong64_t y) { return y % 2 == 0; }, {"y"})
+                  .Filter([](ULong64_t x) { return x % 10 == 0; }, {"x"}) // cheap and very selective
+                  .Filter([](ULong64_t x) { return x < 5000; }, {"x"}, "named");
+      auto c = d.Count();
+      auto report = d.Report();
+      const auto &named = report->At("named");
+      return Result{*c, nExpensive.load(), nBadDefine.load(), named.GetAll(), named.GetPass()};
+   };
+
+   const auto ref = run(false);
+   const auto res = run(true);
+   EXPECT_EQ(500ull, ref.fCount);
+   EXPECT_EQ(ref.fCount, res.fCount);
+   EXPECT_EQ(ref.fNamedAll, res.fNamedAll);
+   EXPECT_EQ(ref.fNamedPass, res.fNamedPass);
+   EXPECT_EQ(0ull, res.fNBadDefineEvals);
+   EXPECT_EQ(10000ull, ref.fNExpensiveEvals);
+   // after the learning phase, the expensive filter only runs on the entries that passed the selective one
+   EXPECT_LT(res.fNExpensiveEvals, ref.fNExpensiveEvals / 2);
+}
+
+TEST_P(RDFSimpleTests, LateMaterialization)
+{
+   const auto fileName = "dataframe_simple_latematerialization.root";
+   {
+      auto makeV = [](ULong64_t e) {
+         std::vector<double> v(20);
+         for (auto i = 0u; i < v.size(); ++i)
+            v[i] = std::sin(e * 20. + i);
+         return v;
+      };
+      ROOT::RDataFrame(10000)
+         .Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"})
+         .Define("v", makeV, {"rdfentry_"})
+         .Snapshot<int, std::vector<double>>("t", fileName, {"x", "v"});
+   }
+
+   auto run = [fileName](bool lateMaterialization) {
+      ROOT::RDataFrame d("t", fileName);
+      d.EnableLateMaterialization(lateMaterialization);
+      auto sum = d.Filter([](int x) { return x % 1000 == 0; }, {"x"})
+                    .Define("v0", [](const RVec<double> &v) { return v[0]; }, {"v"})
+                    .Sum<double>("v0");
+      const auto bytesBefore = TFile::GetFileBytesRead();
+      const auto s = *sum;
+      return std::make_pair(s, TFile::GetFileBytesRead() - bytesBefore);
+   };
+
+   const auto ref = run(false);
+   const auto res = run(true);
+   EXPECT_DOUBLE_EQ(ref.first, res.first);
+   // the bytes read are only counted reliably by a single thread: "v" is only read for the 10 selected entries
+   if (!GetParam())
+      EXPECT_LT(res.second, ref.second / 2);
+
+   gSystem->Unlink(fileName);
+}
+
+TEST_P(RDFSimpleTests, AutoBinnedHistoManyEntries)
+{
+   // more entries than the buffers of the auto-binned histograms can hold
+   const ULong64_t nEntries = 3000000ull;
+   auto d = ROOT::RDataFrame(nEntries).Define("x", [](ULong64_t e) { return std::fmod(e * 0.6180339887, 1.) * 10. - 2.; },
+                                               {"rdfentry_"});
+   auto h = d.Histo1D<double>("x");
+   auto hw = d.Histo1D<double, double>("x", "x");
+   auto mean = d.Mean<double>("x");
+
+   EXPECT_EQ(h->GetEntries(), double(nEntries));
+   EXPECT_NEAR(h->GetMean(), *mean, 1e-9);
+   EXPECT_NEAR(h->GetXaxis()->GetXmin(), -2., 1e-3);
+   EXPECT_NEAR(h->GetXaxis()->GetXmax(), 8., 1e-3);
+   // the values are almost uniformly distributed: each bin holds nEntries / nBins values, up to the resolution of the
+   // rebinning
+   const auto nBins = h->GetNbinsX();
+   for (auto bin = 1; bin < nBins; ++bin)
+      EXPECT_NEAR(h->GetBinContent(bin), double(nEntries) / nBins, 0.03 * nEntries / nBins) << "bin " << bin;
+   EXPECT_NEAR(h->Integral(0, nBins + 1), double(nEntries), 0.5);
+   EXPECT_NEAR(hw->Integral(0, hw->GetNbinsX() + 1), *mean * nEntries, 1e-6 * nEntries);
+}
+
+TEST_P(RDFSimpleTests, ClusterSkipping)
+{
+   const auto fileName = "dataframe_simple_clusterskipping.root";
+   {
+      TFile f(fileName, "RECREATE");
+      TTree t("t", "t");
+      int x = 0;
+      double y = 0.;
+      t.Branch("x", &x);
+      t.Branch("y", &y);
+      t.SetAutoFlush(100);
+      t.EnableClusterStats();
+      for (; x < 10000; ++x) {
+         y = std::sin(x);
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   ROOT::RDataFrame d("t", fileName);
+   auto count = d.Filter("x >= 9950 && y > 0").Count();
+   auto sum = d.Filter([](int x) { return x % 1000 == 0; }, {"x"}).Sum<int>("x");
+   auto named = d.Filter("x < 250", "low").Filter("y < 0", "neg");
+   auto namedCount = named.Count();
+   auto report = named.Report();
+   const auto bytesBefore = TFile::GetFileBytesRead();
+   // the second filter cannot skip clusters: all entries are read
+   EXPECT_EQ(*sum, 45000);
+   int expected = 0;
+   for (int x = 9950; x < 10000; ++x)
+      expected += std::sin(x) > 0;
+   EXPECT_EQ(*count, ULong64_t(expected));
+   int expectedNamed = 0;
+   for (int x = 0; x < 250; ++x)
+      expectedNamed += std::sin(x) < 0;
+   EXPECT_EQ(*namedCount, ULong64_t(expectedNamed));
+   // the cutflow report counts all entries
+   EXPECT_EQ(report->At("low").GetAll(), 10000ull);
+   EXPECT_EQ(report->At("neg").GetAll(), 250ull);
+   const auto allBytes = TFile::GetFileBytesRead() - bytesBefore;
+
+   // only the last cluster is read
+   auto skippingCount = d.Filter("x >= 9950 && y > 0").Count();
+   const auto bytesBeforeSkipping = TFile::GetFileBytesRead();
+   EXPECT_EQ(*skippingCount, ULong64_t(expected));
+   if (!GetParam())
+      EXPECT_LT(TFile::GetFileBytesRead() - bytesBeforeSkipping, allBytes / 10);
+
+   gSystem->Unlink(fileName);
+}
+
 // run single-thread tests
 INSTANTIATE_TEST_CASE_P(Seq, RDFSimpleTests, ::testing::Values(false));
 
@@ -1,4 +1,5 @@
 #include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDF/InterfaceUtils.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "TTree.h"
 
@@ -240,3 +241,50 @@ TEST(RDataFrameUtils, FindUnknownColumnsFriendTrees)
    auto ncols = RDFInt::FindUnknownColumns({"c2", "c3", "c4"}, RDFInt::GetBranchNames(t1), {}, {});
    EXPECT_EQ(ncols.size(), 0u) << "Cannot find column in friend trees.";
 }
+
+TEST(RDataFrameUtils, FindColumnPredicates)
+{
+   using EOp = RDFInt::RColumnPredicate::EOp;
+   int i = 0;
+   unsigned int u = 0;
+   float f = 0;
+   TTree t("t", "t");
+   t.Branch("i", &i);
+   t.Branch("u", &u);
+   t.Branch("f", &f);
+   const std::map<std::string, std::string> aliases{{"alias", "i"}};
+   const RDFInt::RBookedCustomColumns customColumns;
+   auto find = [&](const std::string &expr) { return RDFInt::FindColumnPredicates(expr, t, aliases, customColumns); };
+
+   auto predicates = find("i > 5 && 2.5 >= f && sqrt(f) < 2 && alias == -3");
+   ASSERT_EQ(predicates.size(), 3u);
+   EXPECT_EQ(predicates[0].fColumn, "i");
+   EXPECT_EQ(predicates[0].fOp, EOp::kGreater);
+   EXPECT_EQ(predicates[0].fValue, 5.);
+   EXPECT_EQ(predicates[1].fColumn, "f");
+   EXPECT_EQ(predicates[1].fOp, EOp::kLessEqual);
+   EXPECT_EQ(predicates[1].fValue, 2.5);
+   EXPECT_EQ(predicates[2].fColumn, "i");
+   EXPECT_EQ(predicates[2].fOp, EOp::kEqual);
+   EXPECT_FALSE(predicates[2].MayPass(-2., 10.));
+   EXPECT_TRUE(predicates[2].MayPass(-3., -3.));
+
+   // float literals are rounded to float
+   predicates = find("f < 0.1f");
+   ASSERT_EQ(predicates.size(), 1u);
+   EXPECT_EQ(predicates[0].fValue, double(0.1f));
+
+   // terms that are not necessary for the expression to be true, or not comparisons of a branch with a number
+   EXPECT_TRUE(find("i > 5 || f < 2").empty());
+   EXPECT_TRUE(find("!(f < 2 && i > 5)").empty());
+   EXPECT_TRUE(find("i > 5 ? f < 2 : true").empty());
+   EXPECT_TRUE(find("return i > 5;").empty());
+   EXPECT_TRUE(find("i + 1 > 5").empty());
+   EXPECT_TRUE(find("i != 5").empty());
+   EXPECT_TRUE(find("i > 0x5").empty());
+   EXPECT_TRUE(find("i > 05").empty());
+   EXPECT_TRUE(find("j > 5").empty());
+   // comparisons of unsigned int with negative integers are performed in unsigned arithmetic
+   EXPECT_TRUE(find("u > -1").empty());
+   EXPECT_EQ(find("u > -1.").size(), 1u);
+}
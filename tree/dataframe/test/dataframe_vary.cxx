@@ -0,0 +1,84 @@
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RVec.hxx>
+#include <TH1D.h>
+
+#include "gtest/gtest.h"
+
+using namespace ROOT::RDF;
+using ROOT::RVec;
+
+// x = 0, 1, ..., 99 and w = 1 or 2
+RInterface<ROOT::Detail::RDF::RLoopManager> MakeDF(ROOT::RDataFrame &df)
+{
+   return df.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"})
+      .Define("w", [](ULong64_t e) { return int(1 + e % 2); }, {"rdfentry_"});
+}
+
+TEST(RDFVary, FilterDefineAndActions)
+{
+   ROOT::RDataFrame df(100);
+   int nEvals = 0;
+   auto shift = [&nEvals](double x) {
+      ++nEvals;
+      return RVec<double>{x - 10, x + 10};
+   };
+   auto varied = MakeDF(df).Vary("x", shift, {"x"}, {"down", "up"}, "shift");
+   auto sel = varied.Define("y", [](double x) { return 2 * x; }, {"x"})
+                 .Filter([](double y) { return y >= 100; }, {"y"}, "y cut")
+                 .Filter("w == 1");
+
+   auto count = sel.Count();
+   auto sumY = sel.Sum<double>("y");
+   auto sumW = sel.Sum<int>("w");
+   auto h = sel.Histo1D<double>({"h", "h", 10, 0., 300.}, "y");
+   auto unaffected = varied.Sum<int>("w");
+
+   auto counts = VariationsFor(count);
+   auto sumsY = VariationsFor(sumY);
+   auto sumsW = VariationsFor(sumW);
+   auto histos = VariationsFor(h);
+   ASSERT_EQ(3u, counts.size());
+   ASSERT_EQ(3u, histos.size());
+   EXPECT_EQ(1u, VariationsFor(unaffected).size());
+
+   // nominal: x in [50, 99] with w == 1, i.e. even x
+   EXPECT_EQ(25ull, *counts["nominal"]);
+   EXPECT_DOUBLE_EQ(2 * (50 + 98) * 25 / 2, *sumsY["nominal"]);
+   // down: x - 10 >= 50, i.e. x in [60, 99]
+   EXPECT_EQ(20ull, *counts["shift:down"]);
+   EXPECT_DOUBLE_EQ(2 * (50 + 88) * 20 / 2, *sumsY["shift:down"]);
+   // up: x + 10 >= 50, i.e. x in [40, 99]
+   EXPECT_EQ(30ull, *counts["shift:up"]);
+   EXPECT_DOUBLE_EQ(2 * (50 + 108) * 30 / 2, *sumsY["shift:up"]);
+   EXPECT_EQ(20, *sumsW["shift:down"]);
+   EXPECT_EQ(30., histos["shift:up"]->GetEntries());
+   EXPECT_EQ(150, *unaffected);
+
+   // all results come from a single event loop, which evaluated the variations once per entry
+   EXPECT_EQ(100, nEvals);
+}
+
+TEST(RDFVary, SameSystematicOnTwoColumns)
+{
+   ROOT::RDataFrame df(100);
+   auto scaled = MakeDF(df)
+                    .Vary("x", [](double x) { return RVec<double>{0.5 * x}; }, {"x"}, {"half"}, "scale")
+                    .Vary("w", [](int w) { return RVec<int>{10 * w}; }, {"w"}, {"half"}, "scale");
+   auto sums = VariationsFor(scaled.Define("xw", [](double x, int w) { return x * w; }, {"x", "w"}).Sum<double>("xw"));
+   ASSERT_EQ(2u, sums.size());
+   EXPECT_DOUBLE_EQ(5. * *sums["nominal"], *sums["scale:half"]);
+}
+
+TEST(RDFVary, Errors)
+{
+   ROOT::RDataFrame df(10);
+   auto varied = MakeDF(df).Vary("x", [](double x) { return RVec<double>{x, x}; }, {"x"}, {"a", "b"});
+   EXPECT_ANY_THROW(varied.Vary("x", [](double x) { return RVec<double>{x}; }, {"x"}, {"a"}));
+   EXPECT_ANY_THROW(varied.Filter("x > 0"));
+   EXPECT_ANY_THROW(varied.Define("z", "x * 2"));
+   EXPECT_NO_THROW(varied.Define("z", "w * 2"));
+
+   // the expression must return one value per tag
+   auto wrongSize = MakeDF(df).Vary("x", [](double x) { return RVec<double>{x}; }, {"x"}, {"a", "b"}).Max<double>("x");
+   EXPECT_ANY_THROW(*wrongSize);
+}
@@ -2,12 +2,15 @@
 #include <ROOT/RArrowDS.hxx>
 #include <ROOT/TSeq.hxx>
 #include <TROOT.h>
+#include <TSystem.h>
 
 #if defined(__GNUC__)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wshadow"
 #endif
 #include <arrow/builder.h>
+#include <arrow/io/file.h>
+#include <arrow/ipc/writer.h>
 #include <arrow/memory_pool.h>
 #include <arrow/record_batch.h>
 #include <arrow/table.h>
@@ -58,6 +61,25 @@ std::shared_ptr<Table> createTestTable()
    return table_;
 }
 
+/// Write the test table in an Arrow IPC file, in record batches of three entries
+void writeTestFile(const std::string &fileName)
+{
+   auto table = createTestTable();
+   std::vector<std::shared_ptr<Array>> arrays;
+   for (int i = 0; i < table->num_columns(); ++i)
+      arrays.push_back(table->column(i)->data()->chunk(0));
+   auto batch = RecordBatch::Make(table->schema(), table->num_rows(), arrays);
+
+   std::shared_ptr<io::FileOutputStream> stream;
+   ASSERT_TRUE(io::FileOutputStream::Open(fileName, &stream).ok());
+   std::shared_ptr<ipc::RecordBatchWriter> writer;
+   ASSERT_TRUE(ipc::RecordBatchFileWriter::Open(stream.get(), table->schema(), &writer).ok());
+   ASSERT_TRUE(writer->WriteRecordBatch(*batch->Slice(0, 3)).ok());
+   ASSERT_TRUE(writer->WriteRecordBatch(*batch->Slice(3, 3)).ok());
+   ASSERT_TRUE(writer->Close().ok());
+   ASSERT_TRUE(stream->Close().ok());
+}
+
 TEST(RArrowDS, ColTypeNames)
 {
    RArrowDS tds(createTestTable(), {"Name", "Age", "Height", "Married", "Babies"});
@@ -150,6 +172,58 @@ TEST(RArrowDS, ColumnReadersString)
    }
 }
 
+TEST(RArrowDS, FileEntryRanges)
+{
+   const auto fileName = "RArrowDS_test_ranges.arrow";
+   writeTestFile(fileName);
+   RArrowDS tds(fileName, {});
+   tds.SetNSlots(3U);
+   tds.Initialise();
+
+   // One range per record batch
+   auto ranges = tds.GetEntryRanges();
+
+   ASSERT_EQ(2U, ranges.size());
+   EXPECT_EQ(0U, ranges[0].first);
+   EXPECT_EQ(3U, ranges[0].second);
+   EXPECT_EQ(3U, ranges[1].first);
+   EXPECT_EQ(6U, ranges[1].second);
+   gSystem->Unlink(fileName);
+}
+
+TEST(RArrowDS, FileColumnReaders)
+{
+   const auto fileName = "RArrowDS_test_readers.arrow";
+   writeTestFile(fileName);
+   RArrowDS tds(fileName, {"Age", "Name"});
+
+   const auto nSlots = 2U;
+   tds.SetNSlots(nSlots);
+   auto valsAge = tds.GetColumnReaders<Long64_t>("Age");
+   auto valsName = tds.GetColumnReaders<std::string>("Name");
+
+   tds.Initialise();
+   auto ranges = tds.GetEntryRanges();
+   auto slot = 0U;
+   std::vector<Long64_t> refsAge = {64, 50, 40, 30, 2, 0};
+   std::vector<std::string> refsName = {"Harry", "Bob,Bob", "\"Joe\"", "Tom", " John  ", " Mary Ann "};
+   for (auto &&range : ranges) {
+      tds.InitSlot(slot, range.first);
+      for (auto i : ROOT::TSeqU(range.first, range.second)) {
+         tds.SetEntry(slot, i);
+         EXPECT_EQ(refsAge[i], **valsAge[slot]);
+         EXPECT_EQ(refsName[i], *((std::string *)*valsName[slot]));
+      }
+      slot++;
+   }
+   gSystem->Unlink(fileName);
+}
+
+TEST(RArrowDS, FileNotFound)
+{
+   EXPECT_THROW(RArrowDS("RArrowDS_test_doesnotexist.arrow", {}), std::runtime_error);
+}
+
 #ifndef NDEBUG
 
 TEST(RArrowDS, SetNSlotsTwice)
@@ -189,6 +263,21 @@ TEST(RArrowDS, FromARDFWithJitting)
    EXPECT_EQ(40, *min);
 }
 
+TEST(RArrowDS, FromAFile)
+{
+   const auto fileName = "RArrowDS_test_fromafile.arrow";
+   writeTestFile(fileName);
+   auto rdf = MakeArrowDataFrame(fileName);
+   auto max = rdf.Max<double>("Height");
+   auto sum = rdf.Sum<unsigned int>("Babies");
+   auto c = rdf.Count();
+
+   EXPECT_EQ(6U, *c);
+   EXPECT_DOUBLE_EQ(200.5, *max);
+   EXPECT_EQ(31U, *sum);
+   gSystem->Unlink(fileName);
+}
+
 // NOW MT!-------------
 #ifdef R__USE_IMT
 
@@ -235,6 +324,21 @@ TEST(RArrowDS, FromARDFWithJittingMT)
    EXPECT_EQ(40, *min);
 }
 
+TEST(RArrowDS, FromAFileMT)
+{
+   const auto fileName = "RArrowDS_test_fromafilemt.arrow";
+   writeTestFile(fileName);
+   auto rdf = MakeArrowDataFrame(fileName);
+   auto max = rdf.Filter("Age<40").Max("Age");
+   auto min = rdf.Min<double>("Height");
+   auto c = rdf.Count();
+
+   EXPECT_EQ(6U, *c);
+   EXPECT_EQ(30, *max);
+   EXPECT_DOUBLE_EQ(0.8, *min);
+   gSystem->Unlink(fileName);
+}
+
 #endif // R__USE_IMT
 
 #endif // R__B64
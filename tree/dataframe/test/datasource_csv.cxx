@@ -2,9 +2,12 @@
 #include <ROOT/RCsvDS.hxx>
 #include <ROOT/TSeq.hxx>
 #include <TROOT.h>
+#include <TSystem.h>
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
 
 using namespace ROOT::RDF;
@@ -180,6 +183,38 @@ TEST(RCsvDS, ProgressiveReadingRDF)
    EXPECT_EQ(6U, *c2);
 }
 
+TEST(RCsvDS, WindowsLineBreaksAndEmptyLines)
+{
+   auto fileName = "RCsvDS_test_crlf.csv";
+   {
+      std::ofstream f(fileName, std::ios::binary);
+      f << "Name,Age\r\n\r\n\"Bob\",50\r\nTom,30\r\n\n\nHarry,60";
+   }
+   auto tdf = ROOT::RDF::MakeCsvDataFrame(fileName);
+   EXPECT_EQ("std::string", tdf.GetColumnType("Name"));
+   EXPECT_EQ("Long64_t", tdf.GetColumnType("Age"));
+   auto names = tdf.Take<std::string>("Name");
+   auto ages = tdf.Take<Long64_t>("Age");
+   const std::vector<std::string> namesRef{"Bob", "Tom", "Harry"};
+   const std::vector<Long64_t> agesRef{50, 30, 60};
+   EXPECT_EQ(namesRef, *names);
+   EXPECT_EQ(agesRef, *ages);
+   gSystem->Unlink(fileName);
+}
+
+TEST(RCsvDS, WrongNumberOfFields)
+{
+   auto fileName = "RCsvDS_test_wrongfields.csv";
+   {
+      std::ofstream f(fileName);
+      f << "a,b\n1,2\n3\n";
+   }
+   auto tdf = ROOT::RDF::MakeCsvDataFrame(fileName);
+   auto s = tdf.Sum<Long64_t>("a");
+   EXPECT_THROW(*s, std::runtime_error);
+   gSystem->Unlink(fileName);
+}
+
 #ifndef NDEBUG
 
 TEST(RCsvDS, SetNSlotsTwice)
@@ -289,6 +324,41 @@ TEST(RCsvDS, ProgressiveReadingRDFMT)
    EXPECT_EQ(6U, *c2);
 }
 
+TEST(RCsvDS, ParallelParsingMT)
+{
+   auto fileName = "RCsvDS_test_parallel.csv";
+   const auto nRecords = 10000;
+   {
+      std::ofstream f(fileName);
+      f << "Id,Value,Even,Label\n";
+      for (auto i : ROOT::TSeqI(nRecords))
+         f << i << ',' << i * 0.5 << ',' << (i % 2 == 0 ? "true" : "false") << ",\"l," << i % 7 << "\"\n";
+   }
+
+   for (auto chunkSize : {-1LL, 999LL}) {
+      auto tdf = ROOT::RDF::MakeCsvDataFrame(fileName, true, ',', chunkSize);
+      auto count = tdf.Count();
+      auto sumIds = tdf.Sum<Long64_t>("Id");
+      auto sumValues = tdf.Sum<double>("Value");
+      auto nEven = tdf.Filter([](bool even) { return even; }, {"Even"}).Count();
+      auto nLabels = tdf.Filter([](const std::string &l) { return l == "l,3"; }, {"Label"}).Count();
+      auto ids = tdf.Take<Long64_t>("Id");
+      auto idsMatchValues = tdf.Filter([](Long64_t id, double v) { return v != id * 0.5; }, {"Id", "Value"}).Count();
+
+      EXPECT_EQ(ULong64_t(nRecords), *count);
+      EXPECT_EQ(Long64_t(nRecords) * (nRecords - 1) / 2, *sumIds);
+      EXPECT_DOUBLE_EQ(0.25 * nRecords * (nRecords - 1), *sumValues);
+      EXPECT_EQ(ULong64_t(nRecords / 2), *nEven);
+      EXPECT_EQ(ULong64_t((nRecords - 3 + 6) / 7), *nLabels);
+      EXPECT_EQ(0U, *idsMatchValues);
+      auto sortedIds = *ids;
+      std::sort(sortedIds.begin(), sortedIds.end());
+      for (auto i : ROOT::TSeqI(nRecords))
+         EXPECT_EQ(i, sortedIds[i]);
+   }
+   gSystem->Unlink(fileName);
+}
+
 #endif // R__USE_IMT
 
 #endif // R__B64
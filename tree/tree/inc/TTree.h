@@ -65,6 +65,8 @@ class TBasket;
 class TStreamerInfo;
 class TTreeCache;
 class TTreeCloner;
+class TTreeClusterStats;
+class TTreeClusterTuning;
 class TFileMergeInfo;
 class TVirtualPerfStats;
 
@@ -119,6 +121,8 @@ protected:
    TList         *fFriends;               ///<  pointer to list of friend elements
    TVirtualPerfStats *fPerfStats;         ///<! pointer to the current perf stats object
    TList         *fUserInfo;              ///<  pointer to a list of user objects associated to this Tree
+   TTreeClusterStats *fClusterStats{nullptr}; ///<! Cluster statistics being recorded, owned by fUserInfo
+   TTreeClusterTuning *fClusterTuning{nullptr}; ///<! Tuning of the cluster and basket sizes, owned by fUserInfo
    TVirtualTreePlayer *fPlayer;           ///<! Pointer to current Tree player
    TList         *fClones;                ///<! List of cloned trees which share our addresses
    TBranchRef    *fBranchRef;             ///<  Branch supporting the TRefTable (if any)
@@ -373,6 +377,8 @@ public:
    virtual Long64_t        Draw(const char* varexp, const char* selection, Option_t* option = "", Long64_t nentries = kMaxEntries, Long64_t firstentry = 0); // *MENU*
    virtual void            DropBaskets();
    virtual void            DropBuffers(Int_t nbytes);
+   virtual Int_t           EnableClusterStats(const char *bname = "*");
+   virtual void            EnableClusterTuning(Long64_t targetZipBytes = 30000000, Long64_t maxMemory = 100000000);
    virtual Int_t           Fill();
    virtual TBranch        *FindBranch(const char* name);
    virtual TLeaf          *FindLeaf(const char* name);
@@ -394,6 +400,8 @@ public:
    virtual Long64_t        GetChainEntryNumber(Long64_t entry) const { return entry; }
    virtual Long64_t        GetChainOffset() const { return fChainOffset; }
    virtual Bool_t          GetClusterPrefetch() const { return fCacheDoClusterPrefetch; }
+   TTreeClusterStats      *GetClusterStats() const;
+   TTreeClusterTuning     *GetClusterTuning() const;
    TFile                  *GetCurrentFile() const;
            Int_t           GetDefaultEntryOffsetLen() const {return fDefaultEntryOffsetLen;}
            Long64_t        GetDebugMax()  const { return fDebugMax; }
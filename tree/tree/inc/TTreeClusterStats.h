@@ -0,0 +1,63 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TTreeClusterStats
+#define ROOT_TTreeClusterStats
+
+#include "TNamed.h"
+
+#include <string>
+#include <vector>
+
+class TLeaf;
+class TTree;
+
+class TTreeClusterStats : public TNamed {
+
+private:
+   std::vector<std::string> fBranchNames; ///< Names of the branches with statistics
+   Long64_t fFirstEntry;                  ///< First entry of the first zone
+   std::vector<Long64_t> fZoneEnds;       ///< Entry following the last entry of each zone
+   std::vector<Double_t> fMin;            ///< Minimum of each branch in each zone, at [zone * nbranches + branch]
+   std::vector<Double_t> fMax;            ///< Maximum of each branch in each zone, at [zone * nbranches + branch]
+
+   std::vector<TLeaf *> fLeaves;          ///<! Leaves of the branches in the tree being filled
+   std::vector<Double_t> fCurrentMin;     ///<! Minima of the zone being filled
+   std::vector<Double_t> fCurrentMax;     ///<! Maxima of the zone being filled
+   Long64_t fNCurrentEntries;             ///<! Number of entries accumulated in the zone being filled
+
+   TTreeClusterStats(const TTreeClusterStats &) = delete;
+   TTreeClusterStats &operator=(const TTreeClusterStats &) = delete;
+
+   void ResetCurrentZone();
+
+public:
+   TTreeClusterStats();
+   TTreeClusterStats(TTree &tree, const std::vector<std::string> &branchNames);
+   virtual ~TTreeClusterStats() {}
+
+   void Fill();
+   void CloseZone(Long64_t nentries);
+   void Reset(TTree &tree);
+
+   const std::vector<std::string> &GetBranchNames() const { return fBranchNames; }
+   Int_t GetBranchIndex(const char *branchname) const;
+   Int_t GetNZones() const { return fZoneEnds.size(); }
+   Long64_t GetZoneFirstEntry(Int_t zone) const { return zone == 0 ? fFirstEntry : fZoneEnds[zone - 1]; }
+   Long64_t GetZoneEndEntry(Int_t zone) const { return fZoneEnds[zone]; }
+   Double_t GetMin(Int_t branch, Int_t zone) const { return fMin[zone * fBranchNames.size() + branch]; }
+   Double_t GetMax(Int_t branch, Int_t zone) const { return fMax[zone * fBranchNames.size() + branch]; }
+   Bool_t GetRange(const char *branchname, Long64_t first, Long64_t end, Double_t &min, Double_t &max) const;
+   virtual void Print(Option_t *option = "") const;
+
+   ClassDef(TTreeClusterStats, 1) // Minimum and maximum of numerical branches per cluster of entries
+};
+
+#endif
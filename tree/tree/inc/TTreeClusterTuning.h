@@ -0,0 +1,63 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TTreeClusterTuning
+#define ROOT_TTreeClusterTuning
+
+#include "TNamed.h"
+
+#include <vector>
+
+class TBranch;
+class TTree;
+
+class TTreeClusterTuning : public TNamed {
+
+private:
+   Long64_t fTargetZipBytes;               ///< Compressed size of the clusters aimed at
+   Long64_t fMaxMemory;                    ///< Maximum total size of the baskets being filled
+   std::vector<Long64_t> fFirstEntries;    ///< First entry from which each decision applies
+   std::vector<Long64_t> fClusterSizes;    ///< Number of entries of the clusters chosen by each decision
+   std::vector<Double_t> fZipBytesPerEntry; ///< Compressed bytes per entry measured for each decision
+   std::vector<Long64_t> fBasketMemory;    ///< Total size of the baskets chosen by each decision
+   std::vector<Int_t> fNResized;           ///< Number of branches whose basket size was changed by each decision
+
+   std::vector<TBranch *> fBranches;       ///<! Branches holding data, whose basket size is tuned
+   std::vector<Long64_t> fLastTotBytes;    ///<! Uncompressed bytes of each branch at the previous flush
+   Long64_t fLastEntries;                  ///<! Number of entries of the tree at the previous flush
+   Long64_t fLastTreeZipBytes;             ///<! Compressed bytes of the tree at the previous flush
+
+   TTreeClusterTuning(const TTreeClusterTuning &) = delete;
+   TTreeClusterTuning &operator=(const TTreeClusterTuning &) = delete;
+
+   void StartMeasurement(TTree &tree);
+
+public:
+   TTreeClusterTuning();
+   TTreeClusterTuning(TTree &tree, Long64_t targetZipBytes, Long64_t maxMemory);
+   virtual ~TTreeClusterTuning() {}
+
+   void Reset(TTree &tree);
+   void Tune(TTree &tree);
+
+   Long64_t GetTargetZipBytes() const { return fTargetZipBytes; }
+   Long64_t GetMaxMemory() const { return fMaxMemory; }
+   Int_t GetNDecisions() const { return fFirstEntries.size(); }
+   Long64_t GetFirstEntry(Int_t decision) const { return fFirstEntries[decision]; }
+   Long64_t GetClusterSize(Int_t decision) const { return fClusterSizes[decision]; }
+   Double_t GetZipBytesPerEntry(Int_t decision) const { return fZipBytesPerEntry[decision]; }
+   Long64_t GetBasketMemory(Int_t decision) const { return fBasketMemory[decision]; }
+   Int_t GetNResized(Int_t decision) const { return fNResized[decision]; }
+   virtual void Print(Option_t *option = "") const;
+
+   ClassDef(TTreeClusterTuning, 1) // Adaptive cluster and basket sizes of a TTree being written
+};
+
+#endif
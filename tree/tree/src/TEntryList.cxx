@@ -542,6 +542,26 @@ Int_t TEntryList::Contains(Long64_t entry, TTree *tree)
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if at least one of the entries from entrymin to entrymax included
+/// is in this list. The entries are those of the tree of the list: for a list
+/// with sub-lists, the sub-list of the tree should be used (see GetEntryList()).
+/// A list with sub-lists is assumed to contain all ranges.
+
+Bool_t TEntryList::ContainsRange(Long64_t entrymin, Long64_t entrymax)
+{
+   if (fLists) return kTRUE;
+   if (!fBlocks) return kFALSE;
+   if (entrymin < 0) entrymin = 0;
+   for (Int_t i = entrymin/kBlockSize; i < fNBlocks && Long64_t(i)*kBlockSize <= entrymax; i++) {
+      TEntryListBlock *block = (TEntryListBlock*)fBlocks->UncheckedAt(i);
+      Long64_t first = TMath::Max(entrymin - Long64_t(i)*kBlockSize, Long64_t(0));
+      Long64_t last = TMath::Min(entrymax - Long64_t(i)*kBlockSize, Long64_t(kBlockSize-1));
+      if (block->ContainsRange(first, last)) return kTRUE;
+   }
+   return kFALSE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Called by TKey and others to automatically add us to a directory when we are read from a file.
 
@@ -1230,6 +1250,21 @@ void TEntryList::Subtract(const TEntryList *elist)
          if (!strcmp(elist->fTreeName.Data(),fTreeName.Data()) &&
              !strcmp(elist->fFileName.Data(),fFileName.Data())){
             //same tree
+            if (IsA() == TEntryList::Class()) {
+               //subtract block by block; the derived classes remove the entries one by one
+               //below, to update what they store for each of them
+               if (!elist->fBlocks) return;
+               Int_t nmin = TMath::Min(fNBlocks, elist->fNBlocks);
+               for (Int_t i=0; i<nmin; i++){
+                  TEntryListBlock *block1 = (TEntryListBlock*)fBlocks->UncheckedAt(i);
+                  TEntryListBlock *block2 = (TEntryListBlock*)elist->fBlocks->UncheckedAt(i);
+                  Long64_t nold = block1->GetNPassed();
+                  fN = fN - nold + block1->Subtract(block2);
+               }
+               fLastIndexQueried = -1;
+               fLastIndexReturned = 0;
+               return;
+            }
             Long64_t n2 = elist->GetN();
             Long64_t entry;
             for (Int_t i=0; i<n2; i++){
@@ -14,40 +14,132 @@
 
 Used by TEntryList to store the entry numbers.
 
-There are 2 ways to represent entry numbers in a TEntryListBlock:
+There are 3 ways to represent entry numbers in a TEntryListBlock:
 
  1. as bits, where passing entry numbers are assigned 1, not passing - 0
  2. as a simple array of entry numbers
   - storing the numbers of entries that pass
   - storing the numbers of entries that don't pass
+ 3. as runs of consecutive passing entry numbers, stored as the first and the last
+    entry number of each run
 
-In both cases, a UShort_t* is used. The second option is better in case
-less than 1/16 or more than 15/16 of entries pass the selection, and the representation can be
-changed by calling OptimizeStorage() function.
+In all cases, a UShort_t* is used. The second option is better in case
+less than 1/16 or more than 15/16 of entries pass the selection, the third one
+in case the passing entries come in long runs, as for a selection on a slowly
+varying quantity, and the representation can be changed by calling OptimizeStorage() function.
 When the block is being filled, it's always stored as bits, and the OptimizeStorage()
 function is called by TEntryList when it starts filling the next block. If
 Enter() or Remove() is called after OptimizeStorage(), representation is
 again changed to 1).
 
+The runs are only used in memory: a block stored as runs is written as bits or as
+a list, so that the files can be read by any version.
+
 Begin_Macro
 entrylistblock_figure1.C
 End_Macro
 
 ## Operations on blocks (see also function comments)
 
- - __Merge__() - adds all entries from one block to the other. If the first block
-             uses array representation, it's changed to bits representation only
-             if the total number of passing entries is still less than kBlockSize
+ - __Merge__() - adds all entries from one block to the other
+ - __Subtract__() - removes the entries of one block from the other
+ - __ContainsRange__() - tells whether a range of entries holds any entry of the block
  - __GetEntry(n)__ - returns n-th non-zero entry.
  - __Next__()      - return next non-zero entry. In case of representation 1), Next()
                  is faster than GetEntry()
 */
 
 #include "TEntryListBlock.h"
+#include "TBuffer.h"
 #include "TString.h"
 
+#include <algorithm>
+#include <cstring>
+
 ClassImp(TEntryListBlock);
 
+namespace {
+
+const Int_t kNBits = TEntryListBlock::kBlockSize * 16;
+
+/// Number of bits set in w.
+inline Int_t PopCount(ULong64_t w)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   return __builtin_popcountll(w);
+#else
+   w = w - ((w >> 1) & 0x5555555555555555ULL);
+   w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+   return (((w + (w >> 4)) & 0x0F0F0F0F0F0F0F0FULL) * 0x0101010101010101ULL) >> 56;
+#endif
+}
+
+/// Position of the lowest bit set in w, which is not 0.
+inline Int_t CountTrailingZeros(UInt_t w)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   return __builtin_ctz(w);
+#else
+   return PopCount((w & (~w + 1)) - 1);
+#endif
+}
+
+/// Number of bits set in the kBlockSize words of bits.
+Int_t CountBits(const UShort_t *bits)
+{
+   Int_t n = 0;
+   for (Int_t i = 0; i < TEntryListBlock::kBlockSize; i += 4) {
+      ULong64_t w;
+      memcpy(&w, bits + i, sizeof(w));
+      n += PopCount(w);
+   }
+   return n;
+}
+
+/// Number of runs of consecutive bits set in the kBlockSize words of bits.
+Int_t CountRuns(const UShort_t *bits)
+{
+   Int_t n = 0;
+   UInt_t previous = 0; // last bit of the previous word
+   for (Int_t i = 0; i < TEntryListBlock::kBlockSize; i++) {
+      const UInt_t w = bits[i];
+      n += PopCount(w & ~((w << 1) | previous) & 0xFFFF);
+      previous = w >> 15;
+   }
+   return n;
+}
+
+/// Position of the first bit at or after pos equal to value, kNBits if there is none.
+Int_t FindBit(const UShort_t *bits, Int_t pos, Bool_t value)
+{
+   if (pos >= kNBits)
+      return kNBits;
+   Int_t i = pos >> 4;
+   UInt_t w = (value ? bits[i] : ~bits[i] & 0xFFFF) & (0xFFFFu << (pos & 15));
+   while (!w) {
+      if (++i == TEntryListBlock::kBlockSize)
+         return kNBits;
+      w = value ? bits[i] : ~bits[i] & 0xFFFF;
+   }
+   return (i << 4) + CountTrailingZeros(w);
+}
+
+/// Set the bits from first to last included.
+void SetBits(UShort_t *bits, Int_t first, Int_t last)
+{
+   for (Int_t i = first; i <= last;) {
+      if (!(i & 15) && i + 15 <= last) {
+         bits[i >> 4] = 0xFFFF;
+         i += 16;
+      } else {
+         bits[i >> 4] |= 1 << (i & 15);
+         i++;
+      }
+   }
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default c-tor
 
@@ -206,6 +298,11 @@ Int_t TEntryListBlock::Contains(Int_t entry)
       Bool_t result = (fIndices[i] & (1<<j))!=0;
       return result;
    }
+   if (fType==2){
+      //runs
+      Int_t irun = FindRun(entry);
+      return irun < fN/2 && fIndices[2*irun] <= entry;
+   }
    //list
    if (entry < fCurrent) fCurrent = 0;
    if (fPassing && fIndices){
@@ -236,127 +333,70 @@ Int_t TEntryListBlock::Contains(Int_t entry)
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// True if the block contains at least one of the entries from entrymin to entrymax included
+
+Bool_t TEntryListBlock::ContainsRange(Int_t entrymin, Int_t entrymax)
+{
+   if (entrymin < 0) entrymin = 0;
+   if (entrymax >= kNBits) entrymax = kNBits-1;
+   if (entrymin > entrymax) return kFALSE;
+   if (!fIndices) return !fPassing;
+   if (fType==0)
+      return FindBit(fIndices, entrymin, kTRUE) <= entrymax;
+   if (fType==2){
+      Int_t irun = FindRun(entrymin);
+      return irun < fN/2 && fIndices[2*irun] <= entrymax;
+   }
+   //list
+   UShort_t *end = fIndices + fNPassed;
+   UShort_t *first = std::lower_bound(fIndices, end, entrymin);
+   if (fPassing)
+      return first != end && *first <= entrymax;
+   //the range passes unless all its entries are in the list of the entries that don't pass
+   UShort_t *last = std::upper_bound(first, end, entrymax);
+   return last - first < entrymax - entrymin + 1;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Merge with the other block
 /// Returns the resulting number of entries in the block
+///
+/// The union is computed on the bits representation of both blocks, a word at a time,
+/// and the representation of the result is then chosen by OptimizeStorage().
 
 Int_t TEntryListBlock::Merge(TEntryListBlock *block)
 {
-   Int_t i, j;
    if (block->GetNPassed() == 0) return GetNPassed();
-   if (GetNPassed() == 0){
-      //this block is empty
-      fN = block->fN;
-      fIndices = new UShort_t[fN];
-      for (i=0; i<fN; i++)
-         fIndices[i] = block->fIndices[i];
-      fNPassed = block->fNPassed;
-      fType = block->fType;
-      fPassing = block->fPassing;
-      fCurrent = block->fCurrent;
-      fLastIndexReturned = -1;
-      fLastIndexQueried = -1;
-      return fNPassed;
-   }
-   if (fType==0){
-      //stored as bits
-      if (block->fType == 0){
-         for (i=0; i<kBlockSize*16; i++){
-            if (block->Contains(i))
-               Enter(i);
-         }
-      } else {
-         if (block->fPassing){
-            //the other block stores entries that pass
-            for (i=0; i<block->fNPassed; i++){
-               Enter(block->fIndices[i]);
-            }
-         } else {
-            //the other block stores entries that don't pass
-            if (block->fNPassed==0){
-               for (i=0; i<kBlockSize*16; i++){
-                  Enter(i);
-               }
-            }
-            for (j=0; j<block->fIndices[0]; j++)
-               Enter(j);
-            for (i=0; i<block->fNPassed-1; i++){
-               for (j=block->fIndices[i]+1; j<block->fIndices[i+1]; j++){
-                  Enter(j);
-               }
-            }
-            for (j=block->fIndices[block->fNPassed-1]+1; j<kBlockSize*16; j++)
-               Enter(j);
-         }
-      }
-   } else {
-      //stored as a list
-      if (GetNPassed() + block->GetNPassed() > kBlockSize){
-         //change to bits
-         UShort_t *bits = new UShort_t[kBlockSize];
-         Transform(1, bits);
-         Merge(block);
-      } else {
-         //this is only possible if fPassing=1 in both blocks
-         if (block->fType==1){
-            //second block stored as a list
-            //make a bigger list
-            Int_t en = block->fNPassed;
-            Int_t newsize = fNPassed + en;
-            UShort_t *newlist = new UShort_t[newsize];
-            UShort_t *elst = block->fIndices;
-            Int_t newpos, elpos;
-            newpos = elpos = 0;
-            for (i=0; i<fNPassed; i++) {
-               while (elpos < en && fIndices[i] > elst[elpos]) {
-                  newlist[newpos] = elst[elpos];
-                  newpos++;
-                  elpos++;
-               }
-               if (fIndices[i] == elst[elpos]) elpos++;
-               newlist[newpos] = fIndices[i];
-               newpos++;
-            }
-            while (elpos < en) {
-               newlist[newpos] = elst[elpos];
-               newpos++;
-               elpos++;
-            }
-            delete [] fIndices;
-            fIndices = newlist;
-            fNPassed = newpos;
-            fN = fNPassed;
-         } else {
-            //second block is stored as bits
-
-            Int_t en = block->fNPassed;
-            Int_t newsize = fNPassed + en;
-            UShort_t *newlist = new UShort_t[newsize];
-            Int_t newpos, current;
-            newpos = current = 0;
-            for (i=0; i<kBlockSize*16; i++){
-               if (!block->Contains(i)) continue;
-               while(current < fNPassed && fIndices[current]<i){
-                  newlist[newpos] = fIndices[current];
-                  current++;
-                  newpos++;
-               }
-               if (fIndices[current]==i) current++;
-               newlist[newpos] = i;
-               newpos++;
-            }
-            while(current<fNPassed){
-               newlist[newpos] = fIndices[current];
-               newpos++;
-               current++;
-            }
-            delete [] fIndices;
-            fIndices = newlist;
-            fNPassed = newpos;
-            fN = fNPassed;
-         }
-      }
-   }
+   UShort_t *bits = new UShort_t[kBlockSize];
+   block->FillBits(bits);
+   if (fType!=0 || !fIndices)
+      Transform(1, new UShort_t[kBlockSize]);
+   for (Int_t i=0; i<kBlockSize; i++)
+      fIndices[i] |= bits[i];
+   delete [] bits;
+   fNPassed = CountBits(fIndices);
+   fLastIndexQueried = -1;
+   fLastIndexReturned = -1;
+   OptimizeStorage();
+   return GetNPassed();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the entries of the other block from this block
+/// Returns the resulting number of entries in the block
+
+Int_t TEntryListBlock::Subtract(TEntryListBlock *block)
+{
+   if (block->GetNPassed() == 0 || GetNPassed() == 0) return GetNPassed();
+   UShort_t *bits = new UShort_t[kBlockSize];
+   block->FillBits(bits);
+   if (fType!=0 || !fIndices)
+      Transform(1, new UShort_t[kBlockSize]);
+   for (Int_t i=0; i<kBlockSize; i++)
+      fIndices[i] &= ~bits[i];
+   delete [] bits;
+   fNPassed = CountBits(fIndices);
    fLastIndexQueried = -1;
    fLastIndexReturned = -1;
    OptimizeStorage();
@@ -381,22 +421,32 @@ Int_t TEntryListBlock::GetNPassed()
 
 Int_t TEntryListBlock::GetEntry(Int_t entry)
 {
-   if (entry > kBlockSize*16) return -1;
-   if (entry > GetNPassed()) return -1;
+   if (entry < 0 || entry >= GetNPassed()) return -1;
    if (entry == fLastIndexQueried+1) return Next();
    else {
       Int_t i=0; Int_t j=0; Int_t entries_found=0;
       if (fType==0){
-         if ((fIndices[i] & (1<<j))!=0)
-            entries_found++;
-         while (entries_found<entry+1){
-            if (j==15){i++; j=0;}
-            else j++;
-            if ((fIndices[i] & (1<<j))!=0)
-               entries_found++;
+         //skip the words before the one holding the entry
+         Int_t n;
+         while (entries_found + (n = PopCount(fIndices[i])) <= entry){
+            entries_found += n;
+            i++;
          }
+         UInt_t w = fIndices[i];
+         for (; entries_found<entry; entries_found++)
+            w &= w-1;
          fLastIndexQueried = entry;
-         fLastIndexReturned = i*16+j;
+         fLastIndexReturned = i*16+CountTrailingZeros(w);
+         return fLastIndexReturned;
+      }
+      if (fType==2){
+         while (entries_found + fIndices[2*i+1] - fIndices[2*i] + 1 <= entry){
+            entries_found += fIndices[2*i+1] - fIndices[2*i] + 1;
+            i++;
+         }
+         fCurrent = i;
+         fLastIndexQueried = entry;
+         fLastIndexReturned = fIndices[2*i] + entry - entries_found;
          return fLastIndexReturned;
       }
       if (fType==1){
@@ -453,23 +503,25 @@ Int_t TEntryListBlock::Next()
    }
 
    if (fType==0) {
-      //bits
-      Int_t i=0;
-      Int_t j=0;
-      fLastIndexReturned++;
-      i = fLastIndexReturned>>4;
-      j = fLastIndexReturned & 15;
-      Bool_t result=(fIndices[i] & (1<<j))!=0;
-      while (result==0){
-         if (j==15) {j=0; i++;}
-         else j++;
-         result = (fIndices[i] & (1<<j))!=0;
-      }
-      fLastIndexReturned = i*16+j;
+      //bits, skipping the words with no entry
+      Int_t pos = fLastIndexReturned+1;
+      Int_t i = pos>>4;
+      UInt_t w = fIndices[i] & (0xFFFFu << (pos & 15));
+      while (!w)
+         w = fIndices[++i];
+      fLastIndexReturned = i*16+CountTrailingZeros(w);
       fLastIndexQueried++;
       return fLastIndexReturned;
 
    }
+   if (fType==2) {
+      //runs
+      Int_t pos = fLastIndexReturned+1;
+      Int_t irun = FindRun(pos);
+      fLastIndexReturned = std::max(pos, Int_t(fIndices[2*irun]));
+      fLastIndexQueried++;
+      return fLastIndexReturned;
+   }
    if (fType==1) {
       fLastIndexQueried++;
       if (fPassing){
@@ -514,6 +566,11 @@ void TEntryListBlock::PrintWithShift(Int_t shift) const
          if (result)
             printf("%d\n", i+shift);
       }
+   } else if (fType==2){
+      for (i=0; i<fN; i+=2){
+         for (Int_t j=fIndices[i]; j<=fIndices[i+1]; j++)
+            printf("%d\n", j+shift);
+      }
    } else {
       if (fPassing){
          for (i=0; i<fNPassed; i++){
@@ -542,24 +599,119 @@ void TEntryListBlock::PrintWithShift(Int_t shift) const
 
 ////////////////////////////////////////////////////////////////////////////////
 /// If there are < kBlockSize or >kBlockSize*15 entries, change to an array
-/// representation
+/// representation. If the entries come in runs that take less space than
+/// both the array and the bits, change to the runs representation
 
 void TEntryListBlock::OptimizeStorage()
+{
+   if (fType!=0) return;
+   Int_t nruns = CountRuns(fIndices);
+   //2 numbers per run, to compare with the size of the bits and of the lists
+   if (2*nruns < kBlockSize && 2*nruns < fNPassed && 2*nruns < kNBits-fNPassed){
+      ToRuns(nruns);
+      return;
+   }
+   ToList();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Change from bits to a list of the entries that pass or that don't pass,
+/// if it's smaller
+
+void TEntryListBlock::ToList()
 {
    if (fType!=0) return;
    if (fNPassed > kBlockSize*15)
       fPassing = 0;
    if (fNPassed<kBlockSize || !fPassing){
       //less than 4000 entries passing, makes sense to change from bits to list
-      UShort_t *indexnew = new UShort_t[fNPassed];
+      UShort_t *indexnew = new UShort_t[fPassing ? fNPassed : kNBits-fNPassed];
       Transform(0, indexnew);
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Change from bits to the nruns runs of consecutive entries
+
+void TEntryListBlock::ToRuns(Int_t nruns)
+{
+   UShort_t *runs = new UShort_t[2*nruns];
+   Int_t n = 0;
+   Int_t first = FindBit(fIndices, 0, kTRUE);
+   while (first < kNBits){
+      Int_t end = FindBit(fIndices, first, kFALSE);
+      runs[n++] = first;
+      runs[n++] = end-1;
+      first = FindBit(fIndices, end, kTRUE);
+   }
+   delete [] fIndices;
+   fIndices = runs;
+   fN = n;
+   fType = 2;
+   fPassing = 1;
+   fCurrent = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of the first run that ends at or after entry,
+/// the number of runs if there is none. The runs are mostly visited in order,
+/// so the current run and the next one are tried before a binary search
+
+Int_t TEntryListBlock::FindRun(Int_t entry)
+{
+   Int_t nruns = fN/2;
+   for (Int_t irun = fCurrent; irun < nruns && irun <= fCurrent+1; irun++){
+      if (fIndices[2*irun+1] >= entry && (irun == 0 || fIndices[2*irun-1] < entry)){
+         fCurrent = irun;
+         return irun;
+      }
+   }
+   Int_t lo = 0, hi = nruns;
+   while (lo < hi){
+      Int_t mid = (lo+hi)/2;
+      if (fIndices[2*mid+1] < entry) lo = mid+1;
+      else hi = mid;
+   }
+   fCurrent = lo;
+   return lo;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the kBlockSize words of bits with the bits representation of this block
+
+void TEntryListBlock::FillBits(UShort_t *bits) const
+{
+   Int_t i;
+   if (!fIndices){
+      //empty block, or all entries pass
+      memset(bits, fPassing ? 0 : 0xFF, kBlockSize*sizeof(UShort_t));
+      return;
+   }
+   if (fType==0){
+      memcpy(bits, fIndices, kBlockSize*sizeof(UShort_t));
+      return;
+   }
+   if (fType==2){
+      memset(bits, 0, kBlockSize*sizeof(UShort_t));
+      for (i=0; i<fN; i+=2)
+         SetBits(bits, fIndices[i], fIndices[i+1]);
+      return;
+   }
+   if (fPassing){
+      memset(bits, 0, kBlockSize*sizeof(UShort_t));
+      for (i=0; i<fNPassed; i++)
+         bits[fIndices[i]>>4] |= 1<<(fIndices[i] & 15);
+   } else {
+      memset(bits, 0xFF, kBlockSize*sizeof(UShort_t));
+      for (i=0; i<fNPassed; i++)
+         bits[fIndices[i]>>4] &= ~(1<<(fIndices[i] & 15));
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Transform the existing fIndices
 /// - dir=0 - transform from bits to a list
-/// - dir=1 - tranform from a list to bits
+/// - dir=1 - tranform from a list or from runs to bits
 
 void TEntryListBlock::Transform(Bool_t dir, UShort_t *indexnew)
 {
@@ -592,24 +744,8 @@ void TEntryListBlock::Transform(Bool_t dir, UShort_t *indexnew)
       return;
    }
 
-   if (fPassing){
-      for (i=0; i<kBlockSize; i++)
-         indexnew[i] = 0;
-      for (i=0; i<fNPassed; i++){
-         ibite = fIndices[i]>>4;
-         ibit = fIndices[i] & 15;
-         indexnew[ibite] |= 1<<ibit;
-      }
-   } else {
-      for (i=0; i<kBlockSize; i++)
-         indexnew[i] = 65535;
-      for (i=0; i<fNPassed; i++){
-         ibite = fIndices[i]>>4;
-         ibit = fIndices[i] & 15;
-         indexnew[ibite] ^= 1<<ibit;
-      }
-      fNPassed = kBlockSize*16-fNPassed;
-   }
+   FillBits(indexnew);
+   fNPassed = GetNPassed();
    if (fIndices)
       delete [] fIndices;
    fIndices = indexnew;
@@ -618,3 +754,25 @@ void TEntryListBlock::Transform(Bool_t dir, UShort_t *indexnew)
    fPassing = 1;
    return;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stream an object of class TEntryListBlock.
+/// The runs representation is not written: a block stored as runs is written
+/// as bits or as a list, as the other blocks, so that the file can be read by any version.
+
+void TEntryListBlock::Streamer(TBuffer &b)
+{
+   if (b.IsReading()) {
+      b.ReadClassBuffer(TEntryListBlock::Class(), this);
+      fCurrent = 0;
+      fLastIndexQueried = -1;
+      fLastIndexReturned = -1;
+   } else if (fType==2) {
+      TEntryListBlock block(*this);
+      block.Transform(1, new UShort_t[kBlockSize]);
+      block.ToList();
+      b.WriteClassBuffer(TEntryListBlock::Class(), &block);
+   } else {
+      b.WriteClassBuffer(TEntryListBlock::Class(), this);
+   }
+}
@@ -388,6 +388,7 @@ End_Macro
 #include "TLeafF.h"
 #include "TLeafI.h"
 #include "TLeafL.h"
+#include "TLeafO.h"
 #include "TLeafObject.h"
 #include "TLeafS.h"
 #include "TList.h"
@@ -400,6 +401,8 @@ End_Macro
 #include "TStyle.h"
 #include "TSystem.h"
 #include "TTreeCloner.h"
+#include "TTreeClusterStats.h"
+#include "TTreeClusterTuning.h"
 #include "TTreeCache.h"
 #include "TTreeCacheUnzip.h"
 #include "TVirtualCollectionProxy.h"
@@ -4366,6 +4369,96 @@ void TTree::DropBuffers(Int_t)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Record the minimum and maximum values of the branches matching bname in each cluster of the entries filled from
+/// now on.
+///
+/// bname is interpreted as a wildcarded regular expression, as in SetBranchStatus. Only the branches with a single
+/// leaf holding one value of type Bool_t, Char_t, Short_t, Int_t, Float_t or Double_t (or their unsigned variants) are
+/// considered. The statistics are stored in the list of user objects of the tree and written with it. Readers retrieve
+/// them with GetClusterStats to skip the clusters whose range of values cannot satisfy a selection, see
+/// TTreeClusterStats. They cost two comparisons per branch and entry when filling.
+///
+/// Calling this method again replaces the statistics recorded so far. Returns the number of branches with statistics.
+/// ~~~ {.cpp}
+///     TTree t("t", "t");
+///     float pt;
+///     t.Branch("pt", &pt);
+///     t.EnableClusterStats("pt");
+/// ~~~
+
+Int_t TTree::EnableClusterStats(const char *bname)
+{
+   if (auto stats = GetClusterStats()) {
+      fUserInfo->Remove(stats);
+      delete stats;
+      fClusterStats = nullptr;
+   }
+
+   TRegexp re(bname, kTRUE);
+   const Bool_t all = !strcmp(bname, "*");
+   std::vector<std::string> branchNames;
+   const Int_t nbranches = fBranches.GetEntriesFast();
+   for (Int_t i = 0; i < nbranches; ++i) {
+      auto branch = static_cast<TBranch *>(fBranches.UncheckedAt(i));
+      TString name = branch->GetName();
+      if (!all && name != bname && name.Index(re) == kNPOS)
+         continue;
+      if (branch->GetListOfBranches()->GetEntriesFast() != 0 || branch->GetListOfLeaves()->GetEntriesFast() != 1)
+         continue;
+      auto leaf = static_cast<TLeaf *>(branch->GetListOfLeaves()->UncheckedAt(0));
+      // 64-bit integers are not represented exactly by the Double_t statistics, and the values of Float16_t and
+      // Double32_t leaves are truncated when written, after the statistics are taken
+      const auto leafClass = leaf->IsA();
+      const Bool_t isNumerical = leafClass == TLeafB::Class() || leafClass == TLeafS::Class() ||
+                                 leafClass == TLeafI::Class() || leafClass == TLeafF::Class() ||
+                                 leafClass == TLeafD::Class() || leafClass == TLeafO::Class();
+      if (isNumerical && !leaf->GetLeafCount() && leaf->GetLenStatic() == 1)
+         branchNames.emplace_back(name.Data());
+   }
+   if (branchNames.empty())
+      return 0;
+
+   fClusterStats = new TTreeClusterStats(*this, branchNames);
+   GetUserInfo()->Add(fClusterStats);
+   return branchNames.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Adapt the size of the clusters and the basket sizes of the branches while the tree is written, instead of
+/// choosing them once at the first AutoFlush.
+///
+/// Each time a cluster is flushed, the compressed and uncompressed sizes of its entries are measured. The next
+/// clusters hold as many entries as fit in targetZipBytes compressed bytes, and each branch gets a basket large
+/// enough for its data of a whole cluster, the total size of the baskets being kept below maxMemory, which also
+/// bounds the size of the clusters. Readers then find one basket per branch and cluster, even for trees with many
+/// branches of very different sizes, instead of many small baskets. The decisions are stored in the list of user
+/// objects of the tree and written with it, see GetClusterTuning and TTreeClusterTuning.
+///
+/// If no cluster was flushed yet, the first one is flushed after targetZipBytes compressed bytes (see SetAutoFlush).
+/// To be called after the branches are created. Calling this method again replaces the previous settings.
+/// ~~~ {.cpp}
+///     TTree t("t", "t");
+///     // ... create the branches
+///     t.EnableClusterTuning(50000000, 200000000);
+/// ~~~
+
+void TTree::EnableClusterTuning(Long64_t targetZipBytes, Long64_t maxMemory)
+{
+   if (auto tuning = GetClusterTuning()) {
+      fUserInfo->Remove(tuning);
+      delete tuning;
+      fClusterTuning = nullptr;
+   }
+   if (targetZipBytes <= 0 || maxMemory <= 0)
+      return;
+
+   if (fFlushedBytes == 0)
+      SetAutoFlush(-targetZipBytes);
+   fClusterTuning = new TTreeClusterTuning(*this, targetZipBytes, maxMemory);
+   GetUserInfo()->Add(fClusterTuning);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Fill all branches.
 ///
@@ -4396,7 +4489,8 @@ void TTree::DropBuffers(Int_t)
 /// This makes future reading faster as it guarantees that baskets belonging to nearby
 /// entries will be on the same disk region.
 /// When the first call to flush the baskets happen, we also take this opportunity
-/// to optimize the baskets buffers.
+/// to optimize the baskets buffers, or, if EnableClusterTuning was called, the
+/// cluster and basket sizes are adapted at each flush.
 /// We also check if the amount of data written is greater than fAutoSave (see SetAutoSave).
 /// In this case we also write the Tree header. This makes the Tree recoverable up to this point
 /// in case the program writing the Tree crashes.
@@ -4482,10 +4576,17 @@ Int_t TTree::Fill()
    if (fBranchRef)
       fBranchRef->Fill();
 
+   if (fClusterStats)
+      fClusterStats->Fill();
+
    ++fEntries;
 
-   if (fEntries > fMaxEntries)
+   if (fEntries > fMaxEntries) {
       KeepCircular();
+      // the entries were renumbered
+      if (fClusterStats)
+         fClusterStats->Reset(*this);
+   }
 
    if (gDebug > 0)
       Info("TTree::Fill", " - A: %d %lld %lld %lld %lld %lld %lld \n", nbytes, fEntries, fAutoFlush, fAutoSave,
@@ -4518,7 +4619,7 @@ Int_t TTree::Fill()
             // When we are in one-basket-per-cluster mode, there is no need to optimize basket:
             // they will automatically grow to the size needed for an event cluster (with the basket
             // shrinking preventing them from growing too much larger than the actually-used space).
-            if (!TestBit(TTree::kOnlyFlushAtCluster)) {
+            if (!TestBit(TTree::kOnlyFlushAtCluster) && !fClusterTuning) {
                OptimizeBaskets(GetTotBytes(), 1, "");
                if (gDebug > 0)
                   Info("TTree::Fill", "OptimizeBaskets called at entry %lld, fZipBytes=%lld, fFlushedBytes=%lld\n",
@@ -4552,6 +4653,9 @@ Int_t TTree::Fill()
 
             if (gDebug > 0)
                Info("TTree::Fill", "First AutoFlush.  fAutoFlush = %lld, fAutoSave = %lld\n", fAutoFlush, fAutoSave);
+
+            if (fClusterTuning)
+               fClusterTuning->Tune(*this);
          }
       } else {
          // Check if we need to auto flush
@@ -4573,6 +4677,8 @@ Int_t TTree::Fill()
          Info("TTree::Fill", "FlushBaskets() called at entry %lld, fZipBytes=%lld, fFlushedBytes=%lld\n", fEntries,
               GetZipBytes(), fFlushedBytes);
       fFlushedBytes = GetZipBytes();
+      if (fClusterTuning)
+         fClusterTuning->Tune(*this);
    }
 
    if (autoSave) {
@@ -4947,6 +5053,8 @@ Int_t TTree::FlushBaskets(Bool_t create_cluster) const
 ///
 Int_t TTree::FlushBasketsImpl() const
 {
+   // the flushed entries form a cluster: record the statistics of their values
+   if (fClusterStats) fClusterStats->CloseZone(fEntries);
    if (!fDirectory) return 0;
    Int_t nbytes = 0;
    Int_t nerror = 0;
@@ -5251,6 +5359,24 @@ TTree::TClusterIterator TTree::GetClusterIterator(Long64_t firstentry)
    return TClusterIterator(this,firstentry);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the minimum and maximum values of branches in each cluster, if recorded (see EnableClusterStats),
+/// else a null pointer.
+
+TTreeClusterStats *TTree::GetClusterStats() const
+{
+   return fUserInfo ? dynamic_cast<TTreeClusterStats *>(fUserInfo->FindObject("ClusterStats")) : nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the cluster and basket sizes chosen while writing the tree, if tuned (see EnableClusterTuning),
+/// else a null pointer.
+
+TTreeClusterTuning *TTree::GetClusterTuning() const
+{
+   return fUserInfo ? dynamic_cast<TTreeClusterTuning *>(fUserInfo->FindObject("ClusterTuning")) : nullptr;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return pointer to the current file.
 
@@ -7615,6 +7741,12 @@ void TTree::RecursiveRemove(TObject *obj)
    if (fUserInfo) {
       fUserInfo->RecursiveRemove(obj);
    }
+   if (fClusterStats == obj) {
+      fClusterStats = nullptr;
+   }
+   if (fClusterTuning == obj) {
+      fClusterTuning = nullptr;
+   }
    if (fPlayer == obj) {
       fPlayer = 0;
    }
@@ -7725,6 +7857,16 @@ void TTree::Reset(Option_t* option)
    if (fBranchRef) {
       fBranchRef->Reset();
    }
+
+   // e.g. in a clone of a tree that records its cluster statistics, start recording them for the new entries
+   fClusterStats = GetClusterStats();
+   if (fClusterStats) {
+      fClusterStats->Reset(*this);
+   }
+   fClusterTuning = GetClusterTuning();
+   if (fClusterTuning) {
+      fClusterTuning->Reset(*this);
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
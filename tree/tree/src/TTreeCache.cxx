@@ -284,6 +284,7 @@ myTreeOrChain.GetTree()->PrintCacheStats();
 #include "TBranch.h"
 #include "TBranchElement.h"
 #include "TEventList.h"
+#include "TEntryList.h"
 #include "TObjArray.h"
 #include "TObjString.h"
 #include "TRegexp.h"
@@ -1296,6 +1297,14 @@ Bool_t TTreeCache::FillBuffer()
          chainOffset = chain->GetTreeOffset()[t];
       }
    }
+   // Otherwise, if it has a TEntryList, the baskets holding no entry of the
+   // list of the current tree are skipped as well.
+   TEntryList *entryList = elist ? nullptr : fTree->GetEntryList();
+   if (entryList && entryList->GetLists()) {
+      TTree *tree = fTree->GetTree();
+      TFile *file = tree ? tree->GetCurrentFile() : nullptr;
+      entryList = file ? entryList->GetEntryList(tree->GetName(), file->GetName(), "ne") : nullptr;
+   }
 
    //clear cache buffer
    Int_t ntotCurrentBuf = 0;
@@ -1351,7 +1360,7 @@ Bool_t TTreeCache::FillBuffer()
          kRewind = 3
       };
 
-      auto CollectBaskets = [this, elist, chainOffset, entry, clusterIterations, resetBranchInfo, perfStats,
+      auto CollectBaskets = [this, elist, entryList, chainOffset, entry, clusterIterations, resetBranchInfo, perfStats,
        &cursor, &lowestMaxEntry, &maxReadEntry, &minEntry,
        &reachedEnd, &skippedFirst, &oncePerBranch, &nDistinctLoad, &progress,
        &ranges, &memRanges, &reqRanges,
@@ -1479,6 +1488,13 @@ Bool_t TTreeCache::FillBuffer()
                   if (!elist->ContainsRange(entries[j]+chainOffset,emax+chainOffset))
                      continue;
                }
+               if (entryList) {
+                  Long64_t emax = fEntryMax;
+                  if (j<nb-1)
+                     emax = entries[j + 1] - 1;
+                  if (!entryList->ContainsRange(entries[j],emax))
+                     continue;
+               }
 
                if (b->fCacheInfo.HasBeenUsed(j) || b->fCacheInfo.IsInCache(j) || b->fCacheInfo.IsVetoed(j)) {
                   // We already cached and used this basket during this cluster range,
@@ -0,0 +1,178 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TTreeClusterStats
+\ingroup tree
+
+Minimum and maximum values of numerical branches of a TTree, for each zone of consecutive entries.
+
+The statistics are recorded while the tree is filled, for the branches selected with TTree::EnableClusterStats.
+A zone ends each time the baskets of the tree are flushed, so zones coincide with the clusters of the tree.
+The statistics are stored in the list of user objects of the tree (see TTree::GetUserInfo) and are retrieved
+with TTree::GetClusterStats.
+
+Readers can skip the clusters that cannot contain entries satisfying a selection on the values of these branches:
+~~~ {.cpp}
+   Double_t min, max;
+   auto stats = tree->GetClusterStats();
+   if (stats && stats->GetRange("pt", first, end, min, max) && max <= 500)
+      // no entry in [first, end) has pt > 500
+~~~
+NaN values are not taken into account: they do not satisfy any ordered comparison.
+*/
+
+#include "TTreeClusterStats.h"
+#include "TBranch.h"
+#include "TLeaf.h"
+#include "TTree.h"
+
+#include <algorithm>
+#include <limits>
+
+ClassImp(TTreeClusterStats);
+
+////////////////////////////////////////////////////////////////////////////////
+/// Default constructor, for I/O.
+
+TTreeClusterStats::TTreeClusterStats() : TNamed("ClusterStats", ""), fFirstEntry(0), fNCurrentEntries(0) {}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Record the statistics of the given branches of the tree, starting from its next entry.
+/// The branches must have a single numerical leaf holding one value.
+
+TTreeClusterStats::TTreeClusterStats(TTree &tree, const std::vector<std::string> &branchNames)
+   : TNamed("ClusterStats", "Minimum and maximum of branches per cluster"), fBranchNames(branchNames), fFirstEntry(0),
+     fNCurrentEntries(0)
+{
+   Reset(tree);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget the statistics recorded so far and record them again from the next entry of the tree,
+/// which can be a different tree with the same branches, e.g. a clone of the tree that was filled so far.
+
+void TTreeClusterStats::Reset(TTree &tree)
+{
+   fFirstEntry = tree.GetEntries();
+   fZoneEnds.clear();
+   fMin.clear();
+   fMax.clear();
+   fLeaves.clear();
+   for (const auto &name : fBranchNames) {
+      auto branch = tree.GetBranch(name.c_str());
+      fLeaves.emplace_back(branch ? static_cast<TLeaf *>(branch->GetListOfLeaves()->UncheckedAt(0)) : nullptr);
+   }
+   ResetCurrentZone();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start a new zone.
+
+void TTreeClusterStats::ResetCurrentZone()
+{
+   fCurrentMin.assign(fBranchNames.size(), std::numeric_limits<Double_t>::infinity());
+   fCurrentMax.assign(fBranchNames.size(), -std::numeric_limits<Double_t>::infinity());
+   fNCurrentEntries = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Accumulate the current values of the branches in the zone being filled. Called by TTree::Fill.
+
+void TTreeClusterStats::Fill()
+{
+   const auto nbranches = fLeaves.size();
+   for (auto i = 0u; i < nbranches; ++i) {
+      if (!fLeaves[i])
+         continue;
+      const Double_t value = fLeaves[i]->GetValue(0);
+      // NaN fails both comparisons and is ignored
+      if (value < fCurrentMin[i])
+         fCurrentMin[i] = value;
+      if (value > fCurrentMax[i])
+         fCurrentMax[i] = value;
+   }
+   ++fNCurrentEntries;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// End the zone being filled at entry nentries (excluded). Called when the tree flushes its baskets.
+///
+/// If some of the entries of the zone were not filled through TTree::Fill, e.g. because baskets were copied
+/// from another tree, the zone is dropped: no statistics are available for these entries.
+
+void TTreeClusterStats::CloseZone(Long64_t nentries)
+{
+   const Long64_t first = fZoneEnds.empty() ? fFirstEntry : fZoneEnds.back();
+   if (nentries <= first)
+      return;
+   const bool hasAllLeaves =
+      fLeaves.size() == fBranchNames.size() && std::find(fLeaves.begin(), fLeaves.end(), nullptr) == fLeaves.end();
+   if (nentries - first != fNCurrentEntries || !hasAllLeaves) {
+      // zones must be contiguous: forget the previous ones too
+      fFirstEntry = nentries;
+      fZoneEnds.clear();
+      fMin.clear();
+      fMax.clear();
+   } else {
+      fZoneEnds.emplace_back(nentries);
+      fMin.insert(fMin.end(), fCurrentMin.begin(), fCurrentMin.end());
+      fMax.insert(fMax.end(), fCurrentMax.begin(), fCurrentMax.end());
+   }
+   ResetCurrentZone();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of the branch in the list of branches with statistics, -1 if the branch has no statistics.
+
+Int_t TTreeClusterStats::GetBranchIndex(const char *branchname) const
+{
+   const auto it = std::find(fBranchNames.begin(), fBranchNames.end(), branchname);
+   return it == fBranchNames.end() ? -1 : Int_t(it - fBranchNames.begin());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the range of the values of a branch in the entries [first, end).
+///
+/// The range is the union of the ranges of the zones that overlap with the entries, so it can be larger than
+/// the actual range of the values. If all values are NaN, min is +inf and max is -inf.
+/// Return false if the branch has no statistics or some of the entries are not covered by a zone.
+
+Bool_t TTreeClusterStats::GetRange(const char *branchname, Long64_t first, Long64_t end, Double_t &min,
+                                   Double_t &max) const
+{
+   const auto branch = GetBranchIndex(branchname);
+   if (branch < 0 || fZoneEnds.empty() || first < fFirstEntry || end > fZoneEnds.back() || first >= end)
+      return kFALSE;
+
+   min = std::numeric_limits<Double_t>::infinity();
+   max = -std::numeric_limits<Double_t>::infinity();
+   // first zone ending after the first entry
+   const auto firstZone = std::upper_bound(fZoneEnds.begin(), fZoneEnds.end(), first) - fZoneEnds.begin();
+   const auto nzones = GetNZones();
+   for (auto zone = Int_t(firstZone); zone < nzones && GetZoneFirstEntry(zone) < end; ++zone) {
+      min = std::min(min, GetMin(branch, zone));
+      max = std::max(max, GetMax(branch, zone));
+   }
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the ranges of the branches in each zone.
+
+void TTreeClusterStats::Print(Option_t *) const
+{
+   Printf("Cluster statistics of %zu branches in %d zones", fBranchNames.size(), GetNZones());
+   const auto nzones = GetNZones();
+   for (auto zone = 0; zone < nzones; ++zone) {
+      Printf("  entries [%lld, %lld)", GetZoneFirstEntry(zone), GetZoneEndEntry(zone));
+      for (auto branch = 0u; branch < fBranchNames.size(); ++branch)
+         Printf("    %-20s [%g, %g]", fBranchNames[branch].c_str(), GetMin(branch, zone), GetMax(branch, zone));
+   }
+}
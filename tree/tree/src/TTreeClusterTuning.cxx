@@ -0,0 +1,209 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2019, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class TTreeClusterTuning
+\ingroup tree
+
+Adaptive choice of the cluster size and of the basket sizes of a TTree being written.
+
+Each time the tree flushes a cluster of baskets, the compressed and uncompressed sizes of the entries of that
+cluster are measured. The next clusters are given as many entries as fit in the target compressed size, and each
+branch is given a basket size large enough to hold the data of a whole cluster, so that a reader finds one basket
+per branch and cluster instead of many small ones. The total size of the baskets being filled is kept below a
+memory budget, which bounds the cluster size too.
+
+The cluster size is only changed when it is off by more than 20%, and a basket is only shrunk when it is more than
+twice too large, so that a steady stream of entries leads to few decisions. The decisions are recorded, and stored
+with the tree in its list of user objects (see TTree::GetUserInfo): they are retrieved with
+TTree::GetClusterTuning. The tuning is enabled with TTree::EnableClusterTuning.
+*/
+
+#include "TTreeClusterTuning.h"
+#include "TBranch.h"
+#include "TLeaf.h"
+#include "TObjArray.h"
+#include "TTree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+ClassImp(TTreeClusterTuning);
+
+namespace {
+
+const Double_t kHeadroom = 1.1;         // margin of the basket sizes over the measured size of a cluster
+const Long64_t kMinBasketSize = 512;    // as in TTree::OptimizeBaskets
+const Long64_t kMaxBasketSize = 256000000;
+
+// The branches holding data: the branches with sub-branches are left out, as in TTree::OptimizeBaskets.
+std::vector<TBranch *> GetDataBranches(TTree &tree)
+{
+   std::vector<TBranch *> branches;
+   TObjArray *leaves = tree.GetListOfLeaves();
+   const Int_t nleaves = leaves->GetEntriesFast();
+   for (Int_t i = 0; i < nleaves; ++i) {
+      auto branch = static_cast<TLeaf *>(leaves->UncheckedAt(i))->GetBranch();
+      // the leaves of a branch are consecutive
+      if (branch->GetListOfBranches()->GetEntriesFast() || (!branches.empty() && branches.back() == branch))
+         continue;
+      branches.emplace_back(branch);
+   }
+   return branches;
+}
+
+Long64_t RoundUpBasketSize(Double_t size)
+{
+   const Long64_t rounded = (Long64_t(size) / kMinBasketSize + 1) * kMinBasketSize;
+   return std::min(std::max(rounded, kMinBasketSize), kMaxBasketSize);
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Default constructor, for I/O.
+
+TTreeClusterTuning::TTreeClusterTuning()
+   : TNamed("ClusterTuning", ""), fTargetZipBytes(0), fMaxMemory(0), fLastEntries(0), fLastTreeZipBytes(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Tune the clusters of the tree filled from now on to targetZipBytes compressed bytes, with at most maxMemory
+/// bytes of baskets being filled.
+
+TTreeClusterTuning::TTreeClusterTuning(TTree &tree, Long64_t targetZipBytes, Long64_t maxMemory)
+   : TNamed("ClusterTuning", "Cluster and basket sizes chosen while writing"), fTargetZipBytes(targetZipBytes),
+     fMaxMemory(maxMemory), fLastEntries(0), fLastTreeZipBytes(0)
+{
+   StartMeasurement(tree);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget the decisions taken so far and tune the clusters from the next entry of the tree,
+/// which can be a different tree with the same branches, e.g. a clone of the tree that was filled so far.
+
+void TTreeClusterTuning::Reset(TTree &tree)
+{
+   fFirstEntries.clear();
+   fClusterSizes.clear();
+   fZipBytesPerEntry.clear();
+   fBasketMemory.clear();
+   fNResized.clear();
+   StartMeasurement(tree);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Measure the next cluster from the current entry of the tree.
+
+void TTreeClusterTuning::StartMeasurement(TTree &tree)
+{
+   fBranches = GetDataBranches(tree);
+   fLastTotBytes.clear();
+   for (auto branch : fBranches)
+      fLastTotBytes.emplace_back(branch->GetTotBytes());
+   fLastEntries = tree.GetEntries();
+   fLastTreeZipBytes = tree.GetZipBytes();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Choose the size of the next clusters and the basket sizes from the cluster that was just flushed.
+/// Called by TTree::Fill after flushing the baskets.
+
+void TTreeClusterTuning::Tune(TTree &tree)
+{
+   const Long64_t nentries = tree.GetEntries() - fLastEntries;
+   const Long64_t zipBytes = tree.GetZipBytes() - fLastTreeZipBytes;
+   if (nentries <= 0 || zipBytes <= 0 || GetDataBranches(tree) != fBranches) {
+      // the tree was reset, is not written or has new branches: start measuring again
+      StartMeasurement(tree);
+      return;
+   }
+
+   const auto nbranches = fBranches.size();
+   std::vector<Double_t> bytesPerEntry(nbranches);
+   Double_t totBytesPerEntry = 0;
+   for (auto i = 0u; i < nbranches; ++i) {
+      bytesPerEntry[i] = Double_t(fBranches[i]->GetTotBytes() - fLastTotBytes[i]) / nentries;
+      totBytesPerEntry += bytesPerEntry[i];
+   }
+   const Double_t zipBytesPerEntry = Double_t(zipBytes) / nentries;
+   StartMeasurement(tree);
+   if (totBytesPerEntry <= 0)
+      return;
+
+   // As many entries as fit in the target compressed size, as long as the baskets can hold all of them
+   Double_t clusterSize = std::min(fTargetZipBytes / zipBytesPerEntry, fMaxMemory / (kHeadroom * totBytesPerEntry));
+   Long64_t newClusterSize = std::max(Long64_t(clusterSize), Long64_t(1));
+   const Long64_t oldClusterSize = tree.GetAutoFlush();
+   if (oldClusterSize > 0 && std::abs(newClusterSize - oldClusterSize) * 5 < oldClusterSize)
+      newClusterSize = oldClusterSize;
+
+   // One basket per branch and cluster, scaled down if they do not fit in memory
+   std::vector<Long64_t> sizes(nbranches);
+   Long64_t memory = 0;
+   for (auto i = 0u; i < nbranches; ++i) {
+      sizes[i] = RoundUpBasketSize(kHeadroom * bytesPerEntry[i] * newClusterSize + bytesPerEntry[i]);
+      memory += sizes[i];
+   }
+   if (memory > fMaxMemory) {
+      const Double_t scale = Double_t(fMaxMemory) / memory;
+      for (auto i = 0u; i < nbranches; ++i)
+         sizes[i] = RoundUpBasketSize(scale * sizes[i]);
+   }
+
+   // Grow the baskets too small for a cluster, but only shrink the ones much too large, not to resize them at each
+   // cluster, unless the budget is exceeded
+   std::vector<Bool_t> resize(nbranches);
+   Long64_t basketMemory = 0;
+   for (auto i = 0u; i < nbranches; ++i) {
+      const Long64_t oldSize = fBranches[i]->GetBasketSize();
+      const Double_t needed = bytesPerEntry[i] * (newClusterSize + 1);
+      resize[i] = bytesPerEntry[i] > 0 && (needed > oldSize || 2 * sizes[i] < oldSize);
+      basketMemory += resize[i] ? sizes[i] : oldSize;
+   }
+   if (basketMemory > fMaxMemory)
+      std::fill(resize.begin(), resize.end(), kTRUE);
+
+   Int_t nresized = 0;
+   basketMemory = 0;
+   for (auto i = 0u; i < nbranches; ++i) {
+      if (resize[i] && sizes[i] != fBranches[i]->GetBasketSize()) {
+         fBranches[i]->SetBasketSize(sizes[i]);
+         ++nresized;
+      }
+      basketMemory += fBranches[i]->GetBasketSize();
+   }
+
+   if (newClusterSize != oldClusterSize)
+      tree.SetAutoFlush(newClusterSize);
+   if (newClusterSize != oldClusterSize || nresized || fFirstEntries.empty()) {
+      fFirstEntries.emplace_back(tree.GetEntries());
+      fClusterSizes.emplace_back(newClusterSize);
+      fZipBytesPerEntry.emplace_back(zipBytesPerEntry);
+      fBasketMemory.emplace_back(basketMemory);
+      fNResized.emplace_back(nresized);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print the decisions taken.
+
+void TTreeClusterTuning::Print(Option_t *) const
+{
+   Printf("Cluster tuning to %lld compressed bytes per cluster, with at most %lld bytes of baskets", fTargetZipBytes,
+          fMaxMemory);
+   Printf("  %-16s %-16s %-16s %-16s %s", "From entry", "Cluster size", "Zip bytes/entry", "Basket memory",
+          "Resized baskets");
+   const auto ndecisions = GetNDecisions();
+   for (auto i = 0; i < ndecisions; ++i)
+      Printf("  %-16lld %-16lld %-16.1f %-16lld %d", fFirstEntries[i], fClusterSizes[i], fZipBytesPerEntry[i],
+             fBasketMemory[i], fNResized[i]);
+}
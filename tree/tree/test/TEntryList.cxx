@@ -0,0 +1,192 @@
+#include "TEntryList.h"
+#include "TEntryListBlock.h"
+#include "TMemFile.h"
+#include "TRandom3.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+// Entries in runs of various lengths, over several blocks of the list
+static std::set<Long64_t> MakeRuns(TRandom &rnd, Long64_t n)
+{
+   std::set<Long64_t> entries;
+   Long64_t pos = rnd.Integer(100);
+   while (pos < n) {
+      Long64_t len = 10 + rnd.Integer(3000);
+      for (Long64_t i = pos; i < std::min(n, pos + len); ++i)
+         entries.insert(i);
+      pos += len + 1 + rnd.Integer(5000);
+   }
+   return entries;
+}
+
+static std::set<Long64_t> MakeRandom(TRandom &rnd, Long64_t n, Double_t fraction)
+{
+   std::set<Long64_t> entries;
+   for (Long64_t i = 0; i < n; ++i) {
+      if (rnd.Rndm() < fraction)
+         entries.insert(i);
+   }
+   return entries;
+}
+
+static void Fill(TEntryList &elist, const std::set<Long64_t> &entries)
+{
+   for (auto entry : entries)
+      elist.Enter(entry);
+   elist.OptimizeStorage();
+}
+
+static void Check(TEntryList &elist, const std::set<Long64_t> &entries, Long64_t n)
+{
+   ASSERT_EQ(elist.GetN(), Long64_t(entries.size()));
+   std::vector<Long64_t> sorted(entries.begin(), entries.end());
+   for (Long64_t i = 0; i < elist.GetN(); ++i)
+      EXPECT_EQ(elist.GetEntry(i), sorted[i]);
+   TRandom3 rnd(7);
+   for (Int_t i = 0; i < 1000 && !sorted.empty(); ++i) {
+      auto index = rnd.Integer(sorted.size());
+      EXPECT_EQ(elist.GetEntry(index), sorted[index]);
+   }
+   for (Long64_t entry = 0; entry < n; entry += 13)
+      EXPECT_EQ(elist.Contains(entry) != 0, entries.count(entry) != 0);
+   for (Int_t i = 0; i < 1000; ++i) {
+      Long64_t first = rnd.Integer(n);
+      Long64_t last = first + rnd.Integer(i % 2 ? 100 : 100000);
+      auto it = entries.lower_bound(first);
+      EXPECT_EQ(elist.ContainsRange(first, last), it != entries.end() && *it <= last);
+   }
+}
+
+TEST(TEntryList, RunsRepresentation)
+{
+   TRandom3 rnd(1);
+   const Long64_t n = 3 * TEntryList::kBlockSize + 1000;
+   auto entries = MakeRuns(rnd, n);
+   TEntryList elist("elist", "");
+   Fill(elist, entries);
+   Check(elist, entries, n);
+
+   // Entering and removing entries goes back to bits
+   for (Int_t i = 0; i < 100; ++i) {
+      Long64_t entry = rnd.Integer(n);
+      if (i % 2) {
+         elist.Enter(entry);
+         entries.insert(entry);
+      } else {
+         elist.Remove(entry);
+         entries.erase(entry);
+      }
+   }
+   Check(elist, entries, n);
+}
+
+TEST(TEntryList, BlockTypes)
+{
+   TEntryListBlock runs, bits, list;
+   for (Int_t i = 1000; i < 20000; ++i)
+      runs.Enter(i);
+   for (Int_t i = 0; i < 64000; i += 3)
+      bits.Enter(i);
+   for (Int_t i = 0; i < 64000; i += 100)
+      list.Enter(i);
+   runs.OptimizeStorage();
+   bits.OptimizeStorage();
+   list.OptimizeStorage();
+   EXPECT_EQ(runs.GetType(), 2);
+   EXPECT_EQ(bits.GetType(), 0);
+   EXPECT_EQ(list.GetType(), 1);
+
+   EXPECT_FALSE(runs.ContainsRange(0, 999));
+   EXPECT_TRUE(runs.ContainsRange(0, 1000));
+   EXPECT_TRUE(runs.ContainsRange(19999, 30000));
+   EXPECT_FALSE(runs.ContainsRange(20000, 63999));
+   EXPECT_FALSE(list.ContainsRange(1, 99));
+   EXPECT_TRUE(list.ContainsRange(1, 100));
+}
+
+TEST(TEntryList, AddSubtract)
+{
+   TRandom3 rnd(2);
+   const Long64_t n = 2 * TEntryList::kBlockSize + 5000;
+   std::vector<std::set<Long64_t>> sets{MakeRuns(rnd, n), MakeRandom(rnd, n, 0.01), MakeRandom(rnd, n, 0.5),
+                                        MakeRandom(rnd, n, 0.99), {}};
+   for (const auto &a : sets) {
+      for (const auto &b : sets) {
+         TEntryList la("la", "", "tree", "file.root");
+         TEntryList lb("lb", "", "tree", "file.root");
+         Fill(la, a);
+         Fill(lb, b);
+
+         TEntryList lunion(la);
+         lunion.Add(&lb);
+         std::set<Long64_t> u(a);
+         u.insert(b.begin(), b.end());
+         Check(lunion, u, n);
+
+         TEntryList ldiff(la);
+         ldiff.Subtract(&lb);
+         std::set<Long64_t> d;
+         for (auto entry : a) {
+            if (!b.count(entry))
+               d.insert(entry);
+         }
+         Check(ldiff, d, n);
+      }
+   }
+}
+
+TEST(TEntryList, WriteRead)
+{
+   TRandom3 rnd(3);
+   const Long64_t n = 4 * TEntryList::kBlockSize;
+   auto entries = MakeRuns(rnd, n);
+   auto sparse = MakeRandom(rnd, n, 0.02);
+   entries.insert(sparse.begin(), sparse.end());
+   TEntryList elist("elist", "");
+   Fill(elist, entries);
+
+   TMemFile f("entrylist.root", "RECREATE");
+   f.WriteObject(&elist, "elist");
+   // Writing does not change the representation in memory
+   Check(elist, entries, n);
+
+   auto read = f.Get<TEntryList>("elist");
+   ASSERT_NE(read, nullptr);
+   Check(*read, entries, n);
+   delete read;
+}
+
+TEST(TEntryList, CacheSkipsBaskets)
+{
+   TMemFile f("entrylistcache.root", "RECREATE");
+   TTree t("t", "t");
+   Int_t x;
+   t.Branch("x", &x, 4000);
+   const Long64_t n = 100000;
+   for (x = 0; x < n; ++x)
+      t.Fill();
+   t.Write();
+
+   // Entries of the first and the last baskets only: the cache skips the others
+   TEntryList elist("elist", "", &t);
+   for (Long64_t i = 0; i < 10; ++i) {
+      elist.Enter(i);
+      elist.Enter(n - 1 - i);
+   }
+   elist.OptimizeStorage();
+   t.SetEntryList(&elist);
+   t.SetCacheSize(10000000);
+   t.AddBranchToCache("x");
+   Long64_t sum = 0;
+   for (Long64_t i = 0; i < elist.GetN(); ++i) {
+      t.GetEntry(t.GetEntryNumber(i));
+      sum += x;
+   }
+   EXPECT_EQ(sum, 10 * (n - 1));
+   t.SetEntryList(nullptr);
+}
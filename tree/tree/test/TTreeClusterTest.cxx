@@ -1,10 +1,17 @@
 #include "TFile.h"
 #include "TTree.h"
+#include "TTreeClusterStats.h"
+#include "TTreeClusterTuning.h"
 #include "TBranch.h"
 #include "TRandom.h"
+#include "TSystem.h"
 
 #include "gtest/gtest.h"
 
+#include <limits>
+#include <memory>
+#include <vector>
+
 class TTreeClusterTest : public ::testing::Test {
 protected:
    virtual void SetUp()
@@ -53,3 +60,182 @@ TEST_F(TTreeClusterTest, countBaskets)
 
    delete file;
 }
+
+TEST(TTreeClusterStats, MinMaxPerCluster)
+{
+   const auto fileName = "TTreeClusterStats.root";
+   {
+      TFile file(fileName, "RECREATE");
+      TTree tree("tree", "tree");
+      Int_t i = 0;
+      Float_t x = 0;
+      Long64_t l = 0;
+      tree.Branch("i", &i);
+      tree.Branch("x", &x);
+      tree.Branch("l", &l);
+      tree.SetAutoFlush(100);
+      EXPECT_EQ(tree.EnableClusterStats(), 2); // 64-bit integers are not supported
+      for (; i < 1050; ++i) {
+         x = i % 100 == 50 ? std::numeric_limits<Float_t>::quiet_NaN() : -0.5f * i;
+         tree.Fill();
+      }
+      tree.Write();
+   }
+
+   TFile file(fileName);
+   auto tree = static_cast<TTree *>(file.Get("tree"));
+   auto stats = tree->GetClusterStats();
+   ASSERT_NE(stats, nullptr);
+   EXPECT_EQ(stats->GetBranchIndex("i"), 0);
+   EXPECT_EQ(stats->GetBranchIndex("l"), -1);
+   ASSERT_EQ(stats->GetNZones(), 11);
+   EXPECT_EQ(stats->GetZoneFirstEntry(3), 300);
+   EXPECT_EQ(stats->GetZoneEndEntry(10), 1050);
+
+   Double_t min = 0, max = 0;
+   EXPECT_TRUE(stats->GetRange("i", 0, 100, min, max));
+   EXPECT_EQ(min, 0.);
+   EXPECT_EQ(max, 99.);
+   // ranges are the union of the ranges of the overlapping zones
+   EXPECT_TRUE(stats->GetRange("i", 150, 250, min, max));
+   EXPECT_EQ(min, 100.);
+   EXPECT_EQ(max, 299.);
+   // NaN values are ignored
+   EXPECT_TRUE(stats->GetRange("x", 1000, 1050, min, max));
+   EXPECT_EQ(min, -524.5);
+   EXPECT_EQ(max, -500.);
+   EXPECT_FALSE(stats->GetRange("i", 1000, 1051, min, max));
+   EXPECT_FALSE(stats->GetRange("l", 0, 100, min, max));
+
+   gSystem->Unlink(fileName);
+}
+
+TEST(TTreeClusterStats, CopiedEntries)
+{
+   TTree tree("tree", "tree");
+   Int_t i = 0;
+   tree.Branch("i", &i);
+   tree.SetAutoFlush(10);
+   tree.EnableClusterStats("i");
+   for (; i < 30; ++i)
+      tree.Fill();
+   EXPECT_EQ(tree.GetClusterStats()->GetNZones(), 3);
+
+   // the statistics of the clone are recorded again
+   std::unique_ptr<TTree> clone(tree.CloneTree(0));
+   auto cloneStats = clone->GetClusterStats();
+   ASSERT_NE(cloneStats, nullptr);
+   EXPECT_EQ(cloneStats->GetNZones(), 0);
+   for (Long64_t entry = 0; entry < 20; ++entry) {
+      tree.GetEntry(entry);
+      clone->Fill();
+   }
+   EXPECT_EQ(cloneStats->GetNZones(), 2);
+   Double_t min = 0, max = 0;
+   EXPECT_TRUE(cloneStats->GetRange("i", 10, 20, min, max));
+   EXPECT_EQ(min, 10.);
+   EXPECT_EQ(max, 19.);
+}
+
+// A tree with branches of very different sizes, from one to a hundred doubles per entry
+static void FillWideTree(TTree &tree, Int_t nentries, Long64_t targetZipBytes, Long64_t maxMemory)
+{
+   const Int_t nbranches = 50;
+   std::vector<std::vector<Double_t>> data(nbranches);
+   for (Int_t i = 0; i < nbranches; ++i) {
+      data[i].resize(1 + i * i / 25);
+      tree.Branch(Form("b%d", i), data[i].data(), Form("b%d[%d]/D", i, Int_t(data[i].size())));
+   }
+   tree.EnableClusterTuning(targetZipBytes, maxMemory);
+   TRandom random(42);
+   for (Int_t entry = 0; entry < nentries; ++entry) {
+      for (auto &values : data) {
+         for (auto &value : values)
+            value = random.Gaus(0, 1);
+      }
+      tree.Fill();
+   }
+}
+
+// Number of baskets of all the branches starting at or after firstEntry, among the baskets already written
+static Long64_t CountBaskets(TTree &tree, Long64_t firstEntry)
+{
+   Long64_t nbaskets = 0;
+   for (auto obj : *tree.GetListOfBranches()) {
+      auto branch = static_cast<TBranch *>(obj);
+      const auto entries = branch->GetBasketEntry();
+      for (Int_t i = 0; i < branch->GetWriteBasket(); ++i) {
+         if (entries[i] >= firstEntry)
+            ++nbaskets;
+      }
+   }
+   return nbaskets;
+}
+
+TEST(TTreeClusterTuning, WideTree)
+{
+   const auto fileName = "TTreeClusterTuning.root";
+   const Long64_t targetZipBytes = 1000000;
+   const Long64_t maxMemory = 10000000;
+   Int_t ndecisions = 0;
+   {
+      TFile file(fileName, "RECREATE");
+      TTree tuned("tuned", "tuned");
+      FillWideTree(tuned, 2000, targetZipBytes, maxMemory);
+
+      auto tuning = tuned.GetClusterTuning();
+      ASSERT_NE(tuning, nullptr);
+      ndecisions = tuning->GetNDecisions();
+      ASSERT_GE(ndecisions, 1);
+      const auto last = ndecisions - 1;
+      // the clusters aim at the target compressed size, with the baskets within the memory budget
+      const Double_t clusterZipBytes = tuning->GetClusterSize(last) * tuning->GetZipBytesPerEntry(last);
+      EXPECT_GT(clusterZipBytes, 0.7 * targetZipBytes);
+      EXPECT_LT(clusterZipBytes, 1.3 * targetZipBytes);
+      EXPECT_EQ(tuned.GetAutoFlush(), tuning->GetClusterSize(last));
+      for (Int_t i = 0; i < ndecisions; ++i)
+         EXPECT_LE(tuning->GetBasketMemory(i), maxMemory);
+
+      // after the first decision, there is about one basket per branch and cluster
+      const Long64_t firstTuned = tuning->GetFirstEntry(0);
+      Long64_t nclusters = 0;
+      auto clusters = tuned.GetClusterIterator(firstTuned);
+      for (Long64_t start = clusters(); start < tuned.GetEntries(); start = clusters())
+         ++nclusters;
+      const Long64_t nbranches = tuned.GetListOfBranches()->GetEntries();
+      EXPECT_LE(CountBaskets(tuned, firstTuned), nbranches * (nclusters + 1));
+
+      tuned.Write();
+   }
+
+   // the decisions are written with the tree
+   TFile file(fileName);
+   auto tree = static_cast<TTree *>(file.Get("tuned"));
+   ASSERT_NE(tree, nullptr);
+   auto tuning = tree->GetClusterTuning();
+   ASSERT_NE(tuning, nullptr);
+   EXPECT_EQ(tuning->GetNDecisions(), ndecisions);
+   EXPECT_EQ(tuning->GetTargetZipBytes(), targetZipBytes);
+   EXPECT_EQ(tree->GetEntries(), 2000);
+
+   gSystem->Unlink(fileName);
+}
+
+TEST(TTreeClusterTuning, MemoryBudget)
+{
+   const auto fileName = "TTreeClusterTuningMemory.root";
+   TFile file(fileName, "RECREATE");
+   TTree tree("tree", "tree");
+   // the budget, not the target compressed size, bounds the clusters
+   const Long64_t maxMemory = 500000;
+   FillWideTree(tree, 1000, 10000000, maxMemory);
+   auto tuning = tree.GetClusterTuning();
+   ASSERT_NE(tuning, nullptr);
+   ASSERT_GE(tuning->GetNDecisions(), 1);
+   EXPECT_LT(tuning->GetClusterSize(0) * tuning->GetZipBytesPerEntry(0), maxMemory);
+   for (Int_t i = 0; i < tuning->GetNDecisions(); ++i) {
+      // the baskets are rounded up to 512 bytes
+      EXPECT_LE(tuning->GetBasketMemory(i), maxMemory + 50 * 512);
+   }
+   gSystem->Unlink(fileName);
+}
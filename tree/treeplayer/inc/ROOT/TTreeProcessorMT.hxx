@@ -82,12 +82,16 @@ public:
 } // End of namespace Internal
 
 class TTreeProcessorMT {
+public:
+   using ClusterFilter_t = std::function<bool(TTree &tree, Long64_t start, Long64_t end)>;
+
 private:
    const std::vector<std::string> fFileNames; ///< Names of the files
    const std::string fTreeName;               ///< Name of the tree
    /// User-defined selection of entry numbers to be processed, empty if none was provided
    const TEntryList fEntryList; // const to be sure to avoid race conditions among TTreeViews
    const Internal::FriendInfo fFriendInfo;
+   ClusterFilter_t fClusterFilter; ///< Selection of the clusters to process, empty if all clusters are processed
 
    ROOT::TThreadedObject<ROOT::Internal::TTreeView> fTreeView; ///<! Thread-local TreeViews
 
@@ -102,6 +106,7 @@ public:
    TTreeProcessorMT(TTree &tree);
 
    void Process(std::function<void(TTreeReader &)> func);
+   void SetClusterFilter(ClusterFilter_t filter);
    static void SetMaxTasksPerFilePerWorker(unsigned int m);
    static unsigned int GetMaxTasksPerFilePerWorker();
 };
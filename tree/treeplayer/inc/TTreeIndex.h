@@ -25,6 +25,8 @@
 #include "TVirtualIndex.h"
 #include "TTreeFormula.h"
 
+#include <vector>
+
 class TTreeIndex : public TVirtualIndex {
 
 protected:
@@ -38,12 +40,19 @@ protected:
    TTreeFormula  *fMinorFormula;        //! Pointer to minor TreeFormula
    TTreeFormula  *fMajorFormulaParent;  //! Pointer to major TreeFormula in Parent tree (if any)
    TTreeFormula  *fMinorFormulaParent;  //! Pointer to minor TreeFormula in Parent tree (if any)
+   std::vector<Long64_t> fBlockValues;  //! Major and minor values of the first entry of each block of sorted values
 
 private:
    TTreeIndex(const TTreeIndex&);            // Not implemented.
    TTreeIndex &operator=(const TTreeIndex&); // Not implemented.
 
+   void                   BuildBlockValues();
+
 public:
+   enum EStatusBits {
+      kCompactValues = BIT(14) ///< Write the values in their compact form, which older versions of ROOT cannot read
+   };
+
    TTreeIndex();
    TTreeIndex(const TTree *T, const char *majorname, const char *minorname);
    virtual               ~TTreeIndex();
@@ -66,8 +75,9 @@ public:
    virtual void           Print(Option_t *option="") const;
    virtual void           UpdateFormulaLeaves(const TTree *parent);
    virtual void           SetTree(const TTree *T);
+   void                   SetCompactStreaming(Bool_t compact = kTRUE) { SetBit(kCompactValues, compact); }
 
-   ClassDef(TTreeIndex,2);  //A Tree Index with majorname and minorname.
+   ClassDef(TTreeIndex,3);  //A Tree Index with majorname and minorname.
 };
 
 #endif
@@ -17,16 +17,26 @@ a new index.
 The index values from the first tree should be less then
 all the index values from the second tree, and so on.
 If a tree in the chain doesn't have an index the index will be created
-and kept inside this chain index.
+and kept inside this chain index. When the implicit multi-threading is
+enabled, these indices are built in parallel, each file being opened again
+by the task building the index of its tree.
 */
 
 #include "TChainIndex.h"
 #include "TChain.h"
+#include "TChainElement.h"
 #include "TTreeFormula.h"
 #include "TTreeIndex.h"
 #include "TFile.h"
 #include "TError.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
+#include <memory>
+
 ////////////////////////////////////////////////////////////////////////////////
 /// \class TChainIndex::TChainIndexEntry
 /// Holds a description of indices of trees in the chain.
@@ -79,6 +89,13 @@ TChainIndex::TChainIndex(const TTree *T, const char *majorname, const char *mino
    fMinorName          = minorname;
    Int_t i = 0;
 
+#ifdef R__USE_IMT
+   const Bool_t buildInParallel = ROOT::IsImplicitMTEnabled() && chain->GetNtrees() > 1;
+#else
+   const Bool_t buildInParallel = kFALSE;
+#endif
+   std::vector<Int_t> toBuild;
+
    // Go through all the trees and check if they have indeces. If not then build them.
    for (i = 0; i < chain->GetNtrees(); i++) {
       chain->LoadTree((chain->GetTreeOffset())[i]);
@@ -96,6 +113,12 @@ TChainIndex::TChainIndex(const TTree *T, const char *majorname, const char *mino
             return;
          }
       }
+      if (!index && buildInParallel) {
+         // built below, with the indices of the other trees
+         toBuild.push_back(i);
+         fEntries.push_back(entry);
+         continue;
+      }
       if (!index) {
          chain->GetTree()->BuildIndex(majorname, minorname);
          index = chain->GetTree()->GetTreeIndex();
@@ -120,6 +143,36 @@ TChainIndex::TChainIndex(const TTree *T, const char *majorname, const char *mino
       fEntries.push_back(entry);
    }
 
+#ifdef R__USE_IMT
+   if (!toBuild.empty()) {
+      TObjArray *files = chain->GetListOfFiles();
+      auto buildIndex = [&](Int_t treeNo) {
+         auto element = static_cast<TChainElement *>(files->At(treeNo));
+         std::unique_ptr<TFile> f(TFile::Open(element->GetTitle()));
+         auto tree = f ? f->Get<TTree>(element->GetName()) : nullptr;
+         if (!tree)
+            return;
+         auto index = new TTreeIndex(tree, majorname, minorname);
+         // the tree is deleted with its file
+         index->SetTree(0);
+         fEntries[treeNo].fTreeIndex = index;
+      };
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(buildIndex, toBuild);
+
+      for (auto treeNo : toBuild) {
+         TTreeIndex *index = static_cast<TTreeIndex *>(fEntries[treeNo].fTreeIndex);
+         if (!index || index->IsZombie() || index->GetN() == 0) {
+            DeleteIndices();
+            MakeZombie();
+            Error("TChainIndex", "Error creating a tree index on a tree in the chain");
+            return;
+         }
+         fEntries[treeNo].SetMinMaxFrom(index);
+      }
+   }
+#endif
+
    // Check if the indices of different trees are in order. If not then return an error.
    for (i = 0; i < Int_t(fEntries.size() - 1); i++) {
       if( fEntries[i].GetMaxIndexValPair() > fEntries[i+1].GetMinIndexValPair() ) {
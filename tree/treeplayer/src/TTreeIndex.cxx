@@ -11,14 +11,239 @@
 
 /** \class TTreeIndex
 A Tree Index with majorname and minorname.
+
+When the implicit multi-threading is enabled, the index of a tree read from
+a file is built in parallel: the values of the index are computed by tasks
+reading ranges of clusters, each with its own copy of the tree, and sorted
+in parallel. The index is written in a compact form, where the sorted values
+and the entry numbers are delta-encoded.
 */
 
 #include "TTreeIndex.h"
+#include "TChain.h"
+#include "TFile.h"
+#include "TMemFile.h"
 #include "TTree.h"
 #include "TMath.h"
+#include "ROOT/TSeq.hxx"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
 
 ClassImp(TTreeIndex);
 
+namespace {
+
+/// Number of sorted values per block of fBlockValues.
+constexpr Long64_t kBlockSize = 64;
+
+/// Order of the entries by major value, then minor value. The entry number makes the order deterministic, whatever
+/// the sorting algorithm.
+struct TEntryOrder {
+   const Long64_t *fMajor;
+   const Long64_t *fMinor;
+
+   bool operator()(Long64_t i1, Long64_t i2) const
+   {
+      if (fMajor[i1] != fMajor[i2])
+         return fMajor[i1] < fMajor[i2];
+      if (fMinor[i1] != fMinor[i2])
+         return fMinor[i1] < fMinor[i2];
+      return i1 < i2;
+   }
+};
+
+#ifdef R__USE_IMT
+////////////////////////////////////////////////////////////////////////////////
+/// Return the name of the tree, preceded by the directories of the file it is in.
+
+std::string GetTreePathInFile(const TTree &tree)
+{
+   std::string path = tree.GetName();
+   const TDirectory *file = tree.GetCurrentFile();
+   for (auto dir = tree.GetDirectory(); dir && dir != file; dir = dir->GetMotherDir())
+      path = std::string(dir->GetName()) + "/" + path;
+   return path;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the index values of all the entries of a tree in parallel. Each task opens the file of the tree again and
+/// evaluates the expressions on a range of clusters. Return false if the tree cannot be read this way: a chain, a
+/// tree with friends, a tree in memory or in a file being written, or a tree that is not the last cycle of its name.
+
+bool FillValuesParallel(TTree &tree, const char *majorName, const char *minorName, Long64_t nEntries, Long64_t *majors,
+                        Long64_t *minors)
+{
+   const auto file = tree.GetCurrentFile();
+   if (dynamic_cast<TChain *>(&tree) || !file || file->IsWritable() || dynamic_cast<TMemFile *>(file) ||
+       (tree.GetListOfFriends() && tree.GetListOfFriends()->GetEntries()))
+      return false;
+
+   // ranges of whole clusters, about four per worker
+   const Long64_t minRangeSize = nEntries / (4 * ROOT::GetImplicitMTPoolSize()) + 1;
+   std::vector<std::pair<Long64_t, Long64_t>> ranges;
+   auto clusterIt = tree.GetClusterIterator(0);
+   Long64_t rangeStart = 0;
+   while (clusterIt() < nEntries) {
+      const auto end = std::min(clusterIt.GetNextEntry(), nEntries);
+      if (end - rangeStart >= minRangeSize) {
+         ranges.emplace_back(rangeStart, end);
+         rangeStart = end;
+      }
+   }
+   if (rangeStart < nEntries)
+      ranges.emplace_back(rangeStart, nEntries);
+   if (ranges.size() < 2)
+      return false;
+
+   const std::string fileName = file->GetName();
+   const std::string treePath = GetTreePathInFile(tree);
+   std::atomic<bool> ok(true);
+   auto fillRange = [&](const std::pair<Long64_t, Long64_t> &range) {
+      std::unique_ptr<TFile> f(TFile::Open(fileName.c_str()));
+      auto t = f ? f->Get<TTree>(treePath.c_str()) : nullptr;
+      // the path has no cycle: the tree read may be another cycle than the one indexed, then the serial path is used
+      if (!t || t->GetEntries() != tree.GetEntries() || t->GetTotBytes() != tree.GetTotBytes() ||
+          t->GetZipBytes() != tree.GetZipBytes()) {
+         ok = false;
+         return;
+      }
+      TTreeFormula major("Major", majorName, t);
+      TTreeFormula minor("Minor", minorName, t);
+      major.SetQuickLoad(kTRUE);
+      minor.SetQuickLoad(kTRUE);
+      if (major.GetNdim() != 1 || minor.GetNdim() != 1) {
+         ok = false;
+         return;
+      }
+      for (auto i = range.first; i < range.second; ++i) {
+         if (t->LoadTree(i) < 0) {
+            ok = false;
+            return;
+         }
+         majors[i] = (Long64_t)major.EvalInstance<LongDouble_t>();
+         minors[i] = (Long64_t)minor.EvalInstance<LongDouble_t>();
+      }
+   };
+   ROOT::TThreadExecutor pool;
+   pool.Foreach(fillRange, ranges);
+   return ok;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sort the n entry numbers of order by their index values, in parallel if the implicit multi-threading is enabled:
+/// chunks of the entries are sorted by different tasks, then merged pairwise.
+
+void SortEntries(Long64_t *order, Long64_t n, const TEntryOrder &less)
+{
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && n > 100000) {
+      unsigned nChunks = 2;
+      while (nChunks < 2 * ROOT::GetImplicitMTPoolSize())
+         nChunks *= 2;
+      const Long64_t chunkSize = (n + nChunks - 1) / nChunks;
+      auto chunkBegin = [&](unsigned i) { return order + std::min(n, i * chunkSize); };
+
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](unsigned i) { std::sort(chunkBegin(i), chunkBegin(i + 1), less); }, ROOT::TSeqU(nChunks));
+      for (unsigned width = 1; width < nChunks; width *= 2) {
+         pool.Foreach(
+            [&](unsigned i) {
+               const auto first = 2 * width * i;
+               std::inplace_merge(chunkBegin(first), chunkBegin(first + width), chunkBegin(first + 2 * width), less);
+            },
+            ROOT::TSeqU(nChunks / (2 * width)));
+      }
+      return;
+   }
+#endif
+   std::sort(order, order + n, less);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reorder the n major and minor values in place, the new ith values being the values of the entry order[i].
+/// Each cycle of the permutation is followed once, with one bit per entry to mark the moved values.
+
+void PermuteValues(Long64_t *majors, Long64_t *minors, const Long64_t *order, Long64_t n)
+{
+   std::vector<bool> moved(n);
+   for (Long64_t start = 0; start < n; ++start) {
+      if (moved[start])
+         continue;
+      const Long64_t major = majors[start];
+      const Long64_t minor = minors[start];
+      for (Long64_t i = start;;) {
+         moved[i] = true;
+         const Long64_t from = order[i];
+         if (from == start) {
+            majors[i] = major;
+            minors[i] = minor;
+            break;
+         }
+         majors[i] = majors[from];
+         minors[i] = minors[from];
+         i = from;
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append n values to buf as deltas, each zigzag- and varint-encoded.
+/// With majors, the values are the minor values of these major values, encoded as deltas within the same major value
+/// only.
+
+void PackValues(std::vector<UChar_t> &buf, const Long64_t *values, Long64_t n, const Long64_t *majors = nullptr)
+{
+   Long64_t previous = 0;
+   for (Long64_t i = 0; i < n; ++i) {
+      if (majors && (i == 0 || majors[i] != majors[i - 1]))
+         previous = 0;
+      const Long64_t delta = (Long64_t)((ULong64_t)values[i] - (ULong64_t)previous);
+      previous = values[i];
+      ULong64_t v = ((ULong64_t)delta << 1) ^ (ULong64_t)(delta >> 63);
+      while (v >= 0x80) {
+         buf.push_back(UChar_t(v) | 0x80);
+         v >>= 7;
+      }
+      buf.push_back(UChar_t(v));
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Decode n values written by PackValues. Return false if buf is too short.
+
+bool UnpackValues(const std::vector<UChar_t> &buf, Long64_t *values, Long64_t n, const Long64_t *majors = nullptr)
+{
+   std::size_t pos = 0;
+   Long64_t previous = 0;
+   for (Long64_t i = 0; i < n; ++i) {
+      if (majors && (i == 0 || majors[i] != majors[i - 1]))
+         previous = 0;
+      ULong64_t v = 0;
+      for (int shift = 0;; shift += 7) {
+         if (pos == buf.size() || shift > 63)
+            return false;
+         const UChar_t b = buf[pos++];
+         v |= ULong64_t(b & 0x7F) << shift;
+         if (!(b & 0x80))
+            break;
+      }
+      const Long64_t delta = (Long64_t)(v >> 1) ^ -(Long64_t)(v & 1);
+      values[i] = previous = (Long64_t)((ULong64_t)previous + (ULong64_t)delta);
+   }
+   return true;
+}
+
+} // anonymous namespace
+
 
 struct IndexSortComparator {
 
@@ -161,35 +386,37 @@ TTreeIndex::TTreeIndex(const TTree *T, const char *majorname, const char *minorn
    //   return;
    //}
 
-   Long64_t *tmp_major = new Long64_t[fN];
-   Long64_t *tmp_minor = new Long64_t[fN];
+   // The values are sorted in place, through the permutation that sorts the entry numbers: three arrays of fN
+   // values are all the memory needed, besides one bit per entry and the buffer of the parallel merges.
+   fIndexValues = new Long64_t[fN];
+   fIndexValuesMinor = new Long64_t[fN];
+   fIndex = new Long64_t[fN];
+   Bool_t filled = kFALSE;
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled())
+      filled = FillValuesParallel(*fTree, majorname, minorname, fN, fIndexValues, fIndexValuesMinor);
+#endif
    Long64_t i;
    Long64_t oldEntry = fTree->GetReadEntry();
-   Int_t current = -1;
-   for (i=0;i<fN;i++) {
-      Long64_t centry = fTree->LoadTree(i);
-      if (centry < 0) break;
-      if (fTree->GetTreeNumber() != current) {
-         current = fTree->GetTreeNumber();
-         fMajorFormula->UpdateFormulaLeaves();
-         fMinorFormula->UpdateFormulaLeaves();
+   if (!filled) {
+      Int_t current = -1;
+      for (i=0;i<fN;i++) {
+         Long64_t centry = fTree->LoadTree(i);
+         if (centry < 0) break;
+         if (fTree->GetTreeNumber() != current) {
+            current = fTree->GetTreeNumber();
+            fMajorFormula->UpdateFormulaLeaves();
+            fMinorFormula->UpdateFormulaLeaves();
+         }
+         fIndexValues[i] = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
+         fIndexValuesMinor[i] = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
       }
-      tmp_major[i] = (Long64_t) fMajorFormula->EvalInstance<LongDouble_t>();
-      tmp_minor[i] = (Long64_t) fMinorFormula->EvalInstance<LongDouble_t>();
-   }
-   fIndex = new Long64_t[fN];
-   for(i = 0; i < fN; i++) { fIndex[i] = i; }
-   std::sort(fIndex, fIndex + fN, IndexSortComparator(tmp_major, tmp_minor) );
-   //TMath::Sort(fN,w,fIndex,0);
-   fIndexValues = new Long64_t[fN];
-   fIndexValuesMinor = new Long64_t[fN];
-   for (i=0;i<fN;i++) {
-      fIndexValues[i] = tmp_major[fIndex[i]];
-      fIndexValuesMinor[i] = tmp_minor[fIndex[i]];
    }
+   for (i=0;i<fN;i++) fIndex[i] = i;
+   SortEntries(fIndex, fN, TEntryOrder{fIndexValues, fIndexValuesMinor});
+   PermuteValues(fIndexValues, fIndexValuesMinor, fIndex, fN);
+   BuildBlockValues();
 
-   delete [] tmp_major;
-   delete [] tmp_minor;
    fTree->LoadTree(oldEntry);
 }
 
@@ -285,6 +512,24 @@ void TTreeIndex::Append(const TVirtualIndex *add, Bool_t delaySort )
       delete [] addValues2;
       delete [] ind;
       delete [] conv;
+      BuildBlockValues();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Keep the values of the first entry of every block of kBlockSize sorted
+/// values, so that the lookups first search this small array, then a single
+/// block.
+
+void TTreeIndex::BuildBlockValues()
+{
+   fBlockValues.clear();
+   if (!fIndexValues || !fIndexValuesMinor)
+      return;
+   fBlockValues.reserve(2 * ((fN + kBlockSize - 1) / kBlockSize));
+   for (Long64_t i = 0; i < fN; i += kBlockSize) {
+      fBlockValues.push_back(fIndexValues[i]);
+      fBlockValues.push_back(fIndexValuesMinor[i]);
    }
 }
 
@@ -302,6 +547,7 @@ bool TTreeIndex::ConvertOldToNew()
          fIndexValuesMinor[i] = (fIndexValues[i] & 0x7fffffff);
          fIndexValues[i] >>= 31;
       }
+      BuildBlockValues();
       return true;
    }
    return false;
@@ -350,10 +596,33 @@ Long64_t TTreeIndex::GetEntryNumberFriend(const TTree *parent)
 /// find position where major|minor values are in the IndexValues tables
 /// this is the index in IndexValues table, not entry# !
 /// use lower_bound STD algorithm.
+///
+/// The block of kBlockSize sorted values holding the position is first found
+/// by bisection of the values of the first entry of each block.
 
 Long64_t TTreeIndex::FindValues(Long64_t major, Long64_t minor) const
 {
    Long64_t mid, step, pos = 0, count = fN;
+   const Long64_t nBlocks = fBlockValues.size() / 2;
+   if (nBlocks > 1) {
+      // find the first block whose first value is not lower than major|minor
+      Long64_t block = 0, nb = nBlocks;
+      while( nb > 0 ) {
+         step = nb / 2;
+         mid = block + step;
+         if( fBlockValues[2*mid] < major
+             || ( fBlockValues[2*mid] == major && fBlockValues[2*mid+1] < minor ) ) {
+            block = mid+1;
+            nb -= step + 1;
+         } else
+            nb = step;
+      }
+      if (block == 0)
+         return 0;
+      // the first value of the previous block is lower than major|minor
+      pos = (block - 1) * kBlockSize + 1;
+      count = TMath::Min(fN, block * kBlockSize) - pos;
+   }
    // find lower bound using bisection
    while( count > 0 ) {
       step = count / 2;
@@ -540,6 +809,13 @@ void TTreeIndex::Print(Option_t * option) const
 /// Stream an object of class TTreeIndex.
 /// Note that this Streamer should be changed to an automatic Streamer
 /// once TStreamerInfo supports an index of type Long64_t
+///
+/// The values are written as three arrays of Long64_t, unless the bit kCompactValues is set (see
+/// SetCompactStreaming): then the major values, the minor values and the entry numbers are written as three arrays
+/// of bytes, each value being the varint of the zigzag-encoded difference with the previous one. The minor values
+/// are differences within the same major value only. In that case, the number of values is first written as 0, so
+/// that the versions of ROOT that cannot read the compact form read an empty index and report a byte count
+/// mismatch, instead of taking the bytes for values.
 
 void TTreeIndex::Streamer(TBuffer &R__b)
 {
@@ -550,26 +826,63 @@ void TTreeIndex::Streamer(TBuffer &R__b)
       fMajorName.Streamer(R__b);
       fMinorName.Streamer(R__b);
       R__b >> fN;
-      fIndexValues = new Long64_t[fN];
-      R__b.ReadFastArray(fIndexValues,fN);
-      if( R__v > 1 ) {
+      if (R__v > 2 && TestBit(kCompactValues)) {
+         R__b >> fN;
+         fIndexValues      = new Long64_t[fN];
          fIndexValuesMinor = new Long64_t[fN];
-         R__b.ReadFastArray(fIndexValuesMinor,fN);
+         fIndex            = new Long64_t[fN];
+         std::vector<UChar_t> buf;
+         Long64_t *arrays[3] = {fIndexValues, fIndexValuesMinor, fIndex};
+         for (int k = 0; k < 3; ++k) {
+            Int_t nbytes;
+            R__b >> nbytes;
+            buf.resize(nbytes);
+            R__b.ReadFastArray(reinterpret_cast<Char_t *>(buf.data()), nbytes);
+            if (!UnpackValues(buf, arrays[k], fN, k == 1 ? fIndexValues : nullptr)) {
+               Error("Streamer", "The index values are corrupted");
+               memset(arrays[k], 0, fN * sizeof(Long64_t));
+            }
+         }
       } else {
-         ConvertOldToNew();
+         fIndexValues = new Long64_t[fN];
+         R__b.ReadFastArray(fIndexValues,fN);
+         if( R__v > 1 ) {
+            fIndexValuesMinor = new Long64_t[fN];
+            R__b.ReadFastArray(fIndexValuesMinor,fN);
+         } else {
+            ConvertOldToNew();
+         }
+         fIndex      = new Long64_t[fN];
+         R__b.ReadFastArray(fIndex,fN);
       }
-      fIndex      = new Long64_t[fN];
-      R__b.ReadFastArray(fIndex,fN);
+      BuildBlockValues();
       R__b.CheckByteCount(R__s, R__c, TTreeIndex::IsA());
    } else {
       R__c = R__b.WriteVersion(TTreeIndex::IsA(), kTRUE);
       TVirtualIndex::Streamer(R__b);
       fMajorName.Streamer(R__b);
       fMinorName.Streamer(R__b);
-      R__b << fN;
-      R__b.WriteFastArray(fIndexValues, fN);
-      R__b.WriteFastArray(fIndexValuesMinor, fN);
-      R__b.WriteFastArray(fIndex, fN);
+      if (!TestBit(kCompactValues)) {
+         R__b << fN;
+         R__b.WriteFastArray(fIndexValues, fN);
+         R__b.WriteFastArray(fIndexValuesMinor, fN);
+         R__b.WriteFastArray(fIndex, fN);
+      } else {
+         R__b << Long64_t(0);
+         R__b << fN;
+         std::vector<UChar_t> buf;
+         const Long64_t *arrays[3] = {fIndexValues, fIndexValuesMinor, fIndex};
+         for (int k = 0; k < 3; ++k) {
+            buf.clear();
+            PackValues(buf, arrays[k], fN, k == 1 ? fIndexValues : nullptr);
+            if (buf.size() > (std::size_t)kMaxInt) {
+               Error("Streamer", "The index is too large to be written");
+               buf.clear();
+            }
+            R__b << (Int_t)buf.size();
+            R__b.WriteFastArray(reinterpret_cast<const Char_t *>(buf.data()), (Int_t)buf.size());
+         }
+      }
       R__b.SetByteCount(R__c, kTRUE);
    }
 }
@@ -595,9 +908,15 @@ void TTreeIndex::UpdateFormulaLeaves(const TTree *parent)
 /// when a new Tree is loaded.
 /// Because Trees in a TChain may have a different list of leaves, one
 /// must update the leaves numbers in the TTreeFormula used by the TreeIndex.
+/// The formulas of the previous Tree are deleted, as that Tree may be
+/// deleted; they are created again if needed.
 
 void TTreeIndex::SetTree(const TTree *T)
 {
+   if (T != fTree) {
+      delete fMajorFormula;  fMajorFormula = 0;
+      delete fMinorFormula;  fMinorFormula = 0;
+   }
    fTree = (TTree*)T;
 }
 
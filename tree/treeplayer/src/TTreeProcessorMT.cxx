@@ -157,9 +157,11 @@ TTreeView::GetTreeReader(Long64_t start, Long64_t end, const std::string &treeNa
 
 ////////////////////////////////////////////////////////////////////////
 /// Return a vector of cluster boundaries for the given tree and files.
+/// Clusters for which clusterFilter, if set, returns false are left out.
 // EntryClusters and number of entries per file
 using ClustersAndEntries = std::pair<std::vector<std::vector<EntryCluster>>, std::vector<Long64_t>>;
-static ClustersAndEntries MakeClusters(const std::string &treeName, const std::vector<std::string> &fileNames)
+static ClustersAndEntries MakeClusters(const std::string &treeName, const std::vector<std::string> &fileNames,
+                                       const TTreeProcessorMT::ClusterFilter_t &clusterFilter)
 {
    // Note that as a side-effect of opening all files that are going to be used in the
    // analysis once, all necessary streamers will be loaded into memory.
@@ -196,6 +198,8 @@ static ClustersAndEntries MakeClusters(const std::string &treeName, const std::v
       std::vector<EntryCluster> clusters;
       while ((start = clusterIter()) < entries) {
          end = clusterIter.GetNextEntry();
+         if (clusterFilter && !clusterFilter(*t, start, end))
+            continue;
          // Add the current file's offset to start and end to make them (chain) global
          clusters.emplace_back(EntryCluster{start + offset, end + offset});
       }
@@ -238,12 +242,17 @@ static ClustersAndEntries MakeClusters(const std::string &treeName, const std::v
          const auto start = clustersInThisFile[i].start;
          // We lump together at least nFolds clusters, therefore
          // we need to jump ahead of nFolds-1.
-         i += (nFolds - 1);
+         auto nToFuse = nFolds - 1;
          // We now add a cluster if we have some reminder left
          if (nReminderClusters > 0) {
-            i += 1U;
+            nToFuse += 1U;
             nReminderClusters--;
          }
+         // Clusters left out by the cluster filter must not be processed as part of a lump
+         for (; nToFuse > 0 && i + 1 < clustersInThisFileSize &&
+                clustersInThisFile[i + 1].start == clustersInThisFile[i].end;
+              --nToFuse)
+            ++i;
          const auto end = clustersInThisFile[i].end;
          eventRangesPerFileIt->emplace_back(EntryCluster({start, end}));
       }
@@ -486,7 +495,7 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
    const bool hasEntryList = fEntryList.GetN() > 0;
    const bool shouldRetrieveAllClusters = hasFriends || hasEntryList;
    const auto clustersAndEntries =
-      shouldRetrieveAllClusters ? Internal::MakeClusters(fTreeName, fFileNames) : Internal::ClustersAndEntries{};
+      shouldRetrieveAllClusters ? Internal::MakeClusters(fTreeName, fFileNames, fClusterFilter) : Internal::ClustersAndEntries{};
    const auto &clusters = clustersAndEntries.first;
    const auto &entries = clustersAndEntries.second;
 
@@ -502,7 +511,7 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
       const auto &theseFiles = shouldRetrieveAllClusters ? fFileNames : std::vector<std::string>({fFileNames[fileIdx]});
       // Evaluate clusters (with local entry numbers) and number of entries for this file, if needed
       const auto theseClustersAndEntries =
-         shouldRetrieveAllClusters ? Internal::ClustersAndEntries{} : Internal::MakeClusters(fTreeName, theseFiles);
+         shouldRetrieveAllClusters ? Internal::ClustersAndEntries{} : Internal::MakeClusters(fTreeName, theseFiles, fClusterFilter);
 
       // All clusters for the file to process, either with global or local entry numbers
       const auto &thisFileClusters = shouldRetrieveAllClusters ? clusters[fileIdx] : theseClustersAndEntries.first[0];
@@ -531,6 +540,17 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
    pool.Foreach(processFile, fileIdxs);
 }
 
+////////////////////////////////////////////////////////////////////////
+/// \brief Sets a function that selects the clusters to process.
+/// \param[in] filter Function called with each tree and the range [start, end) of local entry numbers of each of
+/// its clusters. Clusters for which it returns false are not processed.
+///
+/// The function is called concurrently for different files, so it must be thread safe.
+void TTreeProcessorMT::SetClusterFilter(ClusterFilter_t filter)
+{
+   fClusterFilter = std::move(filter);
+}
+
 ////////////////////////////////////////////////////////////////////////
 /// \brief Sets the maximum number of tasks created per file, per worker.
 /// \return The maximum number of tasks created per file, per worker
@@ -0,0 +1,184 @@
+#include "TChain.h"
+#include "TChainIndex.h"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeIndex.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Write a tree of n entries with shuffled (run, event) pairs, returning the pair of each entry.
+std::vector<std::pair<Int_t, Int_t>> WriteIndexTree(const char *fileName, Int_t firstRun, Int_t nRuns, Int_t nEvents)
+{
+   std::vector<std::pair<Int_t, Int_t>> pairs;
+   for (Int_t r = firstRun; r < firstRun + nRuns; ++r)
+      for (Int_t e = 0; e < nEvents; ++e)
+         pairs.emplace_back(r, e);
+   std::shuffle(pairs.begin(), pairs.end(), std::mt19937(firstRun));
+
+   TFile f(fileName, "RECREATE");
+   TTree t("t", "t");
+   Int_t run, event;
+   t.Branch("run", &run);
+   t.Branch("event", &event);
+   t.SetAutoFlush(1000);
+   for (auto &p : pairs) {
+      run = p.first;
+      event = p.second;
+      t.Fill();
+   }
+   t.Write();
+   return pairs;
+}
+
+void CheckIndex(const TVirtualIndex &index, const std::vector<std::pair<Int_t, Int_t>> &pairs, Long64_t offset = 0)
+{
+   for (Long64_t i = 0; i < Long64_t(pairs.size()); ++i)
+      EXPECT_EQ(index.GetEntryNumberWithIndex(pairs[i].first, pairs[i].second), i + offset);
+   EXPECT_EQ(index.GetEntryNumberWithIndex(-1, 0), -1);
+   EXPECT_EQ(index.GetEntryNumberWithIndex(pairs[0].first, -1), -1);
+   EXPECT_EQ(index.GetEntryNumberWithIndex(1000000, 0), -1);
+}
+
+TEST(TTreeIndex, BuildAndLookup)
+{
+   const auto fileName = "treeindex_lookup.root";
+   const auto pairs = WriteIndexTree(fileName, 1, 20, 500);
+   {
+      TFile f(fileName, "UPDATE");
+      auto t = f.Get<TTree>("t");
+      ASSERT_GT(t->BuildIndex("run", "event"), 0);
+      auto index = t->GetTreeIndex();
+      ASSERT_NE(index, nullptr);
+      CheckIndex(*index, pairs);
+      // between two values, the best index is the lower one
+      const auto entry = t->GetEntryNumberWithBestIndex(1, 499);
+      EXPECT_EQ(t->GetEntryNumberWithBestIndex(2, -1), entry);
+      t->Write("", TObject::kOverwrite);
+   }
+   {
+      // the index is read back from the arrays of its values
+      TFile f(fileName);
+      auto t = f.Get<TTree>("t");
+      auto index = dynamic_cast<TTreeIndex *>(t->GetTreeIndex());
+      ASSERT_NE(index, nullptr);
+      EXPECT_STREQ(index->GetMajorName(), "run");
+      EXPECT_EQ(index->GetN(), Long64_t(pairs.size()));
+      CheckIndex(*index, pairs);
+   }
+   gSystem->Unlink(fileName);
+}
+
+TEST(TTreeIndex, CompactStreaming)
+{
+   const auto fileName = "treeindex_compact.root";
+   const auto pairs = WriteIndexTree(fileName, 1, 20, 500);
+   Long64_t defaultSize = 0;
+   {
+      TFile f(fileName, "UPDATE");
+      auto t = f.Get<TTree>("t");
+      TTreeIndex index(t, "run", "event");
+      defaultSize = f.WriteTObject(&index, "default");
+      index.SetCompactStreaming();
+      EXPECT_LT(f.WriteTObject(&index, "compact"), defaultSize);
+   }
+   {
+      TFile f(fileName);
+      auto t = f.Get<TTree>("t");
+      auto index = f.Get<TTreeIndex>("compact");
+      ASSERT_NE(index, nullptr);
+      EXPECT_TRUE(index->TestBit(TTreeIndex::kCompactValues));
+      EXPECT_EQ(index->GetN(), Long64_t(pairs.size()));
+      index->SetTree(t);
+      CheckIndex(*index, pairs);
+   }
+   gSystem->Unlink(fileName);
+}
+
+#ifdef R__USE_IMT
+TEST(TTreeIndex, BuildInParallel)
+{
+   const auto fileName = "treeindex_parallel.root";
+   const auto pairs = WriteIndexTree(fileName, 1, 50, 2000);
+
+   TFile f(fileName);
+   auto t = f.Get<TTree>("t");
+   TTreeIndex serial(t, "run", "event");
+
+   ROOT::EnableImplicitMT(4);
+   TTreeIndex parallel(t, "run", "event");
+   ROOT::DisableImplicitMT();
+
+   ASSERT_EQ(parallel.GetN(), serial.GetN());
+   for (Long64_t i = 0; i < serial.GetN(); ++i) {
+      EXPECT_EQ(parallel.GetIndex()[i], serial.GetIndex()[i]);
+      EXPECT_EQ(parallel.GetIndexValues()[i], serial.GetIndexValues()[i]);
+      EXPECT_EQ(parallel.GetIndexValuesMinor()[i], serial.GetIndexValuesMinor()[i]);
+   }
+   CheckIndex(parallel, pairs);
+   gSystem->Unlink(fileName);
+}
+
+TEST(TTreeIndex, BuildInParallelOlderCycle)
+{
+   // two cycles of the same tree, the newer one with more entries and other values
+   const auto fileName = "treeindex_cycles.root";
+   std::vector<std::pair<Int_t, Int_t>> pairs;
+   {
+      TFile f(fileName, "RECREATE");
+      for (Int_t cycle = 1; cycle <= 2; ++cycle) {
+         TTree t("t", "t");
+         Int_t run, event;
+         t.Branch("run", &run);
+         t.Branch("event", &event);
+         t.SetAutoFlush(1000);
+         for (Int_t i = 0; i < 20000 * cycle; ++i) {
+            run = cycle * 100 + i / 1000;
+            event = (i * 7919) % 1000;
+            if (cycle == 1)
+               pairs.emplace_back(run, event);
+            t.Fill();
+         }
+         t.Write();
+      }
+   }
+
+   TFile f(fileName);
+   auto t = f.Get<TTree>("t;1");
+   ASSERT_EQ(t->GetEntries(), Long64_t(pairs.size()));
+   ROOT::EnableImplicitMT(4);
+   TTreeIndex index(t, "run", "event");
+   ROOT::DisableImplicitMT();
+   EXPECT_EQ(index.GetN(), Long64_t(pairs.size()));
+   CheckIndex(index, pairs);
+   gSystem->Unlink(fileName);
+}
+
+TEST(TChainIndex, BuildInParallel)
+{
+   const auto pairs1 = WriteIndexTree("treeindex_chain1.root", 1, 10, 100);
+   const auto pairs2 = WriteIndexTree("treeindex_chain2.root", 11, 10, 100);
+
+   TChain c("t");
+   c.Add("treeindex_chain1.root");
+   c.Add("treeindex_chain2.root");
+   ROOT::EnableImplicitMT(4);
+   ASSERT_GT(c.BuildIndex("run", "event"), 0);
+   ROOT::DisableImplicitMT();
+
+   auto index = dynamic_cast<TChainIndex *>(c.GetTreeIndex());
+   ASSERT_NE(index, nullptr);
+   EXPECT_EQ(c.GetEntryNumberWithIndex(pairs1[5].first, pairs1[5].second), 5);
+   EXPECT_EQ(c.GetEntryNumberWithIndex(pairs2[7].first, pairs2[7].second), Long64_t(pairs1.size()) + 7);
+   EXPECT_EQ(c.GetEntryNumberWithIndex(100, 0), -1);
+
+   gSystem->Unlink("treeindex_chain1.root");
+   gSystem->Unlink("treeindex_chain2.root");
+}
+#endif